@@ -16,7 +16,7 @@
 #
 # Usage:
 #
-# find_package(SFML COMPONENTS ... [REQUIRED])
+# find_package(SFML [version] COMPONENTS ... [REQUIRED])
 #
 # Possible components are: audio, graphics, network, system, window.
 # You almost always want the "system" component.
@@ -30,6 +30,7 @@
 # SFML_INCLUDE_DIRS: Path to the SFML library headers
 # SFML_LIBRARIES: List of all requested component libraries
 # SFML_DEFINITIONS: Possible required cflags such as SFML_STATIC
+# SFML_VERSION: Version of the found SFML, read from its Config.hpp
 #
 # Also sets SFML_INCLUDE_DIR to the same value as SFML_INCLUDE_DIRS,
 # for compatibility.
@@ -58,10 +59,24 @@ foreach(component ${SFML_FIND_COMPONENTS})
   endif()
 endforeach()
 
+# Read the version from the SFML_VERSION_* macros
+if (SFML_INCLUDE_DIRS AND EXISTS "${SFML_INCLUDE_DIRS}/Config.hpp")
+  file(READ "${SFML_INCLUDE_DIRS}/Config.hpp" SFML_CONFIG_HPP)
+  string(REGEX MATCH "#define SFML_VERSION_MAJOR ([0-9]+)" _ "${SFML_CONFIG_HPP}")
+  set(SFML_VERSION_MAJOR ${CMAKE_MATCH_1})
+  string(REGEX MATCH "#define SFML_VERSION_MINOR ([0-9]+)" _ "${SFML_CONFIG_HPP}")
+  set(SFML_VERSION_MINOR ${CMAKE_MATCH_1})
+  string(REGEX MATCH "#define SFML_VERSION_PATCH ([0-9]+)" _ "${SFML_CONFIG_HPP}")
+  set(SFML_VERSION_PATCH ${CMAKE_MATCH_1})
+  set(SFML_VERSION "${SFML_VERSION_MAJOR}.${SFML_VERSION_MINOR}.${SFML_VERSION_PATCH}")
+endif()
+
 set(SFML_INCLUDE_DIR ${SFML_INCLUDE_DIRS})
 set(SFML_DEFINITIONS ${SFMLPKG_CFLAGS})
 mark_as_advanced(SFML_LIBRARIES SFML_INCLUDE_DIRS)
 
 include(FindPackageHandleStandardArgs)
-find_package_handle_standard_args(SFML DEFAULT_MSG SFML_INCLUDE_DIRS SFML_LIBRARIES)
+find_package_handle_standard_args(SFML
+  REQUIRED_VARS SFML_INCLUDE_DIRS SFML_LIBRARIES
+  VERSION_VAR SFML_VERSION)
 
@@ -0,0 +1,81 @@
+/***************************************************************************
+ * mrbcache.cpp - Precompiles the scripting library to mruby bytecode
+ *
+ * Copyright © 2012-2020 The TSC Contributors
+ ***************************************************************************/
+/*
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "../src/scripting/bytecode_cache.hpp"
+#include <iostream>
+#include <boost/filesystem/fstream.hpp>
+
+namespace fs = boost::filesystem;
+using TSC::Scripting::cBytecode_Cache;
+
+int main(int argc, char* argv[])
+{
+    // This is an internal programme, so no sophistic commandline parsing required.
+    if (argc < 2) {
+        std::cerr << "Usage: tsc-mrbcache OUTPUT_DIR [SCRIPT.rb...]" << std::endl;
+        return 1;
+    }
+
+    fs::path output_dir = fs::path(argv[1]);
+
+    // Prepare output directory
+    if (fs::exists(output_dir))
+        fs::remove_all(output_dir);
+    fs::create_directories(output_dir);
+
+    // Bytecode is written by the cache itself, so that the file names
+    // match exactly what the game looks up at runtime.
+    cBytecode_Cache cache(fs::path(), output_dir);
+    mrb_state* p_state = mrb_open();
+    int result = 0;
+
+    for (int i = 2; i < argc; i++) {
+        fs::path scriptfile(argv[i]);
+
+        fs::ifstream file(scriptfile);
+        if (!file.is_open()) {
+            std::cerr << "Failed to open mruby script file '" << scriptfile.string() << "'" << std::endl;
+            result = 1;
+            continue;
+        }
+
+        // Read it exactly like TSC::readfile() does, otherwise
+        // the hashes would not match.
+        std::string code;
+        std::string line;
+        while (!file.eof()) {
+            std::getline(file, line);
+            code.append(line);
+            code.append("\n");
+        }
+
+        // The game uses the bare file name as the context name, see
+        // cMRuby_Interpreter::Run_File().
+        std::string contextname = scriptfile.filename().string();
+        std::string bytecode;
+
+        if (!cBytecode_Cache::Compile(p_state, code, contextname, bytecode)) {
+            std::cerr << "Syntax error in mruby script file '" << scriptfile.string() << "'" << std::endl;
+            result = 1;
+            continue;
+        }
+
+        cache.Store(code, contextname, bytecode);
+        std::cout << contextname << " -> " << cBytecode_Cache::Cache_Filename(code, contextname) << std::endl;
+    }
+
+    mrb_close(p_state);
+    return result;
+}
@@ -79,7 +79,7 @@ void cRandom_Sound::Init(void)
     m_massive_type = MASS_PASSIVE;
     m_editor_pos_z = 0.111f;
     m_camera_range = 0;
-    m_name = "Sound";
+    Editor_Data().m_name = "Sound";
 
     m_rect.m_w = 10.0f;
     m_rect.m_h = 10.0f;
@@ -125,26 +125,24 @@ std::string cRandom_Sound::Get_XML_Type_Name()
     return "";
 }
 
-xmlpp::Element* cRandom_Sound::Save_To_XML_Node(xmlpp::Element* p_element)
+void cRandom_Sound::Save_To_XML_Node(cXml_Writer& writer)
 {
-    xmlpp::Element* p_node = cSprite::Save_To_XML_Node(p_element);
+    cSprite::Save_To_XML_Node(writer);
 
 
     // filename
-    Add_Property(p_node, "file", m_filename);
+    Add_Property(writer, "file", m_filename);
     // continuous
-    Add_Property(p_node, "continuous", m_continuous);
+    Add_Property(writer, "continuous", m_continuous);
     // delay
-    Add_Property(p_node, "delay_min", m_delay_min);
-    Add_Property(p_node, "delay_max", m_delay_max);
+    Add_Property(writer, "delay_min", m_delay_min);
+    Add_Property(writer, "delay_max", m_delay_max);
     // volume
-    Add_Property(p_node, "volume_min", m_volume_min);
-    Add_Property(p_node, "volume_max", m_volume_max);
+    Add_Property(writer, "volume_min", m_volume_min);
+    Add_Property(writer, "volume_max", m_volume_max);
     // volume reduction
-    Add_Property(p_node, "volume_reduction_begin", m_volume_reduction_begin);
-    Add_Property(p_node, "volume_reduction_end", m_volume_reduction_end);
-
-    return p_node;
+    Add_Property(writer, "volume_reduction_begin", m_volume_reduction_begin);
+    Add_Property(writer, "volume_reduction_end", m_volume_reduction_end);
 }
 
 void cRandom_Sound::Set_Filename(const std::string& str)
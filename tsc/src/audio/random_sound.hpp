@@ -105,7 +105,7 @@ namespace TSC {
         bool Editor_Volume_Reduction_End_Text_Changed(const CEGUI::EventArgs& event);
 
         // Save to XML node
-        virtual xmlpp::Element* Save_To_XML_Node(xmlpp::Element* p_element);
+        virtual void Save_To_XML_Node(cXml_Writer& writer);
 
     protected:
         virtual std::string Get_XML_Type_Name();
@@ -0,0 +1,189 @@
+/***************************************************************************
+ * alloc_counter.cpp - counting global allocator
+ *
+ * Copyright © 2012-2020 The TSC Contributors
+ ***************************************************************************/
+/*
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "../core/alloc_counter.hpp"
+#include "../core/global_basic.hpp"
+
+#ifdef ENABLE_ALLOC_COUNTER
+#include <atomic>
+#include <new>
+#include <cstdlib>
+#include <cstddef>
+
+// constant initialized, so counting works before any constructor ran
+static thread_local uint64_t thread_alloc_count = 0;
+static thread_local uint64_t thread_alloc_bytes = 0;
+static std::atomic<uint64_t> total_alloc_count(0);
+static std::atomic<uint64_t> total_alloc_bytes(0);
+// memory may be freed by another thread, so these are process wide
+static std::atomic<uint64_t> live_alloc_bytes(0);
+static std::atomic<uint64_t> peak_alloc_bytes(0);
+
+// in front of each allocation to know its size when freed, keeps the alignment of malloc()
+static const std::size_t alloc_header_size = alignof(std::max_align_t);
+
+void* operator new(std::size_t size)
+{
+    thread_alloc_count++;
+    thread_alloc_bytes += size;
+    total_alloc_count.fetch_add(1, std::memory_order_relaxed);
+    total_alloc_bytes.fetch_add(size, std::memory_order_relaxed);
+
+    void* p_memory = malloc(alloc_header_size + size);
+
+    while (!p_memory) {
+        std::new_handler handler = std::get_new_handler();
+
+        if (!handler) {
+            throw std::bad_alloc();
+        }
+
+        handler();
+        p_memory = malloc(alloc_header_size + size);
+    }
+
+    *static_cast<std::size_t*>(p_memory) = size;
+
+    uint64_t live = live_alloc_bytes.fetch_add(size, std::memory_order_relaxed) + size;
+    uint64_t peak = peak_alloc_bytes.load(std::memory_order_relaxed);
+
+    while (live > peak && !peak_alloc_bytes.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {
+        // peak was updated by compare_exchange_weak
+    }
+
+    return static_cast<char*>(p_memory) + alloc_header_size;
+}
+
+// Free memory from operator new
+static void Alloc_Counter_Free(void* p_memory)
+{
+    if (!p_memory) {
+        return;
+    }
+
+    void* p_block = static_cast<char*>(p_memory) - alloc_header_size;
+    live_alloc_bytes.fetch_sub(*static_cast<std::size_t*>(p_block), std::memory_order_relaxed);
+    free(p_block);
+}
+
+void* operator new[](std::size_t size)
+{
+    return operator new(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+    try {
+        return operator new(size);
+    }
+    catch (const std::bad_alloc&) {
+        return NULL;
+    }
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept
+{
+    return operator new(size, std::nothrow);
+}
+
+void operator delete(void* p_memory) noexcept
+{
+    Alloc_Counter_Free(p_memory);
+}
+
+void operator delete[](void* p_memory) noexcept
+{
+    Alloc_Counter_Free(p_memory);
+}
+
+void operator delete(void* p_memory, const std::nothrow_t&) noexcept
+{
+    Alloc_Counter_Free(p_memory);
+}
+
+void operator delete[](void* p_memory, const std::nothrow_t&) noexcept
+{
+    Alloc_Counter_Free(p_memory);
+}
+#endif
+
+namespace TSC {
+
+/* *** *** *** *** *** *** *** Allocation counter *** *** *** *** *** *** *** *** *** *** */
+
+uint64_t Get_Alloc_Count(void)
+{
+#ifdef ENABLE_ALLOC_COUNTER
+    return thread_alloc_count;
+#else
+    return 0;
+#endif
+}
+
+uint64_t Get_Alloc_Bytes(void)
+{
+#ifdef ENABLE_ALLOC_COUNTER
+    return thread_alloc_bytes;
+#else
+    return 0;
+#endif
+}
+
+uint64_t Get_Total_Alloc_Count(void)
+{
+#ifdef ENABLE_ALLOC_COUNTER
+    return total_alloc_count.load(std::memory_order_relaxed);
+#else
+    return 0;
+#endif
+}
+
+uint64_t Get_Total_Alloc_Bytes(void)
+{
+#ifdef ENABLE_ALLOC_COUNTER
+    return total_alloc_bytes.load(std::memory_order_relaxed);
+#else
+    return 0;
+#endif
+}
+
+uint64_t Get_Live_Alloc_Bytes(void)
+{
+#ifdef ENABLE_ALLOC_COUNTER
+    return live_alloc_bytes.load(std::memory_order_relaxed);
+#else
+    return 0;
+#endif
+}
+
+uint64_t Get_Peak_Alloc_Bytes(void)
+{
+#ifdef ENABLE_ALLOC_COUNTER
+    return peak_alloc_bytes.load(std::memory_order_relaxed);
+#else
+    return 0;
+#endif
+}
+
+void Reset_Peak_Alloc_Bytes(void)
+{
+#ifdef ENABLE_ALLOC_COUNTER
+    peak_alloc_bytes.store(live_alloc_bytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+#endif
+}
+
+/* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
+
+} // namespace TSC
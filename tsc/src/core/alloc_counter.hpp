@@ -0,0 +1,49 @@
+/***************************************************************************
+ * alloc_counter.hpp - counting global allocator
+ *
+ * Copyright © 2012-2020 The TSC Contributors
+ ***************************************************************************/
+/*
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef TSC_ALLOC_COUNTER_HPP
+#define TSC_ALLOC_COUNTER_HPP
+
+#include "../core/global_basic.hpp"
+
+namespace TSC {
+
+    /* *** *** *** *** *** *** *** Allocation counter *** *** *** *** *** *** *** *** *** *** */
+
+    /* If built with ENABLE_ALLOC_COUNTER the global operator new is
+     * replaced by one counting the allocations of each thread and of
+     * all threads together. Memory allocated with malloc(), as by
+     * libraries written in C, is not counted. Without it these return 0.
+     */
+
+    // Number of allocations of the calling thread since it started
+    uint64_t Get_Alloc_Count(void);
+    // Bytes allocated by the calling thread since it started, freeing is not subtracted
+    uint64_t Get_Alloc_Bytes(void);
+    // Number of allocations of all threads since the start
+    uint64_t Get_Total_Alloc_Count(void);
+    // Bytes allocated by all threads since the start
+    uint64_t Get_Total_Alloc_Bytes(void);
+    // Bytes allocated by all threads and not freed yet
+    uint64_t Get_Live_Alloc_Bytes(void);
+    // Highest live bytes since the start or the last reset
+    uint64_t Get_Peak_Alloc_Bytes(void);
+    void Reset_Peak_Alloc_Bytes(void);
+
+    /* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
+
+} // namespace TSC
+
+#endif
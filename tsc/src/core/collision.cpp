@@ -111,7 +111,6 @@ cObjectCollision::cObjectCollision(void)
     m_valid_type = COL_VTYPE_NOT_VALID;
     m_received = 0;
     m_obj = NULL;
-    m_number = 0;
     m_direction = DIR_UNDEFINED;
     m_array = ARRAY_UNDEFINED;
 }
@@ -51,8 +51,8 @@ namespace TSC {
 
         // the object colliding with (only use it in the same frame for now !)
         cSprite* m_obj;
-        // colliding object number
-        int m_number;
+        // colliding object handle, invalid for the player
+        cSprite_Handle m_handle;
 
         // direction
         ObjectDirection m_direction;
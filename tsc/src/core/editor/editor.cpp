@@ -22,6 +22,7 @@
 #include "../../objects/level_exit.hpp"
 #include "../../objects/level_entry.hpp"
 #include "../errors.hpp"
+#include "editor_catalogue.hpp"
 #include "editor.hpp"
 
 #define TABPANE_OUT_OF_SIGHT_X -0.19f
@@ -43,6 +44,7 @@ cEditor::cEditor()
     m_editor_item_tag = "Must be set by subclass";
     m_help_window_visible = false;
     m_object_config_pane_shown = false;
+    m_items_loaded = false;
     mp_edited_sprite_manager = NULL;
 }
 
@@ -103,13 +105,10 @@ void cEditor::Init(void)
     parse_menu_file();
     populate_menu();
 
-    /* Fill in the creatable objects for each menu entry; first the
-     * image items (= static sprites with a .settings file), then the
-     * special items (= everything else, such as enemies).  The
-     * function menu entries are handled in the
-     * on_menu_selection_changed() event handler function. */
-    load_image_items();
-    load_special_items();
+    /* The creatable objects for each menu entry are only filled in
+     * when the editor is enabled the first time, as most players
+     * never open it. */
+    m_items_loaded = false;
 
     mp_editor_tabpane->subscribeEvent(CEGUI::Window::EventMouseEntersArea, CEGUI::Event::Subscriber(&cEditor::on_mouse_enter, this));
     mp_editor_tabpane->subscribeEvent(CEGUI::Window::EventMouseLeavesArea, CEGUI::Event::Subscriber(&cEditor::on_mouse_leave, this));
@@ -157,6 +156,17 @@ void cEditor::Enable(cSprite_Manager* p_edited_sprite_manager)
     // TRANS: displayed to the user when opening the editor
     Draw_Static_Text(_("Loading"), &orange, NULL, 0);
 
+    /* Fill in the creatable objects for each menu entry; first the
+     * image items (= static sprites with a .settings file), then the
+     * special items (= everything else, such as enemies).  The
+     * function menu entries are handled in the
+     * on_menu_selection_changed() event handler function. */
+    if (!m_items_loaded) {
+        load_image_items();
+        load_special_items();
+        m_items_loaded = true;
+    }
+
     pAudio->Play_Sound("editor/enter.ogg");
     pMouseCursor->Set_Active(true);
 
@@ -800,9 +810,9 @@ bool cEditor::Mouse_Move(const sf::Event& evt)
  * \returns false if the item was not added because the master tag
  * was missing, true otherwise.
  */
-bool cEditor::Try_Add_Image_Item(boost::filesystem::path settings_path, const cImage_Settings_Data* p_settings)
+bool cEditor::Try_Add_Image_Item(const cEditor_Catalogue_Item& item)
 {
-    std::vector<std::string> available_tags = string_split(p_settings->m_editor_tags, ";");
+    std::vector<std::string> available_tags = string_split(item.m_editor_tags, ";");
 
     // If the master tag is not in the tag list, do not add this graphic to the
     // editor.
@@ -813,46 +823,25 @@ bool cEditor::Try_Add_Image_Item(boost::filesystem::path settings_path, const cI
     std::vector<cEditor_Menu_Entry*> target_menu_entries = find_target_menu_entries_for(available_tags);
     std::vector<cEditor_Menu_Entry*>::iterator iter;
 
-    // Find the PNG of this settings file. If an equally named .png exists,
-    // assume that file, otherwise check the settings 'base' property. If
-    // that also doesn't exist, that's an error.
-    boost::filesystem::path pixmap_path(settings_path); // Copy
-    pixmap_path.replace_extension(utf8_to_path(".png"));
-    if (!boost::filesystem::exists(pixmap_path)) {
-        if (p_settings->m_base.empty()) { // Error
-            std::cerr << "PNG file for settings file '" << path_to_utf8(settings_path) << "' not found (no .png found and no 'base' setting)." << std::endl;
-            std::cerr << "Using dummy image instead." << std::endl;
-            pixmap_path = pResource_Manager->Get_Game_Pixmap("game/image_not_found.png");
-        }
-        else {
-            pixmap_path = pixmap_path.parent_path() / p_settings->m_base;
-            if (!boost::filesystem::exists(pixmap_path)) {
-                std::cerr << "PNG base file not found at '" << path_to_utf8(pixmap_path) << "'." << std::endl;
-                std::cerr << "Using dummy image instead." << std::endl;
-                pixmap_path = pResource_Manager->Get_Game_Pixmap("game/image_not_found.png");
-            }
-        }
-    }
-
     // Create the template sprite that will be copied each time the
     // user wants to add this object.
     // Cf. cSprite::cSprite(XmlAtributes) constructor on how to create
     // a sprite correctly.
     cSprite* p_template_sprite = new cSprite(&m_sprite_manager);
-    p_template_sprite->Set_Image(pVideo->Get_Surface(settings_path), 1); // FIXME: handle .imgset files?
-    p_template_sprite->Set_Massive_Type(p_settings->m_massive_type);
+    p_template_sprite->Set_Image(pVideo->Get_Surface(item.m_settings_path), 1); // FIXME: handle .imgset files?
+    p_template_sprite->Set_Massive_Type(item.m_massive_type);
     m_sprite_manager.Add(p_template_sprite); // Memory-manage it
 
     // Add the graphics to the respective menu entries' GUI panels.
     for(iter=target_menu_entries.begin(); iter != target_menu_entries.end(); iter++) {
         (*iter)->Add_Item(
             p_template_sprite,
-            load_cegui_image(pixmap_path),
-            p_settings->m_name,
+            load_cegui_image(item.m_pixmap_path),
+            item.m_name,
             CEGUI::Quaternion::eulerAnglesDegrees(
-                p_settings->m_rotation_x,
-                p_settings->m_rotation_y,
-                p_settings->m_rotation_z
+                item.m_rotation_x,
+                item.m_rotation_y,
+                item.m_rotation_z
                 )
             );
     }
@@ -871,7 +860,7 @@ bool cEditor::Try_Add_Image_Item(boost::filesystem::path settings_path, const cI
 bool cEditor::Try_Add_Special_Item(cSprite* p_sprite)
 {
     // Get the list of tags attached to this graphic.
-    std::vector<std::string> available_tags = string_split(p_sprite->m_editor_tags, ";");
+    std::vector<std::string> available_tags = string_split(p_sprite->Editor_Data().m_editor_tags, ";");
 
     // If the master tag is not in the tag list, do not add this graphic to the
     // editor.
@@ -988,32 +977,11 @@ void cEditor::populate_menu()
 /// Load the static .settings-file based objects into the editor menu.
 void cEditor::load_image_items()
 {
-    namespace fs = boost::filesystem;
-
-    std::vector<fs::path> image_files = Get_Directory_Files(pResource_Manager->Get_Game_Pixmaps_Directory(), ".settings");
-    std::vector<std::pair<fs::path, cImage_Settings_Data*>> items;
-
-    // Parse all the settings files
-    for (const fs::path& settings_path: image_files) {
-        cImage_Settings_Parser parser;
-        cImage_Settings_Data* p_settings = parser.Get(settings_path);
-        items.push_back(std::make_pair(settings_path, p_settings));
-    }
-
-    // Sort them by the name from the settings file's contents
-    std::sort(
-        items.begin(),
-        items.end(), [](std::pair<fs::path, cImage_Settings_Data*> a,
-                        std::pair<fs::path, cImage_Settings_Data*> b) {
-                         return std::get<1>(a)->m_name < std::get<1>(b)->m_name;
-                     });
-
-    // Add them all to the editor's menu
-    for (std::pair<fs::path, cImage_Settings_Data*> pair: items) {
-        fs::path settings_path = std::get<0>(pair);
-        cImage_Settings_Data* p_settings = std::get<1>(pair);
-        Try_Add_Image_Item(settings_path, p_settings);
-        delete p_settings;
+    // Already sorted by name
+    const std::vector<cEditor_Catalogue_Item>& items = pEditor_Catalogue->Get_Items();
+
+    for (const cEditor_Catalogue_Item& item: items) {
+        Try_Add_Image_Item(item);
     }
 }
 
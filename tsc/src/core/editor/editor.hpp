@@ -17,6 +17,8 @@
 #ifndef TSC_EDITOR_HPP
 #define TSC_EDITOR_HPP
 
+#include "editor_catalogue.hpp"
+
 namespace TSC {
     class cEditor_Menu_Entry {
     public:
@@ -79,7 +81,7 @@ namespace TSC {
         /// Is the config panel shown to the user?
         inline bool Is_Config_Panel_Shown(){ return m_object_config_pane_shown; }
 
-        bool Try_Add_Image_Item(boost::filesystem::path settings_path, const cImage_Settings_Data* p_settings);
+        bool Try_Add_Image_Item(const cEditor_Catalogue_Item& item);
         bool Try_Add_Special_Item(cSprite* p_sprite); // FIXME: Must take std::vector<cSprite*> due to multi-sprite objects
         void Select_Same_Object_Types(const cSprite* obj);
 
@@ -99,6 +101,8 @@ namespace TSC {
 
         bool m_enabled;
         bool m_object_config_pane_shown;
+        // the items menus are filled on first Enable()
+        bool m_items_loaded;
     protected:
         std::string m_editor_item_tag;
         boost::filesystem::path m_menu_filename;
@@ -0,0 +1,367 @@
+/***************************************************************************
+ * editor_catalogue.cpp - Catalogue of the image items for the editors
+ *
+ * Copyright © 2012-2020 The TSC Contributors
+ ***************************************************************************/
+/*
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "../global_basic.hpp"
+#include "../game_core.hpp"
+#include "../property_helper.hpp"
+#include "../filesystem/filesystem.hpp"
+#include "../filesystem/resource_manager.hpp"
+#include "../parallel.hpp"
+#include "../../video/img_settings.hpp"
+#include "editor_catalogue.hpp"
+
+using namespace std;
+
+namespace fs = boost::filesystem;
+
+namespace TSC {
+
+/* Increase when changing the catalogue file format */
+static const int EDITOR_CATALOGUE_FORMAT = 2;
+// Catalogue file name in the image cache directory
+static const char* EDITOR_CATALOGUE_FILENAME = "editor_catalogue.txt";
+// Shown for items whose image is missing
+static const char* EDITOR_CATALOGUE_MISSING_IMAGE = "game/image_not_found.png";
+
+// Escape backslashes, tabs and line breaks so the field can't break the line format
+static std::string Escape_Catalogue_Field(const std::string& str)
+{
+    std::string result;
+    result.reserve(str.length());
+
+    for (std::string::const_iterator itr = str.begin(); itr != str.end(); ++itr) {
+        switch (*itr) {
+        case '\\':
+            result += "\\\\";
+            break;
+        case '\t':
+            result += "\\t";
+            break;
+        case '\n':
+            result += "\\n";
+            break;
+        case '\r':
+            result += "\\r";
+            break;
+        default:
+            result += *itr;
+            break;
+        }
+    }
+
+    return result;
+}
+
+/* Reverse Escape_Catalogue_Field
+ * returns 0 if the field contains an unknown or incomplete escape sequence
+*/
+static bool Unescape_Catalogue_Field(const std::string& str, std::string& result)
+{
+    result.clear();
+    result.reserve(str.length());
+
+    for (std::string::size_type i = 0; i < str.length(); i++) {
+        if (str[i] != '\\') {
+            result += str[i];
+            continue;
+        }
+
+        if (++i == str.length()) {
+            return 0;
+        }
+
+        switch (str[i]) {
+        case '\\':
+            result += '\\';
+            break;
+        case 't':
+            result += '\t';
+            break;
+        case 'n':
+            result += '\n';
+            break;
+        case 'r':
+            result += '\r';
+            break;
+        default:
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+/* *** *** *** *** *** *** cEditor_Catalogue *** *** *** *** *** *** *** *** *** *** *** */
+
+cEditor_Catalogue::cEditor_Catalogue(void)
+{
+    m_started = 0;
+}
+
+cEditor_Catalogue::~cEditor_Catalogue(void)
+{
+    Wait();
+}
+
+void cEditor_Catalogue::Prepare(void)
+{
+    if (m_started) {
+        return;
+    }
+
+    m_started = 1;
+    m_thread = boost::thread(&cEditor_Catalogue::Load_Or_Build, this);
+}
+
+const std::vector<cEditor_Catalogue_Item>& cEditor_Catalogue::Get_Items(void)
+{
+    Prepare();
+    Wait();
+
+    return m_items;
+}
+
+void cEditor_Catalogue::Wait(void)
+{
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+}
+
+void cEditor_Catalogue::Load_Or_Build(void)
+{
+    fs::path filename = pResource_Manager->Get_User_Imgcache_Directory() / utf8_to_path(EDITOR_CATALOGUE_FILENAME);
+
+    if (Load(filename)) {
+        return;
+    }
+
+    Build();
+    Save(filename);
+}
+
+/* The catalogue file starts with a header line holding the format,
+ * the game version and the pixmaps directory it was built from.
+ * Then follows one line per item with tab-separated fields:
+ *   settings file, image file, name, editor tags, rotation x, y, z, massive type
+ * Both files are relative to the pixmaps directory. Backslashes, tabs
+ * and line breaks in the text fields are escaped as \\, \t, \n and \r. */
+bool cEditor_Catalogue::Load(const fs::path& filename)
+{
+    if (!File_Exists(filename)) {
+        return 0;
+    }
+
+    uint32_t start_ticks = TSC_GetTicks();
+
+    // read it at once
+    fs::ifstream ifs(filename, ios::in | ios::binary);
+
+    if (!ifs) {
+        return 0;
+    }
+
+    std::string contents((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
+    ifs.close();
+
+    fs::path pixmaps_dir = pResource_Manager->Get_Game_Pixmaps_Directory();
+    std::string header = int_to_string(EDITOR_CATALOGUE_FORMAT) + "\t" + int_to_string(tsc_version) + "\t" + Escape_Catalogue_Field(path_to_utf8(pixmaps_dir));
+
+    std::string::size_type pos = contents.find('\n');
+
+    // outdated
+    if (pos == std::string::npos || contents.compare(0, pos, header) != 0) {
+        return 0;
+    }
+
+    std::vector<cEditor_Catalogue_Item> items;
+
+    while (++pos < contents.length()) {
+        std::string::size_type end = contents.find('\n', pos);
+
+        if (end == std::string::npos) {
+            end = contents.length();
+        }
+
+        std::vector<std::string> fields = string_split(contents.substr(pos, end - pos), "\t");
+        pos = end;
+
+        std::string settings_path;
+        std::string pixmap_path;
+        cEditor_Catalogue_Item item;
+
+        if (fields.size() != 8 ||
+            !Unescape_Catalogue_Field(fields[0], settings_path) || !Unescape_Catalogue_Field(fields[1], pixmap_path) ||
+            !Unescape_Catalogue_Field(fields[2], item.m_name) || !Unescape_Catalogue_Field(fields[3], item.m_editor_tags)) {
+            cerr << "Warning : Invalid editor catalogue " << path_to_utf8(filename) << ", rebuilding it" << endl;
+            return 0;
+        }
+
+        item.m_settings_path = pixmaps_dir / utf8_to_path(settings_path);
+        item.m_pixmap_path = pixmaps_dir / utf8_to_path(pixmap_path);
+        item.m_rotation_x = string_to_int(fields[4]);
+        item.m_rotation_y = string_to_int(fields[5]);
+        item.m_rotation_z = string_to_int(fields[6]);
+        item.m_massive_type = static_cast<MassiveType>(string_to_int(fields[7]));
+
+        items.push_back(item);
+    }
+
+    m_items.swap(items);
+
+    debug_print("Loaded editor catalogue with %u items in %u ms\n", static_cast<unsigned int>(m_items.size()), TSC_GetTicks() - start_ticks);
+    return 1;
+}
+
+bool cEditor_Catalogue::Save(const fs::path& filename) const
+{
+    std::string pixmaps_dir = path_to_utf8(pResource_Manager->Get_Game_Pixmaps_Directory());
+    std::string contents = int_to_string(EDITOR_CATALOGUE_FORMAT) + "\t" + int_to_string(tsc_version) + "\t" + Escape_Catalogue_Field(pixmaps_dir) + "\n";
+
+    for (vector<cEditor_Catalogue_Item>::const_iterator itr = m_items.begin(); itr != m_items.end(); ++itr) {
+        std::string settings_path = Escape_Catalogue_Field(path_to_utf8(itr->m_settings_path).substr(pixmaps_dir.length() + 1));
+        std::string pixmap_path = Escape_Catalogue_Field(path_to_utf8(itr->m_pixmap_path).substr(pixmaps_dir.length() + 1));
+
+        contents += settings_path + "\t" + pixmap_path + "\t" + Escape_Catalogue_Field(itr->m_name) + "\t" + Escape_Catalogue_Field(itr->m_editor_tags) + "\t";
+        contents += int_to_string(itr->m_rotation_x) + "\t" + int_to_string(itr->m_rotation_y) + "\t" + int_to_string(itr->m_rotation_z) + "\t";
+        contents += int_to_string(itr->m_massive_type) + "\n";
+    }
+
+    // write to a temporary file first so a crash never leaves a damaged catalogue behind
+    fs::path temp_filename = filename;
+    temp_filename += utf8_to_path(".tmp");
+
+    fs::ofstream ofs(temp_filename, ios::out | ios::binary | ios::trunc);
+
+    if (!ofs) {
+        cerr << "Warning : Could not write editor catalogue " << path_to_utf8(temp_filename) << endl;
+        return 0;
+    }
+
+    ofs.write(contents.data(), contents.size());
+    ofs.close();
+
+    boost::system::error_code ec;
+
+    if (ofs.fail()) {
+        cerr << "Warning : Could not write editor catalogue " << path_to_utf8(temp_filename) << endl;
+        fs::remove(temp_filename, ec);
+        return 0;
+    }
+
+    fs::rename(temp_filename, filename, ec);
+
+    if (ec) {
+        cerr << "Warning : Could not write editor catalogue " << path_to_utf8(filename) << " : " << ec.message() << endl;
+        fs::remove(temp_filename, ec);
+        return 0;
+    }
+
+    return 1;
+}
+
+void cEditor_Catalogue::Build(void)
+{
+    uint32_t start_ticks = TSC_GetTicks();
+
+    std::vector<fs::path> settings_files = Get_Directory_Files(pResource_Manager->Get_Game_Pixmaps_Directory(), ".settings");
+    std::vector<cEditor_Catalogue_Item> items(settings_files.size());
+    // not std::vector<bool>, which packs bits and can't be written from several threads
+    std::vector<char> valid(settings_files.size(), 0);
+
+    unsigned int thread_count = Get_Worker_Thread_Count();
+    // one parser per thread as the global one is not thread-safe
+    std::vector<cImage_Settings_Parser> parsers(thread_count);
+
+    // all in one batch, the items are kept anyway
+    Parallel_For_Batches(settings_files.size(), settings_files.size(), thread_count, [&settings_files, &items, &valid, &parsers](size_t i, unsigned int thread) {
+        valid[i] = Build_Item(settings_files[i], &parsers[thread], &items[i]);
+    });
+
+    m_items.clear();
+
+    for (size_t i = 0; i < items.size(); i++) {
+        if (valid[i]) {
+            m_items.push_back(items[i]);
+        }
+    }
+
+    // Sort them by the name from the settings file's contents
+    std::stable_sort(m_items.begin(), m_items.end(), [](const cEditor_Catalogue_Item& a, const cEditor_Catalogue_Item& b) {
+        return a.m_name < b.m_name;
+    });
+
+    debug_print("Built editor catalogue with %u items in %u ms using %u threads\n", static_cast<unsigned int>(m_items.size()), TSC_GetTicks() - start_ticks, thread_count);
+}
+
+bool cEditor_Catalogue::Build_Item(const fs::path& settings_path, cImage_Settings_Parser* p_parser, cEditor_Catalogue_Item* p_item)
+{
+    // the index is read-only and may be shared
+    cImage_Settings_Data* p_settings = pSettingsParser->m_index.Get(settings_path);
+
+    if (!p_settings) {
+        p_settings = p_parser->Get(settings_path);
+    }
+
+    // Only items with editor tags can show up in an editor
+    if (!p_settings || p_settings->m_editor_tags.empty()) {
+        delete p_settings;
+        return 0;
+    }
+
+    cEditor_Catalogue_Item& item = *p_item;
+
+    /* Find the PNG of this settings file. If an equally named .png
+     * exists, assume that file, otherwise check the settings 'base'
+     * property. If that also doesn't exist, that's an error. */
+    item.m_pixmap_path = settings_path;
+    item.m_pixmap_path.replace_extension(utf8_to_path(".png"));
+
+    if (!fs::exists(item.m_pixmap_path)) {
+        if (p_settings->m_base.empty()) {
+            cerr << "PNG file for settings file '" << path_to_utf8(settings_path) << "' not found (no .png found and no 'base' setting)." << endl;
+            cerr << "Using dummy image instead." << endl;
+            item.m_pixmap_path = pResource_Manager->Get_Game_Pixmap(EDITOR_CATALOGUE_MISSING_IMAGE);
+        }
+        else {
+            item.m_pixmap_path = item.m_pixmap_path.parent_path() / p_settings->m_base;
+
+            if (!fs::exists(item.m_pixmap_path)) {
+                cerr << "PNG base file not found at '" << path_to_utf8(item.m_pixmap_path) << "'." << endl;
+                cerr << "Using dummy image instead." << endl;
+                item.m_pixmap_path = pResource_Manager->Get_Game_Pixmap(EDITOR_CATALOGUE_MISSING_IMAGE);
+            }
+        }
+    }
+
+    item.m_settings_path = settings_path;
+    item.m_name = p_settings->m_name;
+    item.m_editor_tags = p_settings->m_editor_tags;
+    item.m_rotation_x = p_settings->m_rotation_x;
+    item.m_rotation_y = p_settings->m_rotation_y;
+    item.m_rotation_z = p_settings->m_rotation_z;
+    item.m_massive_type = p_settings->m_massive_type;
+
+    delete p_settings;
+    return 1;
+}
+
+/* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
+
+cEditor_Catalogue* pEditor_Catalogue = NULL;
+
+/* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
+
+} // namespace TSC
@@ -0,0 +1,83 @@
+/***************************************************************************
+ * editor_catalogue.hpp - Catalogue of the image items for the editors
+ *
+ * Copyright © 2012-2020 The TSC Contributors
+ ***************************************************************************/
+/*
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef TSC_EDITOR_CATALOGUE_HPP
+#define TSC_EDITOR_CATALOGUE_HPP
+
+#include "../global_basic.hpp"
+#include "../global_game.hpp"
+
+namespace TSC {
+
+    // One .settings file based item that can be placed with the editors
+    struct cEditor_Catalogue_Item {
+        // absolute path to the .settings file
+        boost::filesystem::path m_settings_path;
+        // absolute path to the image shown in the editor menu
+        boost::filesystem::path m_pixmap_path;
+        std::string m_name;
+        std::string m_editor_tags;
+        int m_rotation_x, m_rotation_y, m_rotation_z;
+        MassiveType m_massive_type;
+    };
+
+    /* The list of all image items (static sprites with a .settings
+     * file), sorted by name. It is shared by the level and the world
+     * editor, which pick the items carrying their editor tag.
+     *
+     * Gathering it means parsing every .settings file below the pixmaps
+     * directory, so it is done on a background thread, spread over all
+     * CPU cores, and saved to a catalogue file in the image cache
+     * directory. Later starts of the same game version read that file
+     * instead. The CEGUI and texture work for the editor menus still
+     * happens on the main thread, see cEditor::Enable(). */
+    class cEditor_Catalogue {
+    public:
+        cEditor_Catalogue(void);
+        ~cEditor_Catalogue(void);
+
+        // Start loading the catalogue in the background if not yet done
+        void Prepare(void);
+        // Returns the items, waiting for the background loading if needed
+        const std::vector<cEditor_Catalogue_Item>& Get_Items(void);
+        /* Wait for the background loading if started
+         * Call before closing the settings index or removing the image cache.
+        */
+        void Wait(void);
+
+    private:
+        // Thread function: read the catalogue file or build and save it
+        void Load_Or_Build(void);
+        bool Load(const boost::filesystem::path& filename);
+        bool Save(const boost::filesystem::path& filename) const;
+        void Build(void);
+        // Parse the settings file into `p_item', returns 0 if it is no editor item (worker thread function)
+        static bool Build_Item(const boost::filesystem::path& settings_path, cImage_Settings_Parser* p_parser, cEditor_Catalogue_Item* p_item);
+
+        bool m_started;
+        boost::thread m_thread;
+        std::vector<cEditor_Catalogue_Item> m_items;
+    };
+
+    /* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
+
+// The editor item catalogue
+    extern cEditor_Catalogue* pEditor_Catalogue;
+
+    /* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
+
+} // namespace TSC
+
+#endif
@@ -0,0 +1,142 @@
+/***************************************************************************
+ * file_writer.cpp - writing files in a background thread
+ *
+ * Copyright © 2012-2020 The TSC Contributors
+ ***************************************************************************/
+/*
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "../../core/filesystem/file_writer.hpp"
+#include "../../core/filesystem/filesystem.hpp"
+#include "../../core/property_helper.hpp"
+#include "../../core/i18n.hpp"
+#include "../../core/global_basic.hpp"
+
+#include <boost/thread/lock_guard.hpp>
+
+using namespace std;
+
+namespace fs = boost::filesystem;
+
+namespace TSC {
+
+/* *** *** *** *** *** *** *** cFile_Writer *** *** *** *** *** *** *** *** *** *** */
+
+cFile_Writer::cFile_Writer(void)
+{
+    m_busy = 0;
+    m_quit = 0;
+}
+
+cFile_Writer::~cFile_Writer(void)
+{
+    {
+        boost::lock_guard<boost::mutex> lock(m_mutex);
+        m_quit = 1;
+    }
+
+    m_condition.notify_all();
+
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+}
+
+void cFile_Writer::Write(const fs::path& filename, std::string& data, const std::string& done_text /* = std::string() */, const std::string& failed_text /* = std::string() */)
+{
+    cJob* job = new cJob();
+    job->m_filename = filename;
+    job->m_data.swap(data);
+    job->m_done_text = done_text;
+    job->m_failed_text = failed_text;
+
+    if (job->m_failed_text.empty()) {
+        job->m_failed_text = _("Couldn't save ") + path_to_utf8(filename);
+    }
+
+    {
+        boost::lock_guard<boost::mutex> lock(m_mutex);
+        m_jobs.push_back(job);
+
+        // started with the first file
+        if (!m_thread.joinable()) {
+            m_thread = boost::thread(&cFile_Writer::Thread_Main, this);
+        }
+    }
+
+    m_condition.notify_all();
+}
+
+void cFile_Writer::Wait(void)
+{
+    boost::unique_lock<boost::mutex> lock(m_mutex);
+
+    while (!m_jobs.empty() || m_busy) {
+        m_condition.wait(lock);
+    }
+}
+
+bool cFile_Writer::Get_Message(std::string& text)
+{
+    boost::lock_guard<boost::mutex> lock(m_mutex);
+
+    if (m_messages.empty()) {
+        return 0;
+    }
+
+    text = m_messages.front();
+    m_messages.pop_front();
+    return 1;
+}
+
+void cFile_Writer::Thread_Main(void)
+{
+    boost::unique_lock<boost::mutex> lock(m_mutex);
+
+    while (1) {
+        while (m_jobs.empty() && !m_quit) {
+            m_condition.wait(lock);
+        }
+
+        if (m_jobs.empty()) {
+            break;
+        }
+
+        cJob* job = m_jobs.front();
+        m_jobs.pop_front();
+        m_busy = 1;
+
+        lock.unlock();
+        bool written = Write_File_Atomic(job->m_filename, job->m_data);
+
+        if (written) {
+            debug_print("Wrote file '%s'.\n", path_to_utf8(job->m_filename).c_str());
+        }
+
+        lock.lock();
+
+        if (!written) {
+            m_messages.push_back(job->m_failed_text);
+        }
+        else if (!job->m_done_text.empty()) {
+            m_messages.push_back(job->m_done_text);
+        }
+
+        delete job;
+        m_busy = 0;
+        m_condition.notify_all();
+    }
+}
+
+cFile_Writer* pFile_Writer = NULL;
+
+/* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
+
+} // namespace TSC
@@ -0,0 +1,89 @@
+/***************************************************************************
+ * file_writer.hpp - writing files in a background thread
+ *
+ * Copyright © 2012-2020 The TSC Contributors
+ ***************************************************************************/
+/*
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef TSC_FILE_WRITER_HPP
+#define TSC_FILE_WRITER_HPP
+
+#include "../../core/global_basic.hpp"
+
+#include <deque>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/condition_variable.hpp>
+
+namespace TSC {
+
+    /* *** *** *** *** *** *** *** cFile_Writer *** *** *** *** *** *** *** *** *** *** */
+
+    /* Writes files with Write_File_Atomic() in its own thread, so saving
+     * does not wait for the disk. The files are written in the order they
+     * were given. Anything reading a file that may still be written has
+     * to call Wait() first.
+     */
+    class cFile_Writer {
+    public:
+        cFile_Writer(void);
+        // Waits for the remaining files
+        ~cFile_Writer(void);
+
+        /* Write the data to the file in the background
+         * The data is taken over and `data' is left empty.
+         * done_text : message when the file is written, none if empty
+         * failed_text : message when writing failed, a default one if empty
+        */
+        void Write(const boost::filesystem::path& filename, std::string& data, const std::string& done_text = std::string(), const std::string& failed_text = std::string());
+
+        // Wait until all files are written
+        void Wait(void);
+
+        /* Get the message of a file which was written or failed since the last call
+         * Returns false if there is none.
+        */
+        bool Get_Message(std::string& text);
+
+    private:
+        struct cJob {
+            boost::filesystem::path m_filename;
+            std::string m_data;
+            std::string m_done_text;
+            std::string m_failed_text;
+        };
+
+        void Thread_Main(void);
+
+        boost::thread m_thread;
+        boost::mutex m_mutex;
+        // signals new jobs and finished ones
+        boost::condition_variable m_condition;
+
+        std::deque<cJob*> m_jobs;
+        // if a job is being written
+        bool m_busy;
+        // stop the thread when the jobs are done
+        bool m_quit;
+
+        // messages of finished jobs
+        std::deque<std::string> m_messages;
+    };
+
+    /* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
+
+// File Writer
+    extern cFile_Writer* pFile_Writer;
+
+    /* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
+
+} // namespace TSC
+
+#endif
@@ -18,6 +18,13 @@
 #include "../../core/game_core.hpp"
 #include "../../core/global_basic.hpp"
 
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#include <fcntl.h>
+#endif
+
 using namespace std;
 
 namespace fs = boost::filesystem;
@@ -148,6 +155,73 @@ boost::filesystem::path Get_Temp_Directory(void)
     return boost::filesystem::temp_directory_path();
 }
 
+bool Write_File_Atomic(const fs::path& filename, const std::string& data)
+{
+    // the same directory, a rename between file systems would copy
+    fs::path temp_filename = filename;
+    temp_filename += ".tmp";
+
+#ifdef _WIN32
+    FILE* file = _wfopen(temp_filename.c_str(), L"wb");
+#else
+    FILE* file = fopen(temp_filename.c_str(), "wb");
+#endif
+
+    if (!file) {
+        cerr << "Warning : Could not create " << path_to_utf8(temp_filename) << " for writing" << endl;
+        return 0;
+    }
+
+    bool written = fwrite(data.data(), 1, data.size(), file) == data.size() && fflush(file) == 0;
+
+    // the data must be on the disk before the rename is
+#ifdef _WIN32
+    written = written && _commit(_fileno(file)) == 0;
+#else
+    written = written && fsync(fileno(file)) == 0;
+#endif
+
+    written = fclose(file) == 0 && written;
+
+    if (!written) {
+        cerr << "Warning : Could not write " << path_to_utf8(temp_filename) << endl;
+
+        boost::system::error_code error;
+        fs::remove(temp_filename, error);
+        return 0;
+    }
+
+    boost::system::error_code error;
+    fs::rename(temp_filename, filename, error);
+
+    if (error) {
+        cerr << "Warning : Could not replace " << path_to_utf8(filename) << " : " << error.message() << endl;
+        fs::remove(temp_filename, error);
+        return 0;
+    }
+
+#ifndef _WIN32
+    // the rename is only on the disk when the directory is
+    fs::path directory = filename.parent_path();
+
+    if (directory.empty()) {
+        directory = ".";
+    }
+
+    int dir_fd = open(directory.c_str(), O_RDONLY);
+
+    if (dir_fd < 0 || fsync(dir_fd) != 0) {
+        cerr << "Warning : Could not flush the directory " << path_to_utf8(directory) << endl;
+    }
+
+    if (dir_fd >= 0) {
+        close(dir_fd);
+    }
+#endif
+
+    return 1;
+}
+
 /* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
 
 } // namespace TSC
@@ -57,6 +57,12 @@ namespace TSC {
 // Return the operating system temporary files directory
     boost::filesystem::path Get_Temp_Directory(void);
 
+    /* Write the data to a temporary file next to the given one, flush it to the disk
+     * and rename it to the given file. A crash leaves the old or the new file, never a partly written one.
+     * Returns false on failure.
+    */
+    bool Write_File_Atomic(const boost::filesystem::path& filename, const std::string& data);
+
     /* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
 
 } // namespace TSC
@@ -92,6 +92,10 @@ void cResource_Manager::Init_User_Directory(void)
     if (!Dir_Exists(Get_User_Imgcache_Directory())) {
         fs::create_directories(Get_User_Imgcache_Directory());
     }
+    // Create scripting bytecode cache directory
+    if (!Dir_Exists(Get_User_Scriptcache_Directory())) {
+        fs::create_directories(Get_User_Scriptcache_Directory());
+    }
     // Create config directory
     if (!Dir_Exists(m_paths.user_config_dir)) {
         fs::create_directories(m_paths.user_config_dir);
@@ -163,6 +167,11 @@ fs::path cResource_Manager::Get_User_Imgcache_Directory()
     return m_paths.user_cache_dir / utf8_to_path(USER_IMGCACHE_DIR);
 }
 
+fs::path cResource_Manager::Get_User_Scriptcache_Directory()
+{
+    return m_paths.user_cache_dir / utf8_to_path(USER_SCRIPTCACHE_DIR);
+}
+
 fs::path cResource_Manager::Get_User_Pixmaps_Directory()
 {
     std::string resolution = int_to_string(pPreferences->m_video_screen_w) + "x" + int_to_string(pPreferences->m_video_screen_h);
@@ -295,6 +304,11 @@ fs::path cResource_Manager::Get_Game_Scripting_Directory()
     return m_paths.game_data_dir / utf8_to_path(GAME_SCRIPTING_DIR);
 }
 
+fs::path cResource_Manager::Get_Game_Scripting_Bytecode_Directory()
+{
+    return m_paths.game_data_dir / utf8_to_path(GAME_SCRIPTING_BYTECODE_DIR);
+}
+
 fs::path cResource_Manager::Get_Game_Scripting(std::string script)
 {
     return Get_Game_Scripting_Directory() / utf8_to_path(script);
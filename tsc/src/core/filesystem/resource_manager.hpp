@@ -75,6 +75,7 @@ namespace TSC {
         boost::filesystem::path Get_Game_Music_Directory();
         boost::filesystem::path Get_Game_Editor_Directory();
         boost::filesystem::path Get_Game_Scripting_Directory();
+        boost::filesystem::path Get_Game_Scripting_Bytecode_Directory();
         boost::filesystem::path Get_Game_Icon_Directory();
 
         // CEGUI data paths
@@ -106,6 +107,7 @@ namespace TSC {
         boost::filesystem::path Get_User_World_Directory();
         boost::filesystem::path Get_User_Campaign_Directory();
         boost::filesystem::path Get_User_Imgcache_Directory();
+        boost::filesystem::path Get_User_Scriptcache_Directory();
         boost::filesystem::path Get_User_Pixmaps_Directory();
         boost::filesystem::path Get_User_CEGUI_Logfile();
         boost::filesystem::path Get_User_GameConsole_Logfile();
@@ -18,6 +18,8 @@
 #include "game_core.hpp"
 #include "../core/framerate.hpp"
 #include "../core/math/utilities.hpp"
+#include "../core/alloc_counter.hpp"
+#include "../user/preferences.hpp"
 
 namespace TSC {
 
@@ -36,8 +38,11 @@ cPerformance_Timer::~cPerformance_Timer(void)
 void cPerformance_Timer::Reset(void)
 {
     frame_counter = 0;
-    ms_counter = 0;
-    ms = 0;
+    us_counter = 0;
+    us = 0;
+    allocs = 0;
+    alloc_bytes = 0;
+    updated = 0;
 }
 
 void cPerformance_Timer::Update(void)
@@ -45,19 +50,81 @@ void cPerformance_Timer::Update(void)
     // count frame
     frame_counter++;
 
-    // add milliseconds
-    uint32_t new_ticks = TSC_GetTicks();
-    ms_counter += new_ticks - pFramerate->m_perf_last_ticks;
-    pFramerate->m_perf_last_ticks = new_ticks;
+    // add microseconds
+    const uint64_t new_us = TSC_GetMicroseconds();
+    us_counter += static_cast<uint32_t>(new_us - pFramerate->m_perf_last_us);
+    pFramerate->m_perf_last_us = new_us;
+
+    // allocations since the last section
+    const uint64_t alloc_count = Get_Alloc_Count();
+    const uint64_t alloc_total_bytes = Get_Alloc_Bytes();
+    allocs = static_cast<uint32_t>(alloc_count - pFramerate->m_perf_last_alloc_count);
+    alloc_bytes = alloc_total_bytes - pFramerate->m_perf_last_alloc_bytes;
+    pFramerate->m_perf_last_alloc_count = alloc_count;
+    pFramerate->m_perf_last_alloc_bytes = alloc_total_bytes;
+    updated = 1;
 
     // counted 100 frames
     if (frame_counter >= 100) {
-        ms = ms_counter;
+        us = us_counter;
         frame_counter = 0;
-        ms_counter = 0;
+        us_counter = 0;
+    }
+}
+
+/* *** *** *** *** *** *** cFrame_Time_Histogram *** *** *** *** *** *** *** *** *** *** *** */
+
+// microseconds per bucket
+static const uint32_t FRAME_TIME_BUCKET_US = 100;
+static const unsigned int FRAME_TIME_BUCKETS = 500;
+
+cFrame_Time_Histogram::cFrame_Time_Histogram(void)
+{
+    Reset();
+}
+
+void cFrame_Time_Histogram::Reset(void)
+{
+    m_count = 0;
+
+    for (unsigned int i = 0; i < FRAME_TIME_BUCKETS; i++) {
+        m_buckets[i] = 0;
     }
 }
 
+void cFrame_Time_Histogram::Add(const uint32_t us)
+{
+    unsigned int bucket = us / FRAME_TIME_BUCKET_US;
+
+    if (bucket >= FRAME_TIME_BUCKETS) {
+        bucket = FRAME_TIME_BUCKETS - 1;
+    }
+
+    m_buckets[bucket]++;
+    m_count++;
+}
+
+uint32_t cFrame_Time_Histogram::Get_Percentile(const float percentile) const
+{
+    if (!m_count) {
+        return 0;
+    }
+
+    // frames at or below the percentile
+    const uint32_t target = static_cast<uint32_t>(ceil(m_count * percentile));
+    uint32_t counted = 0;
+
+    for (unsigned int i = 0; i < FRAME_TIME_BUCKETS; i++) {
+        counted += m_buckets[i];
+
+        // upper bound of the bucket
+        if (counted >= target) {
+            return (i + 1) * FRAME_TIME_BUCKET_US;
+        }
+    }
+
+    return FRAME_TIME_BUCKETS * FRAME_TIME_BUCKET_US;
+}
 
 /* *** *** *** *** *** *** cFramerate *** *** *** *** *** *** *** *** *** *** *** */
 
@@ -73,12 +140,29 @@ cFramerate::cFramerate(void)
     m_last_ticks = 0;
     m_elapsed_ticks = 1;
     m_max_elapsed_ticks = 100;
+    m_last_us = 0;
+    m_elapsed_us = 1000;
+    m_elapsed_us_rest = 0;
     m_speed_factor = 0.1f;
     m_force_speed_factor = 0.0f;
-    m_perf_last_ticks = 0;
+    m_perf_last_us = 0;
+    m_perf_last_alloc_count = 0;
+    m_perf_last_alloc_bytes = 0;
+    m_frame_allocs = 0;
+    m_frame_alloc_bytes = 0;
+    m_frame_total_allocs = 0;
+    m_last_alloc_count = 0;
+    m_last_alloc_bytes = 0;
+    m_last_total_alloc_count = 0;
+    m_frame_time_p50 = 0;
+    m_frame_time_p95 = 0;
+    m_frame_time_p99 = 0;
+    m_missed_deadlines = 0;
+    m_missed_deadlines_last = 0;
+    m_missed_deadlines_total = 0;
 
     // create performance timers
-    for (unsigned int i = 0; i < 24; i++) {
+    for (unsigned int i = 0; i < 25; i++) {
         m_perf_timer.push_back(new cPerformance_Timer());
     }
 }
@@ -104,36 +188,46 @@ void cFramerate::Init(const float target_fps /* = speedfactor_fps */)
 
 void cFramerate::Update(void)
 {
-    const uint32_t current_ticks = TSC_GetTicks();
+    const uint64_t current_us = TSC_GetMicroseconds();
+    const uint32_t current_ticks = static_cast<uint32_t>(current_us / 1000);
+    // real frame time for the statistics
+    const uint32_t frame_us = static_cast<uint32_t>(current_us - m_last_us);
+
+    m_frame_times.Add(frame_us);
 
     // if speed factor is forced
     if (!Is_Float_Equal(m_force_speed_factor, 0.0f)) {
         m_speed_factor = m_force_speed_factor;
-        m_elapsed_ticks = static_cast<uint32_t>((m_force_speed_factor * 1000) / m_fps_target);
+        m_elapsed_us = static_cast<uint32_t>((m_force_speed_factor * 1000000) / m_fps_target);
 
         // change to minimum
-        if (m_elapsed_ticks == 0) {
-            m_elapsed_ticks = 1;
+        if (m_elapsed_us == 0) {
+            m_elapsed_us = 1;
         }
     }
     // measure speed factor
     else {
-        // set elapsed ticks
-        m_elapsed_ticks = current_ticks - m_last_ticks;
+        // set elapsed microseconds
+        m_elapsed_us = frame_us;
 
         // minimum
-        if (m_elapsed_ticks == 0) {
-            m_elapsed_ticks = 1;
+        if (m_elapsed_us == 0) {
+            m_elapsed_us = 1;
         }
         // maximum
-        else if (m_elapsed_ticks > m_max_elapsed_ticks) {
-            m_elapsed_ticks = m_max_elapsed_ticks;
+        else if (m_elapsed_us > m_max_elapsed_ticks * 1000) {
+            m_elapsed_us = m_max_elapsed_ticks * 1000;
         }
 
         // speed factor calculation for this frame
-        m_speed_factor = static_cast<float>(m_elapsed_ticks / (1000 / m_fps_target));
+        m_speed_factor = m_elapsed_us / (1000000 / m_fps_target);
     }
 
+    // whole milliseconds, the rest is added in the next frames
+    m_elapsed_us_rest += m_elapsed_us;
+    m_elapsed_ticks = m_elapsed_us_rest / 1000;
+    m_elapsed_us_rest -= m_elapsed_ticks * 1000;
+
     // speed factor based fps
     m_fps = m_fps_target / m_speed_factor;
 
@@ -143,6 +237,15 @@ void cFramerate::Update(void)
 
         m_fps_average_framedelay += 1000;
         m_frames_counted = 0;
+
+        // frame time statistics of the last second
+        m_frame_time_p50 = m_frame_times.Get_Percentile(0.50f);
+        m_frame_time_p95 = m_frame_times.Get_Percentile(0.95f);
+        m_frame_time_p99 = m_frame_times.Get_Percentile(0.99f);
+        m_frame_times.Reset();
+
+        m_missed_deadlines_last = m_missed_deadlines;
+        m_missed_deadlines = 0;
     }
     // count a fps
     else {
@@ -159,12 +262,38 @@ void cFramerate::Update(void)
     }
 
     m_last_ticks = current_ticks;
+    m_last_us = current_us;
+
+    // allocations in this frame
+    const uint64_t alloc_count = Get_Alloc_Count();
+    const uint64_t alloc_bytes = Get_Alloc_Bytes();
+    m_frame_allocs = static_cast<uint32_t>(alloc_count - m_last_alloc_count);
+    m_frame_alloc_bytes = alloc_bytes - m_last_alloc_bytes;
+    m_last_alloc_count = alloc_count;
+    m_last_alloc_bytes = alloc_bytes;
+
+    const uint64_t total_alloc_count = Get_Total_Alloc_Count();
+    m_frame_total_allocs = static_cast<uint32_t>(total_alloc_count - m_last_total_alloc_count);
+    m_last_total_alloc_count = total_alloc_count;
+
+    // sections not run in this frame did not allocate
+    for (Performance_Timer_List::iterator itr = m_perf_timer.begin(); itr != m_perf_timer.end(); ++itr) {
+        if (!(*itr)->updated) {
+            (*itr)->allocs = 0;
+            (*itr)->alloc_bytes = 0;
+        }
+
+        (*itr)->updated = 0;
+    }
 }
 
 void cFramerate::Reset(void)
 {
-    m_last_ticks = TSC_GetTicks();
+    m_last_us = TSC_GetMicroseconds();
+    m_last_ticks = static_cast<uint32_t>(m_last_us / 1000);
     m_elapsed_ticks = 1;
+    m_elapsed_us = 1000;
+    m_elapsed_us_rest = 0;
     m_speed_factor = 0.001f;
     m_fps_best = 0;
     m_fps_worst = 100000.0f;
@@ -172,12 +301,27 @@ void cFramerate::Reset(void)
     m_fps_average_framedelay = m_last_ticks;
     m_frames_counted = 0;
 
+    m_frame_times.Reset();
+    m_frame_time_p50 = 0;
+    m_frame_time_p95 = 0;
+    m_frame_time_p99 = 0;
+    m_missed_deadlines = 0;
+    m_missed_deadlines_last = 0;
+    m_missed_deadlines_total = 0;
+
     // reset performance timer
     for (Performance_Timer_List::iterator itr = m_perf_timer.begin(); itr != m_perf_timer.end(); ++itr) {
         (*itr)->Reset();
     }
 }
 
+void cFramerate::Start_Perf_Section(void)
+{
+    m_perf_last_us = TSC_GetMicroseconds();
+    m_perf_last_alloc_count = Get_Alloc_Count();
+    m_perf_last_alloc_bytes = Get_Alloc_Bytes();
+}
+
 void cFramerate::Set_Max_Elapsed_Ticks(const uint32_t ticks)
 {
     m_max_elapsed_ticks = ticks;
@@ -190,25 +334,126 @@ void cFramerate::Set_Fixed_Speedfacor(const float val)
 
 /* *** *** *** *** *** *** *** helper functions *** *** *** *** *** *** *** *** *** *** */
 
+/* sleeping may overshoot by the timer resolution of the system
+ * so the last microseconds before a deadline are spun
+*/
+static const uint64_t FRAME_PACING_SPIN_US = 2000;
+
 void Correct_Frame_Time(const unsigned int fps)
 {
-    while (!Is_Frame_Time(fps)) {
-        sf::sleep(sf::milliseconds(1));
+    // deadline of the next frame, advanced by the exact frame time to not drift
+    static uint64_t deadline = 0;
+
+    const uint64_t frame_us = 1000000 / fps;
+    const uint64_t now = TSC_GetMicroseconds();
+
+    // first frame
+    if (!deadline) {
+        deadline = now;
+        return;
+    }
+
+    deadline += frame_us;
+
+    // late
+    if (now >= deadline) {
+        // catch up within a frame, else start over from now
+        if (now - deadline > frame_us) {
+            deadline = now;
+        }
+
+        pFramerate->m_missed_deadlines++;
+        pFramerate->m_missed_deadlines_total++;
+        return;
+    }
+
+    if (pPreferences->m_video_fps_limit_spin) {
+        // sleep coarsely
+        if (deadline - now > FRAME_PACING_SPIN_US) {
+            sf::sleep(sf::microseconds(static_cast<sf::Int64>(deadline - now - FRAME_PACING_SPIN_US)));
+        }
+
+        // spin to the deadline
+        while (TSC_GetMicroseconds() < deadline) {
+            boost::this_thread::yield();
+        }
+    }
+    else {
+        sf::sleep(sf::microseconds(static_cast<sf::Int64>(deadline - now)));
     }
 }
 
 bool Is_Frame_Time(const unsigned int fps)
 {
-    static uint32_t static_time = 0;
+    static uint64_t static_time = 0;
+    const uint64_t now = TSC_GetMicroseconds();
 
-    if (TSC_GetTicks() - static_time < 1000 / fps) {
+    if (now - static_time < 1000000 / fps) {
         return 0;
     }
 
-    static_time = TSC_GetTicks();
+    static_time = now;
     return 1;
 }
 
+const char* Get_Performance_Timer_Name(const performance_timer_type type)
+{
+    switch (type) {
+    case PERF_UPDATE_PROCESS_INPUT:
+        return "input";
+    case PERF_UPDATE_LEVEL:
+        return "level";
+    case PERF_UPDATE_LEVEL_EDITOR:
+        return "level editor";
+    case PERF_UPDATE_HUD:
+        return "hud";
+    case PERF_UPDATE_PLAYER:
+        return "player";
+    case PERF_UPDATE_PLAYER_COLLISIONS:
+        return "player collisions";
+    case PERF_UPDATE_LATE_LEVEL:
+        return "level late";
+    case PERF_UPDATE_LEVEL_COLLISIONS:
+        return "level collisions";
+    case PERF_UPDATE_CAMERA:
+        return "camera";
+    case PERF_UPDATE_SCRIPTING_GC:
+        return "scripting gc";
+    case PERF_UPDATE_OVERWORLD:
+        return "overworld";
+    case PERF_UPDATE_MENU:
+        return "menu";
+    case PERF_UPDATE_LEVEL_SETTINGS:
+        return "level settings";
+    case PERF_DRAW_LEVEL_LAYER1:
+        return "draw layer 1";
+    case PERF_DRAW_LEVEL_PLAYER:
+        return "draw player";
+    case PERF_DRAW_LEVEL_LAYER2:
+        return "draw layer 2";
+    case PERF_DRAW_LEVEL_HUD:
+        return "draw hud";
+    case PERF_DRAW_LEVEL_EDITOR:
+        return "draw editor";
+    case PERF_DRAW_OVERWORLD:
+        return "draw overworld";
+    case PERF_DRAW_MENU:
+        return "draw menu";
+    case PERF_DRAW_LEVEL_SETTINGS:
+        return "draw level settings";
+    case PERF_DRAW_MOUSE:
+        return "draw mouse";
+    case PERF_RENDER_GAME:
+        return "render game";
+    case PERF_RENDER_GUI:
+        return "render gui";
+    case PERF_RENDER_BUFFER:
+        return "render buffer";
+    } // No default to let the compiler warn about missed values
+
+    return "unknown";
+}
+
 /* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
 
 cFramerate* pFramerate = NULL;
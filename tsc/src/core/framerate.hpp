@@ -23,7 +23,7 @@ namespace TSC {
 
     /* *** *** *** *** *** *** *** cPerformance_Timer *** *** *** *** *** *** *** *** *** *** */
 
-// counts milliseconds for 100 frames and sets them to ms
+// counts microseconds for 100 frames and sets them to us
     class cPerformance_Timer {
     public:
         cPerformance_Timer(void);
@@ -37,10 +37,41 @@ namespace TSC {
 
         // current frame counter
         uint32_t frame_counter;
-        // current milliseconds per frames counted
-        uint32_t ms_counter;
-        // milliseconds per 100 frames
-        uint32_t ms;
+        // current microseconds per frames counted
+        uint32_t us_counter;
+        // microseconds per 100 frames
+        uint32_t us;
+        // allocations and allocated bytes of the main thread in the last frame
+        uint32_t allocs;
+        uint64_t alloc_bytes;
+        // if updated in the current frame, otherwise the allocations are reset with the next frame
+        bool updated;
+    };
+
+    /* *** *** *** *** *** *** *** cFrame_Time_Histogram *** *** *** *** *** *** *** *** *** *** */
+
+    /* Counts frame times in buckets of 100 microseconds to get their
+     * percentiles without keeping every frame time. Frame times above
+     * 50 milliseconds are counted in the last bucket.
+    */
+    class cFrame_Time_Histogram {
+    public:
+        cFrame_Time_Histogram(void);
+
+        // remove all frame times
+        void Reset(void);
+        // count a frame time in microseconds
+        void Add(const uint32_t us);
+        /* Return the frame time in microseconds not exceeded by the given part of the frames
+         * percentile : 0.0 - 1.0
+        */
+        uint32_t Get_Percentile(const float percentile) const;
+
+        // number of counted frames
+        uint32_t m_count;
+
+    private:
+        uint32_t m_buckets[500];
     };
 
     /* *** *** *** *** *** *** *** cFramerate *** *** *** *** *** *** *** *** *** *** */
@@ -93,6 +124,13 @@ namespace TSC {
         // maximum elapsed ticks
         uint32_t m_max_elapsed_ticks;
 
+        // last update microseconds
+        uint64_t m_last_us;
+        // elapsed microseconds since last frame
+        uint32_t m_elapsed_us;
+        // elapsed microseconds not yet added to the elapsed ticks
+        uint32_t m_elapsed_us_rest;
+
         /* current factor
          * based on target fps
          */
@@ -101,21 +139,56 @@ namespace TSC {
         float m_force_speed_factor;
 
         // ## performance values ##
-        // ticks since last section
-        uint32_t m_perf_last_ticks;
+        // start a new performance timer section
+        void Start_Perf_Section(void);
+
+        // microseconds at the start of the section
+        uint64_t m_perf_last_us;
+        // allocation counter values at the start of the section
+        uint64_t m_perf_last_alloc_count;
+        uint64_t m_perf_last_alloc_bytes;
+
+        // allocations and allocated bytes of the main thread in the last frame
+        uint32_t m_frame_allocs;
+        uint64_t m_frame_alloc_bytes;
+        // allocations of all threads in the last frame
+        uint32_t m_frame_total_allocs;
+        // allocation counter values at the start of the frame
+        uint64_t m_last_alloc_count;
+        uint64_t m_last_alloc_bytes;
+        uint64_t m_last_total_alloc_count;
 
         typedef vector<cPerformance_Timer*> Performance_Timer_List;
         Performance_Timer_List m_perf_timer;
+
+        // ## frame pacing statistics ##
+        // frame times of the current second
+        cFrame_Time_Histogram m_frame_times;
+        // frame time percentiles of the last second in microseconds
+        uint32_t m_frame_time_p50;
+        uint32_t m_frame_time_p95;
+        uint32_t m_frame_time_p99;
+        // frames which missed their deadline in Correct_Frame_Time() in the current second
+        uint32_t m_missed_deadlines;
+        // missed deadlines in the last second
+        uint32_t m_missed_deadlines_last;
+        // missed deadlines since the last reset
+        uint32_t m_missed_deadlines_total;
     };
 
     /* *** *** *** *** *** *** *** helper functions *** *** *** *** *** *** *** *** *** *** */
 
     /* Fixed framerate method
      * if next frame is not ready wait until it is
+     * The deadlines are kept in microseconds, so the average framerate is exact.
+     * Sleeps until shortly before the deadline and spins the rest if the
+     * video_fps_limit_spin preference is set.
     */
     void Correct_Frame_Time(const unsigned int fps);
 // Return true if the next frame is ready for the given framerate
     bool Is_Frame_Time(const unsigned int fps);
+// Return the name of the given performance timer type
+    const char* Get_Performance_Timer_Name(const performance_timer_type type);
 
     /* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
 
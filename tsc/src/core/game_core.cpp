@@ -36,6 +36,8 @@
 #include "../gui/menu_data.hpp"
 #include "../user/savegame/savegame.hpp"
 #include "../overworld/world_editor.hpp"
+#include "../video/img_manager.hpp"
+#include "../user/preferences.hpp"
 #include "filesystem/resource_manager.hpp"
 #include "../core/global_basic.hpp"
 
@@ -96,6 +98,18 @@ uint32_t TSC_GetTicks()
     return static_cast<uint32_t>(result.count()); // heaven knows what type duration::count() actually returns... Let’s hope this works.
 }
 
+/**
+ * Returns the number of microseconds that have passed since TSC
+ * was started, from the same monotonic clock as TSC_GetTicks().
+ * Used for frame timing where whole milliseconds are too coarse.
+ */
+uint64_t TSC_GetMicroseconds()
+{
+    std::chrono::steady_clock::time_point time_now = std::chrono::steady_clock::now();
+    std::chrono::microseconds result = std::chrono::duration_cast<std::chrono::microseconds>(time_now - s_initial_time);
+    return static_cast<uint64_t>(result.count());
+}
+
 void Handle_Game_Events(void)
 {
     // if game action is set
@@ -480,6 +494,64 @@ void Preload_Images(bool draw_gui /* = 0 */)
     }
 }
 
+// Add the images of the sprites to the textures in use
+static void Add_Used_Textures(const cSprite_Manager* sprite_manager, std::unordered_set<cGL_Texture*>& in_use)
+{
+    for (cSprite_List::const_iterator itr = sprite_manager->objects.begin(); itr != sprite_manager->objects.end(); ++itr) {
+        const cSprite* obj = (*itr);
+
+        if (obj->m_image && obj->m_image->mp_texture) {
+            in_use.insert(obj->m_image->mp_texture.get());
+        }
+        if (obj->m_start_image && obj->m_start_image->mp_texture) {
+            in_use.insert(obj->m_start_image->mp_texture.get());
+        }
+
+        // all animation frames or they get reloaded while drawing
+        for (cImageSet::Surface_List::const_iterator img_itr = obj->m_images.begin(); img_itr != obj->m_images.end(); ++img_itr) {
+            const cGL_Surface* image = img_itr->m_image;
+
+            if (image && image->mp_texture) {
+                in_use.insert(image->mp_texture.get());
+            }
+        }
+    }
+}
+
+void Apply_Texture_Budget(void)
+{
+    static uint32_t last_check = 0;
+
+    uint32_t now = TSC_GetTicks();
+
+    if (now - last_check < 1000) {
+        return;
+    }
+
+    last_check = now;
+
+    if (!pPreferences->m_video_texture_budget) {
+        return;
+    }
+
+    size_t budget = static_cast<size_t>(pPreferences->m_video_texture_budget) * 1024 * 1024;
+
+    if (cGL_Texture::Get_Total_Bytes() <= budget) {
+        return;
+    }
+
+    std::unordered_set<cGL_Texture*> in_use;
+
+    if (pActive_Level) {
+        Add_Used_Textures(pActive_Level->m_sprite_manager, in_use);
+    }
+    if (pActive_Overworld) {
+        Add_Used_Textures(pActive_Overworld->m_sprite_manager, in_use);
+    }
+
+    pImage_Manager->Evict_Textures(budget, in_use);
+}
+
 void Preload_Sounds(bool draw_gui /* = 0 */)
 {
     // skip caching if disabled
@@ -638,6 +710,14 @@ void Replace_Property(xmlpp::Element* p_element, const Glib::ustring& name, cons
     Add_Property(p_element, name, value);
 }
 
+void Add_Property(cXml_Writer& writer, const std::string& name, const std::string& value)
+{
+    writer.Start_Element("property");
+    writer.Add_Attribute("name", name);
+    writer.Add_Attribute("value", value);
+    writer.End_Element();
+}
+
 /* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
 
 } // namespace TSC
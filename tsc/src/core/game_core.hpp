@@ -18,6 +18,7 @@
 #define TSC_GAME_CORE_HPP
 
 #include "../core/property_helper.hpp"
+#include "../core/xml_writer.hpp"
 #include "../objects/sprite.hpp"
 #include "../core/camera.hpp"
 
@@ -78,6 +79,8 @@ namespace TSC {
 
     /// Return the number of milliseconds since the start of TSC.
     uint32_t TSC_GetTicks();
+    /// Return the number of microseconds since the start of TSC.
+    uint64_t TSC_GetMicroseconds();
 
 // Handle game events
     void Handle_Game_Events(void);
@@ -105,6 +108,12 @@ namespace TSC {
      */
     void Preload_Sounds(bool draw_gui = 0);
 
+    /* Unload the least recently used textures if the texture memory is
+     * above the budget from the preferences. The images of the active
+     * level or world sprites are kept. Checks only once per second.
+     */
+    void Apply_Texture_Budget(void);
+
 /// Add a <property> node below the given XML node.
     void Add_Property(xmlpp::Element* p_element, const Glib::ustring& name, const Glib::ustring& value);
 
@@ -161,6 +170,38 @@ namespace TSC {
         Replace_Property(p_element, name, uint_to_string(value));
     }
 
+/// Add a <property> element to the current element of the writer.
+    void Add_Property(cXml_Writer& writer, const std::string& name, const std::string& value);
+
+    inline void Add_Property(cXml_Writer& writer, const std::string& name, const char* value)
+    {
+        Add_Property(writer, name, std::string(value));
+    }
+    inline void Add_Property(cXml_Writer& writer, const std::string& name, int value)
+    {
+        Add_Property(writer, name, int_to_string(value));
+    }
+    inline void Add_Property(cXml_Writer& writer, const std::string& name, uint64_t value)
+    {
+        Add_Property(writer, name, int64_to_string(value));
+    }
+    inline void Add_Property(cXml_Writer& writer, const std::string& name, long value)
+    {
+        Add_Property(writer, name, long_to_string(value));
+    }
+    inline void Add_Property(cXml_Writer& writer, const std::string& name, float value)
+    {
+        Add_Property(writer, name, float_to_string(value));
+    }
+    inline void Add_Property(cXml_Writer& writer, const std::string& name, bool value)
+    {
+        Add_Property(writer, name, bool_to_string(value));
+    }
+    inline void Add_Property(cXml_Writer& writer, const std::string& name, unsigned int value)
+    {
+        Add_Property(writer, name, uint_to_string(value));
+    }
+
     /* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
 
 } // namespace TSC
@@ -166,6 +166,7 @@ namespace TSC {
 #define GAME_SCHEMA_DIR "schema"
 #define GAME_TRANSLATION_DIR "translations"
 #define GAME_SCRIPTING_DIR "scripting"
+#define GAME_SCRIPTING_BYTECODE_DIR "scripting/bytecode"
 // GUI
 #define GUI_SCHEME_DIR "gui/schemes"
 #define GUI_IMAGESET_DIR "gui/imagesets"
@@ -180,6 +181,7 @@ namespace TSC {
 #define USER_WORLD_DIR "worlds"
 #define USER_CAMPAIGN_DIR "campaigns"
 #define USER_IMGCACHE_DIR "images"
+#define USER_SCRIPTCACHE_DIR "scripting"
 #define USER_SCRIPTING_DIR "scripting"
 
     /* *** *** *** *** *** *** *** forward declarations *** *** *** *** *** *** *** *** *** *** */
@@ -380,6 +382,7 @@ namespace TSC {
         PERF_UPDATE_LATE_LEVEL = 22,
         PERF_UPDATE_LEVEL_COLLISIONS = 5,
         PERF_UPDATE_CAMERA = 6,
+        PERF_UPDATE_SCRIPTING_GC = 24,
         // update overworld
         PERF_UPDATE_OVERWORLD = 17,
         // update menu
@@ -414,6 +417,7 @@ namespace TSC {
     class cGL_Surface;
     class cGradient_Request;
     class cImage_Settings_Data;
+    class cImage_Settings_Parser;
     class cLayer_Line_Point_Start;
     class cLevel;
     class cLine_collision;
@@ -429,6 +433,7 @@ namespace TSC {
     class cPath;
     class cPath_State;
     class cRect_Request;
+    class cRenderQueue;
     class cSave_Level_Object;
     class cSaved_Texture;
     class cSize_Float;
@@ -445,6 +450,22 @@ namespace TSC {
     class cLevelLoader;
     class XmlAttributes;
 
+    /* *** *** *** *** *** *** *** Sprite Handle *** *** *** *** *** *** *** *** *** *** */
+
+    /* Refers to a sprite in a cSprite_Manager without the risk of a
+     * dangling pointer. cSprite_Manager::Get_Sprite() returns NULL for
+     * it once the sprite was removed, even if its slot is used again.
+     */
+    struct cSprite_Handle {
+        cSprite_Handle(void)
+            : m_slot(-1), m_generation(0) {}
+
+        // slot of the sprite in the manager
+        int m_slot;
+        // generation of the slot when the handle was created
+        unsigned int m_generation;
+    };
+
     /* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
 
 } // namespace TSC
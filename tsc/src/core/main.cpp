@@ -19,6 +19,7 @@
 #include "../core/main.hpp"
 #include "../core/filesystem/resource_manager.hpp"
 #include "../core/filesystem/filesystem.hpp"
+#include "../core/filesystem/file_writer.hpp"
 #include "../level/level.hpp"
 #include "../scene/scene.hpp"
 #include "../gui/menu.hpp"
@@ -30,6 +31,7 @@
 #include "../level/level_settings.hpp"
 #include "../level/level_editor.hpp"
 #include "../overworld/world_editor.hpp"
+#include "../core/editor/editor_catalogue.hpp"
 #include "../input/joystick.hpp"
 #include "../overworld/world_manager.hpp"
 #include "../overworld/overworld.hpp"
@@ -41,10 +43,14 @@
 #include "../video/loading_screen.hpp"
 #include "../video/img_settings.hpp"
 #include "../video/img_manager.hpp"
+#include "../video/downscale.hpp"
+#include "../video/png_decoder.hpp"
 #include "../core/i18n.hpp"
 #include "../gui/generic.hpp"
 #include "../gui/game_console.hpp"
 #include "../gui/debug_window.hpp"
+#include "../scripting/interpreter_pool.hpp"
+#include "../scripting/events/event.hpp"
 
 using namespace std;
 
@@ -95,6 +101,9 @@ int main(int argc, char** argv)
 
     // convert arguments to a vector string
     vector<std::string> arguments(argv, argv + argc);
+    // frame capture interval, 0 if disabled
+    unsigned int capture_interval = 0;
+    bool capture_ppm = 0;
 
     if (argc >= 2) {
         for (unsigned int i = 1; i < arguments.size(); i++) {
@@ -107,6 +116,9 @@ int main(int argc, char** argv)
                 cout << "-d, --debug\tEnable debug modes with the options : game performance" << endl;
                 cout << "-l, --level\tLoad the given level" << endl;
                 cout << "-w, --world\tLoad the given world" << endl;
+                cout << "-c, --capture\tSave every Nth frame as PNG, or as PPM with N:ppm" << endl;
+                cout << "--benchmark-downscale\tMeasure the image downscaling speed on the game pixmaps" << endl;
+                cout << "--benchmark-image-load\tMeasure the image loading time and memory on the game pixmaps" << endl;
                 return EXIT_SUCCESS;
             }
             // version
@@ -156,6 +168,36 @@ int main(int argc, char** argv)
             else if (arguments[1] == "--world" || arguments[1] == "-w") {
                 // skip
             }
+            // frame capture is started after initialization
+            else if (arguments[i] == "--capture" || arguments[i] == "-c") {
+                if (i + 1 >= arguments.size() || string_to_int(arguments[i + 1]) <= 0) {
+                    cerr << arguments[i] << " requires a positive frame interval" << endl;
+                    return EXIT_FAILURE;
+                }
+
+                i++;
+                std::string::size_type pos = arguments[i].find(':');
+                capture_interval = string_to_int(arguments[i].substr(0, pos));
+                capture_ppm = pos != std::string::npos && arguments[i].substr(pos + 1) == "ppm";
+            }
+            // benchmark the downscaling kernels and exit
+            else if (arguments[i] == "--benchmark-downscale") {
+                pResource_Manager = new cResource_Manager();
+                cout << "Using " << Get_Downscale_Kernel_Name() << " kernels" << endl;
+                Benchmark_Downscale(pResource_Manager->Get_Game_Pixmaps_Directory());
+                delete pResource_Manager;
+                pResource_Manager = NULL;
+                return EXIT_SUCCESS;
+            }
+            // benchmark the image decoding and exit
+            else if (arguments[i] == "--benchmark-image-load") {
+                pResource_Manager = new cResource_Manager();
+                Benchmark_Image_Load(pResource_Manager->Get_Game_Pixmaps_Directory());
+                cPixel_Buffer::Clear_Pool();
+                delete pResource_Manager;
+                pResource_Manager = NULL;
+                return EXIT_SUCCESS;
+            }
             // unknown argument
             else if (arguments[i].substr(0, 1) == "-") {
                 cerr << "Unknown argument " << arguments[i] << endl << "Use -h to list all possible arguments" << endl;
@@ -171,6 +213,10 @@ int main(int argc, char** argv)
         // initialize everything
         Init_Game();
 
+        if (capture_interval) {
+            pVideo->m_screen_capture.Start_Capture(capture_interval, capture_ppm);
+        }
+
         // command line level entering
         if (argc > 2 && (arguments[1] == "--level" || arguments[1] == "-l") && !arguments[2].empty()) {
             Game_Action = GA_ENTER_LEVEL;
@@ -203,12 +249,8 @@ int main(int argc, char** argv)
                 // draw
                 Draw_Game();
 
-                // render
-#ifdef TSC_RENDER_THREAD_TEST
+                // render, the render thread displays it while the next frame is updated
                 pVideo->Render(1);
-#else
-                pVideo->Render();
-#endif
 
                 // update speedfactor
                 pFramerate->Update();
@@ -258,6 +300,7 @@ void Init_Game(void)
     pImage_Manager = new cImage_Manager();
     pSound_Manager = new cSound_Manager();
     pSettingsParser = new cImage_Settings_Parser();
+    pFile_Writer = new cFile_Writer();
 
     // Init Stage 2 - set preferences and init audio and the video screen
 
@@ -309,6 +352,8 @@ void Init_Game(void)
 
     gp_game_console = new cGame_Console();
 
+    pEditor_Catalogue = new cEditor_Catalogue();
+
     pLevel_Editor = new cEditor_Level();
     pLevel_Editor->Init();
 
@@ -329,12 +374,20 @@ void Init_Game(void)
     pMenuCore = new cMenuCore();
     pSavegame = new cSavegame();
 
+    // Needs the objects exposed to mruby to exist. Start warming
+    // an interpreter for the first level while preloading.
+    pMRuby_Pool = new Scripting::cMRuby_Interpreter_Pool();
+    pMRuby_Pool->Refill();
+
     // cache
     debug_print("Preloading images and sounds...\n");
     Preload_Images(1);
     Preload_Sounds(1);
     debug_print("Done preloading images and sounds.\n");
     Loading_Screen_Exit();
+
+    // The main menu comes next, gather the editor items meanwhile
+    pEditor_Catalogue->Prepare();
 }
 
 // Note: This function must not throw exceptions! It is called in main()'s
@@ -348,6 +401,17 @@ void Exit_Game(void)
     pLevel_Manager->Unload();
     pMenuCore->m_handler->m_level->Unload();
 
+    // waits for the files still being saved
+    if (pFile_Writer) {
+        delete pFile_Writer;
+        pFile_Writer = NULL;
+    }
+
+    if (pMRuby_Pool) {
+        delete pMRuby_Pool;
+        pMRuby_Pool = NULL;
+    }
+
     if (pAudio) {
         delete pAudio;
         pAudio = NULL;
@@ -378,6 +442,11 @@ void Exit_Game(void)
         pWorld_Editor = NULL;
     }
 
+    if (pEditor_Catalogue) {
+        delete pEditor_Catalogue;
+        pEditor_Catalogue = NULL;
+    }
+
     if (gp_debug_window) {
         delete gp_debug_window;
         gp_debug_window = NULL;
@@ -458,6 +527,9 @@ void Exit_Game(void)
         pImage_Manager = NULL;
     }
 
+    cGL_Texture::Report_Leaks();
+    cPixel_Buffer::Clear_Pool();
+
     if (pSettingsParser) {
         delete pSettingsParser;
         pSettingsParser = NULL;
@@ -587,9 +659,22 @@ void Update_Game(void)
         pVideo->Render_Finish();
     }
 
+    // ## scripting event statistics
+    Scripting::cEvent::Next_Frame();
+
+    // ## texture memory budget
+    Apply_Texture_Budget();
+
     // ## game events
     Handle_Game_Events();
 
+    // ## files saved in the background
+    std::string file_message;
+
+    while (pFile_Writer->Get_Message(file_message)) {
+        gp_hud->Set_Text(file_message);
+    }
+
     // ## input
     // Actually `input_event' is a global variable that is also queried elsewhere
     // in the code (uaaah, poor design).
@@ -605,7 +690,7 @@ void Update_Game(void)
     pAudio->Update();
 
     // performance measuring
-    pFramerate->m_perf_last_ticks = TSC_GetTicks();
+    pFramerate->Start_Perf_Section();
 
     // ## hud
     gp_hud->Update();
@@ -645,7 +730,7 @@ void Draw_Game(void)
     }
 
     // performance measuring
-    pFramerate->m_perf_last_ticks = TSC_GetTicks();
+    pFramerate->Start_Perf_Section();
 
     if (Game_Mode == MODE_LEVEL) {
         pLevel_Manager->Draw();
@@ -37,13 +37,17 @@ namespace TSC {
         // Delete the object from given array number
         virtual bool Delete(size_t array_num, bool delete_data = 1)
         {
-            // if in vector
-            if (array_num < objects.size()) {
-                objects.erase(objects.begin() + array_num);
+            // not in vector
+            if (array_num >= objects.size()) {
+                return 0;
             }
 
+            // the element is gone after erasing
+            T* obj = objects[array_num];
+            objects.erase(objects.begin() + array_num);
+
             if (delete_data) {
-                delete objects[array_num];
+                delete obj;
             }
 
             return 1;
@@ -124,9 +128,8 @@ namespace TSC {
                 return 0;
             }
 
-            // todo: does that work ?
-            itr1 = obj2;
-            itr2 = obj1;
+            *itr1 = obj2;
+            *itr2 = obj1;
 
             return 1;
         }
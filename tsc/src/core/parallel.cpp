@@ -0,0 +1,71 @@
+/***************************************************************************
+ * parallel.cpp - running work on several threads
+ *
+ * Copyright © 2012-2020 The TSC Contributors
+ ***************************************************************************/
+/*
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "../core/parallel.hpp"
+#include "../core/global_basic.hpp"
+
+namespace TSC {
+
+/* *** *** *** *** *** *** *** Parallel *** *** *** *** *** *** *** *** *** *** */
+
+unsigned int Get_Worker_Thread_Count(void)
+{
+    unsigned int thread_count = boost::thread::hardware_concurrency();
+
+    if (thread_count < 1) {
+        thread_count = 1;
+    }
+    else if (thread_count > 8) {
+        thread_count = 8;
+    }
+
+    return thread_count;
+}
+
+void Parallel_For_Batches(size_t count, size_t batch_size, unsigned int thread_count,
+                          const std::function<void(size_t i, unsigned int thread)>& work,
+                          const std::function<void(size_t start, size_t end)>& batch_done /* = nullptr */)
+{
+    if (thread_count < 1) {
+        thread_count = 1;
+    }
+    if (batch_size < 1) {
+        batch_size = count;
+    }
+
+    for (size_t batch = 0; batch < count; batch += batch_size) {
+        size_t batch_end = std::min(batch + batch_size, count);
+        boost::thread_group threads;
+
+        // every thread takes every thread_count'th item of the batch
+        for (unsigned int t = 0; t < thread_count && batch + t < batch_end; t++) {
+            threads.create_thread([&work, batch, batch_end, t, thread_count]() {
+                for (size_t i = batch + t; i < batch_end; i += thread_count) {
+                    work(i, t);
+                }
+            });
+        }
+
+        threads.join_all();
+
+        if (batch_done) {
+            batch_done(batch, batch_end);
+        }
+    }
+}
+
+/* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
+
+} // namespace TSC
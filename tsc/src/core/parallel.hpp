@@ -0,0 +1,44 @@
+/***************************************************************************
+ * parallel.hpp - running work on several threads
+ *
+ * Copyright © 2012-2020 The TSC Contributors
+ ***************************************************************************/
+/*
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef TSC_PARALLEL_HPP
+#define TSC_PARALLEL_HPP
+
+#include "../core/global_basic.hpp"
+#include <functional>
+
+namespace TSC {
+
+    /* *** *** *** *** *** *** *** Parallel *** *** *** *** *** *** *** *** *** *** */
+
+    // Number of threads for loading work, one per core but 1 - 8
+    unsigned int Get_Worker_Thread_Count(void);
+
+    /* Call work(i, thread) for every i from 0 to count - 1 on thread_count threads
+     * The items are split into batches of batch_size and a batch is finished
+     * before the next one starts. thread is the 0 based number of the thread,
+     * to give each thread its own non thread-safe objects.
+     * batch_done : if set called on the calling thread after each batch
+     *              with the first and the end item of the batch
+    */
+    void Parallel_For_Batches(size_t count, size_t batch_size, unsigned int thread_count,
+                              const std::function<void(size_t i, unsigned int thread)>& work,
+                              const std::function<void(size_t start, size_t end)>& batch_done = nullptr);
+
+    /* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
+
+} // namespace TSC
+
+#endif
@@ -20,6 +20,7 @@
 #include "../input/mouse.hpp"
 #include "../overworld/world_player.hpp"
 #include "../enemies/enemy.hpp"
+#include "../scripting/objects/mrb_uids.hpp"
 #include "../core/global_basic.hpp"
 
 using namespace std;
@@ -34,6 +35,12 @@ cSprite_Manager::cSprite_Manager(unsigned int reserve_items /* = 2000 */, unsign
     objects.reserve(reserve_items);
 
     m_max_uid_mark = 1; // UID 0 is reserved for the player
+    m_first_order = 0;
+    m_last_order = 0;
+    m_compact_removed = 0;
+    m_compact_order = 0;
+    mp_mruby = NULL;
+    m_update_us = 0;
     m_z_pos_data.assign(zpos_items, 0.0f);
     m_z_pos_data_editor.assign(zpos_items,0.0f);
 }
@@ -68,37 +75,138 @@ void cSprite_Manager::Add(cSprite* sprite)
             Allocate_UIDs(sprite->m_uid + 1);
         }
 
-//#ifdef _DEBUG
-//        // This slows down performance, so only check this in debug mode
-//        if (Is_UID_In_Use(sprite->m_uid))
-//            std::cerr << "Warning : UID collision : UID " << sprite->m_uid << " is already in use." << std::endl;
-//#endif
-
         // Mark the sprite’s UID as taken
         m_uid_pool.erase(sprite->m_uid);
     }
 
-    // Check if an destroyed object can be replaced
-    for (cSprite_List::iterator itr = objects.begin(); itr != objects.end(); ++itr) {
-        // get object pointer
-        cSprite* obj = (*itr);
+    cObject_Manager<cSprite>::Add(sprite);
+    Insert_Slot(sprite);
+}
 
-        // if destroy is set
-        if (obj->m_auto_destroy) {
-            // set new object
-            *itr = sprite;
+bool cSprite_Manager::Delete(size_t array_num, bool delete_data /* = 1 */)
+{
+    if (array_num >= objects.size()) {
+        return 0;
+    }
 
-            // Release old sprite’s UID by putting it back into the UID pool
-            m_uid_pool.insert(obj->m_uid);
+    return Delete(objects[array_num], delete_data);
+}
 
-            // delete old
-            delete obj;
+bool cSprite_Manager::Delete(cSprite* sprite, bool delete_data /* = 1 */)
+{
+    // empty object
+    if (!sprite) {
+        return 0;
+    }
 
-            return;
+    // not in this manager
+    if (!Is_Managed(sprite)) {
+        if (delete_data) {
+            delete sprite;
         }
+
+        return 1;
     }
 
-    cObject_Manager<cSprite>::Add(sprite);
+    // kept by the caller or can not be deleted, e.g. the player
+    if (!delete_data || sprite->m_disallow_managed_delete) {
+        int slot_num = sprite->m_manager_slot;
+
+        objects.erase(std::find(objects.begin(), objects.end(), sprite));
+        sprite->m_manager_slot = -1;
+        Free_Slot(slot_num, sprite->m_uid);
+        return 1;
+    }
+
+    cSprite_Slot& slot = m_slots[sprite->m_manager_slot];
+
+    // already removed
+    if (slot.m_removed) {
+        return 1;
+    }
+
+    slot.m_removed = 1;
+    m_compact_removed = 1;
+
+    // handles still resolve until Compact() so it must stay valid
+    sprite->m_auto_destroy = 1;
+    sprite->m_active = 0;
+    sprite->m_valid_draw = 0;
+    sprite->m_valid_update = 0;
+
+    return 1;
+}
+
+void cSprite_Manager::Destroyed(cSprite* sprite)
+{
+    // not in this manager
+    if (!Is_Managed(sprite)) {
+        return;
+    }
+
+    /* Destroyed level objects stay for the savegame which saves their
+     * state, spawned ones and those deleted in the editor are not needed.
+    */
+    if (!sprite->m_spawned && !editor_enabled) {
+        return;
+    }
+
+    Delete(sprite);
+}
+
+void cSprite_Manager::Compact(void)
+{
+    // nothing to do, this is the usual case
+    if (!m_compact_removed && !m_compact_order) {
+        return;
+    }
+
+    cSprite_List removed_objects;
+
+    if (m_compact_removed) {
+        cSprite_List::iterator out = objects.begin();
+
+        for (cSprite_List::iterator itr = objects.begin(); itr != objects.end(); ++itr) {
+            cSprite* obj = (*itr);
+
+            if (m_slots[obj->m_manager_slot].m_removed) {
+                removed_objects.push_back(obj);
+            }
+            else {
+                *out = obj;
+                ++out;
+            }
+        }
+
+        objects.erase(out, objects.end());
+        m_compact_removed = 0;
+    }
+
+    /* Deleted one at a time with the slot freed afterwards, so a
+     * destructor can still resolve handles of the sprites not yet deleted
+     * e.g. a path state unlinking itself from its path.
+    */
+    for (cSprite_List::iterator itr = removed_objects.begin(); itr != removed_objects.end(); ++itr) {
+        cSprite* obj = (*itr);
+        int slot_num = obj->m_manager_slot;
+        int uid = obj->m_uid;
+
+        delete obj;
+        Free_Slot(slot_num, uid);
+    }
+
+    if (m_compact_order) {
+        std::stable_sort(objects.begin(), objects.end(), slot_order_sort(m_slots));
+        m_compact_order = 0;
+    }
+
+    // renumber so the orders can not overflow
+    for (size_t i = 0; i < objects.size(); i++) {
+        m_slots[objects[i]->m_manager_slot].m_order = static_cast<int>(i);
+    }
+
+    m_first_order = 0;
+    m_last_order = objects.empty() ? 0 : static_cast<int>(objects.size()) - 1;
 }
 
 cSprite* cSprite_Manager::Copy(unsigned int identifier)
@@ -163,25 +271,21 @@ void cSprite_Manager::Move_To_Front(cSprite* sprite)
         return;
     }
 
-    cSprite* first = objects.front();
-
-    // if already in front
-    if (sprite == first) {
+    // not available
+    if (!Is_Managed(sprite)) {
+        // fixme : should not happen but it does
         return;
     }
 
-    // get iterator
-    cSprite_List::iterator itr = std::find(objects.begin(), objects.end(), sprite);
+    cSprite_Slot& slot = m_slots[sprite->m_manager_slot];
 
-    // not available
-    if (itr == objects.end()) {
-        // fixme : should not happen but it does
+    // if already in front
+    if (slot.m_order == m_first_order) {
         return;
     }
 
-    objects.erase(itr);
-    objects.front() = sprite;
-    objects.insert(objects.begin() + 1, first);
+    slot.m_order = --m_first_order;
+    m_compact_order = 1;
 
     // make it the first z position
     sprite->m_pos_z = Get_First(sprite->m_type)->m_pos_z - cSprite::m_pos_z_delta;
@@ -194,25 +298,21 @@ void cSprite_Manager::Move_To_Back(cSprite* sprite)
         return;
     }
 
-    cSprite* last = objects.back();
-
-    // if already in back
-    if (sprite == last) {
+    // not available
+    if (!Is_Managed(sprite)) {
+        // fixme : should not happen but it does
         return;
     }
 
-    // get iterator
-    cSprite_List::iterator itr = std::find(objects.begin(), objects.end(), sprite);
+    cSprite_Slot& slot = m_slots[sprite->m_manager_slot];
 
-    // not available
-    if (itr == objects.end()) {
-        // fixme : should not happen but it does
+    // if already in back
+    if (slot.m_order == m_last_order) {
         return;
     }
 
-    objects.erase(itr);
-    objects.back() = sprite;
-    objects.insert(objects.end() - 1, last);
+    slot.m_order = ++m_last_order;
+    m_compact_order = 1;
 
     // make it the last z position
     Ensure_Different_Z(sprite);
@@ -223,33 +323,40 @@ void cSprite_Manager::Delete_All(bool delayed /* = 0 */)
     // delayed
     if (delayed) {
         for (cSprite_List::iterator itr = objects.begin(); itr != objects.end(); ++itr) {
-            // get object pointer
-            cSprite* obj = (*itr);
-
-            obj->Destroy(); // Marks for autodestroy in cSprite_Manager::Add()
+            // if this can not be auto-deleted
+            if (!(*itr)->m_disallow_managed_delete) {
+                Delete(*itr);
+            }
         }
     }
     // instant
     else {
-        // remove objects that can not be auto-deleted
-        for (cSprite_List::iterator itr = objects.begin(); itr != objects.end();) {
-            // get object pointer
+        cSprite_List old_objects;
+        old_objects.swap(objects);
+
+        // see Compact() for the order
+        for (cSprite_List::iterator itr = old_objects.begin(); itr != old_objects.end(); ++itr) {
             cSprite* obj = (*itr);
+            int slot_num = obj->m_manager_slot;
+            int uid = obj->m_uid;
 
+            // remove objects that can not be auto-deleted
             if (obj->m_disallow_managed_delete) {
-                itr = objects.erase(itr);
+                obj->m_manager_slot = -1;
             }
-            // increment
             else {
-                ++itr;
+                delete obj;
             }
+
+            Free_Slot(slot_num, uid);
         }
 
-        cObject_Manager<cSprite>::Delete_All();
-    }
+        m_compact_removed = 0;
+        m_compact_order = 0;
 
-    // Empty the UID pool, we have no sprites anymore
-    m_uid_pool.clear();
+        // Empty the UID pool, we have no sprites anymore
+        m_uid_pool.clear();
+    }
 
     // clear z position data
     std::fill(m_z_pos_data.begin(), m_z_pos_data.end(), 0.0f);
@@ -321,11 +428,51 @@ cSprite* cSprite_Manager::Get_from_Position(int start_pos_x, int start_pos_y, co
 
 cSprite* cSprite_Manager::Get_by_UID(int uid) const
 {
-    for (cSprite_List::const_iterator itr = objects.begin(); itr != objects.end(); ++itr) {
-        if ((*itr)->m_uid == uid)
-            return *itr;
+    if (uid < 0 || static_cast<size_t>(uid) >= m_uid_slots.size() || m_uid_slots[uid] < 0) {
+        return NULL;
     }
-    return NULL;
+
+    return m_slots[m_uid_slots[uid]].mp_sprite;
+}
+
+bool cSprite_Manager::Is_Managed(const cSprite* sprite) const
+{
+    if (!sprite || sprite->m_manager_slot < 0 || static_cast<size_t>(sprite->m_manager_slot) >= m_slots.size()) {
+        return 0;
+    }
+
+    // the slot number may be from another manager
+    return m_slots[sprite->m_manager_slot].mp_sprite == sprite;
+}
+
+cSprite_Handle cSprite_Manager::Get_Handle(const cSprite* sprite) const
+{
+    cSprite_Handle handle;
+
+    // not in this manager
+    if (!Is_Managed(sprite)) {
+        return handle;
+    }
+
+    handle.m_slot = sprite->m_manager_slot;
+    handle.m_generation = m_slots[sprite->m_manager_slot].m_generation;
+    return handle;
+}
+
+cSprite* cSprite_Manager::Get_Sprite(const cSprite_Handle& handle) const
+{
+    if (handle.m_slot < 0 || static_cast<size_t>(handle.m_slot) >= m_slots.size()) {
+        return NULL;
+    }
+
+    const cSprite_Slot& slot = m_slots[handle.m_slot];
+
+    // removed and maybe used again since
+    if (slot.m_generation != handle.m_generation) {
+        return NULL;
+    }
+
+    return slot.mp_sprite;
 }
 
 void cSprite_Manager::Get_Objects_sorted(cSprite_List& new_objects, bool editor_sort /* = 0 */, bool with_player /* = 0 */) const
@@ -487,6 +634,79 @@ void cSprite_Manager::Allocate_UIDs(long new_max_uid_mark)
     m_max_uid_mark = static_cast<int>(new_max_uid_mark);
 }
 
+/* The slots hold the sprites independent of their array position, so
+ * handles and the UID table do not change when the array does. Freed
+ * slots are used again by Add() and have their generation incremented,
+ * so a cSprite_Handle with an older generation does not resolve to the
+ * new sprite. Removal only marks the slot and Compact() takes out all
+ * marked sprites in one pass, so nothing is erased from the middle of
+ * the array while it is iterated.
+ */
+void cSprite_Manager::Insert_Slot(cSprite* sprite)
+{
+    int slot_num;
+
+    if (m_free_slots.empty()) {
+        cSprite_Slot new_slot;
+        new_slot.m_generation = 0;
+        m_slots.push_back(new_slot);
+        slot_num = static_cast<int>(m_slots.size()) - 1;
+    }
+    else {
+        slot_num = m_free_slots.back();
+        m_free_slots.pop_back();
+    }
+
+    cSprite_Slot& slot = m_slots[slot_num];
+    slot.mp_sprite = sprite;
+    slot.m_order = ++m_last_order;
+    slot.m_removed = 0;
+    sprite->m_manager_slot = slot_num;
+
+    if (sprite->m_uid < 0) {
+        return;
+    }
+
+    if (static_cast<size_t>(sprite->m_uid) >= m_uid_slots.size()) {
+        m_uid_slots.resize(sprite->m_uid + 1, -1);
+    }
+
+    // the first one keeps the UID
+    if (m_uid_slots[sprite->m_uid] >= 0) {
+        cerr << "Warning : UID collision : UID " << sprite->m_uid << " is already in use." << endl;
+        return;
+    }
+
+    m_uid_slots[sprite->m_uid] = slot_num;
+}
+
+void cSprite_Manager::Free_Slot(int slot_num, int uid)
+{
+    cSprite_Slot& slot = m_slots[slot_num];
+
+    slot.mp_sprite = NULL;
+    slot.m_generation++;
+    slot.m_removed = 0;
+    m_free_slots.push_back(slot_num);
+
+    // a colliding UID
+    if (uid < 0 || static_cast<size_t>(uid) >= m_uid_slots.size() || m_uid_slots[uid] != slot_num) {
+        return;
+    }
+
+    m_uid_slots[uid] = -1;
+
+    // Release the UID by putting it back into the UID pool
+    if (uid > 0) {
+        m_uid_pool.insert(uid);
+    }
+
+    // scripts may still reference it
+    if (mp_mruby) {
+        Scripting::Delete_UID_From_Cache(mp_mruby->Get_MRuby_State(), uid);
+    }
+}
+
 bool cSprite_Manager::Is_UID_In_Use(int uid)
 {
     // The "invalid UID" always is in use
@@ -21,6 +21,8 @@
 #include "../core/obj_manager.hpp"
 #include "../objects/movingsprite.hpp"
 
+#include <chrono>
+
 namespace TSC {
 
     /* *** *** *** *** *** cSprite_Manager *** *** *** *** *** *** *** *** *** *** *** *** */
@@ -36,22 +38,37 @@ namespace TSC {
          */
         virtual void Add(cSprite* sprite);
 
+        /* Remove the sprite
+         * If delete_data is set it stays in the array until the next
+         * Compact() which deletes it, otherwise it is removed at once.
+         * Its handles get invalid when it is removed from the array.
+        */
+        virtual bool Delete(size_t array_num, bool delete_data = 1);
+        virtual bool Delete(cSprite* sprite, bool delete_data = 1);
+        // Called by cSprite::Destroy()
+        virtual void Destroyed(cSprite* sprite);
+        /* Remove and delete the sprites marked by Delete() and apply
+         * Move_To_Front() and Move_To_Back() to the array.
+         * Call this outside of any iteration over the array.
+        */
+        void Compact(void);
+
         // Return a sprite copy
         cSprite* Copy(unsigned int identifier);
 
-        /* Move the sprite to the front of the array
+        /* Move the sprite to the front of the array with the next Compact()
          * the sprite is then behind other sprites on the screen
          * this also sets the z position
         */
         void Move_To_Front(cSprite* sprite);
-        /* Move the sprite to the back of the array
+        /* Move the sprite to the back of the array with the next Compact()
          * the sprite is then in front of other sprites on the screen
          * this also sets the z position
         */
         void Move_To_Back(cSprite* sprite);
 
         /* Delete all objects
-         * if delayed is set deletion will only occur if replaced
+         * if delayed is set deletion will only occur with the next Compact()
          */
         virtual void Delete_All(bool delayed = 0);
 
@@ -68,6 +85,24 @@ namespace TSC {
          * if no object has this UID.
          */
         cSprite* Get_by_UID(int uid) const;
+        // Return true if the sprite is in this manager
+        bool Is_Managed(const cSprite* sprite) const;
+        /* Return a handle for the given sprite
+         * The handle is invalid if the sprite is not in this manager.
+        */
+        cSprite_Handle Get_Handle(const cSprite* sprite) const;
+        /* Return the sprite of the handle
+         * Returns NULL if it was removed from the array since the handle was created.
+        */
+        cSprite* Get_Sprite(const cSprite_Handle& handle) const;
+
+        /* Set the interpreter of the level
+         * Removed sprites are deleted from its UIDS cache.
+        */
+        void Set_MRuby(Scripting::cMRuby_Interpreter* p_mruby)
+        {
+            mp_mruby = p_mruby;
+        }
 
         /* Get a sorted Objects Array
          * editor_sort : if set sorts from editor z pos
@@ -91,9 +126,13 @@ namespace TSC {
         // Update items
         inline void Update_Items(void)
         {
+            std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
             for (cSprite_List::iterator itr = objects.begin(); itr != objects.end(); ++itr) {
                 (*itr)->Update();
             }
+
+            m_update_us = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
         }
         // Update_Late items
         inline void Update_Items_Late(void)
@@ -147,6 +186,8 @@ namespace TSC {
         // The UID pool is filled as needed. This is always the first
         // non-yet allocated UID.
         int m_max_uid_mark;
+        // microseconds the last Update_Items() took
+        unsigned int m_update_us;
 
         // Z position sort
         struct zpos_sort {
@@ -193,6 +234,52 @@ namespace TSC {
          * are ensured to be placed in front of older ones.
          */
         void Ensure_Different_Z(cSprite* sprite);
+
+        // Put the sprite into a free slot
+        void Insert_Slot(cSprite* sprite);
+        /* Free the slot which invalidates its handles
+         * The sprite may already be deleted.
+        */
+        void Free_Slot(int slot_num, int uid);
+
+        struct cSprite_Slot {
+            cSprite* mp_sprite;
+            // incremented when the slot is freed
+            unsigned int m_generation;
+            // array position after the next Compact()
+            int m_order;
+            // deleted with the next Compact()
+            bool m_removed;
+        };
+
+        // Slot order sort
+        struct slot_order_sort {
+            slot_order_sort(const std::vector<cSprite_Slot>& slots)
+                : m_slots(slots) {}
+
+            bool operator()(const cSprite* a, const cSprite* b) const
+            {
+                return m_slots[a->m_manager_slot].m_order < m_slots[b->m_manager_slot].m_order;
+            }
+
+            const std::vector<cSprite_Slot>& m_slots;
+        };
+
+        // sprites by slot, the slot of a sprite is in its m_manager_slot
+        std::vector<cSprite_Slot> m_slots;
+        // slots which can be used again
+        std::vector<int> m_free_slots;
+        // slot of each UID or -1
+        std::vector<int> m_uid_slots;
+        // smallest and biggest order of the slots
+        int m_first_order;
+        int m_last_order;
+        // Compact() has to remove sprites
+        bool m_compact_removed;
+        // Compact() has to sort the array
+        bool m_compact_order;
+        // interpreter of the level
+        Scripting::cMRuby_Interpreter* mp_mruby;
     };
 
     /* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
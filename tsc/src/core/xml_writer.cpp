@@ -0,0 +1,176 @@
+/***************************************************************************
+ * xml_writer.cpp - streaming XML writer
+ *
+ * Copyright © 2012-2020 The TSC Contributors
+ ***************************************************************************/
+/*
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "../core/xml_writer.hpp"
+#include "../core/global_basic.hpp"
+
+using namespace std;
+
+namespace TSC {
+
+/* *** *** *** *** *** *** *** cXml_Writer *** *** *** *** *** *** *** *** *** *** */
+
+// spaces per element depth
+static const size_t XML_WRITER_INDENT = 2;
+
+cXml_Writer::cXml_Writer(void)
+{
+    m_data = "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n";
+    m_tag_open = 0;
+}
+
+cXml_Writer::~cXml_Writer(void)
+{
+
+}
+
+void cXml_Writer::Start_Element(const std::string& name)
+{
+    cElement element;
+    element.m_name = name;
+    element.m_start = m_data.size();
+    element.m_parent_tag_open = m_tag_open;
+    element.m_parent_children = !m_elements.empty() && m_elements.back().m_children;
+    element.m_children = 0;
+    element.m_text = 0;
+
+    if (!m_elements.empty()) {
+        Close_Start_Tag(1);
+        m_elements.back().m_children = 1;
+    }
+
+    m_data.append(m_elements.size() * XML_WRITER_INDENT, ' ');
+    m_data += '<';
+    m_data += name;
+
+    m_elements.push_back(element);
+    m_tag_open = 1;
+}
+
+void cXml_Writer::Add_Attribute(const std::string& name, const std::string& value)
+{
+    if (!m_tag_open) {
+        cerr << "Warning : cXml_Writer : attribute " << name << " added after the content" << endl;
+        return;
+    }
+
+    m_data += ' ';
+    m_data += name;
+    m_data += "=\"";
+    Append_Escaped(value, 1);
+    m_data += '"';
+}
+
+void cXml_Writer::Add_Text(const std::string& text)
+{
+    if (m_elements.empty()) {
+        return;
+    }
+
+    // text is not indented as the whitespace would become part of it
+    Close_Start_Tag(0);
+    Append_Escaped(text, 0);
+    m_elements.back().m_text = 1;
+}
+
+void cXml_Writer::End_Element(void)
+{
+    if (m_elements.empty()) {
+        return;
+    }
+
+    const cElement& element = m_elements.back();
+
+    if (m_tag_open) {
+        m_data += "/>\n";
+        m_tag_open = 0;
+    }
+    else {
+        // the end tag follows the text directly
+        if (element.m_children && !element.m_text) {
+            m_data.append((m_elements.size() - 1) * XML_WRITER_INDENT, ' ');
+        }
+
+        m_data += "</";
+        m_data += element.m_name;
+        m_data += ">\n";
+    }
+
+    m_elements.pop_back();
+}
+
+void cXml_Writer::Discard_Element(void)
+{
+    if (m_elements.empty()) {
+        return;
+    }
+
+    const cElement element = m_elements.back();
+
+    m_data.resize(element.m_start);
+    m_tag_open = element.m_parent_tag_open;
+    m_elements.pop_back();
+
+    if (!m_elements.empty()) {
+        m_elements.back().m_children = element.m_parent_children;
+    }
+}
+
+void cXml_Writer::Close_Start_Tag(bool newline)
+{
+    if (!m_tag_open) {
+        return;
+    }
+
+    m_data += newline ? ">\n" : ">";
+    m_tag_open = 0;
+}
+
+void cXml_Writer::Append_Escaped(const std::string& text, bool attribute)
+{
+    for (std::string::const_iterator itr = text.begin(); itr != text.end(); ++itr) {
+        switch (*itr) {
+        case '<':
+            m_data += "&lt;";
+            break;
+        case '>':
+            m_data += "&gt;";
+            break;
+        case '&':
+            m_data += "&amp;";
+            break;
+        case '\r':
+            m_data += "&#13;";
+            break;
+        case '"':
+            m_data += attribute ? "&quot;" : "\"";
+            break;
+        // attribute values would have them normalized to spaces
+        case '\n':
+            m_data += attribute ? "&#10;" : "\n";
+            break;
+        case '\t':
+            m_data += attribute ? "&#9;" : "\t";
+            break;
+        default:
+            m_data += *itr;
+            break;
+        }
+    }
+}
+
+/* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
+
+} // namespace TSC
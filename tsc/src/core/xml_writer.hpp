@@ -0,0 +1,91 @@
+/***************************************************************************
+ * xml_writer.hpp - streaming XML writer
+ *
+ * Copyright © 2012-2020 The TSC Contributors
+ ***************************************************************************/
+/*
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef TSC_XML_WRITER_HPP
+#define TSC_XML_WRITER_HPP
+
+#include "../core/global_basic.hpp"
+
+namespace TSC {
+
+    /* *** *** *** *** *** *** *** cXml_Writer *** *** *** *** *** *** *** *** *** *** */
+
+    /* Writes an XML document into memory element by element, formatted
+     * like xmlpp::Document::write_to_file_formatted(). Unlike a document
+     * it creates no node objects, so saving thousands of sprites only
+     * appends to one string which can then be written to the file by
+     * another thread with cFile_Writer.
+     */
+    class cXml_Writer {
+    public:
+        // Starts with the XML declaration
+        cXml_Writer(void);
+        ~cXml_Writer(void);
+
+        // Start a child element of the current element
+        void Start_Element(const std::string& name);
+        // Add an attribute to the current element, only before its content
+        void Add_Attribute(const std::string& name, const std::string& value);
+        // Add text content to the current element
+        void Add_Text(const std::string& text);
+        // End the current element
+        void End_Element(void);
+        // Remove the current element with everything added since it was started
+        void Discard_Element(void);
+
+        // Number of started and not yet ended elements
+        size_t Get_Depth(void) const
+        {
+            return m_elements.size();
+        }
+
+        /* The document, complete if all elements are ended
+         * The data may be swapped out, which leaves the writer empty.
+        */
+        std::string& Get_Data(void)
+        {
+            return m_data;
+        }
+
+    private:
+        struct cElement {
+            std::string m_name;
+            // where it was started, for Discard_Element()
+            size_t m_start;
+            // state of the parent when it was started
+            bool m_parent_tag_open;
+            bool m_parent_children;
+            // if it has child elements
+            bool m_children;
+            // if it has text
+            bool m_text;
+        };
+
+        // Close the start tag if attributes can still be added
+        void Close_Start_Tag(bool newline);
+        // Append the escaped text, attribute values also need line breaks and tabs escaped
+        void Append_Escaped(const std::string& text, bool attribute);
+
+        std::string m_data;
+        std::vector<cElement> m_elements;
+        // if the start tag of the current element has no ">" yet
+        bool m_tag_open;
+    };
+
+    /* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
+
+} // namespace TSC
+
+#endif
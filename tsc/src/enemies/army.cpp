@@ -69,7 +69,7 @@ namespace TSC {
     void cArmy::Init(void)
     {
         m_type = TYPE_ARMY;
-        m_name = "Armadillo";
+        Editor_Data().m_name = "Armadillo";
         m_pos_z = 0.091f;
         m_gravity_max = 24.0f;
 
@@ -99,16 +99,14 @@ namespace TSC {
         return "army";
     }
 
-    xmlpp::Element* cArmy::Save_To_XML_Node(xmlpp::Element* p_element)
+    void cArmy::Save_To_XML_Node(cXml_Writer& writer)
     {
-        xmlpp::Element* p_node = cEnemy::Save_To_XML_Node(p_element);
+        cEnemy::Save_To_XML_Node(writer);
 
-        Add_Property(p_node, "posx", static_cast<int>(m_start_pos_x));
-        Add_Property(p_node, "posy", static_cast<int>(m_start_pos_y));
-        Add_Property(p_node, "color", Get_Color_Name(m_color_type));
-        Add_Property(p_node, "direction", Get_Direction_Name(m_start_direction));
-
-        return p_node;
+        Add_Property(writer, "posx", static_cast<int>(m_start_pos_x));
+        Add_Property(writer, "posy", static_cast<int>(m_start_pos_y));
+        Add_Property(writer, "color", Get_Color_Name(m_color_type));
+        Add_Property(writer, "direction", Get_Direction_Name(m_start_direction));
     }
 
     void cArmy::Load_From_Savegame(cSave_Level_Object* save_object)
@@ -134,13 +132,13 @@ namespace TSC {
         }
     }
 
-    bool cArmy::Save_To_Savegame_XML_Node(xmlpp::Element* p_element) const
+    bool cArmy::Save_To_Savegame_XML_Node(cXml_Writer& writer) const
     {
-        cEnemy::Save_To_Savegame_XML_Node(p_element);
+        cEnemy::Save_To_Savegame_XML_Node(writer);
 
         // army_state ( only save if needed )
         if (m_army_state != ARMY_WALK) {
-            Add_Property(p_element, "army_state", int_to_string(m_army_state));
+            Add_Property(writer, "army_state", int_to_string(m_army_state));
         }
 
         return true;
@@ -322,6 +320,7 @@ namespace TSC {
         }
 
         m_army_state = new_state;
+        m_save_dirty = 1;
 
         Update_Velocity_Max();
         Update_Rotation_Hor();
@@ -766,7 +765,7 @@ namespace TSC {
 void cArmy::Handle_Collision_Enemy(cObjectCollision* collision)
 {
     if (m_army_state == ARMY_SHELL_STAND) {
-        cEnemy* enemy = static_cast<cEnemy*>(m_sprite_manager->Get_Pointer(collision->m_number));
+        cEnemy* enemy = static_cast<cEnemy*>(m_sprite_manager->Get_Sprite(collision->m_handle));
 
         // if able to collide
         if (m_state == STA_OBJ_LINKED || m_vely < -5.0f) {
@@ -776,7 +775,7 @@ void cArmy::Handle_Collision_Enemy(cObjectCollision* collision)
         }
     }
     else if (m_army_state == ARMY_SHELL_RUN) {
-        cEnemy* enemy = static_cast<cEnemy*>(m_sprite_manager->Get_Pointer(collision->m_number));
+        cEnemy* enemy = static_cast<cEnemy*>(m_sprite_manager->Get_Sprite(collision->m_handle));
 
         if (Hit_Enemy(enemy)) {
             // create animation
@@ -814,7 +813,7 @@ void cArmy::Handle_Collision_Enemy(cObjectCollision* collision)
 void cArmy::Handle_Collision_Massive(cObjectCollision* collision)
 {
     // get colliding object
-    cSprite* col_object = m_sprite_manager->Get_Pointer(collision->m_number);
+    cSprite* col_object = m_sprite_manager->Get_Sprite(collision->m_handle);
 
     if (m_army_state == ARMY_WALK) {
         Send_Collision(collision);
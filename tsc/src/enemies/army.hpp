@@ -53,14 +53,14 @@ namespace TSC {
         // Create the MRuby object for this
         virtual mrb_value Create_MRuby_Object(mrb_state* p_state)
         {
-            return mrb_obj_value(Data_Wrap_Struct(p_state, mrb_class_get(p_state, "Armadillo"), &Scripting::rtTSC_Scriptable, this));
+            return Scripting::Wrap_Sprite(p_state, mrb_class_get(p_state, "Armadillo"), this);
         }
 
 
         // load from savegame
         virtual void Load_From_Savegame(cSave_Level_Object* save_object);
         // save to savegame
-        virtual bool Save_To_Savegame_XML_Node(xmlpp::Element* p_element) const;
+        virtual bool Save_To_Savegame_XML_Node(cXml_Writer& writer) const;
 
         // Set Direction
         virtual void Set_Direction(const ObjectDirection dir, bool new_start_direction = 0);
@@ -131,7 +131,7 @@ namespace TSC {
         DefaultColor m_color_type;
 
         // Save to XML node
-        virtual xmlpp::Element* Save_To_XML_Node(xmlpp::Element* p_element);
+        virtual void Save_To_XML_Node(cXml_Writer& writer);
 
     protected:
 
@@ -62,7 +62,7 @@ void cBeetle::Init()
     m_pos_z = 0.092f; // Ensure this is behind cBeetleBarrage
     m_gravity_max = 0.0f;
     m_editor_pos_z = 0.089f;
-    m_name = "Beetle";
+    Editor_Data().m_name = "Beetle";
     m_velx = -2.5;
     m_rest_living_time = Get_Random_Float(150.0f, 250.0f);
     m_start_direction = m_direction = DIR_LEFT;
@@ -95,14 +95,12 @@ std::string cBeetle::Get_XML_Type_Name()
     return "beetle";
 }
 
-xmlpp::Element* cBeetle::Save_To_XML_Node(xmlpp::Element* p_element)
+void cBeetle::Save_To_XML_Node(cXml_Writer& writer)
 {
-    xmlpp::Element* p_node = cEnemy::Save_To_XML_Node(p_element);
+    cEnemy::Save_To_XML_Node(writer);
 
-    Add_Property(p_node, "direction", Get_Direction_Name(m_start_direction));
-    Add_Property(p_node, "color", Get_Color_Name(m_color));
-
-    return p_node;
+    Add_Property(writer, "direction", Get_Direction_Name(m_start_direction));
+    Add_Property(writer, "color", Get_Color_Name(m_color));
 }
 
 void cBeetle::DownGrade(bool force /* = false */)
@@ -225,7 +223,7 @@ void cBeetle::Handle_Collision_Massive(cObjectCollision* p_collision)
 
     Send_Collision(p_collision);
 
-    cSprite* p_colobj = m_sprite_manager->Get_Pointer(p_collision->m_number);
+    cSprite* p_colobj = m_sprite_manager->Get_Sprite(p_collision->m_handle);
     if (p_colobj->m_type == TYPE_CRATE && p_collision->m_direction == DIR_TOP) {
         // Ouch. Crate from above
         DownGrade(true);
@@ -48,7 +48,7 @@ namespace TSC {
 
         virtual void Editor_Activate();
 
-        virtual xmlpp::Element* Save_To_XML_Node(xmlpp::Element* p_element);
+        virtual void Save_To_XML_Node(cXml_Writer& writer);
 
     protected:
         virtual std::string Get_XML_Type_Name();
@@ -63,7 +63,7 @@ void cBeetleBarrage::Init()
     m_pos_z = 0.093f; // Ensure this is in front of cBeetle
     m_gravity_max = 24.0f;
     m_editor_pos_z = 0.089f;
-    m_name = "Beetle Barrage";
+    Editor_Data().m_name = "Beetle Barrage";
     m_beetle_interval = 100.0f;
     m_beetle_interval_counter = 0.0f;
     m_is_spitting_out_beetles = false;
@@ -96,17 +96,15 @@ std::string cBeetleBarrage::Get_XML_Type_Name()
     return "beetle_barrage";
 }
 
-xmlpp::Element* cBeetleBarrage::Save_To_XML_Node(xmlpp::Element* p_element)
+void cBeetleBarrage::Save_To_XML_Node(cXml_Writer& writer)
 {
-    xmlpp::Element* p_node = cEnemy::Save_To_XML_Node(p_element);
+    cEnemy::Save_To_XML_Node(writer);
 
-    Add_Property(p_node, "direction", Get_Direction_Name(m_start_direction));
-    Add_Property(p_node, "active_range", m_active_range);
-    Add_Property(p_node, "interval", m_beetle_interval);
-    Add_Property(p_node, "spit_count", m_beetle_spit_count);
-    Add_Property(p_node, "fly_distance", m_beetle_fly_distance);
-
-    return p_node;
+    Add_Property(writer, "direction", Get_Direction_Name(m_start_direction));
+    Add_Property(writer, "active_range", m_active_range);
+    Add_Property(writer, "interval", m_beetle_interval);
+    Add_Property(writer, "spit_count", m_beetle_spit_count);
+    Add_Property(writer, "fly_distance", m_beetle_fly_distance);
 }
 
 void cBeetleBarrage::DownGrade(bool force /* = false */)
@@ -247,7 +245,7 @@ void cBeetleBarrage::Handle_Collision_Massive(cObjectCollision* p_collision)
     if (m_state == STA_OBJ_LINKED)
         return;
 
-    cSprite* p_colobj = m_sprite_manager->Get_Pointer(p_collision->m_number);
+    cSprite* p_colobj = m_sprite_manager->Get_Sprite(p_collision->m_handle);
     if (p_colobj->m_type == TYPE_CRATE && p_collision->m_direction == DIR_TOP) {
         // Ouch. Crate from above
         DownGrade(true);
@@ -273,6 +271,7 @@ void cBeetleBarrage::Set_Moving_State(Moving_state new_state)
     Reset_Animation();
     Set_Image_Num(0);
     m_state = new_state;
+    m_save_dirty = 1;
 }
 
 void cBeetleBarrage::Set_Active_Range(float range)
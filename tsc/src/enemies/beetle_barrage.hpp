@@ -52,10 +52,10 @@ namespace TSC {
         // Create the MRuby object for this
         virtual mrb_value Create_MRuby_Object(mrb_state* p_state)
         {
-            return mrb_obj_value(Data_Wrap_Struct(p_state, mrb_class_get(p_state, "BeetleBarrage"), &Scripting::rtTSC_Scriptable, this));
+            return Scripting::Wrap_Sprite(p_state, mrb_class_get(p_state, "BeetleBarrage"), this);
         }
 
-        virtual xmlpp::Element* Save_To_XML_Node(xmlpp::Element* p_element);
+        virtual void Save_To_XML_Node(cXml_Writer& writer);
 
     protected:
         virtual std::string Get_XML_Type_Name();
@@ -81,7 +81,7 @@ cTurtleBoss::~cTurtleBoss(void)
 void cTurtleBoss::Init(void)
 {
     m_type = TYPE_TURTLE_BOSS;
-    m_name = "Turtle Boss";
+    Editor_Data().m_name = "Turtle Boss";
     m_pos_z = 0.092f;
     m_gravity_max = 19.0f;
 
@@ -128,18 +128,16 @@ std::string cTurtleBoss::Get_XML_Type_Name()
     return "turtleboss";
 }
 
-xmlpp::Element* cTurtleBoss::Save_To_XML_Node(xmlpp::Element* p_element)
+void cTurtleBoss::Save_To_XML_Node(cXml_Writer& writer)
 {
-    xmlpp::Element* p_node = cEnemy::Save_To_XML_Node(p_element);
-
-    Add_Property(p_node, "color", Get_Color_Name(m_color_type));
-    Add_Property(p_node, "direction", Get_Direction_Name(m_start_direction));
-    Add_Property(p_node, "max_hit_count", m_max_hits);
-    Add_Property(p_node, "max_downgrade_count", m_max_downgrade_count);
-    Add_Property(p_node, "shell_time", m_shell_time);
-    Add_Property(p_node, "level_ends_if_killed", m_level_ends_if_killed);
-
-    return p_node;
+    cEnemy::Save_To_XML_Node(writer);
+
+    Add_Property(writer, "color", Get_Color_Name(m_color_type));
+    Add_Property(writer, "direction", Get_Direction_Name(m_start_direction));
+    Add_Property(writer, "max_hit_count", m_max_hits);
+    Add_Property(writer, "max_downgrade_count", m_max_downgrade_count);
+    Add_Property(writer, "shell_time", m_shell_time);
+    Add_Property(writer, "level_ends_if_killed", m_level_ends_if_killed);
 }
 
 void cTurtleBoss::Set_Max_Hits(int nmax_hits)
@@ -889,7 +887,7 @@ void cTurtleBoss::Handle_Collision_Player(cObjectCollision* collision)
 
 void cTurtleBoss::Handle_Collision_Enemy(cObjectCollision* collision)
 {
-    cEnemy* enemy = static_cast<cEnemy*>(m_sprite_manager->Get_Pointer(collision->m_number));
+    cEnemy* enemy = static_cast<cEnemy*>(m_sprite_manager->Get_Sprite(collision->m_handle));
 
     if (m_turtle_state == TURTLEBOSS_SHELL_STAND) {
         // if able to collide
@@ -922,7 +920,7 @@ void cTurtleBoss::Handle_Collision_Massive(cObjectCollision* collision)
     }
     else if (m_turtle_state == TURTLEBOSS_SHELL_RUN) {
         if (collision->m_direction == DIR_RIGHT || collision->m_direction == DIR_LEFT) {
-            cSprite* col_object = m_sprite_manager->Get_Pointer(collision->m_number);
+            cSprite* col_object = m_sprite_manager->Get_Sprite(collision->m_handle);
 
             // animation
             cParticle_Emitter* anim = NULL;
@@ -958,7 +956,7 @@ void cTurtleBoss::Handle_Collision_Massive(cObjectCollision* collision)
             // active object box collision
             if (collision->m_array == ARRAY_ACTIVE) {
                 // get colliding object
-                cSprite* col_object = m_sprite_manager->Get_Pointer(collision->m_number);
+                cSprite* col_object = m_sprite_manager->Get_Sprite(collision->m_handle);
 
                 if (col_object->m_type == TYPE_BONUS_BOX || col_object->m_type == TYPE_SPIN_BOX) {
                     // get basebox
@@ -1105,7 +1103,7 @@ bool cTurtleBoss::Editor_Level_Ends_If_Killed(const CEGUI::EventArgs& event)
 
 std::string cTurtleBoss::Create_Name(void) const
 {
-    std::string name = m_name; // dup
+    std::string name = Editor_Data().m_name; // dup
     name += " " + Get_Direction_Name(m_start_direction);
     return name;
 }
@@ -54,7 +54,7 @@ namespace TSC {
         // Create the MRuby object for this
         virtual mrb_value Create_MRuby_Object(mrb_state* p_state)
         {
-            return mrb_obj_value(Data_Wrap_Struct(p_state, mrb_class_get(p_state, "TurtleBoss"), &Scripting::rtTSC_Scriptable, this));
+            return Scripting::Wrap_Sprite(p_state, mrb_class_get(p_state, "TurtleBoss"), this);
         }
 
         // maximum hits until downgrade
@@ -172,7 +172,7 @@ namespace TSC {
         int m_shell_stand_start;
 
         // Save to XML node
-        virtual xmlpp::Element* Save_To_XML_Node(xmlpp::Element* p_element);
+        virtual void Save_To_XML_Node(cXml_Writer& writer);
 
 
         virtual std::string Get_XML_Type_Name();
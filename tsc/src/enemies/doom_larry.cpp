@@ -55,7 +55,7 @@ void cDoomLarry::Init()
     Clear_Images(true, true);
 
     m_type = TYPE_DOOM_LARRY;
-    m_name = "Doom Larry";
+    Editor_Data().m_name = "Doom Larry";
     m_pos_z = 0.09f;
     m_gravity_max = 29.0f;
 
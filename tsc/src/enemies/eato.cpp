@@ -67,7 +67,7 @@ cEato::~cEato(void)
 void cEato::Init(void)
 {
     m_type = TYPE_EATO;
-    m_name = "Eato";
+    Editor_Data().m_name = "Eato";
     m_camera_range = 1000;
     m_pos_z = 0.087f;
     m_can_be_on_ground = 0;
@@ -96,14 +96,12 @@ std::string cEato::Get_XML_Type_Name()
     return "eato";
 }
 
-xmlpp::Element* cEato::Save_To_XML_Node(xmlpp::Element* p_element)
+void cEato::Save_To_XML_Node(cXml_Writer& writer)
 {
-    xmlpp::Element* p_node = cEnemy::Save_To_XML_Node(p_element);
+    cEnemy::Save_To_XML_Node(writer);
 
-    Add_Property(p_node, "image_dir", path_to_utf8(m_img_dir));
-    Add_Property(p_node, "direction", Get_Direction_Name(m_start_direction));
-
-    return p_node;
+    Add_Property(writer, "image_dir", path_to_utf8(m_img_dir));
+    Add_Property(writer, "direction", Get_Direction_Name(m_start_direction));
 }
 
 void cEato::Set_Image_Dir(fs::path dir)
@@ -254,7 +252,7 @@ void cEato::Handle_Collision_Massive(cObjectCollision* p_collision)
 
     Send_Collision(p_collision);
 
-    cSprite* p_colobj = m_sprite_manager->Get_Pointer(p_collision->m_number);
+    cSprite* p_colobj = m_sprite_manager->Get_Sprite(p_collision->m_handle);
     if (p_colobj->m_type == TYPE_CRATE && p_collision->m_direction == DIR_TOP) {
         // Ouch. Crate from above
         DownGrade(true);
@@ -315,7 +313,7 @@ bool cEato::Editor_Image_Dir_Text_Changed(const CEGUI::EventArgs& event)
 
 std::string cEato::Create_Name(void) const
 {
-    std::string name = m_name; // dup
+    std::string name = Editor_Data().m_name; // dup
     name += " ";
     name += _(Get_Direction_Name(m_start_direction).c_str());
 
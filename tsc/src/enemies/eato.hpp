@@ -43,7 +43,7 @@ namespace TSC {
         // Create the MRuby object for this
         virtual mrb_value Create_MRuby_Object(mrb_state* p_state)
         {
-            return mrb_obj_value(Data_Wrap_Struct(p_state, mrb_class_get(p_state, "Eato"), &Scripting::rtTSC_Scriptable, this));
+            return Scripting::Wrap_Sprite(p_state, mrb_class_get(p_state, "Eato"), this);
         }
 
         // Set the image directory. `dir' must be relative to the pixmaps/
@@ -83,7 +83,7 @@ namespace TSC {
         boost::filesystem::path m_img_dir;
 
         // Save to XML node
-        virtual xmlpp::Element* Save_To_XML_Node(xmlpp::Element* p_element);
+        virtual void Save_To_XML_Node(cXml_Writer& writer);
         virtual std::string Create_Name() const;
 
     protected:
@@ -72,13 +72,13 @@ void cEnemy::Load_From_Savegame(cSave_Level_Object* save_object)
     }
 }
 
-bool cEnemy::Save_To_Savegame_XML_Node(xmlpp::Element* p_element) const
+bool cEnemy::Save_To_Savegame_XML_Node(cXml_Writer& writer) const
 {
-    cMovingSprite::Save_To_Savegame_XML_Node(p_element);
+    cMovingSprite::Save_To_Savegame_XML_Node(writer);
 
     // dead ( only save if needed )
     if (m_dead) {
-        Add_Property(p_element, "dead", int_to_string(m_dead));
+        Add_Property(writer, "dead", int_to_string(m_dead));
     }
 
     return true;
@@ -88,6 +88,7 @@ void cEnemy::Set_Dead(bool enable /* = 1 */)
 {
     m_dead = enable;
     m_can_be_ground = false; // Once dead can’t stand on it anymore
+    m_save_dirty = 1;
 
     if (m_dead) {
         // Issue the die event
@@ -316,15 +317,15 @@ void cEnemy::Handle_Ball_Hit(const cBall& ball, const cObjectCollision* p_collis
     }
 }
 
-xmlpp::Element* cEnemy::Save_To_XML_Node(xmlpp::Element* p_element)
+void cEnemy::Save_To_XML_Node(cXml_Writer& writer)
 {
-    return cMovingSprite::Save_To_XML_Node(p_element);
+    cMovingSprite::Save_To_XML_Node(writer);
 }
 
 std::string cEnemy::Create_Name() const
 {
     std::stringstream ss;
-    ss << m_name
+    ss << Editor_Data().m_name
        << " " << _(Get_Direction_Name(m_start_direction).c_str());
 
     return ss.str();
@@ -37,12 +37,12 @@ namespace TSC {
         // load from savegame
         virtual void Load_From_Savegame(cSave_Level_Object* save_object);
         // save to savegame
-        virtual bool Save_To_Savegame_XML_Node(xmlpp::Element* p_element) const;
+        virtual bool Save_To_Savegame_XML_Node(cXml_Writer& writer) const;
 
         // Create the MRuby object for this
         virtual mrb_value Create_MRuby_Object(mrb_state* p_state)
         {
-            return mrb_obj_value(Data_Wrap_Struct(p_state, mrb_class_get(p_state, "Enemy"), &Scripting::rtTSC_Scriptable, this));
+            return Scripting::Wrap_Sprite(p_state, mrb_class_get(p_state, "Enemy"), this);
         }
 
         // Set Dead
@@ -84,7 +84,7 @@ namespace TSC {
         virtual void Handle_Ball_Hit(const cBall& ball, const cObjectCollision* p_collision);
 
         // Save to XML node
-        virtual xmlpp::Element* Save_To_XML_Node(xmlpp::Element* p_element);
+        virtual void Save_To_XML_Node(cXml_Writer& writer);
 
         virtual std::string Create_Name() const;
 
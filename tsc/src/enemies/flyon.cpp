@@ -76,7 +76,7 @@ cFlyon::~cFlyon(void)
 void cFlyon::Init(void)
 {
     m_type = TYPE_FLYON;
-    m_name = "Flyon";
+    Editor_Data().m_name = "Flyon";
     m_pos_z = 0.06f;
     Set_Rotation_Affects_Rect(1);
     m_editor_pos_z = 0.089f;
@@ -113,16 +113,14 @@ std::string cFlyon::Get_XML_Type_Name()
     return "flyon";
 }
 
-xmlpp::Element* cFlyon::Save_To_XML_Node(xmlpp::Element* p_element)
+void cFlyon::Save_To_XML_Node(cXml_Writer& writer)
 {
-    xmlpp::Element* p_node = cEnemy::Save_To_XML_Node(p_element);
+    cEnemy::Save_To_XML_Node(writer);
 
-    Add_Property(p_node, "direction", Get_Direction_Name(m_start_direction));
-    Add_Property(p_node, "image_dir", path_to_utf8(m_img_dir));
-    Add_Property(p_node, "max_distance", static_cast<int>(m_max_distance));
-    Add_Property(p_node, "speed", m_speed);
-
-    return p_node;
+    Add_Property(writer, "direction", Get_Direction_Name(m_start_direction));
+    Add_Property(writer, "image_dir", path_to_utf8(m_img_dir));
+    Add_Property(writer, "max_distance", static_cast<int>(m_max_distance));
+    Add_Property(writer, "speed", m_speed);
 }
 
 void cFlyon::Load_From_Savegame(cSave_Level_Object* save_object)
@@ -135,13 +133,13 @@ void cFlyon::Load_From_Savegame(cSave_Level_Object* save_object)
     }
 }
 
-bool cFlyon::Save_To_Savegame_XML_Node(xmlpp::Element* p_element) const
+bool cFlyon::Save_To_Savegame_XML_Node(cXml_Writer& writer) const
 {
-    cEnemy::Save_To_Savegame_XML_Node(p_element);
+    cEnemy::Save_To_Savegame_XML_Node(writer);
 
     // move_back ( only save if needed )
     if (m_move_back) {
-        Add_Property(p_element, "move_back", int_to_string(m_move_back));
+        Add_Property(writer, "move_back", int_to_string(m_move_back));
     }
 
     return true;
@@ -276,6 +274,7 @@ void cFlyon::Set_Moving_State(Moving_state new_state)
     }
 
     m_state = new_state;
+    m_save_dirty = 1;
 }
 
 void cFlyon::Update(void)
@@ -42,12 +42,12 @@ namespace TSC {
         // load from savegame
         virtual void Load_From_Savegame(cSave_Level_Object* save_object);
         // save to savegame
-        virtual bool Save_To_Savegame_XML_Node(xmlpp::Element* p_element) const;
+        virtual bool Save_To_Savegame_XML_Node(cXml_Writer& writer) const;
 
         // Create the MRuby object for this
         virtual mrb_value Create_MRuby_Object(mrb_state* p_state)
         {
-            return mrb_obj_value(Data_Wrap_Struct(p_state, mrb_class_get(p_state, "Flyon"), &Scripting::rtTSC_Scriptable, this));
+            return Scripting::Wrap_Sprite(p_state, mrb_class_get(p_state, "Flyon"), this);
         }
 
         // Set the image directory. `dir' must be a relative
@@ -121,7 +121,7 @@ namespace TSC {
         bool m_move_back;
 
         // Save to XML node
-        virtual xmlpp::Element* Save_To_XML_Node(xmlpp::Element* p_element);
+        virtual void Save_To_XML_Node(cXml_Writer& writer);
         std::string Create_Name(void) const;
 
     protected:
@@ -73,7 +73,7 @@ cFurball::~cFurball(void)
 void cFurball::Init(void)
 {
     m_type = TYPE_FURBALL;
-    m_name = "Furball";
+    Editor_Data().m_name = "Furball";
     m_pos_z = 0.09f;
     m_gravity_max = 19.0f;
 
@@ -109,19 +109,17 @@ std::string cFurball::Get_XML_Type_Name()
     return "furball";
 }
 
-xmlpp::Element* cFurball::Save_To_XML_Node(xmlpp::Element* p_element)
+void cFurball::Save_To_XML_Node(cXml_Writer& writer)
 {
-    xmlpp::Element* p_node = cEnemy::Save_To_XML_Node(p_element);
+    cEnemy::Save_To_XML_Node(writer);
 
-    Add_Property(p_node, "color", Get_Color_Name(m_color_type));
-    Add_Property(p_node, "direction", Get_Direction_Name(m_start_direction));
+    Add_Property(writer, "color", Get_Color_Name(m_color_type));
+    Add_Property(writer, "direction", Get_Direction_Name(m_start_direction));
 
     if (m_type == TYPE_FURBALL_BOSS) {
-        Add_Property(p_node, "max_downgrade_count", m_max_downgrade_count);
-        Add_Property(p_node, "level_ends_if_killed", m_level_ends_if_killed);
+        Add_Property(writer, "max_downgrade_count", m_max_downgrade_count);
+        Add_Property(writer, "level_ends_if_killed", m_level_ends_if_killed);
     }
-
-    return p_node;
 }
 
 void cFurball::Load_From_Savegame(cSave_Level_Object* save_object)
@@ -380,6 +378,7 @@ void cFurball::Set_Moving_State(Moving_state new_state)
     }
 
     m_state = new_state;
+    m_save_dirty = 1;
 
     Update_Velocity_Max();
     // if in the first part of the turn around animation
@@ -700,7 +699,7 @@ void cFurball::Handle_Collision_Massive(cObjectCollision* collision)
     Send_Collision(collision);
 
     // get colliding object
-    cSprite* col_object = m_sprite_manager->Get_Pointer(collision->m_number);
+    cSprite* col_object = m_sprite_manager->Get_Sprite(collision->m_handle);
 
     if (col_object->m_type == TYPE_BALL) {
         return;
@@ -813,7 +812,7 @@ bool cFurball::Editor_Max_Downgrade_Count_Text_Changed(const CEGUI::EventArgs& e
 
 std::string cFurball::Create_Name(void) const
 {
-    std::string name = m_name; // dup
+    std::string name = Editor_Data().m_name; // dup
     name += " ";
 
     if (m_color_type == COL_BLACK) {
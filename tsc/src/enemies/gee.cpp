@@ -90,7 +90,7 @@ void cGee::Init(void)
     Set_Color(COL_YELLOW);
 
     m_kill_sound = "enemy/gee/die.ogg";
-    m_name = "Gee";
+    Editor_Data().m_name = "Gee";
 
     m_wait_time_counter = 0.0f;
     m_fly_distance_counter = 0.0f;
@@ -115,18 +115,16 @@ std::string cGee::Get_XML_Type_Name()
     return "gee";
 }
 
-xmlpp::Element* cGee::Save_To_XML_Node(xmlpp::Element* p_element)
+void cGee::Save_To_XML_Node(cXml_Writer& writer)
 {
-    xmlpp::Element* p_node = cEnemy::Save_To_XML_Node(p_element);
+    cEnemy::Save_To_XML_Node(writer);
 
-    Add_Property(p_node, "direction", Get_Direction_Name(m_start_direction));
-    Add_Property(p_node, "max_distance", static_cast<int>(m_max_distance));
-    Add_Property(p_node, "always_fly", m_always_fly);
-    Add_Property(p_node, "wait_time", m_wait_time);
-    Add_Property(p_node, "fly_distance", static_cast<int>(m_fly_distance));
-    Add_Property(p_node, "color", Get_Color_Name(m_color_type));
-
-    return p_node;
+    Add_Property(writer, "direction", Get_Direction_Name(m_start_direction));
+    Add_Property(writer, "max_distance", static_cast<int>(m_max_distance));
+    Add_Property(writer, "always_fly", m_always_fly);
+    Add_Property(writer, "wait_time", m_wait_time);
+    Add_Property(writer, "fly_distance", static_cast<int>(m_fly_distance));
+    Add_Property(writer, "color", Get_Color_Name(m_color_type));
 }
 
 void cGee::Load_From_Savegame(cSave_Level_Object* save_object)
@@ -307,6 +305,7 @@ void cGee::Set_Moving_State(Moving_state new_state)
     }
 
     m_state = new_state;
+    m_save_dirty = 1;
 }
 
 void cGee::Update(void)
@@ -673,7 +672,7 @@ bool cGee::Editor_Fly_Distance_Text_Changed(const CEGUI::EventArgs& event)
 
 std::string cGee::Create_Name(void) const
 {
-    std::string name = m_name; // dup
+    std::string name = Editor_Data().m_name; // dup
     name += " ";
 
     switch (m_color_type) {
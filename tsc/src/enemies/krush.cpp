@@ -62,7 +62,7 @@ cKrush::~cKrush(void)
 void cKrush::Init(void)
 {
     m_type = TYPE_KRUSH;
-    m_name = "Krush";
+    Editor_Data().m_name = "Krush";
     m_pos_z = 0.093f;
     m_gravity_max = 27.0f;
 
@@ -89,13 +89,11 @@ std::string cKrush::Get_XML_Type_Name()
     return "krush";
 }
 
-xmlpp::Element* cKrush::Save_To_XML_Node(xmlpp::Element* p_element)
+void cKrush::Save_To_XML_Node(cXml_Writer& writer)
 {
-    xmlpp::Element* p_node = cEnemy::Save_To_XML_Node(p_element);
+    cEnemy::Save_To_XML_Node(writer);
 
-    Add_Property(p_node, "direction", Get_Direction_Name(m_start_direction));
-
-    return p_node;
+    Add_Property(writer, "direction", Get_Direction_Name(m_start_direction));
 }
 
 
@@ -206,6 +204,7 @@ void cKrush::Set_Moving_State(Moving_state new_state)
     }
 
     m_state = new_state;
+    m_save_dirty = 1;
 
     Update_Velocity_Max();
 }
@@ -334,7 +333,7 @@ void cKrush::Handle_Collision_Massive(cObjectCollision* collision)
     Send_Collision(collision);
 
     // get colliding object
-    cSprite* col_object = m_sprite_manager->Get_Pointer(collision->m_number);
+    cSprite* col_object = m_sprite_manager->Get_Sprite(collision->m_handle);
 
     if (col_object->m_type == TYPE_BALL) {
         return;
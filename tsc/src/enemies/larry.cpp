@@ -56,7 +56,7 @@ cLarry::~cLarry()
 void cLarry::Init()
 {
     m_type = TYPE_LARRY;
-    m_name = "Larry";
+    Editor_Data().m_name = "Larry";
     m_pos_z = 0.09f;
     m_gravity_max = 29.0f;
 
@@ -90,13 +90,11 @@ std::string cLarry::Get_XML_Type_Name()
     return "larry";
 }
 
-xmlpp::Element* cLarry::Save_To_XML_Node(xmlpp::Element* p_element)
+void cLarry::Save_To_XML_Node(cXml_Writer& writer)
 {
-    xmlpp::Element* p_node = cEnemy::Save_To_XML_Node(p_element);
+    cEnemy::Save_To_XML_Node(writer);
 
-    Add_Property(p_node, "direction", Get_Direction_Name(m_start_direction));
-
-    return p_node;
+    Add_Property(writer, "direction", Get_Direction_Name(m_start_direction));
 }
 
 void cLarry::DownGrade(bool force /* = false */)
@@ -234,7 +232,7 @@ void cLarry::Handle_Collision_Massive(cObjectCollision* p_collision)
     //Send_Collision(p_collision);
 
     // get colliding object
-    cSprite* p_collidor = m_sprite_manager->Get_Pointer(p_collision->m_number);
+    cSprite* p_collidor = m_sprite_manager->Get_Sprite(p_collision->m_handle);
 
     if (p_collidor->m_type == TYPE_BALL) {
         cBall* p_ball = static_cast<cBall*>(p_collidor);
@@ -317,6 +315,7 @@ void cLarry::Set_Moving_State(Moving_state new_state)
         return;
 
     m_state = new_state;
+    m_save_dirty = 1;
 
     if (m_state == STA_WALK) {
         Set_Image_Set("walk", true);
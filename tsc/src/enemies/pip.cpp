@@ -62,7 +62,7 @@ cPip::~cPip()
 void cPip::Init()
 {
     m_type = TYPE_PIP;
-    m_name = "Pip";
+    Editor_Data().m_name = "Pip";
     m_pos_z = 0.093f;
     m_gravity_max = 13.0f;
 
@@ -90,13 +90,11 @@ std::string cPip::Get_XML_Type_Name()
     return "pip";
 }
 
-xmlpp::Element* cPip::Save_To_XML_Node(xmlpp::Element* p_element)
+void cPip::Save_To_XML_Node(cXml_Writer& writer)
 {
-    xmlpp::Element* p_node = cEnemy::Save_To_XML_Node(p_element);
+    cEnemy::Save_To_XML_Node(writer);
 
-    Add_Property(p_node, "direction", Get_Direction_Name(m_start_direction));
-
-    return p_node;
+    Add_Property(writer, "direction", Get_Direction_Name(m_start_direction));
 }
 
 void cPip::Load_From_Savegame(cSave_Level_Object* p_save_object)
@@ -215,6 +213,7 @@ void cPip::Set_Moving_State(Moving_state new_state)
     }
 
     m_state = new_state;
+    m_save_dirty = 1;
     Update_Velocity_Max();
 }
 
@@ -338,7 +337,7 @@ void cPip::Handle_Collision_Massive(cObjectCollision* p_collision)
     Send_Collision(p_collision);
 
     // get colliding object
-    cSprite* p_colobj = m_sprite_manager->Get_Pointer(p_collision->m_number);
+    cSprite* p_colobj = m_sprite_manager->Get_Sprite(p_collision->m_handle);
     if (p_colobj->m_type == TYPE_BALL)
         return;
     else if (p_colobj->m_type == TYPE_CRATE && p_collision->m_direction == DIR_TOP) {
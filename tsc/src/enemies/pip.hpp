@@ -68,7 +68,7 @@ namespace TSC {
         bool Editor_Direction_Select(const CEGUI::EventArgs& event);
 
         // Save to XML node
-        virtual xmlpp::Element* Save_To_XML_Node(xmlpp::Element* p_elemet);
+        virtual void Save_To_XML_Node(cXml_Writer& writer);
 
     protected:
         virtual std::string Get_XML_Type_Name();
@@ -69,7 +69,7 @@ cRokko::~cRokko(void)
 void cRokko::Init(void)
 {
     m_type = TYPE_ROKKO;
-    m_name = "Rokko";
+    Editor_Data().m_name = "Rokko";
     m_massive_type = MASS_PASSIVE;
     m_pos_z = 0.03f;
     m_gravity_max = 0;
@@ -116,14 +116,12 @@ std::string cRokko::Get_XML_Type_Name()
     return "rokko";
 }
 
-xmlpp::Element* cRokko::Save_To_XML_Node(xmlpp::Element* p_element)
+void cRokko::Save_To_XML_Node(cXml_Writer& writer)
 {
-    xmlpp::Element* p_node = cEnemy::Save_To_XML_Node(p_element);
+    cEnemy::Save_To_XML_Node(writer);
 
-    Add_Property(p_node, "direction", Get_Direction_Name(m_start_direction));
-    Add_Property(p_node, "speed", m_speed);
-
-    return p_node;
+    Add_Property(writer, "direction", Get_Direction_Name(m_start_direction));
+    Add_Property(writer, "speed", m_speed);
 }
 
 
@@ -63,7 +63,7 @@ void cShell::Init()
     cArmy::Init();
 
     m_type = TYPE_SHELL;
-    m_name = "Shell";
+    Editor_Data().m_name = "Shell";
     m_gravity_max = 22.0f;
 
     Set_Army_Moving_State(ARMY_SHELL_STAND);
@@ -147,5 +147,5 @@ void cShell::Set_Color(DefaultColor col)
 
 std::string cShell::Create_Name() const
 {
-    return m_name + " " + _(Get_Color_Name(m_color_type).c_str()) + " " + _(Get_Direction_Name(m_start_direction).c_str());
+    return Editor_Data().m_name + " " + _(Get_Color_Name(m_color_type).c_str()) + " " + _(Get_Direction_Name(m_start_direction).c_str());
 }
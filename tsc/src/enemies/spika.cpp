@@ -64,7 +64,7 @@ cSpika::~cSpika(void)
 void cSpika::Init(void)
 {
     m_type = TYPE_SPIKA;
-    m_name = "Spika";
+    Editor_Data().m_name = "Spika";
     m_pos_z = 0.09f;
     m_gravity_max = 25.0f;
 
@@ -89,13 +89,11 @@ std::string cSpika::Get_XML_Type_Name()
     return "spika";
 }
 
-xmlpp::Element* cSpika::Save_To_XML_Node(xmlpp::Element* p_element)
+void cSpika::Save_To_XML_Node(cXml_Writer& writer)
 {
-    xmlpp::Element* p_node = cEnemy::Save_To_XML_Node(p_element);
+    cEnemy::Save_To_XML_Node(writer);
 
-    Add_Property(p_node, "color", Get_Color_Name(m_color_type));
-
-    return p_node;
+    Add_Property(writer, "color", Get_Color_Name(m_color_type));
 }
 
 void cSpika::Set_Color(DefaultColor col)
@@ -316,13 +314,13 @@ void cSpika::Handle_Collision_Player(cObjectCollision* collision)
 
 void cSpika::Handle_Collision_Enemy(cObjectCollision* collision)
 {
+    cEnemy* enemy = static_cast<cEnemy*>(m_sprite_manager->Get_Sprite(collision->m_handle));
+
     // invalid
-    if (collision->m_number < 0) {
+    if (!enemy) {
         return;
     }
 
-    cEnemy* enemy = static_cast<cEnemy*>(m_sprite_manager->Get_Pointer(collision->m_number));
-
     // already dead
     if (enemy->m_dead) {
         return;
@@ -391,7 +389,7 @@ void cSpika::Handle_Collision_Massive(cObjectCollision* collision)
     Send_Collision(collision);
 
     // get colliding object
-    cSprite* col_object = m_sprite_manager->Get_Pointer(collision->m_number);
+    cSprite* col_object = m_sprite_manager->Get_Sprite(collision->m_handle);
 
     if (col_object->m_type == TYPE_BALL) {
         return;
@@ -64,7 +64,7 @@ cSpikeball::~cSpikeball(void)
 void cSpikeball::Init(void)
 {
     m_type = TYPE_SPIKEBALL;
-    m_name = "Spikeball";
+    Editor_Data().m_name = "Spikeball";
     m_pos_z = 0.09f;
     m_gravity_max = 29.0f;
 
@@ -94,14 +94,12 @@ std::string cSpikeball::Get_XML_Type_Name()
     return "spikeball";
 }
 
-xmlpp::Element* cSpikeball::Save_To_XML_Node(xmlpp::Element* p_element)
+void cSpikeball::Save_To_XML_Node(cXml_Writer& writer)
 {
-    xmlpp::Element* p_node = cEnemy::Save_To_XML_Node(p_element);
+    cEnemy::Save_To_XML_Node(writer);
 
-    Add_Property(p_node, "color", Get_Color_Name(m_color_type));
-    Add_Property(p_node, "direction", Get_Direction_Name(m_start_direction));
-
-    return p_node;
+    Add_Property(writer, "color", Get_Color_Name(m_color_type));
+    Add_Property(writer, "direction", Get_Direction_Name(m_start_direction));
 }
 
 void cSpikeball::Load_From_Savegame(cSave_Level_Object* save_object)
@@ -223,6 +221,7 @@ void cSpikeball::Set_Moving_State(Moving_state new_state)
     }
 
     m_state = new_state;
+    m_save_dirty = 1;
 
     Update_Velocity_Max();
     // if in the first part of the turn around animation
@@ -455,7 +454,7 @@ void cSpikeball::Handle_Collision_Massive(cObjectCollision* collision)
     Send_Collision(collision);
 
     // get colliding object
-    cSprite* col_object = m_sprite_manager->Get_Pointer(collision->m_number);
+    cSprite* col_object = m_sprite_manager->Get_Sprite(collision->m_handle);
 
     if (col_object->m_type == TYPE_BALL) {
         return;
@@ -58,9 +58,9 @@ cStaticEnemy::cStaticEnemy(XmlAttributes& attributes, cSprite_Manager* sprite_ma
     Set_Rotation_Speed(string_to_float(attributes.fetch("rotation_speed", "-7.5")));
 
     // image
-    m_image_filename = attributes.fetch("image", m_image_filename); // Init sets m_image_filename default
+    Editor_Data().m_image_filename = attributes.fetch("image", Editor_Data().m_image_filename); // Init sets the image filename default
     Clear_Images();
-    Add_Image_Set("main", utf8_to_path(m_image_filename));
+    Add_Image_Set("main", utf8_to_path(Editor_Data().m_image_filename));
     Set_Image_Set("main", true);
 
     // path
@@ -84,7 +84,7 @@ cStaticEnemy::~cStaticEnemy(void)
 void cStaticEnemy::Init(void)
 {
     m_type = TYPE_STATIC_ENEMY;
-    m_name = "Static Enemy";
+    Editor_Data().m_name = "Static Enemy";
     m_pos_z = 0.094f;
     m_can_be_on_ground = 0;
     m_can_be_hit_from_shell = 0;
@@ -92,9 +92,9 @@ void cStaticEnemy::Init(void)
     Set_Rotation_Speed(0.0f);
     Set_Speed(0.0f);
 
-    m_image_filename = "enemy/static/blocks/spike_1/2_grey.png";
+    Editor_Data().m_image_filename = "enemy/static/blocks/spike_1/2_grey.png";
     Clear_Images();
-    Add_Image_Set("main", utf8_to_path(m_image_filename));
+    Add_Image_Set("main", utf8_to_path(Editor_Data().m_image_filename));
     Set_Image_Set("main", true);
 }
 
@@ -109,8 +109,8 @@ cStaticEnemy* cStaticEnemy::Copy(void) const
     cStaticEnemy* static_enemy = new cStaticEnemy(m_sprite_manager);
     static_enemy->Set_Pos(m_start_pos_x, m_start_pos_y, 1);
     static_enemy->Clear_Images();
-    static_enemy->m_image_filename = m_image_filename;
-    static_enemy->Add_Image_Set("main", utf8_to_path(m_image_filename));
+    static_enemy->Editor_Data().m_image_filename = Editor_Data().m_image_filename;
+    static_enemy->Add_Image_Set("main", utf8_to_path(Editor_Data().m_image_filename));
     static_enemy->Set_Image_Set("main", true);
     static_enemy->Set_Rotation_Speed(m_rotation_speed);
     static_enemy->Set_Path_Identifier(m_path_state.m_path_identifier);
@@ -125,18 +125,15 @@ std::string cStaticEnemy::Get_XML_Type_Name()
     return "static";
 }
 
-xmlpp::Element* cStaticEnemy::Save_To_XML_Node(xmlpp::Element* p_element)
+void cStaticEnemy::Save_To_XML_Node(cXml_Writer& writer)
 {
-    xmlpp::Element* p_node = cEnemy::Save_To_XML_Node(p_element);
+    cEnemy::Save_To_XML_Node(writer);
 
-    Replace_Property(p_node, "image", m_image_filename);
-    Add_Property(p_node, "rotation_speed", m_rotation_speed);
-    Add_Property(p_node, "path", m_path_state.m_path_identifier);
-    Add_Property(p_node, "speed", m_speed);
-    Add_Property(p_node, "fire_resistant", m_fire_resistant); // sic! fire_resistant!
-    Add_Property(p_node, "ice_resistance", m_ice_resistance);
-
-    return p_node;
+    Add_Property(writer, "rotation_speed", m_rotation_speed);
+    Add_Property(writer, "path", m_path_state.m_path_identifier);
+    Add_Property(writer, "speed", m_speed);
+    Add_Property(writer, "fire_resistant", m_fire_resistant); // sic! fire_resistant!
+    Add_Property(writer, "ice_resistance", m_ice_resistance);
 }
 
 
@@ -152,11 +149,11 @@ void cStaticEnemy::Load_From_Savegame(cSave_Level_Object* save_object)
     m_path_state.Load_From_Savegame(save_object);
 }
 
-bool cStaticEnemy::Save_To_Savegame_XML_Node(xmlpp::Element* p_element) const
+bool cStaticEnemy::Save_To_Savegame_XML_Node(cXml_Writer& writer) const
 {
-    cEnemy::Save_To_Savegame_XML_Node(p_element);
+    cEnemy::Save_To_Savegame_XML_Node(writer);
 
-    m_path_state.Save_To_Savegame_XML_Node(p_element);
+    m_path_state.Save_To_Savegame_XML_Node(writer);
 
     return true;
 }
@@ -206,18 +203,20 @@ void cStaticEnemy::Update(void)
         Add_Rotation_Z(m_rotation_speed * pFramerate->m_speed_factor);
     }
 
-    if (m_path_state.m_path) {
+    cPath* path = m_path_state.Get_Path();
+
+    if (path) {
         // move along path
         if (m_path_state.Path_Move(m_speed * pFramerate->m_speed_factor) == 0) {
-            if (!m_path_state.m_path->m_rewind) {
+            if (!path->m_rewind) {
                 // if we can not move further along the path, reverse the direction
                 m_path_state.Move_Toggle();
             }
         }
 
         // get difference
-        float diff_x = (m_path_state.m_path->m_start_pos_x + m_path_state.m_pos_x) - m_pos_x;
-        float diff_y = (m_path_state.m_path->m_start_pos_y + m_path_state.m_pos_y) - m_pos_y;
+        float diff_x = (path->m_start_pos_x + m_path_state.m_pos_x) - m_pos_x;
+        float diff_y = (path->m_start_pos_y + m_path_state.m_pos_y) - m_pos_y;
 
         // move to position
         Set_Velocity(diff_x, diff_y);
@@ -287,13 +286,13 @@ void cStaticEnemy::Handle_Collision_Player(cObjectCollision* collision)
 
 void cStaticEnemy::Handle_Collision_Enemy(cObjectCollision* collision)
 {
+    cEnemy* enemy = static_cast<cEnemy*>(m_sprite_manager->Get_Sprite(collision->m_handle));
+
     // invalid
-    if (collision->m_number < 0) {
+    if (!enemy) {
         return;
     }
 
-    cEnemy* enemy = static_cast<cEnemy*>(m_sprite_manager->Get_Pointer(collision->m_number));
-
     // already dead
     if (enemy->m_dead) {
         return;
@@ -314,7 +313,7 @@ void cStaticEnemy::Editor_Activate(void)
     CEGUI::Editbox* editbox = static_cast<CEGUI::Editbox*>(wmgr.createWindow("TSCLook256/Editbox", "editor_static_enemy_image"));
     pLevel_Editor->Add_Config_Widget(UTF8_("Image"), UTF8_("Image filename"), editbox);
 
-    editbox->setText(m_image_filename.c_str());
+    editbox->setText(Editor_Data().m_image_filename.c_str());
     editbox->subscribeEvent(CEGUI::Editbox::EventTextChanged, CEGUI::Event::Subscriber(&cStaticEnemy::Editor_Image_Text_Changed, this));
 
     // rotation speed
@@ -374,8 +373,8 @@ bool cStaticEnemy::Editor_Image_Text_Changed(const CEGUI::EventArgs& event)
     std::string str_text = static_cast<CEGUI::Editbox*>(windowEventArgs.window)->getText().c_str();
 
     Clear_Images();
-    m_image_filename = str_text;
-    Add_Image_Set("main", utf8_to_path(m_image_filename));
+    Editor_Data().m_image_filename = str_text;
+    Add_Image_Set("main", utf8_to_path(Editor_Data().m_image_filename));
     Set_Image_Set("main", true);
 
     return 1;
@@ -442,7 +441,7 @@ bool cStaticEnemy::Editor_Ice_Resistance_Text_Changed(const CEGUI::EventArgs& ev
 
 std::string cStaticEnemy::Create_Name(void) const
 {
-    std::string name = m_name; // dup
+    std::string name = Editor_Data().m_name; // dup
 
     if (m_start_image && !m_start_image->m_name.empty()) {
         name += " " + m_start_image->m_name;
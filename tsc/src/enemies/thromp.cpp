@@ -79,7 +79,7 @@ cThromp::~cThromp(void)
 void cThromp::Init(void)
 {
     m_type = TYPE_THROMP;
-    m_name = "Thromp";
+    Editor_Data().m_name = "Thromp";
     m_pos_z = 0.093f;
     m_camera_range = 1000;
     m_can_be_on_ground = 0;
@@ -114,16 +114,14 @@ std::string cThromp::Get_XML_Type_Name()
     return "thromp";
 }
 
-xmlpp::Element* cThromp::Save_To_XML_Node(xmlpp::Element* p_element)
+void cThromp::Save_To_XML_Node(cXml_Writer& writer)
 {
-    xmlpp::Element* p_node = cEnemy::Save_To_XML_Node(p_element);
+    cEnemy::Save_To_XML_Node(writer);
 
-    Add_Property(p_node, "image_dir", path_to_utf8(m_img_dir));
-    Add_Property(p_node, "direction", Get_Direction_Name(m_start_direction));
-    Add_Property(p_node, "max_distance", static_cast<int>(m_max_distance));
-    Add_Property(p_node, "speed", m_speed);
-
-    return p_node;
+    Add_Property(writer, "image_dir", path_to_utf8(m_img_dir));
+    Add_Property(writer, "direction", Get_Direction_Name(m_start_direction));
+    Add_Property(writer, "max_distance", static_cast<int>(m_max_distance));
+    Add_Property(writer, "speed", m_speed);
 }
 
 void cThromp::Load_From_Savegame(cSave_Level_Object* save_object)
@@ -141,13 +139,13 @@ void cThromp::Load_From_Savegame(cSave_Level_Object* save_object)
     }
 }
 
-bool cThromp::Save_To_Savegame_XML_Node(xmlpp::Element* p_element) const
+bool cThromp::Save_To_Savegame_XML_Node(cXml_Writer& writer) const
 {
-    cEnemy::Save_To_Savegame_XML_Node(p_element);
+    cEnemy::Save_To_Savegame_XML_Node(writer);
 
     // move_back ( only save if needed )
     if (m_move_back) {
-        Add_Property(p_element, "move_back", int_to_string(m_move_back));
+        Add_Property(writer, "move_back", int_to_string(m_move_back));
     }
 
     return true;
@@ -613,7 +611,7 @@ void cThromp::Handle_Collision_Enemy(cObjectCollision* collision)
     if (collision->m_direction == m_direction) {
         // if active
         if (m_state == STA_FLY) {
-            cEnemy* enemy = static_cast<cEnemy*>(m_sprite_manager->Get_Pointer(collision->m_number));
+            cEnemy* enemy = static_cast<cEnemy*>(m_sprite_manager->Get_Sprite(collision->m_handle));
 
             // enemies that only hit us
             if (enemy->m_type == TYPE_SPIKEBALL) {
@@ -642,7 +640,7 @@ void cThromp::Handle_Collision_Massive(cObjectCollision* collision)
 {
     Send_Collision(collision);
 
-    cSprite* col_obj = m_sprite_manager->Get_Pointer(collision->m_number);
+    cSprite* col_obj = m_sprite_manager->Get_Sprite(collision->m_handle);
 
     // ignore ball
     if (col_obj->m_type == TYPE_BALL) {
@@ -754,7 +752,7 @@ bool cThromp::Editor_Speed_Text_Changed(const CEGUI::EventArgs& event)
 
 std::string cThromp::Create_Name(void) const
 {
-    std::string name = m_name; // dup
+    std::string name = Editor_Data().m_name; // dup
     name += " ";
     name += _(Get_Direction_Name(m_start_direction).c_str());
 
@@ -24,6 +24,11 @@
 #include "../overworld/overworld.hpp"
 #include "../objects/bonusbox.hpp"
 #include "../scene/scene.hpp"
+#include "../scripting/events/event.hpp"
+#include "../video/img_manager.hpp"
+#include "../video/video.hpp"
+#include "../video/renderer.hpp"
+#include "../user/preferences.hpp"
 #include "debug_window.hpp"
 
 // extern
@@ -106,6 +111,40 @@ void cDebug_Window::Update()
              pFramerate->m_fps);
     mp_debugwin_root->getChild("fps")->setText(reinterpret_cast<const CEGUI::utf8*>(buf));
 
+    // Frame time percentiles and missed fps limit deadlines of the last second
+    snprintf(buf,
+             4096,
+             _("Frame time p50: %.1f ms p95: %.1f ms p99: %.1f ms Missed: %u (total %u)"),
+             pFramerate->m_frame_time_p50 / 1000.0f,
+             pFramerate->m_frame_time_p95 / 1000.0f,
+             pFramerate->m_frame_time_p99 / 1000.0f,
+             pFramerate->m_missed_deadlines_last,
+             pFramerate->m_missed_deadlines_total);
+    mp_debugwin_root->getChild("frame_times")->setText(reinterpret_cast<const CEGUI::utf8*>(buf));
+
+#ifdef ENABLE_ALLOC_COUNTER
+    // Allocations and the performance timer section with the most
+    unsigned int top_section = 0;
+    for (unsigned int i = 1; i < pFramerate->m_perf_timer.size(); i++) {
+        if (pFramerate->m_perf_timer[i]->allocs > pFramerate->m_perf_timer[top_section]->allocs) {
+            top_section = i;
+        }
+    }
+
+    snprintf(buf,
+             4096,
+             _("Allocations/frame: %u (%.1f KiB) all threads: %u most in %s: %u (%.1f KiB)"),
+             pFramerate->m_frame_allocs,
+             pFramerate->m_frame_alloc_bytes / 1024.0f,
+             pFramerate->m_frame_total_allocs,
+             Get_Performance_Timer_Name(static_cast<performance_timer_type>(top_section)),
+             pFramerate->m_perf_timer[top_section]->allocs,
+             pFramerate->m_perf_timer[top_section]->alloc_bytes / 1024.0f);
+#else
+    snprintf(buf, 4096, _("Allocations/frame: <not counted in this build>"));
+#endif
+    mp_debugwin_root->getChild("allocations")->setText(reinterpret_cast<const CEGUI::utf8*>(buf));
+
     snprintf(buf,
              4096,
              _("Camera X: %d Y: %d"),
@@ -180,6 +219,16 @@ void cDebug_Window::Update()
              moving_platforms);
     mp_debugwin_root->getChild("objectcount2")->setText(reinterpret_cast<const CEGUI::utf8*>(buf));
 
+    // Size of the sprite base class, subclasses add their own members
+    snprintf(buf,
+             4096,
+             _("Sprite: %u + %u bytes editor data, %u KiB, update: %u us"),
+             static_cast<unsigned int>(sizeof(cSprite)),
+             static_cast<unsigned int>(sizeof(cSprite_Editor_Data)),
+             static_cast<unsigned int>((mp_sprite_manager->size() * sizeof(cSprite) + cSprite::s_editor_data_table.Get_Size() * sizeof(cSprite_Editor_Data)) / 1024),
+             mp_sprite_manager->m_update_us);
+    mp_debugwin_root->getChild("sprite_memory")->setText(reinterpret_cast<const CEGUI::utf8*>(buf));
+
     snprintf(buf,
              4096,
              _("Player X1: %.4f X2: %.4f"),
@@ -214,4 +263,61 @@ void cDebug_Window::Update()
              _("Game Mode: %d"),
              Game_Mode);
     mp_debugwin_root->getChild("game_mode")->setText(reinterpret_cast<const CEGUI::utf8*>(buf));
+
+    snprintf(buf,
+             4096,
+             _("Events/frame: fired: %u dispatched: %u"),
+             Scripting::cEvent::Get_Fired_Count(),
+             Scripting::cEvent::Get_Dispatched_Count());
+    mp_debugwin_root->getChild("scripting")->setText(reinterpret_cast<const CEGUI::utf8*>(buf));
+
+    if (pActive_Level && pActive_Level->m_mruby) {
+        Scripting::cMRuby_Interpreter* p_mruby = pActive_Level->m_mruby;
+        snprintf(buf,
+                 4096,
+                 _("GC: heap pages: %u live: %u step: %u us protected: %u"),
+                 p_mruby->Get_GC_Heap_Pages(),
+                 p_mruby->Get_GC_Live_Objects(),
+                 p_mruby->Get_GC_Step_Time(),
+                 p_mruby->Get_GC_Protected_Count());
+    }
+    else {
+        snprintf(buf, 4096, _("GC: <no interpreter>"));
+    }
+    mp_debugwin_root->getChild("scripting_gc")->setText(reinterpret_cast<const CEGUI::utf8*>(buf));
+
+    // Texture memory
+    snprintf(buf,
+             4096,
+             _("Textures: %u MiB / %u MiB budget, %u loaded, %u evicted"),
+             static_cast<unsigned int>(cGL_Texture::Get_Total_Bytes() / (1024 * 1024)),
+             pPreferences->m_video_texture_budget,
+             static_cast<unsigned int>(cGL_Texture::Get_Count()),
+             pImage_Manager->m_evicted_textures);
+    mp_debugwin_root->getChild("textures")->setText(reinterpret_cast<const CEGUI::utf8*>(buf));
+
+    // Sprite batching
+    if (pVideo->m_sprite_batch.Is_Active()) {
+        snprintf(buf,
+                 4096,
+                 _("Sprites: %u in %u draw calls"),
+                 pVideo->m_sprite_batch.Get_Quad_Count(),
+                 pVideo->m_sprite_batch.Get_Draw_Calls());
+    }
+    else {
+        snprintf(buf, 4096, _("Sprites: <fixed-function pipeline>"));
+    }
+    mp_debugwin_root->getChild("sprites")->setText(reinterpret_cast<const CEGUI::utf8*>(buf));
+
+    // Overdraw as multiples of the screen
+    const float screen_area = static_cast<float>(pPreferences->m_video_screen_w * pPreferences->m_video_screen_h);
+    snprintf(buf,
+             4096,
+             _("Overdraw: opaque: %u %.2fx translucent: %u %.2fx drawn: %.2fx"),
+             pRenderer->m_opaque_count,
+             pRenderer->m_opaque_area / screen_area,
+             pRenderer->m_translucent_count,
+             pRenderer->m_translucent_area / screen_area,
+             pVideo->m_overdraw_samples / screen_area);
+    mp_debugwin_root->getChild("overdraw")->setText(reinterpret_cast<const CEGUI::utf8*>(buf));
 }
@@ -420,7 +420,7 @@ void cMenuCore::Load(const MenuID menu /* = MENU_MAIN */, const GameMode exit_ga
     pMouseCursor->Double_Click(0);
 
     // default background color to white
-    glClearColor(1, 1, 1, 1);
+    pVideo->Set_Clear_Color(white);
 
     // Set ID
     m_menu_id = menu;
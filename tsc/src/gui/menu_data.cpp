@@ -2663,9 +2663,11 @@ bool cMenu_Options::Video_Button_Apply_Clicked(const CEGUI::EventArgs& event)
     // Hide options menu
     p_options_root->hide();
 
-    CEGUI::System::getSingleton().renderAllGUIContexts();
-    pRenderer->Render();
-    pVideo->mp_window->display();
+    pVideo->m_render_thread.Run([]() {
+        CEGUI::System::getSingleton().renderAllGUIContexts();
+        pRenderer->Render();
+        pVideo->mp_window->display();
+    });
 
     // apply new settings
     pPreferences->Apply_Video(m_vid_w, m_vid_h, m_vid_bpp, m_vid_fullscreen, m_vid_vsync, m_vid_geometry_detail, m_vid_texture_detail);
@@ -3418,7 +3420,7 @@ void cMenu_Credits::Init_GUI(void)
 void cMenu_Credits::Enter(const GameMode old_mode /* = MODE_NOTHING */)
 {
     // black background because of fade alpha
-    glClearColor(0, 0, 0, 1);
+    pVideo->Set_Clear_Color(black);
 
     if (old_mode == MODE_MENU) {
         // fade in
@@ -3433,7 +3435,7 @@ void cMenu_Credits::Leave(const GameMode next_mode /* = MODE_NOTHING */)
         Menu_Fade(0);
 
         // white background
-        glClearColor(1, 1, 1, 1);
+        pVideo->Set_Clear_Color(white);
     }
 
     // set menu gradient colors back
@@ -212,6 +212,17 @@ bool cKeyboard::Key_Down(const sf::Event& evt)
             gp_hud->Set_Text("Fixed speed factor enabled");
         }
     }
+    // toggle capturing every second frame
+    else if (evt.key.code == pPreferences->m_key_screenshot && evt.key.control) {
+        if (pVideo->m_screen_capture.Is_Capturing()) {
+            pVideo->m_screen_capture.Stop_Capture();
+            gp_hud->Set_Text("Frame capture stopped");
+        }
+        else {
+            pVideo->m_screen_capture.Start_Capture(2);
+            gp_hud->Set_Text("Frame capture started");
+        }
+    }
     // take a screenshot
     else if (evt.key.code == pPreferences->m_key_screenshot) {
         pVideo->Save_Screenshot();
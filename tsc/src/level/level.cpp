@@ -60,9 +60,11 @@
 #include "../core/filesystem/filesystem.hpp"
 #include "../core/filesystem/resource_manager.hpp"
 #include "../core/filesystem/relative.hpp"
+#include "../core/filesystem/file_writer.hpp"
 #include "../overworld/world_editor.hpp"
 #include "../scripting/events/key_down_event.hpp"
 #include "../scripting/objects/misc/mrb_timer.hpp"
+#include "../scripting/interpreter_pool.hpp"
 #include "../core/global_basic.hpp"
 
 namespace fs = boost::filesystem;
@@ -204,6 +206,10 @@ cLevel* cLevel::Load_From_File(fs::path filename)
 {
     if (filename.empty())
         throw(InvalidLevelError("Empty level filename!"));
+
+    // the file may still be written
+    pFile_Writer->Wait();
+
     if (!File_Exists(filename)) {
         std::string msg = "Level file not found: " + path_to_utf8(filename);
         throw (InvalidLevelError(msg));
@@ -232,6 +238,8 @@ cLevel* cLevel::Load_From_File(fs::path filename)
         cSprite* obj = (*itr);
 
         obj->Init_Links();
+        // only changes made while playing are saved in savegames
+        obj->Set_Save_Dirty(0);
     }
 
     debug_print("Loaded level: %s\n", path_to_utf8(p_level->m_level_filename).c_str());
@@ -283,8 +291,11 @@ void cLevel::Unload(bool delayed /* = 0 */)
      * startup screen) has not been Init()ialized and hence has no mruby
      * interpreter attached. Therefore we need to check the existance
      * of the mruby interpreter here. */
-    if (m_mruby)
-        delete m_mruby;
+    if (m_mruby) {
+        m_sprite_manager->Set_MRuby(NULL);
+        pMRuby_Pool->Release(m_mruby);
+        m_mruby = NULL;
+    }
 
     /* delete sprites
      * do this at last
@@ -292,59 +303,52 @@ void cLevel::Unload(bool delayed /* = 0 */)
     m_sprite_manager->Delete_All();
 }
 
-fs::path cLevel::Save_To_File(fs::path filename /* = fs::path() */)
+fs::path cLevel::Save_To_File(fs::path filename /* = fs::path() */, const std::string& done_text /* = std::string() */, const std::string& failed_text /* = std::string() */)
 {
-    xmlpp::Document doc;
-    xmlpp::Element* p_root = doc.create_root_node("level");
-    xmlpp::Element* p_node = NULL;
+    cXml_Writer writer;
+    writer.Start_Element("level");
 
     // <information>
-#ifdef USE_LIBXMLPP3
-    p_node = p_root->add_child_element("information");
-#else
-    p_node = p_root->add_child("information");
-#endif
-    Add_Property(p_node, "game_version", int_to_string(TSC_VERSION_MAJOR) + "." + int_to_string(TSC_VERSION_MINOR) + "." + int_to_string(TSC_VERSION_PATCH));
-    Add_Property(p_node, "engine_version", level_engine_version);
-    Add_Property(p_node, "save_time", static_cast<uint64_t>(time(NULL)));
+    writer.Start_Element("information");
+    Add_Property(writer, "game_version", int_to_string(TSC_VERSION_MAJOR) + "." + int_to_string(TSC_VERSION_MINOR) + "." + int_to_string(TSC_VERSION_PATCH));
+    Add_Property(writer, "engine_version", level_engine_version);
+    Add_Property(writer, "save_time", static_cast<uint64_t>(time(NULL)));
+    writer.End_Element();
     // </information>
 
     // <settings>
-#ifdef USE_LIBXMLPP3
-    p_node = p_root->add_child_element("settings");
-#else
-    p_node = p_root->add_child("settings");
-#endif
-    Add_Property(p_node, "lvl_author", m_author);
-    Add_Property(p_node, "lvl_version", m_version);
-    Add_Property(p_node, "lvl_music", Get_Music_Filename().generic_string());
-    Add_Property(p_node, "lvl_description", m_description);
-    Add_Property(p_node, "lvl_difficulty", static_cast<int>(m_difficulty));
-    Add_Property(p_node, "lvl_land_type", Get_Level_Land_Type_Name(m_land_type));
-    Add_Property(p_node, "cam_limit_x", static_cast<int>(m_camera_limits.m_x));
-    Add_Property(p_node, "cam_limit_y", static_cast<int>(m_camera_limits.m_y));
-    Add_Property(p_node, "cam_limit_w", static_cast<int>(m_camera_limits.m_w));
-    Add_Property(p_node, "cam_limit_h", static_cast<int>(m_camera_limits.m_h));
-    Add_Property(p_node, "cam_fixed_hor_vel", m_fixed_camera_hor_vel);
-    Add_Property(p_node, "unload_after_exit", m_unload_after_exit ? 1 : 0);
+    writer.Start_Element("settings");
+    Add_Property(writer, "lvl_author", m_author);
+    Add_Property(writer, "lvl_version", m_version);
+    Add_Property(writer, "lvl_music", Get_Music_Filename().generic_string());
+    Add_Property(writer, "lvl_description", m_description);
+    Add_Property(writer, "lvl_difficulty", static_cast<int>(m_difficulty));
+    Add_Property(writer, "lvl_land_type", Get_Level_Land_Type_Name(m_land_type));
+    Add_Property(writer, "cam_limit_x", static_cast<int>(m_camera_limits.m_x));
+    Add_Property(writer, "cam_limit_y", static_cast<int>(m_camera_limits.m_y));
+    Add_Property(writer, "cam_limit_w", static_cast<int>(m_camera_limits.m_w));
+    Add_Property(writer, "cam_limit_h", static_cast<int>(m_camera_limits.m_h));
+    Add_Property(writer, "cam_fixed_hor_vel", m_fixed_camera_hor_vel);
+    Add_Property(writer, "unload_after_exit", m_unload_after_exit ? 1 : 0);
+    writer.End_Element();
     // </settings>
 
     // backgrounds
     vector<cBackground*>::iterator iter;
     for (iter=m_background_manager->objects.begin(); iter != m_background_manager->objects.end(); iter++)
-        (*iter)->Save_To_XML_Node(p_root);
+        (*iter)->Save_To_XML_Node(writer);
 
     // <player>
-#ifdef USE_LIBXMLPP3
-    p_node = p_root->add_child_element("player");
-#else
-    p_node = p_root->add_child("player");
-#endif
-    Add_Property(p_node, "posx", static_cast<int>(pLevel_Player->m_start_pos_x));
-    Add_Property(p_node, "posy", static_cast<int>(pLevel_Player->m_start_pos_y));
-    Add_Property(p_node, "direction", Get_Direction_Name(pLevel_Player->m_start_direction));
+    writer.Start_Element("player");
+    Add_Property(writer, "posx", static_cast<int>(pLevel_Player->m_start_pos_x));
+    Add_Property(writer, "posy", static_cast<int>(pLevel_Player->m_start_pos_y));
+    Add_Property(writer, "direction", Get_Direction_Name(pLevel_Player->m_start_direction));
+    writer.End_Element();
     // </player>
 
+    // in the array order of the editor
+    m_sprite_manager->Compact();
+
     cSprite_List::iterator iter2;
     for (iter2=m_sprite_manager->objects.begin(); iter2 != m_sprite_manager->objects.end(); iter2++) {
         cSprite* p_obj = *iter2;
@@ -354,23 +358,24 @@ fs::path cLevel::Save_To_File(fs::path filename /* = fs::path() */)
             continue;
 
         // save to XML node
-        p_obj->Save_To_XML_Node(p_root);
+        writer.Start_Element(p_obj->m_type_name);
+        p_obj->Save_To_XML_Node(writer);
+        writer.End_Element();
     }
 
     // MRuby script code
     // <script>
-#ifdef USE_LIBXMLPP3
-    p_node = p_root->add_child_element("script");
-    p_node->add_child_text(m_script);
-#else
-    p_node = p_root->add_child("script");
-    p_node->add_child_text(m_script);
-#endif
+    writer.Start_Element("script");
+    writer.Add_Text(m_script);
+    writer.End_Element();
     // </script>
 
-    // Write to file (raises xmlpp::exception on write error)
-    doc.write_to_file_formatted(Glib::filename_from_utf8(path_to_utf8(filename)));
-    debug_print("Wrote level file '%s'.\n", path_to_utf8(filename).c_str());
+    writer.End_Element();
+
+    /* Only the serialized data is handed over, so the level can change
+     * while the file is written. The messages are shown by Update_Game().
+    */
+    pFile_Writer->Write(filename, writer.Get_Data(), done_text, failed_text);
 
     return filename;
 }
@@ -393,33 +398,28 @@ void cLevel::Save(void)
     fs::path tsc_level_filename = m_level_filename;
     tsc_level_filename.replace_extension(".tsclvl");
 
-    try {
-        Save_To_File(tsc_level_filename);
-    }
-    catch (xmlpp::exception& e) {
-        cerr << "Error: Couldn't save level file: " << e.what() << endl;
-        cerr << "Is the file read-only?" << endl;
-        gp_hud->Set_Text(_("Couldn't save level ") + path_to_utf8(m_level_filename));
+    // shown when the file is written
+    std::string done_text = _("Level ") + path_to_utf8(Trim_Filename(tsc_level_filename, false, false)) + _(" saved");
+    std::string failed_text = _("Couldn't save level ") + path_to_utf8(tsc_level_filename);
 
-        // Abort
-        return;
-    }
+    Save_To_File(tsc_level_filename, done_text, failed_text);
 
     //If the file originally had .smclvl for the extension and if the .tsclvl save was successful, remove the old
     //.smclvl file.
     if (m_level_filename.extension().string() == ".smclvl") {
+        pFile_Writer->Wait();
+
         if (fs::exists(m_level_filename) && fs::exists(tsc_level_filename)) {
             fs::remove(m_level_filename);
         }
         m_level_filename.replace_extension(".tsclvl");
     }
-
-    // Display nice completion message
-    gp_hud->Set_Text(_("Level ") + path_to_utf8(Trim_Filename(m_level_filename, false, false)) + _(" saved"));
 }
 
 void cLevel::Delete(void)
 {
+    // a pending save would create it again
+    pFile_Writer->Wait();
     fs::remove(m_level_filename);
     Unload();
 }
@@ -570,6 +570,9 @@ void cLevel::Leave(const GameMode next_mode /* = MODE_NOTHING */)
     }
 
     Pause_All_Timers();
+    // nothing is drawn while away, a good time for a complete GC
+    if (m_mruby)
+        m_mruby->Full_GC();
 
     // reset camera limits
     pLevel_Manager->m_camera->Reset_Limits();
@@ -613,6 +616,9 @@ void cLevel::Update(void)
         //Load( path_to_utf8(m_next_level_filename) );
     }
 
+    // delete removed objects before anything iterates them
+    m_sprite_manager->Compact();
+
     // if level-editor is not active
     if (!editor_level_enabled) {
         // backgrounds
@@ -1170,16 +1176,23 @@ void cLevel::Reinitialize_MRuby_Interpreter()
 
     // Delete any currently existing incarnation of an mruby
     // stack and completely annihilate it.
-    if (m_mruby)
-        delete m_mruby;
+    if (m_mruby) {
+        m_sprite_manager->Set_MRuby(NULL);
+        pMRuby_Pool->Release(m_mruby);
+    }
 
     // Initialize an mruby interpreter for this level. Each level has its own mruby
     // interpreter to prevent unintended object exchange between levels.
-    m_mruby = new Scripting::cMRuby_Interpreter(this);
+    m_mruby = pMRuby_Pool->Acquire(this);
+    // removed sprites are deleted from its UID cache
+    m_sprite_manager->Set_MRuby(m_mruby);
 
     // Run the mruby code associated with this level (this sets up
     // all the event handlers the user wants to register)
     m_mruby->Run_Code(m_script, "(level script)");
+
+    // Still loading, so clean up now what loading left behind
+    m_mruby->Full_GC();
 }
 
 void cLevel::Pause_All_Timers(bool pause)
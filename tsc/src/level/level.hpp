@@ -51,8 +51,9 @@ namespace TSC {
         void Unload(bool delayed = 0);
 
         // Save the level to a file as XML.
-        // Raises xmlpp::exception on failure to write the XML file.
-        boost::filesystem::path Save_To_File(boost::filesystem::path filename = boost::filesystem::path());
+        // The file is written in the background by pFile_Writer,
+        // which shows done_text or failed_text when finished.
+        boost::filesystem::path Save_To_File(boost::filesystem::path filename = boost::filesystem::path(), const std::string& done_text = std::string(), const std::string& failed_text = std::string());
 
         // Save the Level
         void Save(void);
@@ -101,49 +101,45 @@ void cBackground::Load_From_Attributes(XmlAttributes& attributes)
     }
 }
 
-void cBackground::Save_To_XML_Node(xmlpp::Element* p_parent)
+void cBackground::Save_To_XML_Node(cXml_Writer& writer)
 {
     if (m_type == BG_NONE)
         return;
 
     // <background>
-#ifdef USE_LIBXMLPP3
-    xmlpp::Element* p_node = p_parent->add_child_element("background");
-    Add_Property(p_node, "type", m_type);
-#else
-    xmlpp::Element* p_node = p_parent->add_child("background");
-    Add_Property(p_node, "type", m_type);
-#endif
+    writer.Start_Element("background");
+    Add_Property(writer, "type", m_type);
 
     // gradient
     if (m_type == BG_GR_HOR || m_type == BG_GR_VER) {
         // background color 1
-        Add_Property(p_node, "bg_color_1_red", static_cast<int>(m_color_1.red));
-        Add_Property(p_node, "bg_color_1_green", static_cast<int>(m_color_1.green));
-        Add_Property(p_node, "bg_color_1_blue", static_cast<int>(m_color_1.blue));
+        Add_Property(writer, "bg_color_1_red", static_cast<int>(m_color_1.red));
+        Add_Property(writer, "bg_color_1_green", static_cast<int>(m_color_1.green));
+        Add_Property(writer, "bg_color_1_blue", static_cast<int>(m_color_1.blue));
         // background color 2
-        Add_Property(p_node, "bg_color_2_red", static_cast<int>(m_color_2.red));
-        Add_Property(p_node, "bg_color_2_green", static_cast<int>(m_color_2.green));
-        Add_Property(p_node, "bg_color_2_blue", static_cast<int>(m_color_2.blue));
+        Add_Property(writer, "bg_color_2_red", static_cast<int>(m_color_2.red));
+        Add_Property(writer, "bg_color_2_green", static_cast<int>(m_color_2.green));
+        Add_Property(writer, "bg_color_2_blue", static_cast<int>(m_color_2.blue));
     }
     // image
     else if (m_type == BG_IMG_BOTTOM || m_type == BG_IMG_TOP || m_type == BG_IMG_ALL) {
         // position
-        Add_Property(p_node, "posx", m_start_pos_x);
-        Add_Property(p_node, "posy", m_start_pos_y);
-        Add_Property(p_node, "posz", m_pos_z);
+        Add_Property(writer, "posx", m_start_pos_x);
+        Add_Property(writer, "posy", m_start_pos_y);
+        Add_Property(writer, "posz", m_pos_z);
 
         // image filename
-        Add_Property(p_node, "image", path_to_utf8(m_image_1_filename));
+        Add_Property(writer, "image", path_to_utf8(m_image_1_filename));
         // speed
-        Add_Property(p_node, "speedx", m_speed_x);
-        Add_Property(p_node, "speedy", m_speed_y);
+        Add_Property(writer, "speedx", m_speed_x);
+        Add_Property(writer, "speedy", m_speed_y);
         // constant velocity
-        Add_Property(p_node, "const_velx", m_const_vel_x);
-        Add_Property(p_node, "const_vely", m_const_vel_y);
+        Add_Property(writer, "const_velx", m_const_vel_x);
+        Add_Property(writer, "const_vely", m_const_vel_y);
     }
     else
         cerr << "Warning: Detected unknown background type '" << m_type << "' on saving." << endl;
+    writer.End_Element();
     // </background>
 }
 
@@ -301,6 +297,18 @@ void cBackground::Draw(void)
             }
         }
 
+        /* one quad repeating the image over the screen width, or the screen if tiled vertically
+         * the tiles are drawn one by one if the texture is padded
+        */
+        if (m_type == BG_IMG_ALL) {
+            if (m_image_1->Blit_Tiled(0.0f, 0.0f, game_res_w, game_res_h, m_pos_z, posx_final, posy_final)) {
+                return;
+            }
+        }
+        else if (m_image_1->Blit_Tiled(0.0f, 0.0f, game_res_w, 0.0f, m_pos_z, posx_final, posy_final, 0)) {
+            return;
+        }
+
         // draw until width is filled
         while (posx_final < game_res_w) {
             // draw horizontal
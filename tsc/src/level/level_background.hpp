@@ -21,6 +21,7 @@
 #include "../video/video.hpp"
 #include "../video/img_set.hpp"
 #include "../core/obj_manager.hpp"
+#include "../core/xml_writer.hpp"
 
 namespace TSC {
 
@@ -52,8 +53,8 @@ namespace TSC {
         // load from stream
         void Load_From_Attributes(XmlAttributes& attributes);
 
-        /// Save this object below the given XML node
-        void Save_To_XML_Node(xmlpp::Element* p_parent);
+        /// Save this object as element of the current element
+        void Save_To_XML_Node(cXml_Writer& writer);
 
         // Set the parent sprite manager
         void Set_Sprite_Manager(cSprite_Manager* sprite_manager);
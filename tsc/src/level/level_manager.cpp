@@ -31,6 +31,7 @@
 #include "../core/global_basic.hpp"
 #include "../gui/hud.hpp"
 #include "../gui/game_console.hpp"
+#include "../user/preferences.hpp"
 
 using namespace std;
 
@@ -241,6 +242,14 @@ void cLevel_Manager::Update(void)
     // update performance timer
     pFramerate->m_perf_timer[PERF_UPDATE_LEVEL]->Update();
 
+    // scripting garbage collection ( after the timer callbacks ran, also in the editor )
+    if (pActive_Level->m_mruby) {
+        pActive_Level->m_mruby->Step_GC(pPreferences->m_scripting_gc_budget);
+    }
+
+    // update performance timer
+    pFramerate->m_perf_timer[PERF_UPDATE_SCRIPTING_GC]->Update();
+
     // editor
     pLevel_Editor->Update();
 
@@ -386,8 +395,10 @@ void cLevel_Manager::Goto_Sub_Level(std::string str_level, const std::string& st
                     // set parent path
                     path_state.Set_Path_Identifier(path_identifier);
 
+                    cPath* path = path_state.Get_Path();
+
                     // path found
-                    if (path_state.m_path) {
+                    if (path) {
                         // forward
                         if (move_camera == CAMERA_MOVE_ALONG_PATH) {
                             path_state.Move_Start_Forward();
@@ -398,8 +409,8 @@ void cLevel_Manager::Goto_Sub_Level(std::string str_level, const std::string& st
                         }
 
                         // start path position
-                        float start_path_pos_x = path_state.m_path->m_col_rect.m_x - (game_res_w * 0.5f);
-                        float start_path_pos_y = path_state.m_path->m_col_rect.m_y - (game_res_h * 0.5f);
+                        float start_path_pos_x = path->m_col_rect.m_x - (game_res_w * 0.5f);
+                        float start_path_pos_y = path->m_col_rect.m_y - (game_res_h * 0.5f);
                         // move gradually to start point
                         pActive_Camera->Move_to_Position_Gradually(start_path_pos_x + path_state.m_pos_x, start_path_pos_y + path_state.m_pos_y, 20);
                         // reset offset
@@ -68,7 +68,7 @@ cLevel_Player::cLevel_Player(cSprite_Manager* sprite_manager)
 
     m_alex_type = ALEX_SMALL;
     m_alex_type_temp_power = ALEX_DEAD;
-    m_name = "Alex";
+    Editor_Data().m_name = "Alex";
 
     m_pos_z = cSprite::m_pos_z_player;
     m_gravity_max = 25.0f;
@@ -3620,7 +3620,7 @@ void cLevel_Player::Handle_Collision_Enemy(cObjectCollision* collision)
         return;
     }
 
-    cEnemy* enemy = static_cast<cEnemy*>(m_sprite_manager->Get_Pointer(collision->m_number));
+    cEnemy* enemy = static_cast<cEnemy*>(m_sprite_manager->Get_Sprite(collision->m_handle));
 
     // if enemy already dead
     if (enemy->m_dead) {
@@ -3749,7 +3749,7 @@ void cLevel_Player::Handle_Collision_Massive(cObjectCollision* collision)
     */
     //printf( "direction is %s\n", Get_Direction_Name( collision->m_direction ).c_str() );
 
-    cSprite* col_obj = m_sprite_manager->Get_Pointer(collision->m_number);
+    cSprite* col_obj = m_sprite_manager->Get_Sprite(collision->m_handle);
 
     // climbable
     if (col_obj->m_massive_type == MASS_CLIMBABLE && m_state != STA_CLIMB && m_state != STA_FLY) {
@@ -3905,7 +3905,7 @@ void cLevel_Player::Handle_Collision_Passive(cObjectCollision* collision)
         return;
     }
 
-    //cSprite *col_obj = m_sprite_manager->Get_Pointer( collision->m_number );
+    //cSprite *col_obj = m_sprite_manager->Get_Sprite( collision->m_handle );
     //printf( "passive %s\n", col_obj->name.c_str() );
 
     // send it
@@ -102,19 +102,17 @@ std::string cBall::Get_XML_Type_Name()
     return "";
 }
 
-xmlpp::Element* cBall::Save_To_XML_Node(xmlpp::Element* p_element)
+void cBall::Save_To_XML_Node(cXml_Writer& writer)
 {
-    xmlpp::Element* p_node = cMovingSprite::Save_To_XML_Node(p_element);
+    cMovingSprite::Save_To_XML_Node(writer);
 
     // direction
-    Add_Property(p_node, "direction", m_direction);
+    Add_Property(writer, "direction", m_direction);
     // origin array and type
-    Add_Property(p_node, "origin_array", m_origin_array);
-    Add_Property(p_node, "origin_type", m_origin_type);
+    Add_Property(writer, "origin_array", m_origin_array);
+    Add_Property(writer, "origin_type", m_origin_type);
     // type
-    Add_Property(p_node, "ball_type", m_ball_type);
-
-    return p_node;
+    Add_Property(writer, "ball_type", m_ball_type);
 }
 
 void cBall::Load_From_Savegame(cSave_Level_Object* save_object)
@@ -388,7 +386,7 @@ void cBall::Handle_Collision_Player(cObjectCollision* collision)
 
 void cBall::Handle_Collision_Enemy(cObjectCollision* collision)
 {
-    cEnemy* enemy = static_cast<cEnemy*>(m_sprite_manager->Get_Pointer(collision->m_number));
+    cEnemy* enemy = static_cast<cEnemy*>(m_sprite_manager->Get_Sprite(collision->m_handle));
 
     // if enemy is not vulnerable
     if ((m_ball_type == FIREBALL_DEFAULT && enemy->m_fire_resistant) || (m_ball_type == ICEBALL_DEFAULT && enemy->m_ice_resistance >= 1)) {
@@ -44,7 +44,7 @@ namespace TSC {
         // Create the MRuby object for this
         virtual mrb_value Create_MRuby_Object(mrb_state* p_state)
         {
-            return mrb_obj_value(Data_Wrap_Struct(p_state, mrb_class_get(p_state, "Ball"), &Scripting::rtTSC_Scriptable, this));
+            return Scripting::Wrap_Sprite(p_state, mrb_class_get(p_state, "Ball"), this);
         }
 
         // set type
@@ -87,7 +87,7 @@ namespace TSC {
         virtual void Handle_out_of_Level(ObjectDirection dir);
 
         // Save below given XML node
-        virtual xmlpp::Element* Save_To_XML_Node(xmlpp::Element* p_element);
+        virtual void Save_To_XML_Node(cXml_Writer& writer);
 
         // origin
         ArrayType m_origin_array;
@@ -76,7 +76,7 @@ void cBonusBox::Init(void)
     Set_Goldcolor(COL_YELLOW);
 
     box_type = TYPE_UNDEFINED;
-    m_name = _("Bonusbox Empty");
+    Editor_Data().m_name = _("Bonusbox Empty");
 
     mp_force_best_item_box = NULL;
     mp_gold_color_box      = NULL;
@@ -108,17 +108,15 @@ void cBonusBox::Load_From_XML(XmlAttributes& attributes)
         Set_Goldcolor(Get_Color_Id(attributes.fetch("gold_color", Get_Color_Name(m_gold_color))));
 }
 
-xmlpp::Element* cBonusBox::Save_To_XML_Node(xmlpp::Element* p_element)
+void cBonusBox::Save_To_XML_Node(cXml_Writer& writer)
 {
-    xmlpp::Element* p_node = cBaseBox::Save_To_XML_Node(p_element);
+    cBaseBox::Save_To_XML_Node(writer);
 
     // force best possible item
-    Add_Property(p_node, "force_best_item", m_force_best_item);
+    Add_Property(writer, "force_best_item", m_force_best_item);
     // gold color
     if (box_type == TYPE_GOLDPIECE)
-        Add_Property(p_node, "gold_color", Get_Color_Name(m_gold_color));
-
-    return p_node;
+        Add_Property(writer, "gold_color", Get_Color_Name(m_gold_color));
 }
 
 void cBonusBox::Set_Useable_Count(int count, bool new_startcount /* = 0 */)
@@ -149,7 +147,7 @@ void cBonusBox::Set_Bonus_Type(SpriteType bonus_type)
     // set item image
     if (box_type == TYPE_UNDEFINED) {
         m_item_image = NULL;
-        m_name = _("Bonusbox Empty");
+        Editor_Data().m_name = _("Bonusbox Empty");
     }
     else if (box_type == TYPE_POWERUP) {
         // force always best item
@@ -158,27 +156,27 @@ void cBonusBox::Set_Bonus_Type(SpriteType bonus_type)
     }
     else if (box_type == TYPE_MUSHROOM_DEFAULT) {
         m_item_image = cImageSet::Fetch_Single_Image("game/items/berry_big.imgset");
-        m_name = _("Bonusbox Berry");
+        Editor_Data().m_name = _("Bonusbox Berry");
     }
     else if (box_type == TYPE_FIREPLANT) {
         m_item_image = cImageSet::Fetch_Single_Image("game/items/berry_fire.imgset");
-        m_name = _("Bonusbox Fire berry");
+        Editor_Data().m_name = _("Bonusbox Fire berry");
     }
     else if (box_type == TYPE_MUSHROOM_BLUE) {
         m_item_image = cImageSet::Fetch_Single_Image("game/items/berry_ice.imgset");
-        m_name = _("Bonusbox Ice berry");
+        Editor_Data().m_name = _("Bonusbox Ice berry");
     }
     else if (box_type == TYPE_MUSHROOM_GHOST) {
         m_item_image = cImageSet::Fetch_Single_Image("game/items/berry_ghost.imgset");
-        m_name = _("Bonusbox Ghost berry");
+        Editor_Data().m_name = _("Bonusbox Ghost berry");
     }
     else if (box_type == TYPE_MUSHROOM_LIVE_1) {
         m_item_image = cImageSet::Fetch_Single_Image("game/items/berry_life.imgset");
-        m_name = _("Bonusbox 1-Up berry");
+        Editor_Data().m_name = _("Bonusbox 1-Up berry");
     }
     else if (box_type == TYPE_STAR) {
         m_item_image = cImageSet::Fetch_Single_Image("game/items/lemon.imgset");
-        m_name = _("Bonusbox Lemon");
+        Editor_Data().m_name = _("Bonusbox Lemon");
     }
     else if (box_type == TYPE_GOLDPIECE) {
         if (m_gold_color == COL_RED) {
@@ -190,7 +188,7 @@ void cBonusBox::Set_Bonus_Type(SpriteType bonus_type)
     }
     else if (box_type == TYPE_MUSHROOM_POISON) {
         m_item_image = cImageSet::Fetch_Single_Image("game/items/berry_poison.imgset");
-        m_name = _("Bonusbox Poisonous berry");
+        Editor_Data().m_name = _("Bonusbox Poisonous berry");
     }
     else {
         m_item_image = NULL;
@@ -216,7 +214,7 @@ void cBonusBox::Set_Goldcolor(DefaultColor new_color)
      * to UNDEFINED (= empty box). When you set the box type to GOLDPIECE,
      * this results in a call to Set_Goldcolor() (this method), but as the
      * goldcolor is already set, it would immediately return. Problem with
-     * this is that m_name doesn’t get adjusted, it will show whatever
+     * this is that Editor_Data().m_name doesn’t get adjusted, it will show whatever
      * the box was previously (usually UNDEFINED => "Bonusbox Empty").
      * The proper solution to this is to divide gold boxes and powerup boxes;
      * it doesn’t make sense to set the gold color on a fireberry box for
@@ -238,11 +236,11 @@ void cBonusBox::Set_Goldcolor(DefaultColor new_color)
 
     if (m_gold_color == COL_YELLOW) {
         m_item_image = cImageSet::Fetch_Single_Image("game/items/goldpiece/yellow/jewel.imgset");
-        m_name = _("Bonusbox Jewel");
+        Editor_Data().m_name = _("Bonusbox Jewel");
     }
     else if (m_gold_color == COL_RED) {
         m_item_image = cImageSet::Fetch_Single_Image("game/items/goldpiece/red/jewel.imgset");
-        m_name = _("Bonusbox Red Jewel");
+        Editor_Data().m_name = _("Bonusbox Red Jewel");
     }
     else {
         cerr << "Warning : Unknown Bonusbox Gold Color " << m_gold_color << endl;
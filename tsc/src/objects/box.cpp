@@ -50,7 +50,7 @@ cBaseBox::cBaseBox(cSprite_Manager* sprite_manager)
     m_type = TYPE_ACTIVE_SPRITE;
     m_sprite_array = ARRAY_ACTIVE;
     m_massive_type = MASS_MASSIVE;
-    m_name = _("Box");
+    Editor_Data().m_name = _("Box");
     m_can_be_ground = 1;
     Set_Scale_Directions(1, 1, 1, 1);
 
@@ -105,23 +105,21 @@ std::string cBaseBox::Get_XML_Type_Name()
     }
 }
 
-xmlpp::Element* cBaseBox::Save_To_XML_Node(xmlpp::Element* p_element)
+void cBaseBox::Save_To_XML_Node(cXml_Writer& writer)
 {
-    xmlpp::Element* p_node = cMovingSprite::Save_To_XML_Node(p_element);
+    cMovingSprite::Save_To_XML_Node(writer);
 
     if (box_type != TYPE_SPIN_BOX && box_type != TYPE_TEXT_BOX) {
         // animation type
-        Add_Property(p_node, "animation", m_anim_type);
+        Add_Property(writer, "animation", m_anim_type);
         // best possible item
-        Add_Property(p_node, "item", box_type);
+        Add_Property(writer, "item", box_type);
     }
 
     // invisible
-    Add_Property(p_node, "invisible", m_box_invisible);
+    Add_Property(writer, "invisible", m_box_invisible);
     // useable count
-    Add_Property(p_node, "useable_count", m_start_useable_count);
-
-    return p_node;
+    Add_Property(writer, "useable_count", m_start_useable_count);
 }
 
 void cBaseBox::Load_From_Savegame(cSave_Level_Object* save_object)
@@ -131,11 +129,11 @@ void cBaseBox::Load_From_Savegame(cSave_Level_Object* save_object)
     Set_Useable_Count(save_useable_count);
 }
 
-bool cBaseBox::Save_To_Savegame_XML_Node(xmlpp::Element* p_element) const
+bool cBaseBox::Save_To_Savegame_XML_Node(cXml_Writer& writer) const
 {
-    cMovingSprite::Save_To_Savegame_XML_Node(p_element);
+    cMovingSprite::Save_To_Savegame_XML_Node(writer);
 
-    Add_Property(p_element, "useable_count", int_to_string(m_useable_count));
+    Add_Property(writer, "useable_count", int_to_string(m_useable_count));
 
     return true;
 }
@@ -192,6 +190,7 @@ void cBaseBox::Set_Animation_Type(const std::string& new_anim_type)
 void cBaseBox::Set_Useable_Count(int count, bool new_startcount /* = 0 */)
 {
     m_useable_count = count;
+    m_save_dirty = 1;
 
     if (new_startcount) {
         m_start_useable_count = m_useable_count;
@@ -634,7 +633,7 @@ void cBaseBox::Handle_Collision_Player(cObjectCollision* collision)
 
 void cBaseBox::Handle_Collision_Enemy(cObjectCollision* collision)
 {
-    cEnemy* enemy = static_cast<cEnemy*>(m_sprite_manager->Get_Pointer(collision->m_number));
+    cEnemy* enemy = static_cast<cEnemy*>(m_sprite_manager->Get_Sprite(collision->m_handle));
 
     // if army
     if (enemy->m_type == TYPE_ARMY || enemy->m_type == TYPE_SHELL) {
@@ -747,7 +746,7 @@ bool cBaseBox::Editor_Invisible_Select(const CEGUI::EventArgs& event)
 
 std::string cBaseBox::Create_Name(void) const
 {
-    std::string name = m_name; // dup
+    std::string name = Editor_Data().m_name; // dup
 
     if (m_box_invisible == BOX_INVISIBLE_MASSIVE) {
         name += " " + std::string(_("(Invisible)"));
@@ -56,7 +56,7 @@ void cCrate::Init()
     m_type = TYPE_CRATE;
     m_sprite_array = ARRAY_ACTIVE;
     m_massive_type = MASS_MASSIVE;
-    m_name = _("Crate");
+    Editor_Data().m_name = _("Crate");
     m_gravity_max = 22.0f;
     m_crate_state = CRATE_STAND;
 
@@ -126,13 +126,11 @@ std::string cCrate::Get_XML_Type_Name()
     return "crate";
 }
 
-xmlpp::Element* cCrate::Save_To_XML_Node(xmlpp::Element* p_element)
+void cCrate::Save_To_XML_Node(cXml_Writer& writer)
 {
-    xmlpp::Element* p_node = cMovingSprite::Save_To_XML_Node(p_element);
+    cMovingSprite::Save_To_XML_Node(writer);
 
     // No configuration currently
-
-    return p_node;
 }
 
 void cCrate::Handle_Collision_Player(cObjectCollision* p_collision)
@@ -43,14 +43,14 @@ namespace TSC {
         // Create the MRuby object for this
         virtual mrb_value Create_MRuby_Object(mrb_state* p_state)
         {
-            return mrb_obj_value(Data_Wrap_Struct(p_state, mrb_class_get(p_state, "Crate"), &Scripting::rtTSC_Scriptable, this));
+            return Scripting::Wrap_Sprite(p_state, mrb_class_get(p_state, "Crate"), this);
         }
 
         virtual void Update();
         virtual cCrate* Copy() const;
         /*virtual void Draw(cSurface_Request* p_request = NULL);*/
 
-        virtual xmlpp::Element* Save_To_XML_Node(xmlpp::Element* p_element);
+        virtual void Save_To_XML_Node(cXml_Writer& writer);
 
         virtual void Handle_Collision_Player(cObjectCollision* p_collision);
         virtual void Handle_out_of_Level(ObjectDirection dir);
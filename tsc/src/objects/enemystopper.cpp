@@ -58,7 +58,7 @@ void cEnemyStopper::Init(void)
     m_massive_type = MASS_PASSIVE;
     m_editor_pos_z = 0.11f;
 
-    m_name = _("Enemystopper");
+    Editor_Data().m_name = _("Enemystopper");
 
     // size
     m_rect.m_w = 15.0f;
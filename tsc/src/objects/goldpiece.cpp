@@ -77,14 +77,12 @@ std::string cGoldpiece::Get_XML_Type_Name()
     return "goldpiece";
 }
 
-xmlpp::Element* cGoldpiece::Save_To_XML_Node(xmlpp::Element* p_element)
+void cGoldpiece::Save_To_XML_Node(cXml_Writer& writer)
 {
-    xmlpp::Element* p_node = cMovingSprite::Save_To_XML_Node(p_element);
+    cMovingSprite::Save_To_XML_Node(writer);
 
     // color
-    Add_Property(p_node, "color", Get_Color_Name(m_color_type));
-
-    return p_node;
+    Add_Property(writer, "color", Get_Color_Name(m_color_type));
 }
 
 void cGoldpiece::Load_From_Savegame(cSave_Level_Object* save_object)
@@ -103,26 +101,26 @@ void cGoldpiece::Set_Gold_Color(DefaultColor color)
         if (m_color_type == COL_RED) {
             Add_Image_Set("main", "game/items/goldpiece/red/falling.imgset");
 
-            m_name = _("Red Falling Jewel");
+            Editor_Data().m_name = _("Red Falling Jewel");
         }
         // default is yellow
         else {
             Add_Image_Set("main", "game/items/goldpiece/yellow/falling.imgset");
 
-            m_name = _("Falling Jewel");
+            Editor_Data().m_name = _("Falling Jewel");
         }
     }
     else {
         if (m_color_type == COL_RED) {
             Add_Image_Set("main", "game/items/goldpiece/red/jewel.imgset");
 
-            m_name = _("Red Jewel");
+            Editor_Data().m_name = _("Red Jewel");
         }
         // default is yellow
         else {
             Add_Image_Set("main", "game/items/goldpiece/yellow/jewel.imgset");
 
-            m_name = _("Jewel");
+            Editor_Data().m_name = _("Jewel");
         }
     }
 
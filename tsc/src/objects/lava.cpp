@@ -52,7 +52,7 @@ void cLava::Init()
     m_type = TYPE_ACTIVE_SPRITE;
     m_sprite_array = ARRAY_LAVA;
     m_massive_type = MASS_MASSIVE;
-    m_name = _("Lava");
+    Editor_Data().m_name = _("Lava");
 
     m_can_be_ground = true;
     Set_Scale_Directions(1, 1, 1, 1);
@@ -93,13 +93,11 @@ void cLava::Handle_Collision_Enemy(cObjectCollision* p_collision)
     p_enemy->DownGrade(true);
 }
 
-xmlpp::Element* cLava::Save_To_XML_Node(xmlpp::Element* p_element)
+void cLava::Save_To_XML_Node(cXml_Writer& writer)
 {
-    xmlpp::Element* p_node = cMovingSprite::Save_To_XML_Node(p_element);
+    cMovingSprite::Save_To_XML_Node(writer);
 
     // No configuration currently
-
-    return p_node;
 }
 
 std::string cLava::Get_XML_Type_Name()
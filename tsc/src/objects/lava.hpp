@@ -29,7 +29,7 @@ namespace TSC {
         virtual void Update();
         virtual void Draw(cSurface_Request* p_request = NULL);
 
-        virtual xmlpp::Element* Save_To_XML_Node(xmlpp::Element* p_element);
+        virtual void Save_To_XML_Node(cXml_Writer& writer);
 
         void Set_Massive_Type(MassiveType type);
 
@@ -67,7 +67,7 @@ void cLevel_Entry::Init(void)
     m_sprite_array = ARRAY_ACTIVE;
     m_type = TYPE_LEVEL_ENTRY;
     m_massive_type = MASS_PASSIVE;
-    m_name = "Level Entry";
+    Editor_Data().m_name = "Level Entry";
     m_editor_pos_z = 0.112f;
     m_camera_range = 1000;
 
@@ -101,18 +101,16 @@ std::string cLevel_Entry::Get_XML_Type_Name()
     return int_to_string(m_entry_type);
 }
 
-xmlpp::Element* cLevel_Entry::Save_To_XML_Node(xmlpp::Element* p_element)
+void cLevel_Entry::Save_To_XML_Node(cXml_Writer& writer)
 {
-    xmlpp::Element* p_node = cMovingSprite::Save_To_XML_Node(p_element);
+    cMovingSprite::Save_To_XML_Node(writer);
 
     // direction
     if (m_entry_type == LEVEL_ENTRY_WARP)
-        Add_Property(p_node, "direction", Get_Direction_Name(m_start_direction));
+        Add_Property(writer, "direction", Get_Direction_Name(m_start_direction));
     // name
     if (!m_entry_name.empty())
-        Add_Property(p_node, "name", m_entry_name);
-
-    return p_node;
+        Add_Property(writer, "name", m_entry_name);
 }
 
 void cLevel_Entry::Set_Direction(const ObjectDirection dir)
@@ -127,7 +125,7 @@ void cLevel_Entry::Set_Direction(const ObjectDirection dir)
 
 std::string cLevel_Entry::Create_Name(void) const
 {
-    std::string name = m_name; // Dup
+    std::string name = Editor_Data().m_name; // Dup
 
     if (m_entry_type == LEVEL_ENTRY_BEAM) {
         name += _(" Beam");
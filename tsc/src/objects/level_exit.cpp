@@ -104,7 +104,7 @@ void cLevel_Exit::Init(void)
 {
     m_sprite_array = ARRAY_ACTIVE;
     m_type = TYPE_LEVEL_EXIT;
-    m_name = "Level Exit";
+    Editor_Data().m_name = "Level Exit";
     m_massive_type = MASS_PASSIVE;
     m_editor_pos_z = 0.111f;
     m_camera_range = 1000;
@@ -150,44 +150,42 @@ std::string cLevel_Exit::Get_XML_Type_Name()
     return int_to_string(m_exit_type);
 }
 
-xmlpp::Element* cLevel_Exit::Save_To_XML_Node(xmlpp::Element* p_element)
+void cLevel_Exit::Save_To_XML_Node(cXml_Writer& writer)
 {
-    xmlpp::Element* p_node = cMovingSprite::Save_To_XML_Node(p_element);
+    cMovingSprite::Save_To_XML_Node(writer);
 
     // camera motion
-    Add_Property(p_node, "camera_motion", m_exit_motion);
+    Add_Property(writer, "camera_motion", m_exit_motion);
 
     // destination level
     if (!m_dest_level.empty())
-        Add_Property(p_node, "level_name", m_dest_level);
+        Add_Property(writer, "level_name", m_dest_level);
 
     // destination entry name
     if (!m_dest_entry.empty())
-        Add_Property(p_node, "entry", m_dest_entry);
+        Add_Property(writer, "entry", m_dest_entry);
 
     // return level name
     if (!m_return_level.empty())
-        Add_Property(p_node, "return_level_name", m_return_level);
+        Add_Property(writer, "return_level_name", m_return_level);
 
     // return entry
     if (!m_return_entry.empty())
-        Add_Property(p_node, "return_entry", m_return_entry);
+        Add_Property(writer, "return_entry", m_return_entry);
 
     // path identifier
     if (m_exit_motion == CAMERA_MOVE_ALONG_PATH || m_exit_motion == CAMERA_MOVE_ALONG_PATH_BACKWARDS) {
         if (!m_path_identifier.empty()) {
-            Add_Property(p_node, "path_identifier", m_path_identifier);
+            Add_Property(writer, "path_identifier", m_path_identifier);
         }
     }
 
     // exit name
     if (!m_exit_name.empty())
-        Add_Property(p_node, "exit_name", m_exit_name);
+        Add_Property(writer, "exit_name", m_exit_name);
 
     if (m_exit_type == LEVEL_EXIT_WARP)
-        Add_Property(p_node, "direction", Get_Direction_Name(m_start_direction));
-
-    return p_node;
+        Add_Property(writer, "direction", Get_Direction_Name(m_start_direction));
 }
 
 void cLevel_Exit::Set_Direction(const ObjectDirection dir, bool initial /* = true */)
@@ -202,7 +200,7 @@ void cLevel_Exit::Set_Direction(const ObjectDirection dir, bool initial /* = tru
 
 std::string cLevel_Exit::Create_Name(void) const
 {
-    std::string name = m_name; // dup
+    std::string name = Editor_Data().m_name; // dup
 
     if (m_exit_type == LEVEL_EXIT_BEAM) {
         name += _(" Beam");
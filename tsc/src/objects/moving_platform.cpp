@@ -110,7 +110,7 @@ void cMoving_Platform::Init(void)
 {
     m_sprite_array = ARRAY_ACTIVE;
     m_type = TYPE_MOVING_PLATFORM;
-    m_name = "Moving Platform";
+    Editor_Data().m_name = "Moving Platform";
     m_pos_z = 0.085f;
     m_gravity_max = 25.0f;
     m_can_be_on_ground = 0;
@@ -184,47 +184,45 @@ std::string cMoving_Platform::Get_XML_Type_Name()
     return int_to_string(m_move_type);
 }
 
-xmlpp::Element* cMoving_Platform::Save_To_XML_Node(xmlpp::Element* p_element)
+void cMoving_Platform::Save_To_XML_Node(cXml_Writer& writer)
 {
-    xmlpp::Element* p_node = cMovingSprite::Save_To_XML_Node(p_element);
+    cMovingSprite::Save_To_XML_Node(writer);
 
     // massive type
-    Add_Property(p_node, "massive_type", Get_Massive_Type_Name(m_massive_type));
+    Add_Property(writer, "massive_type", Get_Massive_Type_Name(m_massive_type));
 
     // Move type
-    Add_Property(p_node, "move_type", m_move_type);
+    Add_Property(writer, "move_type", m_move_type);
 
     switch (m_move_type) {
     // path identifier
     case MOVING_PLATFORM_TYPE_PATH: // fallthrough
     case MOVING_PLATFORM_TYPE_PATH_BACKWARDS:
         if (!m_path_state.m_path_identifier.empty())
-            Add_Property(p_node, "path_identifier", m_path_state.m_path_identifier);
+            Add_Property(writer, "path_identifier", m_path_state.m_path_identifier);
         break;
     // if move type is line or circle
     case MOVING_PLATFORM_TYPE_LINE: // fallthrough
     case MOVING_PLATFORM_TYPE_CIRCLE:
-        Add_Property(p_node, "direction", Get_Direction_Name(m_start_direction));
-        Add_Property(p_node, "max_distance", m_max_distance);
+        Add_Property(writer, "direction", Get_Direction_Name(m_start_direction));
+        Add_Property(writer, "max_distance", m_max_distance);
         break;
     }
 
     // Other properties
-    Add_Property(p_node, "speed", m_speed);
-    Add_Property(p_node, "touch_time", m_touch_time);
-    Add_Property(p_node, "shake_time", m_shake_time);
-    Add_Property(p_node, "touch_move_time", m_touch_move_time);
-    Add_Property(p_node, "middle_img_count", m_middle_count);
+    Add_Property(writer, "speed", m_speed);
+    Add_Property(writer, "touch_time", m_touch_time);
+    Add_Property(writer, "shake_time", m_shake_time);
+    Add_Property(writer, "touch_move_time", m_touch_move_time);
+    Add_Property(writer, "middle_img_count", m_middle_count);
 
     fs::path rel;
     // image top left
-    Add_Property(p_node, "image_top_left", path_to_utf8(m_left_filename));
+    Add_Property(writer, "image_top_left", path_to_utf8(m_left_filename));
     // image top middle
-    Add_Property(p_node, "image_top_middle", path_to_utf8(m_middle_filename));
+    Add_Property(writer, "image_top_middle", path_to_utf8(m_middle_filename));
     // image top right
-    Add_Property(p_node, "image_top_right", path_to_utf8(m_right_filename));
-
-    return p_node;
+    Add_Property(writer, "image_top_right", path_to_utf8(m_right_filename));
 }
 
 
@@ -247,15 +245,15 @@ void cMoving_Platform::Load_From_Savegame(cSave_Level_Object* save_object)
     m_path_state.Load_From_Savegame(save_object);
 }
 
-bool cMoving_Platform::Save_To_Savegame_XML_Node(xmlpp::Element* p_element) const
+bool cMoving_Platform::Save_To_Savegame_XML_Node(cXml_Writer& writer) const
 {
-    cMovingSprite::Save_To_Savegame_XML_Node(p_element);
+    cMovingSprite::Save_To_Savegame_XML_Node(writer);
 
     // platform state
-    Add_Property(p_element, "platform_state", int_to_string(m_platform_state));
+    Add_Property(writer, "platform_state", int_to_string(m_platform_state));
 
     // path state
-    m_path_state.Save_To_Savegame_XML_Node(p_element);
+    m_path_state.Save_To_Savegame_XML_Node(writer);
 
     return true;
 }
@@ -639,18 +637,20 @@ void cMoving_Platform::Update(void)
             Set_Velocity(diff_x, diff_y);
         }
         else if (m_move_type == MOVING_PLATFORM_TYPE_PATH || m_move_type == MOVING_PLATFORM_TYPE_PATH_BACKWARDS) {
-            if (m_path_state.m_path) {
+            cPath* path = m_path_state.Get_Path();
+
+            if (path) {
                 // move along path
                 if (m_path_state.Path_Move(m_speed * pFramerate->m_speed_factor) == 0) {
-                    if (!m_path_state.m_path->m_rewind) {
+                    if (!path->m_rewind) {
                         // if we can not move further along the path, reverse the direction
                         m_path_state.Move_Toggle();
                     }
                 }
 
                 // get difference
-                float diff_x = (m_path_state.m_path->m_start_pos_x + m_path_state.m_pos_x) - m_pos_x;
-                float diff_y = (m_path_state.m_path->m_start_pos_y + m_path_state.m_pos_y) - m_pos_y;
+                float diff_x = (path->m_start_pos_x + m_path_state.m_pos_x) - m_pos_x;
+                float diff_y = (path->m_start_pos_y + m_path_state.m_pos_y) - m_pos_y;
 
                 // move to position
                 Set_Velocity(diff_x, diff_y);
@@ -892,6 +892,7 @@ void cMoving_Platform::Handle_Collision_Player(cObjectCollision* collision)
         // set to touched
         if ((m_touch_time > 0.0f || m_touch_move_time > 0.0f) && m_platform_state == MOVING_PLATFORM_STAY) {
             m_platform_state = MOVING_PLATFORM_TOUCHED;
+            m_save_dirty = 1;
         }
 
         // send collision
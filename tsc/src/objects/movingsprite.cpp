@@ -33,13 +33,13 @@ namespace TSC {
 
 /* *** *** *** *** *** *** *** cMovingSprite *** *** *** *** *** *** *** *** *** *** */
 
-cMovingSprite::cMovingSprite(cSprite_Manager* sprite_manager, std::string type_name /* = "sprite" */)
+cMovingSprite::cMovingSprite(cSprite_Manager* sprite_manager, const char* type_name /* = "sprite" */)
     : cSprite(sprite_manager, type_name)
 {
     cMovingSprite::Init();
 }
 
-cMovingSprite::cMovingSprite(XmlAttributes& attributes, cSprite_Manager* sprite_manager, std::string type_name /* = "sprite" */)
+cMovingSprite::cMovingSprite(XmlAttributes& attributes, cSprite_Manager* sprite_manager, const char* type_name /* = "sprite" */)
     : cSprite(sprite_manager, type_name)
 {
     cMovingSprite::Init();
@@ -100,30 +100,30 @@ void cMovingSprite::Load_From_Savegame(cSave_Level_Object* save_object)
  * Each moving sprite has the potential to change, so this method returns
  * true now (as opposed to the cSprite implementation).
  */
-bool cMovingSprite::Save_To_Savegame_XML_Node(xmlpp::Element* p_element) const
+bool cMovingSprite::Save_To_Savegame_XML_Node(cXml_Writer& writer) const
 {
-    cSprite::Save_To_Savegame_XML_Node(p_element);
+    cSprite::Save_To_Savegame_XML_Node(writer);
 
-    Add_Property(p_element, "state", int_to_string(m_state));
+    Add_Property(writer, "state", int_to_string(m_state));
 
     // new position ( only save if needed )
     if (!Is_Float_Equal(m_start_pos_x, m_pos_x) || !Is_Float_Equal(m_start_pos_y, m_pos_y)) {
-        Add_Property(p_element, "new_posx", int_to_string(static_cast<int>(m_pos_x)));
-        Add_Property(p_element, "new_posy", int_to_string(static_cast<int>(m_pos_y)));
+        Add_Property(writer, "new_posx", int_to_string(static_cast<int>(m_pos_x)));
+        Add_Property(writer, "new_posy", int_to_string(static_cast<int>(m_pos_y)));
     }
 
     // direction
-    Add_Property(p_element, "direction", int_to_string(m_direction));
+    Add_Property(writer, "direction", int_to_string(m_direction));
 
     // velocity (only if needed)
     if(!Is_Float_Equal(m_velx, 0.0) || !Is_Float_Equal(m_vely, 0.0)) {
-        Add_Property(p_element, "velx", float_to_string(m_velx));
-        Add_Property(p_element, "vely", float_to_string(m_vely));
+        Add_Property(writer, "velx", float_to_string(m_velx));
+        Add_Property(writer, "vely", float_to_string(m_vely));
     }
 
     // active ( only save if needed )
     if (!m_active) {
-        Add_Property(p_element, "active", int_to_string(m_active));
+        Add_Property(writer, "active", int_to_string(m_active));
     }
 
     return true;
@@ -145,6 +145,11 @@ void cMovingSprite::Init(void)
 
     m_ice_resistance = 0.0f;
     m_freeze_counter = 0.0f;
+
+    m_save_check_state = STA_STAY;
+    m_save_check_velx = 0.0f;
+    m_save_check_vely = 0.0f;
+    m_save_check_valid = 0;
 }
 
 cMovingSprite* cMovingSprite::Copy(void) const
@@ -186,6 +191,7 @@ void cMovingSprite::Set_Image(cGL_Surface* new_image, bool new_start_image /* =
 void cMovingSprite::Set_Direction(const ObjectDirection dir, bool new_start_direction /* = 0 */)
 {
     m_direction = dir;
+    m_save_dirty = 1;
 
     // turn velocity if wrong
     if ((dir == DIR_LEFT && m_velx > 0.0f) || (dir == DIR_RIGHT && m_velx < 0.0f)) {
@@ -415,6 +421,9 @@ void cMovingSprite::Col_Move(float move_x, float move_y, bool real /* = 0 */, bo
         return;
     }
 
+    // even if blocked by a collision
+    m_save_dirty = 1;
+
     // use speedfactor
     if (!real) {
         move_x *= pFramerate->m_speed_factor;
@@ -523,6 +532,8 @@ void cMovingSprite::Add_Velocity(const float x, const float y, const bool real /
         m_velx += x * pFramerate->m_speed_factor;
         m_vely += y * pFramerate->m_speed_factor;
     }
+
+    m_save_dirty = 1;
 }
 
 void cMovingSprite::Add_Velocity_X(const float x, const bool real /* = 0 */)
@@ -533,6 +544,8 @@ void cMovingSprite::Add_Velocity_X(const float x, const bool real /* = 0 */)
     else {
         m_velx += x * pFramerate->m_speed_factor;
     }
+
+    m_save_dirty = 1;
 }
 
 void cMovingSprite::Add_Velocity_Y(const float y, const bool real /* = 0 */)
@@ -543,6 +556,8 @@ void cMovingSprite::Add_Velocity_Y(const float y, const bool real /* = 0 */)
     else {
         m_vely += y * pFramerate->m_speed_factor;
     }
+
+    m_save_dirty = 1;
 }
 
 void cMovingSprite::Turn_Around(ObjectDirection col_dir /* = DIR_UNDEFINED */)
@@ -569,6 +584,18 @@ void cMovingSprite::Turn_Around(ObjectDirection col_dir /* = DIR_UNDEFINED */)
 
 void cMovingSprite::Update(void)
 {
+    // state or velocity assigned directly, which changes the savegame without moving
+    if (!m_save_dirty) {
+        if (m_save_check_valid && (m_state != m_save_check_state || !Is_Float_Equal(m_velx, m_save_check_velx) || !Is_Float_Equal(m_vely, m_save_check_vely))) {
+            m_save_dirty = 1;
+        }
+
+        m_save_check_state = m_state;
+        m_save_check_velx = m_velx;
+        m_save_check_vely = m_vely;
+        m_save_check_valid = 1;
+    }
+
     if (m_freeze_counter > 0.0f) {
         m_freeze_counter -= pFramerate->m_speed_factor;
 
@@ -1089,7 +1116,7 @@ void cMovingSprite::Handle_Move_Object_Collision(const cObjectCollision* collisi
     cMovingSprite* obj = NULL;
 
     if (collision->m_array == ARRAY_ENEMY) {
-        obj = static_cast<cMovingSprite*>(m_sprite_manager->Get_Pointer(collision->m_number));
+        obj = static_cast<cMovingSprite*>(m_sprite_manager->Get_Sprite(collision->m_handle));
 
         // ignore these enemies
         if (obj->m_type == TYPE_THROMP || obj->m_type == TYPE_EATO || obj->m_type == TYPE_FLYON || obj->m_type == TYPE_STATIC_ENEMY) {
@@ -1211,11 +1238,6 @@ void cMovingSprite::Send_Collision(const cObjectCollision* collision, bool handl
         return;
     }
 
-    // if no target object number is available
-    if (collision->m_number < 0) {
-        return;
-    }
-
     /* if collision is received ignore it
      * a received collision can't create another received collision
      * only a self detected collision can create a received collision
@@ -1224,19 +1246,15 @@ void cMovingSprite::Send_Collision(const cObjectCollision* collision, bool handl
         return;
     }
 
-    int my_number;
+    // player has no handle
+    cSprite_Handle my_handle;
 
-    // player is always 0
-    if (m_type == TYPE_PLAYER) {
-        my_number = 0;
-    }
-    // get sprite array number
-    else {
-        my_number = m_sprite_manager->Get_Array_Num(this);
+    if (m_type != TYPE_PLAYER) {
+        my_handle = m_sprite_manager->Get_Handle(this);
 
         // object not available (yet) in manager
-        if (my_number < 0) {
-            //debug_print("Warning : Object %s did send Collision but doesn't exists in Manager\n", m_name.c_str());
+        if (my_handle.m_slot < 0) {
+            //debug_print("Warning : Object %s did send Collision but doesn't exists in Manager\n", Editor_Data().m_name.c_str());
             return;
         }
     }
@@ -1247,7 +1265,12 @@ void cMovingSprite::Send_Collision(const cObjectCollision* collision, bool handl
         target_obj = pActive_Player;
     }
     else {
-        target_obj = m_sprite_manager->Get_Pointer(collision->m_number);
+        target_obj = m_sprite_manager->Get_Sprite(collision->m_handle);
+
+        // if no target object is available
+        if (!target_obj) {
+            return;
+        }
     }
 
     // check if this is already in list
@@ -1262,8 +1285,8 @@ void cMovingSprite::Send_Collision(const cObjectCollision* collision, bool handl
 
     // set object
     new_collision->m_obj = this;
-    // set object manager id
-    new_collision->m_number = my_number;
+    // set object manager handle
+    new_collision->m_handle = my_handle;
 
     // set direction
     if (collision->m_direction != DIR_UNDEFINED) {
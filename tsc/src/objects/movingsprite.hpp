@@ -59,16 +59,16 @@ namespace TSC {
     class cMovingSprite : public cSprite {
     public:
         // constructor
-        cMovingSprite(cSprite_Manager* sprite_manager, std::string type_name = "sprite");
+        cMovingSprite(cSprite_Manager* sprite_manager, const char* type_name = "sprite");
         // create from stream
-        cMovingSprite(XmlAttributes& attributes, cSprite_Manager* sprite_manager, std::string type_name = "sprite");
+        cMovingSprite(XmlAttributes& attributes, cSprite_Manager* sprite_manager, const char* type_name = "sprite");
         // destructor
         virtual ~cMovingSprite(void);
 
         // load from save game
         virtual void Load_From_Savegame(cSave_Level_Object* save_object);
         // save to save game
-        virtual bool Save_To_Savegame_XML_Node(xmlpp::Element* p_element) const;
+        virtual bool Save_To_Savegame_XML_Node(cXml_Writer& writer) const;
 
         // Init defaults
         void Init(void);
@@ -78,7 +78,7 @@ namespace TSC {
         // Create the MRuby instance for this object.
         virtual mrb_value Create_MRuby_Object(mrb_state* p_state)
         {
-            return mrb_obj_value(Data_Wrap_Struct(p_state, mrb_class_get(p_state, "MovingSprite"), &Scripting::rtTSC_Scriptable, this));
+            return Scripting::Wrap_Sprite(p_state, mrb_class_get(p_state, "MovingSprite"), this);
         }
 
         /* Sets the image for drawing
@@ -116,12 +116,14 @@ namespace TSC {
         {
             m_velx = x;
             m_vely = y;
+            m_save_dirty = 1;
         };
         // Sets the velocity from the given angle and speed
         inline void Set_Velocity_From_Angle(const float angle, const float speed, const bool new_start_direction = 0)
         {
             m_velx = cos(angle * deg_to_rad) * speed;
             m_vely = sin(angle * deg_to_rad) * speed;
+            m_save_dirty = 1;
 
             if (new_start_direction) {
                 m_start_direction = m_direction;
@@ -303,6 +305,12 @@ namespace TSC {
         float m_freeze_counter;
 
     private:
+        // state and velocity at the last Update() while not dirty for the savegame
+        Moving_state m_save_check_state;
+        float m_save_check_velx;
+        float m_save_check_vely;
+        bool m_save_check_valid;
+
         /* moves in steps and checks in both directions simultaneous
          * returns the found collisions
          * sprite_list : objects to check
@@ -38,7 +38,6 @@ namespace TSC {
 cPath_State::cPath_State(cSprite_Manager* sprite_manager)
 {
     m_sprite_manager = sprite_manager;
-    m_path = NULL;
     m_forward = 1;
     m_pos_x = 0;
     m_pos_y = 0;
@@ -49,9 +48,11 @@ cPath_State::cPath_State(cSprite_Manager* sprite_manager)
 
 cPath_State::~cPath_State(void)
 {
+    cPath* path = Get_Path();
+
     // remove link
-    if (m_path) {
-        m_path->Remove_Link(this);
+    if (path) {
+        path->Remove_Link(this);
     }
 }
 
@@ -76,36 +77,49 @@ void cPath_State::Load_From_Savegame(cSave_Level_Object* save_object)
     }
 }
 
-bool cPath_State::Save_To_Savegame_XML_Node(xmlpp::Element* p_element) const
+bool cPath_State::Save_To_Savegame_XML_Node(cXml_Writer& writer) const
 {
     // path position
-    Add_Property(p_element, "new_pos_x", float_to_string(m_pos_x));
-    Add_Property(p_element, "new_pos_y", float_to_string(m_pos_y));
+    Add_Property(writer, "new_pos_x", float_to_string(m_pos_x));
+    Add_Property(writer, "new_pos_y", float_to_string(m_pos_y));
 
     // current segment
-    Add_Property(p_element, "current_segment", int_to_string(m_current_segment));
+    Add_Property(writer, "current_segment", int_to_string(m_current_segment));
 
     // current segment position
-    Add_Property(p_element, "current_segmant_pos", float_to_string(m_current_segment_pos));
+    Add_Property(writer, "current_segmant_pos", float_to_string(m_current_segment_pos));
 
     // forward
-    Add_Property(p_element, "forward", int_to_string(static_cast<int>(m_forward)));
+    Add_Property(writer, "forward", int_to_string(static_cast<int>(m_forward)));
 
     return true;
 }
 
 void cPath_State::Set_Sprite_Manager(cSprite_Manager* sprite_manager)
 {
+    // the handle is only valid in its manager
+    if (sprite_manager != m_sprite_manager) {
+        cPath* path = Get_Path();
+
+        if (path) {
+            path->Remove_Link(this);
+        }
+
+        m_path_handle = cSprite_Handle();
+    }
+
     m_sprite_manager = sprite_manager;
 }
 
 void cPath_State::Draw(void)
 {
-    if (!m_path) {
+    cPath* path = Get_Path();
+
+    if (!path) {
         return;
     }
 
-    pVideo->Draw_Rect(m_path->m_col_rect.m_x + m_pos_x - 4 - pActive_Camera->m_x, m_path->m_col_rect.m_y + m_pos_y - 4 - pActive_Camera->m_y, 8, 8, m_path->m_editor_pos_z + 0.00002f, &orange);
+    pVideo->Draw_Rect(path->m_col_rect.m_x + m_pos_x - 4 - pActive_Camera->m_x, path->m_col_rect.m_y + m_pos_y - 4 - pActive_Camera->m_y, 8, 8, path->m_editor_pos_z + 0.00002f, &orange);
 }
 
 cPath* cPath_State::Get_Path_Object(const std::string& identifier)
@@ -135,22 +149,25 @@ cPath* cPath_State::Get_Path_Object(const std::string& identifier)
 
 void cPath_State::Set_Path_Identifier(const std::string& path)
 {
+    cPath* old_path = Get_Path();
+
     // remove old link
-    if (m_path) {
-        m_path->Remove_Link(this);
+    if (old_path) {
+        old_path->Remove_Link(this);
     }
 
     // set path
     m_path_identifier = path;
-    m_path = Get_Path_Object(m_path_identifier);
+    cPath* new_path = Get_Path_Object(m_path_identifier);
+    m_path_handle = m_sprite_manager->Get_Handle(new_path);
 
     // not found
-    if (!m_path) {
+    if (!new_path) {
         return;
     }
 
     // create link
-    m_path->Create_Link(this);
+    new_path->Create_Link(this);
 
     // set position to start
     Move_Reset();
@@ -158,7 +175,17 @@ void cPath_State::Set_Path_Identifier(const std::string& path)
 
 void cPath_State::Path_Destroyed_Event(void)
 {
-    m_path = NULL;
+    m_path_handle = cSprite_Handle();
+}
+
+cPath* cPath_State::Get_Path(void) const
+{
+    // not linked
+    if (m_path_handle.m_slot < 0) {
+        return NULL;
+    }
+
+    return static_cast<cPath*>(m_sprite_manager->Get_Sprite(m_path_handle));
 }
 
 void cPath_State::Move_Toggle(void)
@@ -188,7 +215,9 @@ void cPath_State::Move_Reverse(void)
 
 void cPath_State::Move_Start_Forward(void)
 {
-    if (!m_path || m_path->m_segments.empty()) {
+    cPath* path = Get_Path();
+
+    if (!path || path->m_segments.empty()) {
         return;
     }
 
@@ -198,22 +227,26 @@ void cPath_State::Move_Start_Forward(void)
 
 void cPath_State::Move_Start_Backward(void)
 {
-    if (!m_path || m_path->m_segments.empty()) {
+    cPath* path = Get_Path();
+
+    if (!path || path->m_segments.empty()) {
         return;
     }
 
     m_forward = 0;
-    Move_From_Segment(m_path->m_segments.size() - 1);
+    Move_From_Segment(path->m_segments.size() - 1);
 }
 
 void cPath_State::Move_From_Segment(unsigned int segment)
 {
-    if (!m_path) {
+    cPath* path = Get_Path();
+
+    if (!path) {
         return;
     }
 
     // invalid segment
-    if (segment >= m_path->m_segments.size()) {
+    if (segment >= path->m_segments.size()) {
         return;
     }
 
@@ -221,30 +254,32 @@ void cPath_State::Move_From_Segment(unsigned int segment)
 
     if (m_forward) {
         m_current_segment_pos = 0;
-        m_pos_x = m_path->m_segments[m_current_segment].m_x1;
-        m_pos_y = m_path->m_segments[m_current_segment].m_y1;
+        m_pos_x = path->m_segments[m_current_segment].m_x1;
+        m_pos_y = path->m_segments[m_current_segment].m_y1;
     }
     // backward
     else {
-        m_current_segment_pos = m_path->m_segments[m_current_segment].m_distance;
-        m_pos_x = m_path->m_segments[m_current_segment].m_x2;
-        m_pos_y = m_path->m_segments[m_current_segment].m_y2;
+        m_current_segment_pos = path->m_segments[m_current_segment].m_distance;
+        m_pos_x = path->m_segments[m_current_segment].m_x2;
+        m_pos_y = path->m_segments[m_current_segment].m_y2;
     }
 }
 
 bool cPath_State::Path_Move(float distance)
 {
-    if (!m_path) {
+    cPath* path = Get_Path();
+
+    if (!path) {
         return 0;
     }
 
     // invalid slot
-    if (m_current_segment >= m_path->m_segments.size()) {
+    if (m_current_segment >= path->m_segments.size()) {
         return 0;
     }
 
     // get current segment object
-    cPath_Segment obj = m_path->m_segments[m_current_segment];
+    cPath_Segment obj = path->m_segments[m_current_segment];
 
     // walk forward
     if (m_forward) {
@@ -257,9 +292,9 @@ bool cPath_State::Path_Move(float distance)
                 m_pos_y = obj.m_y2;
 
                 // finished
-                if (m_current_segment + 1 >= m_path->m_segments.size()) {
+                if (m_current_segment + 1 >= path->m_segments.size()) {
                     // rewind
-                    if (m_path->m_rewind) {
+                    if (path->m_rewind) {
                         m_current_segment = 0;
                         m_current_segment_pos = 0;
                         return 0;
@@ -272,7 +307,7 @@ bool cPath_State::Path_Move(float distance)
 
                 // set current segment object
                 m_current_segment++;
-                obj = m_path->m_segments[m_current_segment];
+                obj = path->m_segments[m_current_segment];
 
                 m_current_segment_pos = 0;
                 distance -= remaining;
@@ -299,9 +334,9 @@ bool cPath_State::Path_Move(float distance)
                 // finished
                 if (m_current_segment == 0) {
                     // rewind
-                    if (m_path->m_rewind) {
-                        m_current_segment = m_path->m_segments.size() - 1;
-                        obj = m_path->m_segments[m_current_segment];
+                    if (path->m_rewind) {
+                        m_current_segment = path->m_segments.size() - 1;
+                        obj = path->m_segments[m_current_segment];
                         m_current_segment_pos = obj.m_distance;
                         return 0;
                     }
@@ -313,7 +348,7 @@ bool cPath_State::Path_Move(float distance)
 
                 // set current segment object
                 m_current_segment--;
-                obj = m_path->m_segments[m_current_segment];
+                obj = path->m_segments[m_current_segment];
 
                 m_current_segment_pos = obj.m_distance;
                 distance -= remaining;
@@ -479,7 +514,7 @@ void cPath::Init(void)
     m_editor_pos_z = 0.11f;
     m_show_line = false;
 
-    m_name = _("Path");
+    Editor_Data().m_name = _("Path");
 
     // size
     m_rect.m_w = 10;
@@ -515,14 +550,14 @@ std::string cPath::Get_XML_Type_Name()
     return "";
 }
 
-xmlpp::Element* cPath::Save_To_XML_Node(xmlpp::Element* p_element)
+void cPath::Save_To_XML_Node(cXml_Writer& writer)
 {
-    xmlpp::Element* p_node = cSprite::Save_To_XML_Node(p_element);
+    cSprite::Save_To_XML_Node(writer);
 
     // Attributes
-    Add_Property(p_node, "identifier", m_identifier);
-    Add_Property(p_node, "show_line", m_show_line);
-    Add_Property(p_node, "rewind", m_rewind);
+    Add_Property(writer, "identifier", m_identifier);
+    Add_Property(writer, "show_line", m_show_line);
+    Add_Property(writer, "rewind", m_rewind);
 
     // segments
     // This is ugly XML because TSC's loader does not support nested
@@ -530,13 +565,11 @@ xmlpp::Element* cPath::Save_To_XML_Node(xmlpp::Element* p_element)
     for (unsigned int i=0; i < m_segments.size(); i++) {
         std::string str_pos = int_to_string(i);
 
-        Add_Property(p_node, "segment_" + str_pos + "_x1", m_segments[i].m_x1);
-        Add_Property(p_node, "segment_" + str_pos + "_y1", m_segments[i].m_y1);
-        Add_Property(p_node, "segment_" + str_pos + "_x2", m_segments[i].m_x2);
-        Add_Property(p_node, "segment_" + str_pos + "_y2", m_segments[i].m_y2);
+        Add_Property(writer, "segment_" + str_pos + "_x1", m_segments[i].m_x1);
+        Add_Property(writer, "segment_" + str_pos + "_y1", m_segments[i].m_y1);
+        Add_Property(writer, "segment_" + str_pos + "_x2", m_segments[i].m_x2);
+        Add_Property(writer, "segment_" + str_pos + "_y2", m_segments[i].m_y2);
     }
-
-    return p_node;
 }
 
 void cPath::Load_From_Savegame(cSave_Level_Object* save_object)
@@ -37,7 +37,7 @@ namespace TSC {
         // load from savegame
         void Load_From_Savegame(cSave_Level_Object* save_object);
         // save to an existing savegame object
-        virtual bool Save_To_Savegame_XML_Node(xmlpp::Element* p_element) const;
+        virtual bool Save_To_Savegame_XML_Node(cXml_Writer& writer) const;
         // Set the parent sprite manager
         void Set_Sprite_Manager(cSprite_Manager* sprite_manager);
 
@@ -59,6 +59,8 @@ namespace TSC {
         void Set_Path_Identifier(const std::string& path);
         // event if parent path got destroyed
         void Path_Destroyed_Event(void);
+        // Return the parent path or NULL
+        cPath* Get_Path(void) const;
 
         // Start movement from the start of the opposite direction
         void Move_Toggle(void);
@@ -84,8 +86,8 @@ namespace TSC {
 
         // parent path identifier
         std::string m_path_identifier;
-        // parent path pointer ( auto removes the link if destroyed itself )
-        cPath* m_path;
+        // parent path handle ( auto removes the link if destroyed itself )
+        cSprite_Handle m_path_handle;
 
         // current position
         float m_pos_x;
@@ -161,7 +163,7 @@ namespace TSC {
         // Create the MRuby object for this
         virtual mrb_value Create_MRuby_Object(mrb_state* p_state)
         {
-            return mrb_obj_value(Data_Wrap_Struct(p_state, mrb_class_get(p_state, "Path"), &Scripting::rtTSC_Scriptable, this));
+            return Scripting::Wrap_Sprite(p_state, mrb_class_get(p_state, "Path"), this);
         }
 
         // Set the identifier
@@ -242,7 +244,7 @@ namespace TSC {
         PathStateList m_linked_path_states;
 
         // Save to XML node
-        virtual xmlpp::Element* Save_To_XML_Node(xmlpp::Element* p_element);
+        virtual void Save_To_XML_Node(cXml_Writer& writer);
 
     protected:
         virtual std::string Get_XML_Type_Name();
@@ -200,13 +200,11 @@ std::string cMushroom::Get_XML_Type_Name()
     return "mushroom";
 }
 
-xmlpp::Element* cMushroom::Save_To_XML_Node(xmlpp::Element* p_element)
+void cMushroom::Save_To_XML_Node(cXml_Writer& writer)
 {
-    xmlpp::Element* p_node = cPowerUp::Save_To_XML_Node(p_element);
+    cPowerUp::Save_To_XML_Node(writer);
 
-    Add_Property(p_node, "mushroom_type", m_type);
-
-    return p_node;
+    Add_Property(writer, "mushroom_type", m_type);
 }
 
 void cMushroom::Set_Type(SpriteType new_type)
@@ -221,23 +219,23 @@ void cMushroom::Set_Type(SpriteType new_type)
 
     if (new_type == TYPE_MUSHROOM_DEFAULT) {
         Add_Image_Set("main", "game/items/berry_big.imgset");
-        m_name = _("Berry");
+        Editor_Data().m_name = _("Berry");
     }
     else if (new_type == TYPE_MUSHROOM_LIVE_1) {
         Add_Image_Set("main", "game/items/berry_life.imgset");
-        m_name = _("Life berry");
+        Editor_Data().m_name = _("Life berry");
     }
     else if (new_type == TYPE_MUSHROOM_POISON) {
         Add_Image_Set("main", "game/items/berry_poison.imgset");
-        m_name = _("Poisonous berry");
+        Editor_Data().m_name = _("Poisonous berry");
     }
     else if (new_type == TYPE_MUSHROOM_BLUE) {
         Add_Image_Set("main", "game/items/berry_ice.imgset");
-        m_name = _("Ice berry");
+        Editor_Data().m_name = _("Ice berry");
     }
     else if (new_type == TYPE_MUSHROOM_GHOST) {
         Add_Image_Set("main", "game/items/berry_ghost.imgset");
-        m_name = _("Ghost berry");
+        Editor_Data().m_name = _("Ghost berry");
     }
     else {
         cerr << "Warning Unknown Mushroom type : " << new_type << endl;
@@ -446,7 +444,7 @@ void cFirePlant::Init(void)
     Add_Image_Set("main", "game/items/berry_fire.imgset");
     Set_Image_Set("main", 1);
 
-    m_name = _("Fireberry");
+    Editor_Data().m_name = _("Fireberry");
 
     m_particle_counter = 0.0f;
 }
@@ -550,7 +548,7 @@ void cMoon::Init(void)
     Add_Image_Set("main", "game/items/cookie.imgset");
     Set_Image_Set("main", 1);
 
-    m_name = _("Cookie (3-UP)");
+    Editor_Data().m_name = _("Cookie (3-UP)");
     m_particle_counter = 0.0f;
 }
 
@@ -64,7 +64,7 @@ void cSecret_Area::Init()
 {
     m_sprite_array = ARRAY_ACTIVE;
     m_type = TYPE_SECRET_AREA;
-    m_name = _("Secret Area");
+    Editor_Data().m_name = _("Secret Area");
     m_massive_type = MASS_PASSIVE;
     m_editor_pos_z = 0.112f;
     m_camera_range = 1000;
@@ -179,6 +179,7 @@ void cSecret_Area::Activate(void)
     m_transparency_counter = 0.0f;
     m_move_counter = 0.0f;
     m_activated = true;
+    m_save_dirty = 1;
 
     Scripting::cActivate_Event evt;
     evt.Fire(pActive_Level->m_mruby, this);
@@ -197,21 +198,19 @@ void cSecret_Area::Editor_State_Update(void)
 {
 }
 
-xmlpp::Element* cSecret_Area::Save_To_XML_Node(xmlpp::Element* p_element)
+void cSecret_Area::Save_To_XML_Node(cXml_Writer& writer)
 {
-    xmlpp::Element* p_node = cMovingSprite::Save_To_XML_Node(p_element);
-    Add_Property(p_node, "width", m_rect.m_w);
-    Add_Property(p_node, "height", m_rect.m_h);
-
-    return p_node;
+    cMovingSprite::Save_To_XML_Node(writer);
+    Add_Property(writer, "width", m_rect.m_w);
+    Add_Property(writer, "height", m_rect.m_h);
 }
 
-bool cSecret_Area::Save_To_Savegame_XML_Node(xmlpp::Element* p_element) const
+bool cSecret_Area::Save_To_Savegame_XML_Node(cXml_Writer& writer) const
 {
-    cMovingSprite::Save_To_Savegame_XML_Node(p_element);
+    cMovingSprite::Save_To_Savegame_XML_Node(writer);
 
     if (m_activated)
-        Add_Property(p_element, "activated", m_activated);
+        Add_Property(writer, "activated", m_activated);
 
     return true;
 }
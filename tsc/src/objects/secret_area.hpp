@@ -41,7 +41,7 @@ namespace TSC {
         // Create the MRuby object for this
         virtual mrb_value Create_MRuby_Object(mrb_state* p_state)
         {
-            return mrb_obj_value(Data_Wrap_Struct(p_state, mrb_class_get(p_state, "SecretArea"), &Scripting::rtTSC_Scriptable, this));
+            return Scripting::Wrap_Sprite(p_state, mrb_class_get(p_state, "SecretArea"), this);
         }
 
         // if draw is valid for the current state and position
@@ -54,8 +54,8 @@ namespace TSC {
         virtual void Editor_Deactivate(void);
         virtual void Editor_State_Update(void);
 
-        virtual xmlpp::Element* Save_To_XML_Node(xmlpp::Element* p_element);
-        virtual bool Save_To_Savegame_XML_Node(xmlpp::Element* p_element) const;
+        virtual void Save_To_XML_Node(cXml_Writer& writer);
+        virtual bool Save_To_Savegame_XML_Node(cXml_Writer& writer) const;
         virtual void Load_From_Savegame(cSave_Level_Object* save_object);
 
         CEGUI::Window* mp_msg_window;
@@ -46,7 +46,7 @@ void cSpinBox::Init(void)
 {
     m_type = TYPE_SPIN_BOX;
     box_type = m_type;
-    m_name = _("Spinbox");
+    Editor_Data().m_name = _("Spinbox");
     m_camera_range = 5000;
     m_can_be_on_ground = 0;
 
@@ -76,9 +76,9 @@ void cSpinBox::Load_From_XML(XmlAttributes& attributes)
     cBaseBox::Load_From_XML(attributes);
 }
 
-xmlpp::Element* cSpinBox::Save_To_XML_Node(xmlpp::Element* p_element)
+void cSpinBox::Save_To_XML_Node(cXml_Writer& writer)
 {
-    return cBaseBox::Save_To_XML_Node(p_element);
+    cBaseBox::Save_To_XML_Node(writer);
 }
 
 void cSpinBox::Load_From_Savegame(cSave_Level_Object* save_object)
@@ -90,13 +90,13 @@ void cSpinBox::Load_From_Savegame(cSave_Level_Object* save_object)
     }
 }
 
-bool cSpinBox::Save_To_Savegame_XML_Node(xmlpp::Element* p_element) const
+bool cSpinBox::Save_To_Savegame_XML_Node(cXml_Writer& writer) const
 {
-    cBaseBox::Save_To_Savegame_XML_Node(p_element);
+    cBaseBox::Save_To_Savegame_XML_Node(writer);
 
     // spin counter
     if (m_spin) {
-        Add_Property(p_element, "spin_counter", float_to_string(m_spin_counter));
+        Add_Property(writer, "spin_counter", float_to_string(m_spin_counter));
     }
 
     return true;
@@ -112,6 +112,7 @@ void cSpinBox::Activate(void)
     cBaseBox::Activate();
 
     m_spin = 1;
+    m_save_dirty = 1;
     Update_Valid_Update();
     // passive box for spinning
     m_massive_type = MASS_PASSIVE;
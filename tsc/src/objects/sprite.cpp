@@ -67,8 +67,15 @@ void cCollidingSprite::Handle_Collisions(void)
 
     // parse the given collisions
     for (cObjectCollision_List::iterator itr = col_list.begin(); itr != col_list.end(); ++itr) {
+        cObjectCollision* collision = (*itr);
+
+        // the colliding object was removed since
+        if (collision->m_obj && collision->m_array != ARRAY_PLAYER && !m_sprite_manager->Get_Sprite(collision->m_handle)) {
+            continue;
+        }
+
         // handle it
-        Handle_Collision((*itr));
+        Handle_Collision(collision);
     }
 
     // clear
@@ -95,7 +102,7 @@ cObjectCollision* cCollidingSprite::Create_Collision_Object(const cSprite* base,
         collision->m_obj = col;
         // identifier
         if (col->m_sprite_array != ARRAY_PLAYER) {
-            collision->m_number = m_sprite_manager->Get_Array_Num(col);
+            collision->m_handle = m_sprite_manager->Get_Handle(col);
         }
         // type
         collision->m_array = col->m_sprite_array;
@@ -203,7 +210,20 @@ cObjectCollision* cCollidingSprite::Get_Last_Collision(bool only_blocking /* = 0
             // get object pointer
             cObjectCollision* col = (*itr);
 
-            cSprite* col_obj = m_sprite_manager->Get_Pointer(col->m_number);
+            cSprite* col_obj;
+
+            // the player is not in the manager
+            if (col->m_array == ARRAY_PLAYER) {
+                col_obj = col->m_obj;
+            }
+            else {
+                col_obj = m_sprite_manager->Get_Sprite(col->m_handle);
+
+                // removed
+                if (!col_obj) {
+                    continue;
+                }
+            }
 
             // ignore passive
             if (col_obj->m_massive_type == MASS_PASSIVE) {
@@ -303,8 +323,32 @@ void cCollidingSprite::Handle_Collision(cObjectCollision* collision)
     }
 }
 
+/* *** *** *** *** *** *** *** cSprite_Editor_Data_Table *** *** *** *** *** *** *** *** *** *** */
+
+int cSprite_Editor_Data_Table::Add(void)
+{
+    if (!m_free_slots.empty()) {
+        int slot = m_free_slots.back();
+        m_free_slots.pop_back();
+        return slot;
+    }
+
+    m_data.push_back(cSprite_Editor_Data());
+    return static_cast<int>(m_data.size() - 1);
+}
+
+void cSprite_Editor_Data_Table::Remove(int slot)
+{
+    // free the strings now, the slot may stay unused
+    m_data[slot] = cSprite_Editor_Data();
+    m_free_slots.push_back(slot);
+}
+
 /* *** *** *** *** *** *** *** cSprite *** *** *** *** *** *** *** *** *** *** */
 
+cSprite_Editor_Data_Table cSprite::s_editor_data_table;
+const cSprite_Editor_Data cSprite::s_empty_editor_data;
+
 const float cSprite::m_pos_z_passive_start = 0.01f;
 const float cSprite::m_pos_z_massive_start = 0.08f;
 const float cSprite::m_pos_z_front_passive_start = 0.1f;
@@ -312,31 +356,31 @@ const float cSprite::m_pos_z_halfmassive_start = 0.04f;
 const float cSprite::m_pos_z_player = 0.0999f;
 const float cSprite::m_pos_z_delta = 0.000001f;
 
-cSprite::cSprite(cSprite_Manager* sprite_manager, const std::string type_name /* = "sprite" */)
-    : cCollidingSprite(sprite_manager), m_type_name(type_name)
+cSprite::cSprite(cSprite_Manager* sprite_manager, const char* type_name /* = "sprite" */)
+    : cCollidingSprite(sprite_manager), m_type_name(type_name), m_editor_data_slot(-1)
 {
     cSprite::Init();
 }
 
-cSprite::cSprite(XmlAttributes& attributes, cSprite_Manager* sprite_manager, const std::string type_name /* = "sprite" */)
-    : cCollidingSprite(sprite_manager), m_type_name(type_name)
+cSprite::cSprite(XmlAttributes& attributes, cSprite_Manager* sprite_manager, const char* type_name /* = "sprite" */)
+    : cCollidingSprite(sprite_manager), m_type_name(type_name), m_editor_data_slot(-1)
 {
     cSprite::Init();
 
     // position
     Set_Pos(string_to_float(attributes["posx"]), string_to_float(attributes["posy"]), true);
     // image
-    m_image_filename = attributes["image"];
-    if(utf8_to_path(m_image_filename).extension() == utf8_to_path(".png")) {
+    Editor_Data().m_image_filename = attributes["image"];
+    if(utf8_to_path(Editor_Data().m_image_filename).extension() == utf8_to_path(".png")) {
         Set_Image(pVideo->Get_Surface(utf8_to_path(attributes["image"])), true) ;
     }
     else {
-        if (Add_Image_Set("main", utf8_to_path(m_image_filename)))
+        if (Add_Image_Set("main", utf8_to_path(Editor_Data().m_image_filename)))
             Set_Image_Set("main", true);
         else { // level XML points to invalid file
-            std::cerr << "Warning: Level XML is invalid -- file does not load: " << m_image_filename << std::endl;
-            m_image_filename = "game/image_not_found.png";
-            Set_Image(pVideo->Get_Surface(utf8_to_path(m_image_filename)));
+            std::cerr << "Warning: Level XML is invalid -- file does not load: " << Editor_Data().m_image_filename << std::endl;
+            Editor_Data().m_image_filename = "game/image_not_found.png";
+            Set_Image(pVideo->Get_Surface(utf8_to_path(Editor_Data().m_image_filename)));
         }
     }
     // Massivity.
@@ -350,6 +394,10 @@ cSprite::~cSprite(void)
         delete m_image;
         m_image = NULL;
     }
+
+    if (m_editor_data_slot >= 0) {
+        s_editor_data_table.Remove(m_editor_data_slot);
+    }
 }
 
 void cSprite::Init(void)
@@ -409,6 +457,8 @@ void cSprite::Init(void)
     m_active = 1;
     m_spawned = 0;
     m_suppress_save = 0;
+    // cleared after the level is loaded
+    m_save_dirty = 1;
     m_camera_range = 1000;
     m_can_be_ground = 0;
     m_disallow_managed_delete = 0;
@@ -436,6 +486,7 @@ void cSprite::Init(void)
     m_valid_update = 1;
 
     m_uid = -1;
+    m_manager_slot = -1;
 }
 
 cSprite* cSprite::Copy(void) const
@@ -443,7 +494,7 @@ cSprite* cSprite::Copy(void) const
     cSprite* basic_sprite = new cSprite(m_sprite_manager);
  
     // current image
-    basic_sprite->m_image_filename = m_image_filename;
+    basic_sprite->Editor_Data().m_image_filename = Editor_Data().m_image_filename;
     basic_sprite->Set_Image(m_start_image, true);
 
     // animation details
@@ -480,32 +531,24 @@ cSprite* cSprite::Copy(void) const
 /**
  * This method saves the object into XML for saving it inside a level
  * XML file. Subclasses should override this *and* call the base class
- * method.  The subclasses should then add attributes to the node the
- * baseclass method returned and return that node themselves again.
- *
- * \param p_element libxml2’s node we are in currently.
- *
- * \return Exactly `p_element`.
+ * method. The caller has already started the element named after
+ * `m_type_name` and ends it afterwards, so all methods only add their
+ * properties to the current element of the writer.
  *
+ * \param writer The writer of the level file.
 */
-xmlpp::Element* cSprite::Save_To_XML_Node(xmlpp::Element* p_element)
+void cSprite::Save_To_XML_Node(cXml_Writer& writer)
 {
-#ifdef USE_LIBXMLPP3
-    xmlpp::Element* p_node = p_element->add_child_element(m_type_name);
-#else
-    xmlpp::Element* p_node = p_element->add_child(m_type_name);
-#endif
-
     // position
-    Add_Property(p_node, "posx", static_cast<int>(m_start_pos_x));
-    Add_Property(p_node, "posy", static_cast<int>(m_start_pos_y));
+    Add_Property(writer, "posx", static_cast<int>(m_start_pos_x));
+    Add_Property(writer, "posy", static_cast<int>(m_start_pos_y));
     // UID
-    Add_Property(p_node, "uid", m_uid);
+    Add_Property(writer, "uid", m_uid);
 
     // image
     boost::filesystem::path img_filename;
-    if (!m_image_filename.empty())
-        img_filename = utf8_to_path(m_image_filename);
+    if (!Editor_Data().m_image_filename.empty())
+        img_filename = utf8_to_path(Editor_Data().m_image_filename);
     else if (m_start_image)
         img_filename = m_start_image->m_path;
     else if (m_image)
@@ -518,17 +561,15 @@ xmlpp::Element* cSprite::Save_To_XML_Node(xmlpp::Element* p_element)
     if (img_filename.is_absolute())
         img_filename = fs::relative(img_filename, pResource_Manager->Get_Game_Pixmaps_Directory());
 
-    Add_Property(p_node, "image", img_filename.generic_string());
+    Add_Property(writer, "image", img_filename.generic_string());
 
     // type (only if Get_XML_Type_Name() returns something meaningful)
     // type is massive type in real. Should probably have an own XML attribute.
     std::string type = Get_XML_Type_Name();
     if (type.empty())
-        Add_Property(p_node, "type", Get_Massive_Type_Name(m_massive_type));
+        Add_Property(writer, "type", Get_Massive_Type_Name(m_massive_type));
     else
-        Add_Property(p_node, "type", type);
-
-    return p_node;
+        Add_Property(writer, "type", type);
 }
 
 /**
@@ -541,13 +582,16 @@ xmlpp::Element* cSprite::Save_To_XML_Node(xmlpp::Element* p_element)
  * consider the node for storing.
  *
  * "posx" and "posy" attributes for the initial position (m_start_pos*
- * attributes) are also saved.
+ * attributes) are also saved, as is the "uid" which is used to find
+ * the object again when loading. Only sprites with m_save_dirty set
+ * are saved at all.
  */
-bool cSprite::Save_To_Savegame_XML_Node(xmlpp::Element* p_element) const
+bool cSprite::Save_To_Savegame_XML_Node(cXml_Writer& writer) const
 {
-    Add_Property(p_element, "type", m_type);
-    Add_Property(p_element, "posx", int_to_string(static_cast<int>(m_start_pos_x)));
-    Add_Property(p_element, "posy", int_to_string(static_cast<int>(m_start_pos_y)));
+    Add_Property(writer, "type", m_type);
+    Add_Property(writer, "uid", m_uid);
+    Add_Property(writer, "posx", int_to_string(static_cast<int>(m_start_pos_x)));
+    Add_Property(writer, "posy", int_to_string(static_cast<int>(m_start_pos_y)));
     return false;
 }
 
@@ -609,12 +653,12 @@ void cSprite::Set_Image(cGL_Surface* new_image, bool new_start_image /* = 0 */,
         m_delete_image = del_img;
 
         // if no name is set use the first image name
-        if (m_name.empty()) {
-            m_name = m_image->m_name;
+        if (Editor_Data().m_name.empty()) {
+            Editor_Data().m_name = m_image->m_name;
         }
         // if no editor tags are set use the first image editor tags
-        if (m_editor_tags.empty()) {
-            m_editor_tags = m_image->m_editor_tags;
+        if (Editor_Data().m_editor_tags.empty()) {
+            Editor_Data().m_editor_tags = m_image->m_editor_tags;
         }
     }
     else {
@@ -636,7 +680,7 @@ void cSprite::Set_Image(cGL_Surface* new_image, bool new_start_image /* = 0 */,
 
             // always set the image name for basic sprites
             if (Is_Basic_Sprite()) {
-                m_name = m_start_image->m_name;
+                Editor_Data().m_name = m_start_image->m_name;
             }
         }
         else {
@@ -694,6 +738,7 @@ void cSprite::Set_Pos(float x, float y, bool new_startpos /* = 0 */)
 {
     m_pos_x = x;
     m_pos_y = y;
+    m_save_dirty = 1;
 
     if (new_startpos || (Is_Float_Equal(m_start_pos_x, 0.0f) && Is_Float_Equal(m_start_pos_y, 0.0f))) {
         m_start_pos_x = x;
@@ -706,6 +751,7 @@ void cSprite::Set_Pos(float x, float y, bool new_startpos /* = 0 */)
 void cSprite::Set_Pos_X(float x, bool new_startpos /* = 0 */)
 {
     m_pos_x = x;
+    m_save_dirty = 1;
 
     if (new_startpos) {
         m_start_pos_x = x;
@@ -717,6 +763,7 @@ void cSprite::Set_Pos_X(float x, bool new_startpos /* = 0 */)
 void cSprite::Set_Pos_Y(float y, bool new_startpos /* = 0 */)
 {
     m_pos_y = y;
+    m_save_dirty = 1;
 
     if (new_startpos) {
         m_start_pos_y = y;
@@ -733,6 +780,7 @@ void cSprite::Set_Active(bool enabled)
     }
 
     m_active = enabled;
+    m_save_dirty = 1;
 
     Update_Valid_Draw();
     Update_Valid_Update();
@@ -897,6 +945,7 @@ void cSprite::Set_On_Top(const cSprite* sprite, bool optimize_hor_pos /* = 1 */)
         m_pos_x = sprite->m_pos_x + sprite->m_col_rect.m_w / 3;
     }
 
+    m_save_dirty = 1;
     Update_Position_Rect();
 }
 
@@ -913,6 +962,7 @@ void cSprite::Move(float move_x, float move_y, const bool real /* = 0 */)
 
     m_pos_x += move_x;
     m_pos_y += move_y;
+    m_save_dirty = 1;
 
     Update_Position_Rect();
 }
@@ -1062,11 +1112,14 @@ void cSprite::Draw_Image(cSurface_Request* request /* = NULL */) const
 void cSprite::Draw_Image_Normal(cSurface_Request* request /* = NULL */) const
 {
     // texture id
-    request->m_texture_id = m_image->m_image;
+    request->m_texture_id = m_image->Get_Texture_ID();
 
     // size
     request->m_w = m_image->m_start_w;
     request->m_h = m_image->m_start_h;
+    request->m_tex_cover_w = m_image->m_tex_cover_w;
+    request->m_tex_cover_h = m_image->m_tex_cover_h;
+    request->m_opaque = m_image->m_opaque;
 
     // rotation
     request->m_rot_x += m_rot_x + m_image->m_base_rot_x;
@@ -1154,11 +1207,14 @@ void cSprite::Draw_Image_Normal(cSurface_Request* request /* = NULL */) const
 void cSprite::Draw_Image_Editor(cSurface_Request* request /* = NULL */) const
 {
     // texture id
-    request->m_texture_id = m_start_image->m_image;
+    request->m_texture_id = m_start_image->Get_Texture_ID();
 
     // size
     request->m_w = m_start_image->m_start_w;
     request->m_h = m_start_image->m_start_h;
+    request->m_tex_cover_w = m_start_image->m_tex_cover_w;
+    request->m_tex_cover_h = m_start_image->m_tex_cover_h;
+    request->m_opaque = m_start_image->m_opaque;
 
     // rotation
     request->m_rot_x += m_start_rot_x + m_start_image->m_base_rot_x;
@@ -1411,9 +1467,14 @@ void cSprite::Destroy(void)
 
     m_auto_destroy = 1;
     m_active = 0;
+    m_save_dirty = 1;
     m_valid_draw = 0;
     m_valid_update = 0;
     Set_Image(NULL, 1);
+
+    if (m_sprite_manager) {
+        m_sprite_manager->Destroyed(this);
+    }
 }
 
 /**
@@ -1511,13 +1572,13 @@ bool cSprite::Editor_Image_Text_Changed(const CEGUI::EventArgs& event)
 
 /**
  * This method should append all necessary components
- * to m_name and return the result as a new string.
+ * to Editor_Data().m_name and return the result as a new string.
  * This is how the object is presented to the user
- * in the editor. By default it just returns `m_name`.
+ * in the editor. By default it just returns `Editor_Data().m_name`.
  */
 std::string cSprite::Create_Name() const
 {
-    return m_name;
+    return Editor_Data().m_name;
 }
 
 /* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
@@ -19,6 +19,7 @@
 
 #include "../core/global_game.hpp"
 #include "../core/math/rect.hpp"
+#include "../core/xml_writer.hpp"
 #include "../video/video.hpp"
 #include "../video/img_set.hpp"
 #include "../core/collision.hpp"
@@ -26,6 +27,8 @@
 #include "../scripting/scripting.hpp"
 #include "../scripting/objects/sprites/mrb_sprite.hpp"
 
+#include <deque>
+
 namespace TSC {
 
     /* *** *** *** *** *** *** *** cCollidingSprite *** *** *** *** *** *** *** *** *** *** */
@@ -112,17 +115,67 @@ namespace TSC {
         cObjectCollision_List m_collisions;
     };
 
+    /* *** *** *** *** *** *** *** cSprite_Editor_Data *** *** *** *** *** *** *** *** *** *** */
+
+    /* Sprite data only used by the editor and for saving
+     * Kept in the cSprite_Editor_Data_Table instead of the sprite
+     * so the sprite itself stays small.
+    */
+    struct cSprite_Editor_Data {
+        /// image filename
+        std::string m_image_filename;
+        /// visible main name component for the user.
+        /// Additions such as direction are added behind this.
+        std::string m_name;
+        /// sprite editor tags. Only populated and used in relation
+        /// with the editor's object menu. See
+        /// cEditor::load_special_items() function. In normal
+        /// gameplay, this is empty.
+        std::string m_editor_tags;
+    };
+
+    /* Editor data of all sprites in one table instead of a heap
+     * allocation for each sprite. Slots of deleted sprites are reused.
+     * Only used from the main thread.
+    */
+    class cSprite_Editor_Data_Table {
+    public:
+        // Take a slot with empty data and return it
+        int Add(void);
+        // Give the slot back
+        void Remove(int slot);
+
+        cSprite_Editor_Data& Get(int slot)
+        {
+            return m_data[slot];
+        }
+        // Number of slots including free ones
+        size_t Get_Size(void) const
+        {
+            return m_data.size();
+        }
+
+    private:
+        // a deque keeps references to the data valid when it grows
+        std::deque<cSprite_Editor_Data> m_data;
+        std::vector<int> m_free_slots;
+    };
+
     /* *** *** *** *** *** *** *** cSprite *** *** *** *** *** *** *** *** *** *** */
 
     class cSprite : public cCollidingSprite, public cImageSet {
     public:
         // constructor
-        cSprite(cSprite_Manager* sprite_manager, const std::string type_name = "sprite");
+        cSprite(cSprite_Manager* sprite_manager, const char* type_name = "sprite");
         // create from stream
-        cSprite(XmlAttributes& attributes, cSprite_Manager* sprite_manager, const std::string type_name = "sprite");
+        cSprite(XmlAttributes& attributes, cSprite_Manager* sprite_manager, const char* type_name = "sprite");
         // destructor
         virtual ~cSprite(void);
 
+        // a copy would share the editor data slot, use Copy()
+        cSprite(const cSprite&) = delete;
+        cSprite& operator=(const cSprite&) = delete;
+
         // initialize defaults
         virtual void Init(void);
         /* late initialization
@@ -133,12 +186,12 @@ namespace TSC {
         virtual cSprite* Copy(void) const;
 
         /// Save the level below the given XML node.
-        virtual xmlpp::Element* Save_To_XML_Node(xmlpp::Element* p_element);
+        virtual void Save_To_XML_Node(cXml_Writer& writer);
 
         // load from savegame
         virtual void Load_From_Savegame(cSave_Level_Object* save_object) {};
         // save to savegame
-        virtual bool Save_To_Savegame_XML_Node(xmlpp::Element* p_element) const;
+        virtual bool Save_To_Savegame_XML_Node(cXml_Writer& writer) const;
 
         /// Sets the image for drawing
         virtual void Set_Image(cGL_Surface* new_image, bool new_start_image = 0, bool del_img = 0);
@@ -178,6 +231,13 @@ namespace TSC {
          {
              m_suppress_save = suppress;
          }
+        /* Set if state which is saved in savegames changed
+         * Only dirty sprites are saved in savegames.
+        */
+        void Set_Save_Dirty(bool enable = 1)
+        {
+            m_save_dirty = enable;
+        }
 
         // Sets the Position
         void Set_Pos(float x, float y, bool new_startpos = 0);
@@ -352,7 +412,7 @@ namespace TSC {
          */
         virtual mrb_value Create_MRuby_Object(mrb_state* p_state)
         {
-            return mrb_obj_value(Data_Wrap_Struct(p_state, mrb_class_get(p_state, "Sprite"), &Scripting::rtTSC_Scriptable, this));
+            return Scripting::Wrap_Sprite(p_state, mrb_class_get(p_state, "Sprite"), this);
         }
 
         /* Move this object
@@ -452,17 +512,16 @@ namespace TSC {
         // editor image text changed event
         bool Editor_Image_Text_Changed(const CEGUI::EventArgs& event);
 
+        /* The members are ordered by use. Those used in every update, draw
+         * and collision check come first, the start and editor values after
+         * them and the strings only used by the editor and for saving are
+         * in the editor data table.
+        */
+
         /// current image used for drawing
         cGL_Surface* m_image;
-        /// editor and first image
-        cGL_Surface* m_start_image;
-        /// image filename
-        std::string m_image_filename;
-
         /// complete image rect
         GL_rect m_rect;
-        /// editor and first image rect
-        GL_rect m_start_rect;
         /// collision rect
         GL_rect m_col_rect;
         /// collision start point
@@ -472,20 +531,6 @@ namespace TSC {
         float m_pos_x;
         float m_pos_y;
         float m_pos_z;
-        /// start position
-        float m_start_pos_x;
-        float m_start_pos_y;
-        /** editor z position
-         * it's only used if not 0
-        */
-        float m_editor_pos_z;
-
-        /// if set rotation not only affects the image but also the rectangle
-        bool m_rotation_affects_rect;
-        /// editor and start rotation
-        float m_start_rot_x;
-        float m_start_rot_y;
-        float m_start_rot_z;
         /// X rotation. Can only be "0" (no rotation) or "180" (mirror on X axis).
         float m_rot_x;
         /// Y rotation. Can only be "0" (no rotation) or "180" (mirror on Y axis).
@@ -496,19 +541,6 @@ namespace TSC {
         // FIXME: m_rot_x and m_rot_y should probably be renamed
         // to m_mirror_x and m_mirror_y, m_rot_z should be renamed
         // to m_rot(ation).
-
-        /// if set scale not only affects the image but also the rectangle
-        bool m_scale_affects_rect;
-        /** which parts of the image get scaled
-         * if all are set scaling is centered
-        */
-        bool m_scale_up;
-        bool m_scale_down;
-        bool m_scale_left;
-        bool m_scale_right;
-        /// editor and start scale
-        float m_start_scale_x;
-        float m_start_scale_y;
         /// scale
         float m_scale_x;
         float m_scale_y;
@@ -522,54 +554,96 @@ namespace TSC {
 
         /// sprite type
         SpriteType m_type;
-        /// internal type name
-        const std::string m_type_name;
         /// sprite array type
         ArrayType m_sprite_array;
         /// massive collision type
         MassiveType m_massive_type;
+        /// maximum distance to the camera to get updated
+        unsigned int m_camera_range;
+        /// ID to uniquely identify this sprite (UIDS[idhere] uses this)
+        int m_uid;
+        /// slot in the sprite manager or -1
+        int m_manager_slot;
+        /// shadow position
+        float m_shadow_pos;
+        /// shadow color
+        Color m_shadow_color;
 
-        /// sprite editor tags. Only populated and used in relation
-        /// with the editor's object menu. See
-        /// cEditor::load_special_items() function. In normal
-        /// gameplay, this is empty.
-        std::string m_editor_tags;
-
-        /// true if not using the camera position
-        bool m_no_camera;
         /// if true we are active and can be updated and drawn
         bool m_active;
+        /// if drawing is valid
+        bool m_valid_draw;
+        /// if updating is valid
+        bool m_valid_update;
+        /** if true this sprite is not used anywhere anymore
+         * and is ready to be replaced with a new sprite
+         * should not be used for objects needed by the editor
+         * should be used for not active spawned objects
+        */
+        bool m_auto_destroy;
+        /// true if not using the camera position
+        bool m_no_camera;
+        /// can be used as ground object
+        bool m_can_be_ground;
+        /// if set rotation not only affects the image but also the rectangle
+        bool m_rotation_affects_rect;
+        /// if set scale not only affects the image but also the rectangle
+        bool m_scale_affects_rect;
+        /** which parts of the image get scaled
+         * if all are set scaling is centered
+        */
+        bool m_scale_up;
+        bool m_scale_down;
+        bool m_scale_left;
+        bool m_scale_right;
         /// if spawned
         bool m_spawned;
         /// enable to prevent a spawned object from being saved
         bool m_suppress_save;
-        /// maximum distance to the camera to get updated
-        unsigned int m_camera_range;
-        /// can be used as ground object
-        bool m_can_be_ground;
-
+        /// if moved or changed since the level was loaded and needs to be in savegames
+        bool m_save_dirty;
         /// delete the given image when it gets unloaded
         bool m_delete_image;
         /// if this can not be auto-deleted because the object is controlled from elsewhere
         bool m_disallow_managed_delete;
-        /** if true this sprite is not used anywhere anymore
-         * and is ready to be replaced with a new sprite
-         * should not be used for objects needed by the editor
-         * should be used for not active spawned objects
+
+        /// editor and first image
+        cGL_Surface* m_start_image;
+        /// editor and first image rect
+        GL_rect m_start_rect;
+        /// start position
+        float m_start_pos_x;
+        float m_start_pos_y;
+        /** editor z position
+         * it's only used if not 0
         */
-        bool m_auto_destroy;
-        /// shadow position
-        float m_shadow_pos;
-        /// shadow color
-        Color m_shadow_color;
+        float m_editor_pos_z;
+        /// editor and start rotation
+        float m_start_rot_x;
+        float m_start_rot_y;
+        float m_start_rot_z;
+        /// editor and start scale
+        float m_start_scale_x;
+        float m_start_scale_y;
 
-        /// if drawing is valid
-        bool m_valid_draw;
-        /// if updating is valid
-        bool m_valid_update;
+        /// internal type name
+        const char* const m_type_name;
+        /// image filename, name and editor tags, takes a slot in the table on first use
+        cSprite_Editor_Data& Editor_Data(void)
+        {
+            if (m_editor_data_slot < 0) {
+                m_editor_data_slot = s_editor_data_table.Add();
+            }
 
-        /// ID to uniquely identify this sprite (UIDS[idhere] uses this)
-        int m_uid;
+            return s_editor_data_table.Get(m_editor_data_slot);
+        }
+        /// empty data if none was set yet
+        const cSprite_Editor_Data& Editor_Data(void) const
+        {
+            return m_editor_data_slot < 0 ? s_empty_editor_data : s_editor_data_table.Get(m_editor_data_slot);
+        }
+        /// editor data of all sprites
+        static cSprite_Editor_Data_Table s_editor_data_table;
 
         static const float m_pos_z_passive_start; ///< Start Z position for passive elements
         static const float m_pos_z_massive_start; ///< Start Z position for massive elements
@@ -582,12 +656,14 @@ namespace TSC {
         virtual std::string Create_Name() const;
 
     protected:
-        /// visible main name component for the user.
-        /// Additions such as direction are added behind this.
-        std::string m_name;
-
         /// XML type property.
         virtual std::string Get_XML_Type_Name();
+
+    private:
+        /// slot in s_editor_data_table or -1
+        int m_editor_data_slot;
+
+        static const cSprite_Editor_Data s_empty_editor_data;
     };
 
     typedef vector<cSprite*> cSprite_List;
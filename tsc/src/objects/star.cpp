@@ -61,7 +61,7 @@ void cjStar::Init(void)
     Add_Image_Set("main", "game/items/lemon.imgset");
     Set_Image_Set("main", 1);
 
-    m_name = _("Lemon");
+    Editor_Data().m_name = _("Lemon");
 }
 
 cjStar* cjStar::Copy(void) const
@@ -61,7 +61,7 @@ void cText_Box::Init(void)
     m_type = TYPE_TEXT_BOX;
     box_type = m_type;
     m_can_be_on_ground = 0;
-    m_name = _("Text Box");
+    Editor_Data().m_name = _("Text Box");
 
     // default is infinite times activate-able
     Set_Useable_Count(-1, 1);
@@ -89,14 +89,12 @@ void cText_Box::Load_From_XML(XmlAttributes& attributes)
     Set_Text(xml_string_to_string(attributes["text"]));
 }
 
-xmlpp::Element* cText_Box::Save_To_XML_Node(xmlpp::Element* p_element)
+void cText_Box::Save_To_XML_Node(cXml_Writer& writer)
 {
-    xmlpp::Element* p_node = cBaseBox::Save_To_XML_Node(p_element);
+    cBaseBox::Save_To_XML_Node(writer);
 
     // text
-    Add_Property(p_node, "text", m_text);
-
-    return p_node;
+    Add_Property(writer, "text", m_text);
 }
 
 void cText_Box::Activate(void)
@@ -59,7 +59,7 @@ namespace TSC {
         std::string m_text;
 
         // Save to node
-        virtual xmlpp::Element* Save_To_XML_Node(xmlpp::Element* p_element);
+        virtual void Save_To_XML_Node(cXml_Writer& writer);
 
     protected:
         // typename inherited
@@ -32,6 +32,7 @@
 #include "../core/i18n.hpp"
 #include "../core/filesystem/filesystem.hpp"
 #include "../core/filesystem/resource_manager.hpp"
+#include "../core/filesystem/file_writer.hpp"
 #include "overworld_description_loader.hpp"
 #include "overworld_layer_loader.hpp"
 #include "overworld_loader.hpp"
@@ -63,34 +64,23 @@ void cOverworld_description::Save(void)
 {
     fs::path filename = pResource_Manager->Get_User_World(path_to_utf8(m_path.filename())) / utf8_to_path("description.xml");
 
-    try {
-        Save_To_File(filename);
-    }
-    catch (xmlpp::exception& e) {
-        cerr << "Failed to save world description file '" << path_to_utf8(filename) << "': " << e.what() << endl;
-        gp_hud->Set_Text(_("Couldn't save world description ") + path_to_utf8(filename));
-        return;
-    }
+    // written in the background, failures are shown by Update_Game()
+    Save_To_File(filename);
 }
 
 void cOverworld_description::Save_To_File(fs::path path)
 {
-#ifdef USE_LIBXMLPP3
-    xmlpp::Document doc;
-    xmlpp::Element* p_root = doc.create_root_node("description");
-    xmlpp::Element* p_node = p_root->add_child_element("world");
-#else
-    xmlpp::Document doc;
-    xmlpp::Element* p_root = doc.create_root_node("description");
-    xmlpp::Element* p_node = p_root->add_child("world");
-#endif
+    cXml_Writer writer;
+    writer.Start_Element("description");
+    writer.Start_Element("world");
 
-    Add_Property(p_node, "name", m_name);
-    Add_Property(p_node, "visible", m_visible);
+    Add_Property(writer, "name", m_name);
+    Add_Property(writer, "visible", m_visible);
 
-    // Write to file (raises xmlpp::exception on error)
-    doc.write_to_file_formatted(Glib::filename_from_utf8(path_to_utf8(path)));
-    debug_print("Wrote world description file '%s'.\n", path_to_utf8(path).c_str());
+    writer.End_Element();
+    writer.End_Element();
+
+    pFile_Writer->Write(path, writer.Get_Data());
 }
 
 fs::path cOverworld_description::Get_Path()
@@ -119,6 +109,9 @@ cOverworld* cOverworld::Load_From_Directory(fs::path directory, int user_dir /*
     // loading the main world file and loading the layers file.
     debug_print("Loading world from directory '%s'\n", path_to_utf8(directory).c_str());
 
+    // the files may still be written
+    pFile_Writer->Wait();
+
     //////// Step 1: Description file ////////
     cOverworldDescriptionLoader descloader;
     cOverworld_description* p_desc = NULL;
@@ -236,15 +229,8 @@ void cOverworld::Save(void)
         fs::create_directories(save_dir);
     }
 
-    try {
-        Save_To_Directory(save_dir);
-    }
-    catch (xmlpp::exception& e) {
-        cerr << "Error: Could not save overworld '" << path_to_utf8(save_dir) << "': " << e.what() << endl
-             << "Is the directory read-only?" << endl;
-        gp_hud->Set_Text(_("Couldn't save world ") + path_to_utf8(save_dir));
-        return;
-    }
+    // the files are written in the background, failures are shown by Update_Game()
+    Save_To_Directory(save_dir);
 
     // show info
     gp_hud->Set_Text(_("World ") + m_description->m_name + _(" saved"));
@@ -262,47 +248,36 @@ void cOverworld::Save_To_Directory(fs::path path)
 
 void cOverworld::Save_To_File(fs::path path)
 {
-    xmlpp::Document doc;
-    xmlpp::Element* p_root = doc.create_root_node("overworld");
-    xmlpp::Element* p_node = NULL;
+    cXml_Writer writer;
+    writer.Start_Element("overworld");
 
     // General information
-#ifdef USE_LIBXMLPP3
-    p_node = p_root->add_child_element("information");
-#else
-    p_node = p_root->add_child("information");
-#endif
-    Add_Property(p_node, "game_version", int_to_string(TSC_VERSION_MAJOR) + "." + int_to_string(TSC_VERSION_MINOR) + "." + int_to_string(TSC_VERSION_PATCH));
-    Add_Property(p_node, "engine_version", world_engine_version);
-    Add_Property(p_node, "save_time", static_cast<uint64_t>(time(NULL))); // seconds since 1970
+    writer.Start_Element("information");
+    Add_Property(writer, "game_version", int_to_string(TSC_VERSION_MAJOR) + "." + int_to_string(TSC_VERSION_MINOR) + "." + int_to_string(TSC_VERSION_PATCH));
+    Add_Property(writer, "engine_version", world_engine_version);
+    Add_Property(writer, "save_time", static_cast<uint64_t>(time(NULL))); // seconds since 1970
+    writer.End_Element();
 
     // Settings (currently only music)
-#ifdef USE_LIBXMLPP3
-    p_node = p_root->add_child_element("settings");
-    Add_Property(p_node, "music", m_musicfile);
-#else
-    p_node = p_root->add_child("settings");
-    Add_Property(p_node, "music", m_musicfile);
-#endif
+    writer.Start_Element("settings");
+    Add_Property(writer, "music", m_musicfile);
+    writer.End_Element();
 
     // Background color
-#ifdef USE_LIBXMLPP3
-    p_node = p_root->add_child_element("background");
-#else
-    p_node = p_root->add_child("background");
-#endif
-    Add_Property(p_node, "color_red", static_cast<int>(m_background_color.red));
-    Add_Property(p_node, "color_green", static_cast<int>(m_background_color.green));
-    Add_Property(p_node, "color_blue", static_cast<int>(m_background_color.blue));
+    writer.Start_Element("background");
+    Add_Property(writer, "color_red", static_cast<int>(m_background_color.red));
+    Add_Property(writer, "color_green", static_cast<int>(m_background_color.green));
+    Add_Property(writer, "color_blue", static_cast<int>(m_background_color.blue));
+    writer.End_Element();
 
     // Player
-#ifdef USE_LIBXMLPP3
-    p_node = p_root->add_child_element("player");
-#else
-    p_node = p_root->add_child("player");
-#endif
-    Add_Property(p_node, "waypoint", m_player_start_waypoint);
-    Add_Property(p_node, "moving_state", static_cast<int>(m_player_moving_state));
+    writer.Start_Element("player");
+    Add_Property(writer, "waypoint", m_player_start_waypoint);
+    Add_Property(writer, "moving_state", static_cast<int>(m_player_moving_state));
+    writer.End_Element();
+
+    // in the array order of the editor
+    m_sprite_manager->Compact();
 
     cSprite_List::const_iterator iter;
     for (iter = m_sprite_manager->objects.begin(); iter != m_sprite_manager->objects.end(); iter++) {
@@ -311,13 +286,18 @@ void cOverworld::Save_To_File(fs::path path)
         // Skip spawned and destroyed objects
         if (p_sprite->m_spawned || p_sprite->m_auto_destroy)
             continue;
+        // Skip layer lines which are saved into the layer file
+        if (p_sprite->m_type == TYPE_OW_LINE_START || p_sprite->m_type == TYPE_OW_LINE_END)
+            continue;
 
         // Save below this node
-        p_sprite->Save_To_XML_Node(p_root);
+        writer.Start_Element(p_sprite->m_type_name);
+        p_sprite->Save_To_XML_Node(writer);
+        writer.End_Element();
     }
 
-    doc.write_to_file_formatted(Glib::filename_from_utf8(path_to_utf8(path)));
-    debug_print("Wrote world file '%s'.\n", path_to_utf8(path).c_str());
+    writer.End_Element();
+    pFile_Writer->Write(path, writer.Get_Data());
 }
 
 void cOverworld::Enter(const GameMode old_mode /* = MODE_NOTHING */)
@@ -478,6 +458,9 @@ void cOverworld::Process_Input()
 
 void cOverworld::Update(void)
 {
+    // delete removed objects before anything iterates them
+    m_sprite_manager->Compact();
+
     if (!editor_world_enabled) {
         // Camera
         Update_Camera();
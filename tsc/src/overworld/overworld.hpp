@@ -36,7 +36,7 @@ namespace TSC {
         // Save
         void Save(void);
 
-        // Save to the given file. Raises xmlpp::exception on error.
+        // Save to the given file in the background with pFile_Writer.
         void Save_To_File(boost::filesystem::path path);
 
         // Full path to the world directory
@@ -87,7 +87,7 @@ namespace TSC {
         // Save
         void Save(void);
 
-        // Save to the given directory. Raises xmlpp::exception on error.
+        // Save to the given directory in the background with pFile_Writer.
         void Save_To_Directory(boost::filesystem::path path);
 
         // Enter
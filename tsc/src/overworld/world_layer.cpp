@@ -21,6 +21,7 @@
 #include "../core/i18n.hpp"
 #include "../overworld/world_editor.hpp"
 #include "../core/filesystem/resource_manager.hpp"
+#include "../core/filesystem/file_writer.hpp"
 #include "../core/xml_attributes.hpp"
 #include "../core/sprite_manager.hpp"
 #include "../core/editor/editor.hpp"
@@ -47,11 +48,11 @@ cLayer_Line_Point::cLayer_Line_Point(cSprite_Manager* sprite_manager, cOverworld
     if (m_type == TYPE_OW_LINE_START) {
         m_pos_z += 0.001f;
         m_color = orange;
-        m_name = _("Line Start Point");
+        Editor_Data().m_name = _("Line Start Point");
     }
     else {
         m_color = red;
-        m_name = _("Line End Point");
+        Editor_Data().m_name = _("Line End Point");
     }
 
     m_rect.m_w = 4;
@@ -76,12 +77,10 @@ cLayer_Line_Point::~cLayer_Line_Point(void)
     }
 }
 
-xmlpp::Element* cLayer_Line_Point::Save_To_XML_Node(xmlpp::Element* p_element)
+void cLayer_Line_Point::Save_To_XML_Node(cXml_Writer& writer)
 {
-    // Do NOT call parent class’ method as we are no real sprite.
-    // We are being saved into the world description file, so no
-    // need to duplicate nonsensical entries in world.xml.
-    return NULL;
+    // Nothing to add as we are no real sprite. The lines are saved
+    // into the layer file and cOverworld::Save_To_File() skips us.
 }
 
 void cLayer_Line_Point::Draw(cSurface_Request* request /* = NULL */)
@@ -342,12 +341,12 @@ void cLayer::Add(cLayer_Line_Point_Start* line_point)
     cObject_Manager<cLayer_Line_Point_Start>::Add(line_point);
 
     // check if in sprite manager
-    if (m_overworld->m_sprite_manager->Get_Array_Num(line_point) == -1) {
+    if (!m_overworld->m_sprite_manager->Is_Managed(line_point)) {
         // add start point
         m_overworld->m_sprite_manager->Add(line_point);
     }
     // check if in sprite manager
-    if (m_overworld->m_sprite_manager->Get_Array_Num(line_point->m_linked_point) == -1) {
+    if (!m_overworld->m_sprite_manager->Is_Managed(line_point->m_linked_point)) {
         // add end point
         m_overworld->m_sprite_manager->Add(line_point->m_linked_point);
     }
@@ -368,31 +367,29 @@ cLayer_Line_Point_Start* cLayer::Get_Line_Start_By_UID(int uid)
 
 void cLayer::Save_To_File(const fs::path& path)
 {
-    xmlpp::Document doc;
-    xmlpp::Element* p_root = doc.create_root_node("layer");
+    cXml_Writer writer;
+    writer.Start_Element("layer");
 
     // lines
     LayerLineList::const_iterator iter;
     for (iter=objects.begin(); iter != objects.end(); iter++) {
         cLayer_Line_Point_Start* p_line = *iter;
-#ifdef USE_LIBXMLPP3
-        xmlpp::Element* p_node = p_root->add_child_element("line");
-#else
-        xmlpp::Element* p_node = p_root->add_child("line");
-#endif
+        writer.Start_Element("line");
 
         // start
-        Add_Property(p_node, "X1", static_cast<int>(p_line->Get_Line_Pos_X()));
-        Add_Property(p_node, "Y1", static_cast<int>(p_line->Get_Line_Pos_Y()));
+        Add_Property(writer, "X1", static_cast<int>(p_line->Get_Line_Pos_X()));
+        Add_Property(writer, "Y1", static_cast<int>(p_line->Get_Line_Pos_Y()));
         // end
-        Add_Property(p_node, "X2", static_cast<int>(p_line->m_linked_point->Get_Line_Pos_X()));
-        Add_Property(p_node, "Y2", static_cast<int>(p_line->m_linked_point->Get_Line_Pos_Y()));
+        Add_Property(writer, "X2", static_cast<int>(p_line->m_linked_point->Get_Line_Pos_X()));
+        Add_Property(writer, "Y2", static_cast<int>(p_line->m_linked_point->Get_Line_Pos_Y()));
         // origin
-        Add_Property(p_node, "origin", p_line->m_origin);
+        Add_Property(writer, "origin", p_line->m_origin);
+
+        writer.End_Element();
     }
 
-    doc.write_to_file_formatted(Glib::filename_from_utf8(path_to_utf8(path)));
-    debug_print("Wrote world layer file '%s'.\n", path_to_utf8(path).c_str());
+    writer.End_Element();
+    pFile_Writer->Write(path, writer.Get_Data());
 }
 
 void cLayer::Delete_All(void)
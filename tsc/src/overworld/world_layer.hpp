@@ -35,7 +35,7 @@ namespace TSC {
         // destructor
         virtual ~cLayer_Line_Point(void);
 
-        virtual xmlpp::Element* Save_To_XML_Node(xmlpp::Element* p_element);
+        virtual void Save_To_XML_Node(cXml_Writer& writer);
 
         // draw
         virtual void Draw(cSurface_Request* request = NULL);
@@ -134,7 +134,7 @@ namespace TSC {
         // Add a layer line
         virtual void Add(cLayer_Line_Point_Start* line_point);
 
-        // Save to file, raises xmlpp::exception on failure
+        // Save to file, written in the background by pFile_Writer
         void Save_To_File(const boost::filesystem::path& filename);
 
         // Delete all objects
@@ -38,7 +38,7 @@ cOverworld_Player::cOverworld_Player(cSprite_Manager* sprite_manager, cOverworld
     m_pos_z = 0.0999f;
     m_massive_type = MASS_MASSIVE;
     m_camera_range = 0;
-    m_name = "Alex";
+    Editor_Data().m_name = "Alex";
 
     m_overworld = overworld;
     m_current_waypoint = -2; // no waypoint
@@ -52,6 +52,16 @@ void cWorld_Sprite_Manager::Add(cSprite* sprite)
     }
 }
 
+void cWorld_Sprite_Manager::Destroyed(cSprite* sprite)
+{
+    // waypoints are referenced by their number and stay
+    if (sprite->m_type == TYPE_OW_WAYPOINT) {
+        return;
+    }
+
+    cSprite_Manager::Destroyed(sprite);
+}
+
 /* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
 
 } // namespace TSC
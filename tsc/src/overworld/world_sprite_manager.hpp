@@ -32,6 +32,8 @@ namespace TSC {
 
         // Add a sprite
         virtual void Add(cSprite* sprite);
+        // Called by cSprite::Destroy()
+        virtual void Destroyed(cSprite* sprite);
 
         // parent overworld
         cOverworld* m_overworld;
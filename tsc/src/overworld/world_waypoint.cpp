@@ -123,7 +123,7 @@ void cWaypoint::Init(void)
     m_camera_range = 0;
 
     m_waypoint_type = WAYPOINT_NORMAL;
-    m_name = _("Waypoint");
+    Editor_Data().m_name = _("Waypoint");
 
     m_access = 0;
     m_access_default = 0;
@@ -163,24 +163,24 @@ std::string cWaypoint::Get_XML_Type_Name()
     return int_to_string(m_waypoint_type);
 }
 
-xmlpp::Element* cWaypoint::Save_To_XML_Node(xmlpp::Element* p_element)
+void cWaypoint::Save_To_XML_Node(cXml_Writer& writer)
 {
-    xmlpp::Element* p_node = cSprite::Save_To_XML_Node(p_element);
+    cSprite::Save_To_XML_Node(writer);
 
     // destination
-    Add_Property(p_node, "destination", m_destination);
+    Add_Property(writer, "destination", m_destination);
 
     // The following attributes only affect pre 2.1.0 worlds.
 
     if (m_direction_backward != DIR_UNDEFINED)
         // direction backward
-        Add_Property(p_node, "direction_backward", Get_Direction_Name(m_direction_backward));
+        Add_Property(writer, "direction_backward", Get_Direction_Name(m_direction_backward));
     if (m_direction_forward != DIR_UNDEFINED)
         // direction forward
-        Add_Property(p_node, "direction_forward", Get_Direction_Name(m_direction_forward));
+        Add_Property(writer, "direction_forward", Get_Direction_Name(m_direction_forward));
 
     // access
-    Add_Property(p_node, "access", m_access_default);
+    Add_Property(writer, "access", m_access_default);
 
     // post-2.1.0 way of saving waypoint exits. Note that this is rather ugly
     // XML, but TSC's XML loader does not support nested tags as of now. Everything
@@ -189,13 +189,11 @@ xmlpp::Element* cWaypoint::Save_To_XML_Node(xmlpp::Element* p_element)
         std::string str_pos = int_to_string(i);
         const waypoint_exit& exit  = m_exits[i];
 
-        Add_Property(p_node, "waypoint_exit_" + str_pos + "_direction", Get_Direction_Name(exit.direction));
-        Add_Property(p_node, "waypoint_exit_" + str_pos + "_level_exit_name", exit.level_exit_name);
-        Add_Property(p_node, "waypoint_exit_" + str_pos + "_line_start_uid", exit.line_start_uid);
-        Add_Property(p_node, "waypoint_exit_" + str_pos + "_locked", exit.locked);
+        Add_Property(writer, "waypoint_exit_" + str_pos + "_direction", Get_Direction_Name(exit.direction));
+        Add_Property(writer, "waypoint_exit_" + str_pos + "_level_exit_name", exit.level_exit_name);
+        Add_Property(writer, "waypoint_exit_" + str_pos + "_line_start_uid", exit.line_start_uid);
+        Add_Property(writer, "waypoint_exit_" + str_pos + "_locked", exit.locked);
     }
-
-    return p_node;
 }
 
 void cWaypoint::Update(void)
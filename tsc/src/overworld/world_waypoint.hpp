@@ -155,7 +155,7 @@ namespace TSC {
         CEGUI::Editbox* mp_wp_exit_uid_edit;
 
         // Save to node
-        virtual xmlpp::Element* Save_To_XML_Node(xmlpp::Element* p_element);
+        virtual void Save_To_XML_Node(cXml_Writer& writer);
     protected:
         virtual std::string Get_XML_Type_Name();
     private:
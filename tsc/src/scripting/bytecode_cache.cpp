@@ -0,0 +1,268 @@
+/***************************************************************************
+ * bytecode_cache.cpp - Cache for precompiled mruby bytecode
+ *
+ * Copyright © 2012-2020 The TSC Contributors
+ ***************************************************************************
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "bytecode_cache.hpp"
+#include <cstdio>
+#include <iostream>
+#include <iterator>
+#include <boost/filesystem/fstream.hpp>
+#include <mruby/dump.h>
+#include <mruby/proc.h>
+#include <mruby/version.h>
+
+namespace fs = boost::filesystem;
+using namespace TSC;
+using namespace TSC::Scripting;
+
+// Limit of the in-memory table, level scripts are a few KiB each
+static const size_t MEMORY_CACHE_MAX_BYTES = 4 * 1024 * 1024;
+
+/* Cache file header: this magic (includes the format version), the
+ * mruby release number as 4 bytes and the FNV-1a hash of the bytecode
+ * as 8 bytes, both little endian. Change the magic if the format changes. */
+static const char CACHE_FILE_MAGIC[8] = {'T', 'S', 'C', 'M', 'R', 'B', '0', '1'};
+static const size_t CACHE_FILE_HEADER_SIZE = 8 + 4 + 8;
+
+std::map<std::string, cBytecode_Cache::Memory_Entry> cBytecode_Cache::s_memory_cache;
+std::list<std::string> cBytecode_Cache::s_memory_order;
+size_t cBytecode_Cache::s_memory_bytes = 0;
+std::mutex cBytecode_Cache::s_mutex;
+unsigned long cBytecode_Cache::s_hits = 0;
+unsigned long cBytecode_Cache::s_misses = 0;
+
+cBytecode_Cache::cBytecode_Cache(const fs::path& shipped_dir, const fs::path& writable_dir)
+    : m_shipped_dir(shipped_dir), m_writable_dir(writable_dir)
+{
+    //
+}
+
+// Continue the 64-bit FNV-1a hash `hash' over `data'
+static uint64_t Hash_FNV1a(uint64_t hash, const std::string& data)
+{
+    for (unsigned char c : data) {
+        hash ^= c;
+        hash *= 1099511628211ULL;
+    }
+
+    return hash;
+}
+
+static const uint64_t FNV1A_OFFSET_BASIS = 14695981039346656037ULL;
+
+static void Append_LE(std::string& str, uint64_t value, unsigned int bytes)
+{
+    for (unsigned int i = 0; i < bytes; i++) {
+        str += static_cast<char>((value >> (8 * i)) & 0xff);
+    }
+}
+
+static uint64_t Read_LE(const std::string& str, size_t pos, unsigned int bytes)
+{
+    uint64_t value = 0;
+
+    for (unsigned int i = 0; i < bytes; i++) {
+        value |= static_cast<uint64_t>(static_cast<unsigned char>(str[pos + i])) << (8 * i);
+    }
+
+    return value;
+}
+
+/**
+ * Builds the file name for the cached bytecode of `code'. This is a
+ * 64-bit FNV-1a hash over the mruby release number, the context name
+ * and the code itself, so that bytecode produced by a different mruby
+ * version or for different source is never picked up.
+ */
+std::string cBytecode_Cache::Cache_Filename(const std::string& code, const std::string& contextname)
+{
+    std::string key = std::to_string(MRUBY_RELEASE_NO) + '\0' + contextname + '\0';
+    uint64_t hash = Hash_FNV1a(Hash_FNV1a(FNV1A_OFFSET_BASIS, key), code);
+
+    char buf[17];
+    snprintf(buf, sizeof(buf), "%016llx", static_cast<unsigned long long>(hash));
+    return std::string(buf) + ".mrb";
+}
+
+bool cBytecode_Cache::Lookup(const std::string& code, const std::string& contextname, std::string& bytecode)
+{
+    std::string filename = Cache_Filename(code, contextname);
+    std::lock_guard<std::mutex> lock(s_mutex);
+
+    std::map<std::string, Memory_Entry>::iterator iter = s_memory_cache.find(filename);
+    if (iter != s_memory_cache.end()) {
+        // most recently used
+        s_memory_order.splice(s_memory_order.begin(), s_memory_order, iter->second.m_order);
+        bytecode = iter->second.m_bytecode;
+        s_hits++;
+        return true;
+    }
+
+    if ((!m_shipped_dir.empty() && Read_File(m_shipped_dir / filename, bytecode)) ||
+        (!m_writable_dir.empty() && Read_File(m_writable_dir / filename, bytecode))) {
+        Memory_Store(filename, bytecode);
+        s_hits++;
+        return true;
+    }
+
+    s_misses++;
+    return false;
+}
+
+void cBytecode_Cache::Store(const std::string& code, const std::string& contextname, const std::string& bytecode)
+{
+    std::string filename = Cache_Filename(code, contextname);
+    std::lock_guard<std::mutex> lock(s_mutex);
+
+    Memory_Store(filename, bytecode);
+
+    if (m_writable_dir.empty())
+        return;
+
+    // Write to a temporary file first and rename it afterwards, so
+    // that a crash never leaves a truncated cache file behind.
+    fs::path target = m_writable_dir / filename;
+    fs::path temp = m_writable_dir / (filename + ".tmp");
+
+    fs::ofstream file(temp, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        std::cerr << "Warning: Failed to write mruby bytecode cache file '" << temp.string() << "'" << std::endl;
+        return;
+    }
+
+    std::string header(CACHE_FILE_MAGIC, sizeof(CACHE_FILE_MAGIC));
+    Append_LE(header, MRUBY_RELEASE_NO, 4);
+    Append_LE(header, Hash_FNV1a(FNV1A_OFFSET_BASIS, bytecode), 8);
+
+    file.write(header.data(), header.size());
+    file.write(bytecode.data(), bytecode.size());
+    file.close();
+
+    boost::system::error_code ec;
+    fs::rename(temp, target, ec);
+    if (ec) {
+        std::cerr << "Warning: Failed to write mruby bytecode cache file '" << target.string() << "': " << ec.message() << std::endl;
+        fs::remove(temp, ec);
+    }
+}
+
+bool cBytecode_Cache::Compile(mrb_state* p_state, const std::string& code, const std::string& contextname, std::string& bytecode)
+{
+    int arena = mrb_gc_arena_save(p_state);
+
+    mrbc_context* p_context = mrbc_context_new(p_state);
+    p_context->capture_errors = true;
+    p_context->no_exec = true;
+    p_context->lineno = 1;
+    mrbc_filename(p_state, p_context, contextname.c_str());
+
+    bool result = false;
+    struct mrb_parser_state* p_parser = mrb_parse_nstring(p_state, code.c_str(), code.length(), p_context);
+
+    if (p_parser && p_parser->tree && p_parser->nerr == 0) {
+        struct RProc* p_proc = mrb_generate_code(p_state, p_parser);
+
+        if (p_proc) {
+            uint8_t* p_bin = NULL;
+            size_t bin_size = 0;
+
+            if (mrb_dump_irep(p_state, p_proc->body.irep, DUMP_DEBUG_INFO, &p_bin, &bin_size) == MRB_DUMP_OK) {
+                bytecode.assign(reinterpret_cast<char*>(p_bin), bin_size);
+                result = true;
+            }
+
+            mrb_free(p_state, p_bin);
+        }
+    }
+
+    if (p_parser)
+        mrb_parser_free(p_parser);
+
+    mrbc_context_free(p_state, p_context);
+    mrb_gc_arena_restore(p_state, arena);
+
+    return result;
+}
+
+unsigned long cBytecode_Cache::Get_Hits()
+{
+    std::lock_guard<std::mutex> lock(s_mutex);
+    return s_hits;
+}
+
+unsigned long cBytecode_Cache::Get_Misses()
+{
+    std::lock_guard<std::mutex> lock(s_mutex);
+    return s_misses;
+}
+
+bool cBytecode_Cache::Read_File(const fs::path& path, std::string& bytecode)
+{
+    boost::system::error_code ec;
+    if (!fs::is_regular_file(path, ec))
+        return false;
+
+    fs::ifstream file(path, std::ios::in | std::ios::binary);
+    if (!file.is_open())
+        return false;
+
+    std::string contents((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    if (contents.size() <= CACHE_FILE_HEADER_SIZE || contents.compare(0, sizeof(CACHE_FILE_MAGIC), CACHE_FILE_MAGIC, sizeof(CACHE_FILE_MAGIC)) != 0) {
+        std::cerr << "Warning: Ignoring mruby bytecode cache file '" << path.string() << "' with unknown format" << std::endl;
+        return false;
+    }
+    if (Read_LE(contents, sizeof(CACHE_FILE_MAGIC), 4) != MRUBY_RELEASE_NO) {
+        std::cerr << "Warning: Ignoring mruby bytecode cache file '" << path.string() << "' from another mruby release" << std::endl;
+        return false;
+    }
+
+    uint64_t checksum = Read_LE(contents, sizeof(CACHE_FILE_MAGIC) + 4, 8);
+    contents.erase(0, CACHE_FILE_HEADER_SIZE);
+
+    if (Hash_FNV1a(FNV1A_OFFSET_BASIS, contents) != checksum) {
+        std::cerr << "Warning: Ignoring corrupt mruby bytecode cache file '" << path.string() << "'" << std::endl;
+        return false;
+    }
+
+    bytecode.swap(contents);
+    return true;
+}
+
+/**
+ * Adds `bytecode' as the most recently used entry and drops the least
+ * recently used ones while the table is over MEMORY_CACHE_MAX_BYTES.
+ * The new entry itself is always kept. s_mutex must be locked.
+ */
+void cBytecode_Cache::Memory_Store(const std::string& filename, const std::string& bytecode)
+{
+    std::map<std::string, Memory_Entry>::iterator iter = s_memory_cache.find(filename);
+
+    if (iter != s_memory_cache.end()) {
+        s_memory_bytes -= iter->second.m_bytecode.size();
+        s_memory_order.erase(iter->second.m_order);
+        s_memory_cache.erase(iter);
+    }
+
+    s_memory_order.push_front(filename);
+    Memory_Entry& entry = s_memory_cache[filename];
+    entry.m_bytecode = bytecode;
+    entry.m_order = s_memory_order.begin();
+    s_memory_bytes += bytecode.size();
+
+    while (s_memory_bytes > MEMORY_CACHE_MAX_BYTES && s_memory_order.size() > 1) {
+        iter = s_memory_cache.find(s_memory_order.back());
+        s_memory_bytes -= iter->second.m_bytecode.size();
+        s_memory_cache.erase(iter);
+        s_memory_order.pop_back();
+    }
+}
@@ -0,0 +1,101 @@
+/***************************************************************************
+ * bytecode_cache.hpp - Cache for precompiled mruby bytecode
+ *
+ * Copyright © 2012-2020 The TSC Contributors
+ ***************************************************************************
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TSC_SCRIPTING_BYTECODE_CACHE_HPP
+#define TSC_SCRIPTING_BYTECODE_CACHE_HPP
+
+/* This file intentionally does not include global_basic.hpp, because
+ * it is also compiled into the tsc-mrbcache build tool, which
+ * precompiles the scripting library at build time and does not link
+ * against CEGUI, SFML & co. */
+#include <string>
+#include <map>
+#include <list>
+#include <mutex>
+#include <cstdint>
+#include <boost/filesystem.hpp>
+#include <mruby.h>
+#include <mruby/compile.h>
+
+namespace TSC {
+    namespace Scripting {
+
+        /* Cache for compiled mruby code (RITE bytecode). Entries are
+         * keyed by a hash over the source code and the context name,
+         * so a changed script automatically misses the cache.
+         *
+         * Lookups check an in-memory table first, then the read-only
+         * directory with bytecode shipped with the game (produced at
+         * build time by tsc-mrbcache), and finally the user’s writable
+         * cache directory. Stores go to the in-memory table and to
+         * the writable directory, if any. The in-memory table drops
+         * the least recently used entries above a size limit. Cache
+         * files start with a header holding the mruby release and a
+         * checksum of the bytecode; files not matching it are ignored
+         * and the code is compiled again. This class is threadsafe.
+         */
+        class cBytecode_Cache {
+        public:
+            /* `shipped_dir' is searched for bytecode, but never
+             * written to. `writable_dir' is where newly compiled
+             * bytecode is stored. Either may be empty. */
+            cBytecode_Cache(const boost::filesystem::path& shipped_dir, const boost::filesystem::path& writable_dir);
+
+            /* Retrieve the bytecode for `code' into `bytecode'. Returns
+             * false on a cache miss, in which case `bytecode' is not
+             * touched. */
+            bool Lookup(const std::string& code, const std::string& contextname, std::string& bytecode);
+            // Store compiled bytecode for `code'.
+            void Store(const std::string& code, const std::string& contextname, const std::string& bytecode);
+
+            /* Compile `code' into bytecode, without executing it.
+             * Returns false if the code has syntax errors; `bytecode'
+             * is not touched then. Debug information (filename and
+             * line numbers) is retained so that backtraces stay
+             * meaningful. */
+            static bool Compile(mrb_state* p_state, const std::string& code, const std::string& contextname, std::string& bytecode);
+            // Name of the cache file for the given code.
+            static std::string Cache_Filename(const std::string& code, const std::string& contextname);
+
+            // Number of cache hits and misses since program start.
+            static unsigned long Get_Hits();
+            static unsigned long Get_Misses();
+        private:
+            boost::filesystem::path m_shipped_dir;
+            boost::filesystem::path m_writable_dir;
+
+            // Read a cache file, returns false if missing or its header doesn't match
+            static bool Read_File(const boost::filesystem::path& path, std::string& bytecode);
+            // Add to the in-memory table and drop the least recently used entries
+            static void Memory_Store(const std::string& filename, const std::string& bytecode);
+
+            struct Memory_Entry {
+                std::string m_bytecode;
+                // position in s_memory_order
+                std::list<std::string>::iterator m_order;
+            };
+
+            // Bytecode already loaded during this run, by cache filename
+            static std::map<std::string, Memory_Entry> s_memory_cache;
+            // Cache filenames, most recently used first
+            static std::list<std::string> s_memory_order;
+            static size_t s_memory_bytes;
+            static std::mutex s_mutex;
+            static unsigned long s_hits;
+            static unsigned long s_misses;
+        };
+    };
+};
+
+#endif
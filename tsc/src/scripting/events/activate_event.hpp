@@ -25,6 +25,7 @@ namespace TSC {
             {
                 return "activate";
             }
+            MRUBY_EVENT_ID(activate)
         };
     }
 }
@@ -26,6 +26,7 @@ namespace TSC {
             {
                 return "die";
             }
+            MRUBY_EVENT_ID(die)
         };
     }
 }
@@ -23,6 +23,7 @@ namespace TSC {
         public:
             cDowngrade_Event(int downgrades, int max_downgrades);
             virtual std::string Event_Name();
+            MRUBY_EVENT_ID(downgrade)
             int Get_Downgrades();
             int Get_Max_Downgrades();
         protected:
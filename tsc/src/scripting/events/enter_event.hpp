@@ -27,6 +27,7 @@ namespace TSC {
             {
                 return "enter";
             }
+            MRUBY_EVENT_ID(enter)
         };
 
     }
@@ -20,6 +20,11 @@ using namespace TSC;
 using namespace TSC::Scripting;
 using namespace std;
 
+unsigned int cEvent::s_fired = 0;
+unsigned int cEvent::s_dispatched = 0;
+unsigned int cEvent::s_fired_last_frame = 0;
+unsigned int cEvent::s_dispatched_last_frame = 0;
+
 /**
  * Cycles through all registered event handlers for the event
  * name returned by the Event_Name() method and calls the
@@ -27,27 +32,48 @@ using namespace std;
  * documentation for more information on this.
  *
  * For subclasses, you don’t want to override Fire(), but rather
- * Run_MRuby_Callback() and Event_Name().
+ * Run_MRuby_Callback(), Event_Name() and Event_ID().
  */
 void cEvent::Fire(cMRuby_Interpreter* p_mruby, Scripting::cScriptable_Object* p_obj)
 {
-    // Menu level has no mruby interpreter
-    if (!p_mruby)
+    s_fired++;
+
+    // Menu level has no mruby interpreter. Most objects do not
+    // have any handlers, so bail out as early as possible.
+    unsigned int id = Event_ID();
+    if (!p_mruby || !p_obj->may_have_event_handlers(id))
+        return;
+
+    std::vector<mrb_value>* p_handlers = p_obj->get_event_handlers(id);
+    if (!p_handlers)
         return;
+
+    s_dispatched++;
     mrb_state* p_state = p_mruby->Get_MRuby_State();
 
-    // Iterate through the list of callbacks and execute them
-    std::string evtname = Event_Name();
-    std::vector<mrb_value>::iterator start = p_obj->event_handlers_begin(evtname);
-    std::vector<mrb_value>::iterator end = p_obj->event_handlers_end(evtname);
+    /* Run the handlers registered when the event was fired. A callback
+     * may register or clear handlers itself, then the list is looked
+     * up again. Objects are not deleted while their handlers run,
+     * sprites only in cSprite_Manager::Compact(). */
+    unsigned int version = p_obj->get_handlers_version();
+    size_t count = p_handlers->size();
 
-    std::vector<mrb_value>::iterator iter;
-    for (iter=start; iter != end; iter++) {
-        Run_MRuby_Callback(p_mruby, *iter);
+    for (size_t i = 0; i < count; i++) {
+        Run_MRuby_Callback(p_mruby, (*p_handlers)[i]);
         if (p_state->exc) {
             cerr << "Warning: Error running mruby handler:" << endl;
             mrb_print_error(p_state);
         }
+
+        if (p_obj->get_handlers_version() != version) {
+            version = p_obj->get_handlers_version();
+            p_handlers = p_obj->get_event_handlers(id);
+
+            if (!p_handlers)
+                break;
+
+            count = std::min(count, p_handlers->size());
+        }
     }
 }
 
@@ -65,6 +91,35 @@ std::string cEvent::Event_Name()
     return "generic";
 }
 
+/**
+ * Returns the ID of the event name as per Intern_Event_Name(). The
+ * default implementation interns the return value of Event_Name()
+ * each time it is called; subclasses should use the MRUBY_EVENT_ID
+ * macro to do that only once, as this is called on every Fire().
+ */
+unsigned int cEvent::Event_ID()
+{
+    return Intern_Event_Name(Event_Name());
+}
+
+void cEvent::Next_Frame()
+{
+    s_fired_last_frame = s_fired;
+    s_dispatched_last_frame = s_dispatched;
+    s_fired = 0;
+    s_dispatched = 0;
+}
+
+unsigned int cEvent::Get_Fired_Count()
+{
+    return s_fired_last_frame;
+}
+
+unsigned int cEvent::Get_Dispatched_Count()
+{
+    return s_dispatched_last_frame;
+}
+
 /**
  * Called whenever a MRuby callback shall be run. The callback is
  * passed as a mruby lambda via the `callback' argument.
@@ -42,6 +42,16 @@
 // by MRUBY_IMPLEMENT_EVENT.
 #define MRUBY_EVENT_HANDLER(evtname) Scripting_Event_On_##evtname
 
+// Implements Event_ID() for an event class, interning `evtname'
+// only once. Put this into the class declaration. `evtname' must
+// be what Event_Name() returns.
+#define MRUBY_EVENT_ID(evtname) \
+    virtual unsigned int Event_ID() \
+    { \
+    static const unsigned int id = Intern_Event_Name(#evtname); \
+    return id; \
+    }
+
 namespace TSC {
     namespace Scripting {
         // TODO: Pass the cMruby_Interpreter instance to the constructor!
@@ -51,8 +61,21 @@ namespace TSC {
         public:
             void Fire(cMRuby_Interpreter* p_mruby, Scripting::cScriptable_Object* p_obj);
             virtual std::string Event_Name();
+            virtual unsigned int Event_ID();
+
+            // Start counting the events of a new frame.
+            static void Next_Frame();
+            // Events fired and events that actually had handlers
+            // to run in the previous frame.
+            static unsigned int Get_Fired_Count();
+            static unsigned int Get_Dispatched_Count();
         protected:
             virtual void Run_MRuby_Callback(cMRuby_Interpreter* p_mruby, mrb_value callback);
+        private:
+            static unsigned int s_fired;
+            static unsigned int s_dispatched;
+            static unsigned int s_fired_last_frame;
+            static unsigned int s_dispatched_last_frame;
         };
     };
 };
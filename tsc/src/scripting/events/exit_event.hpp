@@ -24,6 +24,7 @@ namespace TSC {
             {
                 return "exit";
             }
+            MRUBY_EVENT_ID(exit)
         };
     }
 }
@@ -26,6 +26,7 @@ namespace TSC {
             {
                 return "gold_100";
             }
+            MRUBY_EVENT_ID(gold_100)
         };
     }
 }
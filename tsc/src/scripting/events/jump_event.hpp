@@ -26,6 +26,7 @@ namespace TSC {
             {
                 return "jump";
             }
+            MRUBY_EVENT_ID(jump)
         };
     }
 }
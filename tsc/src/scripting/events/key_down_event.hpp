@@ -23,6 +23,7 @@ namespace TSC {
         public:
             cKeyDown_Event(std::string keyname);
             virtual std::string Event_Name();
+            MRUBY_EVENT_ID(key_down)
             std::string Get_Keyname();
         protected:
             virtual void Run_MRuby_Callback(cMRuby_Interpreter* p_mruby, mrb_value callback);
@@ -23,6 +23,7 @@ namespace TSC {
         public:
             cLevel_Load_Event(std::string save_data);
             virtual std::string Event_Name();
+            MRUBY_EVENT_ID(load)
             std::string Get_Save_Data();
         protected:
             virtual void Run_MRuby_Callback(cMRuby_Interpreter* p_mruby, mrb_value callback);
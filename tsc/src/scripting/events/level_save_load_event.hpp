@@ -24,6 +24,7 @@ namespace TSC {
         public:
             cLevel_SaveLoad_Event(bool is_save);
             virtual std::string Event_Name();
+            MRUBY_EVENT_ID(save_load)
             std::vector<Script_Data> Get_Storage();
             void Set_Storage(const std::vector<Script_Data>& storage);
         protected:
@@ -23,6 +23,7 @@ namespace TSC {
         public:
             cShoot_Event(std::string ball_type);
             virtual std::string Event_Name();
+            MRUBY_EVENT_ID(shoot)
             std::string Get_Ball_Type();
         protected:
             virtual void Run_MRuby_Callback(cMRuby_Interpreter* p_mruby, mrb_value callback);
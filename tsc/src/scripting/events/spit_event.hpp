@@ -25,6 +25,7 @@ namespace TSC {
             {
                 return "spit";
             }
+            MRUBY_EVENT_ID(spit)
         };
     }
 }
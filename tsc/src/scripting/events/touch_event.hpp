@@ -23,6 +23,7 @@ namespace TSC {
         public:
             cTouch_Event(cSprite* p_collided);
             virtual std::string Event_Name();
+            MRUBY_EVENT_ID(touch)
             cSprite* Get_Collided();
         protected:
             virtual void Run_MRuby_Callback(cMRuby_Interpreter* p_mruby, mrb_value callback);
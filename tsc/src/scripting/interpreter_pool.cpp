@@ -0,0 +1,151 @@
+/***************************************************************************
+ * interpreter_pool.cpp - Pool of pre-initialised mruby interpreters
+ *
+ * Copyright © 2012-2020 The TSC Contributors
+ ***************************************************************************
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "interpreter_pool.hpp"
+#include "../core/filesystem/resource_manager.hpp"
+#include "../core/filesystem/filesystem.hpp"
+
+using namespace TSC;
+using namespace TSC::Scripting;
+
+cMRuby_Interpreter_Pool::cMRuby_Interpreter_Pool(unsigned int size /* = 1 */)
+{
+    m_size = size;
+    m_warming = false;
+}
+
+cMRuby_Interpreter_Pool::~cMRuby_Interpreter_Pool()
+{
+    Clear();
+}
+
+cMRuby_Interpreter* cMRuby_Interpreter_Pool::Acquire(cLevel* p_level)
+{
+    // If an interpreter is just being warmed, waiting for
+    // it is never slower than building another one.
+    if (m_thread.joinable())
+        m_thread.join();
+
+    cMRuby_Interpreter* p_mruby = NULL;
+    {
+        boost::lock_guard<boost::mutex> lock(m_mutex);
+        if (!m_ready.empty()) {
+            p_mruby = m_ready.back();
+            m_ready.pop_back();
+        }
+    }
+
+    if (p_mruby) {
+        debug_print("Scripting engine: using pre-initialised mruby interpreter\n");
+        p_mruby->Set_Level(p_level);
+    }
+    else {
+        p_mruby = new cMRuby_Interpreter(p_level);
+    }
+
+    // Prepare the next one while this level plays
+    Refill();
+
+    return p_mruby;
+}
+
+void cMRuby_Interpreter_Pool::Release(cMRuby_Interpreter* p_mruby)
+{
+    if (p_mruby)
+        delete p_mruby;
+}
+
+void cMRuby_Interpreter_Pool::Refill()
+{
+    {
+        boost::lock_guard<boost::mutex> lock(m_mutex);
+        if (m_warming || m_ready.size() >= m_size)
+            return;
+    }
+
+    // A previous warming thread has finished, reap it
+    if (m_thread.joinable())
+        m_thread.join();
+
+    // If not possible, Acquire() creates interpreters on demand as it always did
+    if (!Can_Warm_In_Background())
+        return;
+
+    {
+        boost::lock_guard<boost::mutex> lock(m_mutex);
+        m_warming = true;
+    }
+    m_thread = boost::thread(&cMRuby_Interpreter_Pool::Warm, this);
+}
+
+void cMRuby_Interpreter_Pool::Clear()
+{
+    if (m_thread.joinable())
+        m_thread.join();
+
+    boost::lock_guard<boost::mutex> lock(m_mutex);
+    for (cMRuby_Interpreter* p_mruby : m_ready)
+        delete p_mruby;
+
+    m_ready.clear();
+}
+
+unsigned int cMRuby_Interpreter_Pool::Get_Ready_Count()
+{
+    boost::lock_guard<boost::mutex> lock(m_mutex);
+    return m_ready.size();
+}
+
+void cMRuby_Interpreter_Pool::Warm()
+{
+    while (true) {
+        {
+            boost::lock_guard<boost::mutex> lock(m_mutex);
+            if (m_ready.size() >= m_size) {
+                m_warming = false;
+                return;
+            }
+        }
+
+        cMRuby_Interpreter* p_mruby = new cMRuby_Interpreter(NULL, true);
+
+        boost::lock_guard<boost::mutex> lock(m_mutex);
+        m_ready.push_back(p_mruby);
+    }
+}
+
+/* The scripting library shipped with TSC only defines classes and
+ * modules when loaded, which is safe to do on another thread. User
+ * expansion packs may run arbitrary code at load time instead, for
+ * example register event handlers, which accesses the game state.
+ * Interpreters are hence only warmed in the background if there are
+ * none installed. */
+bool cMRuby_Interpreter_Pool::Can_Warm_In_Background()
+{
+    boost::filesystem::path dir = pResource_Manager->Get_User_Scripting_Directory();
+    if (!Dir_Exists(dir))
+        return true;
+
+    for (boost::filesystem::directory_iterator diter(dir); diter != boost::filesystem::directory_iterator(); diter++) {
+        if (boost::filesystem::is_directory(diter->path()))
+            return false;
+    }
+
+    return true;
+}
+
+/* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
+
+/// The interpreter pool used for all levels
+cMRuby_Interpreter_Pool* TSC::pMRuby_Pool = NULL;
@@ -0,0 +1,78 @@
+/***************************************************************************
+ * interpreter_pool.hpp - Pool of pre-initialised mruby interpreters
+ *
+ * Copyright © 2012-2020 The TSC Contributors
+ ***************************************************************************
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TSC_SCRIPTING_INTERPRETER_POOL_HPP
+#define TSC_SCRIPTING_INTERPRETER_POOL_HPP
+#include "scripting.hpp"
+
+namespace TSC {
+    namespace Scripting {
+
+        /* Setting up an mruby interpreter (mrb_open(), all the Init_*
+         * wrapper functions and the scripting library) is expensive, and
+         * each level needs a fresh one. This class keeps interpreters
+         * that have been set up ahead of time, but have not yet run any
+         * level code, and hands them out to levels on request.
+         *
+         * Used interpreters are not put back into the pool. Level scripts
+         * can change any global state (classes, constants, globals) and
+         * mruby has no means to snapshot and restore a heap, so an
+         * interpreter is only clean before it was handed out. Instead,
+         * a replacement is warmed on a background thread while the
+         * level plays. Returning an interpreter deletes it, which tears
+         * down event handlers and timers exactly as before.
+         */
+        class cMRuby_Interpreter_Pool {
+        public:
+            // Keep up to `size' interpreters ready.
+            cMRuby_Interpreter_Pool(unsigned int size = 1);
+            ~cMRuby_Interpreter_Pool();
+
+            // Hand out a clean interpreter for `p_level'. If none is
+            // ready, one is created right away. Afterwards, refilling
+            // the pool is started in the background.
+            cMRuby_Interpreter* Acquire(cLevel* p_level);
+            // Give back an interpreter obtained with Acquire(). This
+            // deletes it. NULL is accepted and ignored.
+            void Release(cMRuby_Interpreter* p_mruby);
+
+            // Start warming interpreters in the background until the
+            // pool is full. Does nothing if that is already going on.
+            void Refill();
+            // Wait for the background warming, then delete all
+            // interpreters that are ready.
+            void Clear();
+
+            // Number of interpreters ready for use.
+            unsigned int Get_Ready_Count();
+        private:
+            // Creates interpreters until the pool is full (thread function).
+            void Warm();
+            // Whether warming may happen on another thread.
+            bool Can_Warm_In_Background();
+
+            unsigned int m_size;
+            // Whether the background thread is running (guarded by m_mutex)
+            bool m_warming;
+            std::vector<cMRuby_Interpreter*> m_ready;
+            boost::mutex m_mutex;
+            boost::thread m_thread;
+        };
+    };
+
+    // The interpreter pool used for all levels
+    extern Scripting::cMRuby_Interpreter_Pool* pMRuby_Pool;
+};
+
+#endif
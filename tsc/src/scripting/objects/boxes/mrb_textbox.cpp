@@ -54,6 +54,7 @@ static mrb_value Initialize(mrb_state* p_state, mrb_value self)
 
     // Let TSC manage the memory
     pActive_Level->m_sprite_manager->Add(p_box);
+    Set_Sprite_Data(p_state, self, p_box);
 
     return self;
 }
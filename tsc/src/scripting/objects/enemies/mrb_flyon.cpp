@@ -57,6 +57,7 @@ static mrb_value Initialize(mrb_state* p_state, mrb_value self)
 
     // Let TSC manager the memory
     pActive_Level->m_sprite_manager->Add(p_flyon);
+    Set_Sprite_Data(p_state, self, p_flyon);
 
     return self;
 }
@@ -76,6 +76,7 @@ static mrb_value Initialize(mrb_state* p_state, mrb_value self)
 
     p_ball->Set_Spawned(true);
     pActive_Level->m_sprite_manager->Add(p_ball);
+    Set_Sprite_Data(p_state, self, p_ball);
 
     return self;
 }
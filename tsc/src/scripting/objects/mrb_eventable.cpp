@@ -51,7 +51,7 @@ mrb_value Bind(mrb_state* p_state, mrb_value self)
     mrb_value callback;
     mrb_get_args(p_state, "z&", &evtname, &callback);
 
-    Scripting::cScriptable_Object* p_obj = (Scripting::cScriptable_Object*) DATA_PTR(self);
+    Scripting::cScriptable_Object* p_obj = (Scripting::cScriptable_Object*) Scripting::Get_Data(p_state, self);
     if (!p_obj)
         mrb_raise(p_state, MRB_RUNTIME_ERROR(p_state), "No associated C++ object found.");
 
@@ -64,21 +64,17 @@ static mrb_value _Index(mrb_state* p_state, mrb_value cache, mrb_value ruid)
 
     // Otherwise, allocate a new MRuby object for it and store
     // that new object in the cache.
-    cSprite_List objs = pActive_Level->m_sprite_manager->objects; // Shorthand
-    mrb_int uid = mrb_fixnum(ruid);
-    for (cSprite_List::const_iterator iter = objs.begin(); iter != objs.end(); iter++) {
-        if ((*iter)->m_uid == uid) {
-            // Ask the sprite to create the correct type of MRuby object
-            // so we don’t have to maintain a static C++/MRuby type mapping table
-            mrb_value obj = (*iter)->Create_MRuby_Object(p_state);
-            // Store it in the cache
-            mrb_hash_set(p_state, cache, ruid, obj);
-
-            return obj;
-        }
-    }
+    cSprite* p_sprite = pActive_Level->m_sprite_manager->Get_by_UID(mrb_fixnum(ruid));
+    if (!p_sprite || p_sprite->m_auto_destroy)
+        return mrb_nil_value();
 
-    return mrb_nil_value();
+    // Ask the sprite to create the correct type of MRuby object
+    // so we don’t have to maintain a static C++/MRuby type mapping table
+    mrb_value obj = p_sprite->Create_MRuby_Object(p_state);
+    // Store it in the cache
+    mrb_hash_set(p_state, cache, ruid, obj);
+
+    return obj;
 }
 
 /**
@@ -90,9 +86,8 @@ static mrb_value _Index(mrb_state* p_state, mrb_value cache, mrb_value ruid)
  *
  * Retrieve an MRuby object for the sprite with the unique identifier
  * C<uid>. The first time you call this method with a given UID, it
- * will cycle through I<all> sprite objects in the level, so it will
- * take relatively long. The sprite object is then cached internally,
- * causing later lookups to be fast.
+ * has to create the MRuby object for the sprite. The sprite object
+ * is then cached internally, causing later lookups to be fast.
  *
  * =head4 Parameters
  *
@@ -217,11 +212,13 @@ static mrb_value Cached_UIDs(mrb_state* p_state, mrb_value self)
     return mrb_hash_keys(p_state, mrb_iv_get(p_state, self, mrb_intern_cstr(p_state, "cache")));
 }
 
-// FIXME: Call Scripting::Delete_UID_From_Cache for sprites
-// being removed from a level’s cSprite_Manager!
+// Called by cSprite_Manager for sprites being removed from it.
 void TSC::Scripting::Delete_UID_From_Cache(mrb_state* p_state, int uid)
 {
     mrb_value cache = mrb_iv_get(p_state, mrb_obj_value(mrb_class_get(p_state, "UIDS")), mrb_intern_cstr(p_state, "cache"));
+
+    // Scripts still holding the object get an exception as its
+    // handle no longer resolves, but the UID may be used again.
     mrb_hash_delete_key(p_state, cache, mrb_fixnum_value(uid));
 }
 
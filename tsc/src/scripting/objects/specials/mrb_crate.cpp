@@ -56,6 +56,7 @@ static mrb_value Initialize(mrb_state* p_state, mrb_value self)
 
     p_crate->Set_Spawned(true);
     pActive_Level->m_sprite_manager->Add(p_crate);
+    Set_Sprite_Data(p_state, self, p_crate);
 
     return self;
 }
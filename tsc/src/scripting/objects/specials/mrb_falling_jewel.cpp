@@ -48,6 +48,7 @@ static mrb_value Initialize(mrb_state* p_state, mrb_value self)
 
     p_fj->Set_Spawned(true);
     pActive_Level->m_sprite_manager->Add(p_fj);
+    Set_Sprite_Data(p_state, self, p_fj);
 
     return self;
 }
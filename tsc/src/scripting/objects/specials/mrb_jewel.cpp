@@ -66,6 +66,7 @@ static mrb_value Initialize(mrb_state* p_state, mrb_value self)
 
     p_jewel->Set_Spawned(true);
     pActive_Level->m_sprite_manager->Add(p_jewel);
+    Set_Sprite_Data(p_state, self, p_jewel);
 
     return self;
 }
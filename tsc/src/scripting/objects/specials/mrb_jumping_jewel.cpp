@@ -46,6 +46,7 @@ static mrb_value Initialize(mrb_state* p_state, mrb_value self)
 
     p_jj->Set_Spawned(true);
     pActive_Level->m_sprite_manager->Add(p_jj);
+    Set_Sprite_Data(p_state, self, p_jj);
 
     return self;
 }
@@ -45,6 +45,7 @@ static mrb_value Initialize(mrb_state* p_state, mrb_value self)
 
     p_plat->Set_Spawned(true);
     pActive_Level->m_sprite_manager->Add(p_plat);
+    Set_Sprite_Data(p_state, self, p_plat);
 
     return self;
 }
@@ -155,6 +155,8 @@ static mrb_value Initialize(mrb_state* p_state, mrb_value self)
 
     // Add to the sprite manager for automatic memory management by TSC
     pActive_Level->m_sprite_manager->Add(p_sprite);
+    // Scripts may keep this object after the sprite was deleted
+    Set_Sprite_Data(p_state, self, p_sprite);
 
     return self;
 }
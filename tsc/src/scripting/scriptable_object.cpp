@@ -15,6 +15,8 @@
 #include "scriptable_object.hpp"
 #include "../level/level.hpp"
 #include "../core/property_helper.hpp"
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/lock_guard.hpp>
 
 using namespace TSC;
 using namespace TSC::Scripting;
@@ -38,9 +40,25 @@ using namespace TSC::Scripting;
  * member by employing clear_event_handlers() with its level name
  * passed. */
 
+unsigned int TSC::Scripting::Intern_Event_Name(const std::string& evtname)
+{
+    static boost::mutex ids_mutex;
+    static std::unordered_map<std::string, unsigned int> ids;
+
+    boost::lock_guard<boost::mutex> lock(ids_mutex);
+
+    std::unordered_map<std::string, unsigned int>::iterator iter = ids.find(evtname);
+    if (iter != ids.end())
+        return iter->second;
+
+    unsigned int id = ids.size();
+    ids[evtname] = id;
+    return id;
+}
+
 cScriptable_Object::cScriptable_Object()
 {
-    //
+    m_handlers_version = 0;
 }
 
 cScriptable_Object::~cScriptable_Object()
@@ -77,7 +95,10 @@ void cScriptable_Object::clear_event_handlers(const std::string& levelname /* =
     if (levelname.empty())
         m_callbacks.clear();
     else
-        m_callbacks[levelname].clear();
+        m_callbacks.erase(levelname);
+
+    m_handlers_version++;
+    update_event_mask();
 }
 
 /**
@@ -94,36 +115,65 @@ void cScriptable_Object::clear_event_handlers(const std::string& levelname /* =
  */
 void cScriptable_Object::register_event_handler(const std::string& evtname, mrb_value callback)
 {
-    m_callbacks[get_active_level_name()][evtname].push_back(callback);
-}
+    unsigned int id = Intern_Event_Name(evtname);
+    std::vector<std::vector<mrb_value> >& handlers = m_callbacks[get_active_level_name()];
 
-/**
- * Start iterator for the list of callbacks registered for the
- * given event name.
- *
- * \param evtname Name of the event you want the handlers for.
- *
- * \returns Iterator pointing to the first callback.
- */
-std::vector<mrb_value>::iterator cScriptable_Object::event_handlers_begin(const std::string& evtname)
-{
-    return m_callbacks[get_active_level_name()][evtname].begin();
+    if (handlers.size() <= id)
+        handlers.resize(id + 1);
+
+    handlers[id].push_back(callback);
+    m_handlers_version++;
+    add_to_event_mask(id);
 }
 
 /**
- * Stop iterator for the list of callbacks registered for the
- * given event name.
+ * List of callbacks registered for the given event in the
+ * currently active level.
  *
- * \param evtname Name of the event you want the handlers for.
+ * \param evtid ID of the event you want the handlers for, as
+ * returned by Intern_Event_Name().
  *
- * \returns Iterator pointing post the last callback (termination iterator).
+ * \returns Pointer to the list of callbacks, or NULL if there
+ * are none. The pointer is invalidated when event handlers are
+ * registered or cleared, see get_handlers_version().
  */
-std::vector<mrb_value>::iterator cScriptable_Object::event_handlers_end(const std::string& evtname)
+std::vector<mrb_value>* cScriptable_Object::get_event_handlers(unsigned int evtid)
 {
-    return m_callbacks[get_active_level_name()][evtname].end();
+    if (!may_have_event_handlers(evtid))
+        return NULL;
+
+    std::map<std::string, std::vector<std::vector<mrb_value> > >::iterator iter = m_callbacks.find(get_active_level_name());
+    if (iter == m_callbacks.end() || iter->second.size() <= evtid || iter->second[evtid].empty())
+        return NULL;
+
+    return &iter->second[evtid];
 }
 
 std::string cScriptable_Object::get_active_level_name()
 {
     return path_to_utf8(pActive_Level->m_level_filename.stem());
 }
+
+void cScriptable_Object::update_event_mask()
+{
+    m_event_mask.clear();
+
+    std::map<std::string, std::vector<std::vector<mrb_value> > >::const_iterator iter;
+    for (iter = m_callbacks.begin(); iter != m_callbacks.end(); iter++) {
+        for (unsigned int id = 0; id < iter->second.size(); id++) {
+            if (!iter->second[id].empty())
+                add_to_event_mask(id);
+        }
+    }
+}
+
+void cScriptable_Object::add_to_event_mask(unsigned int evtid)
+{
+    unsigned int word = evtid / 64;
+
+    if (m_event_mask.size() <= word)
+        m_event_mask.resize(word + 1, 0);
+
+    m_event_mask[word] |= static_cast<uint64_t>(1) << (evtid % 64);
+}
+
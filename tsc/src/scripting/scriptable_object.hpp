@@ -19,6 +19,12 @@
 namespace TSC {
     namespace Scripting {
 
+        /* Map an event name to a compact integer ID. The first name
+         * interned gets 0, the next 1 and so on; interning the same
+         * name again returns the same ID. Thread-safe, as interpreters
+         * are prepared on another thread. */
+        unsigned int Intern_Event_Name(const std::string& evtname);
+
         /**
          * This class encapsulates the stuff that is common
          * to all objects exposed to the mruby scripting
@@ -31,16 +37,35 @@ namespace TSC {
 
             void clear_event_handlers(const std::string& levelname = "");
             void register_event_handler(const std::string& evtname, mrb_value callback);
-            std::vector<mrb_value>::iterator event_handlers_begin(const std::string& evtname);
-            std::vector<mrb_value>::iterator event_handlers_end(const std::string& evtname);
+            std::vector<mrb_value>* get_event_handlers(unsigned int evtid);
+
+            // Cheap check whether handlers for the event are registered in
+            // any level. get_event_handlers() returns those of the active one.
+            inline bool may_have_event_handlers(unsigned int evtid) const
+            {
+                unsigned int word = evtid / 64;
+                return word < m_event_mask.size() && (m_event_mask[word] & (static_cast<uint64_t>(1) << (evtid % 64))) != 0;
+            }
+            // Changes whenever handlers are registered or cleared
+            inline unsigned int get_handlers_version() const
+            {
+                return m_handlers_version;
+            }
 
         protected:
-            /// Mapping of level + event names and registered callbacks.
+            /// Mapping of level names to the callbacks registered,
+            /// indexed by event ID (see Intern_Event_Name()).
             /// Example in ruby syntax:
-            /// {"mylevel" => {"myevent" => [handle1, handle2]}, "mevent2" => ["handle3"]}
-            std::map<std::string, std::map<std::string, std::vector<mrb_value> > > m_callbacks;
+            /// {"mylevel" => [[handle1, handle2], [], ["handle3"]]}
+            std::map<std::string, std::vector<std::vector<mrb_value> > > m_callbacks;
+            /// Bit for each event ID with callbacks in any level, 64 IDs
+            /// per element. Empty for objects without callbacks.
+            std::vector<uint64_t> m_event_mask;
+            unsigned int m_handlers_version;
         private:
             std::string get_active_level_name();
+            void update_event_mask();
+            void add_to_event_mask(unsigned int evtid);
         };
     };
 };
@@ -77,13 +77,28 @@
 #include "objects/specials/mrb_crate.hpp"
 #include "objects/specials/mrb_moving_platform.hpp"
 #include "../core/global_basic.hpp"
+#include <mruby/irep.h>
+#include <mruby/gc.h>
+#include <chrono>
 
 ////////////////////////////////////////
 // Be sure to review docs/scripting.md!
 ////////////////////////////////////////
 
+// A sprite as referenced by the MRuby objects of rtTSC_Sprite
+struct cSprite_Ref {
+    TSC::cSprite_Manager* mp_manager;
+    TSC::cSprite_Handle m_handle;
+};
+
+static void Free_Sprite_Ref(mrb_state* p_state, void* ptr)
+{
+    delete static_cast<cSprite_Ref*>(ptr);
+}
+
 // Extern
 mrb_data_type TSC::Scripting::rtTSC_Scriptable = {"TscScriptable", NULL};
+mrb_data_type TSC::Scripting::rtTSC_Sprite = {"TscSprite", Free_Sprite_Ref};
 
 using namespace std;
 
@@ -91,10 +106,65 @@ namespace TSC {
 
 namespace Scripting {
 
-cMRuby_Interpreter::cMRuby_Interpreter(cLevel* p_level)
+/* Sprites in a sprite manager are deleted by it while scripts may
+ * still hold their MRuby objects, so those only store a handle which
+ * no longer resolves once the sprite was removed. Sprites outside of a
+ * manager, like the level player, live as long as the interpreter.
+ */
+void* Get_Data(mrb_state* p_state, mrb_value obj)
+{
+    if (mrb_type(obj) == MRB_TT_DATA && DATA_TYPE(obj) == &rtTSC_Sprite) {
+        cSprite_Ref* p_ref = static_cast<cSprite_Ref*>(DATA_PTR(obj));
+        cSprite* p_sprite = p_ref->mp_manager->Get_Sprite(p_ref->m_handle);
+
+        if (!p_sprite) {
+            mrb_raise(p_state, MRB_RUNTIME_ERROR(p_state), "This sprite was removed from the level.");
+            return NULL; // Not reached
+        }
+
+        return p_sprite;
+    }
+
+    return mrb_data_get_ptr(p_state, obj, &rtTSC_Scriptable);
+}
+
+mrb_value Wrap_Sprite(mrb_state* p_state, struct RClass* p_class, cSprite* p_sprite)
+{
+    // not in a manager
+    if (!p_sprite->m_sprite_manager || !p_sprite->m_sprite_manager->Is_Managed(p_sprite)) {
+        return mrb_obj_value(Data_Wrap_Struct(p_state, p_class, &rtTSC_Scriptable, p_sprite));
+    }
+
+    cSprite_Ref* p_ref = new cSprite_Ref;
+    p_ref->mp_manager = p_sprite->m_sprite_manager;
+    p_ref->m_handle = p_sprite->m_sprite_manager->Get_Handle(p_sprite);
+
+    return mrb_obj_value(Data_Wrap_Struct(p_state, p_class, &rtTSC_Sprite, p_ref));
+}
+
+void Set_Sprite_Data(mrb_state* p_state, mrb_value self, cSprite* p_sprite)
+{
+    // not added or already set
+    if (!p_sprite->m_sprite_manager->Is_Managed(p_sprite) || DATA_TYPE(self) == &rtTSC_Sprite) {
+        return;
+    }
+
+    cSprite_Ref* p_ref = new cSprite_Ref;
+    p_ref->mp_manager = p_sprite->m_sprite_manager;
+    p_ref->m_handle = p_sprite->m_sprite_manager->Get_Handle(p_sprite);
+
+    DATA_PTR(self) = p_ref;
+    DATA_TYPE(self) = &rtTSC_Sprite;
+}
+
+cMRuby_Interpreter::cMRuby_Interpreter(cLevel* p_level, bool off_main_thread /* = false */)
+    : m_bytecode_cache(pResource_Manager->Get_Game_Scripting_Bytecode_Directory(),
+                       pResource_Manager->Get_User_Scriptcache_Directory())
 {
     // Set member variables
     mp_level = p_level;
+    m_off_main_thread = off_main_thread;
+    m_gc_step_us = 0;
     mp_mruby = mrb_open();
 
     // Create console context (execution context for the game console)
@@ -107,25 +177,30 @@ cMRuby_Interpreter::cMRuby_Interpreter(cLevel* p_level)
     Load_Wrappers();
     // Load scripting library
     Load_Scripts();
+    // From now on, only collect garbage when told to
+    Init_GC();
 }
 
 cMRuby_Interpreter::~cMRuby_Interpreter()
 {
     /* When the mruby interpreter gets deleted, all remaining mruby objects
      * (mrb_value instances) are invalidated. Therefore, we wipe all the
-     * existing event callbacks here. */
-    std::string levelname = path_to_utf8(pActive_Level->m_level_filename.stem());
-    cSprite_List::iterator iter;
-    for (iter = mp_level->m_sprite_manager->objects.begin(); iter != mp_level->m_sprite_manager->objects.end(); iter++) {
-        cSprite* p_sprite = *iter;
-        p_sprite->clear_event_handlers(levelname); // Would probably work fine without the level name (→ total clearing) as these sprites do not live longer than the level itself anyway
+     * existing event callbacks here. An interpreter that was never handed
+     * to a level cannot have any. */
+    if (mp_level) {
+        std::string levelname = path_to_utf8(pActive_Level->m_level_filename.stem());
+        cSprite_List::iterator iter;
+        for (iter = mp_level->m_sprite_manager->objects.begin(); iter != mp_level->m_sprite_manager->objects.end(); iter++) {
+            cSprite* p_sprite = *iter;
+            p_sprite->clear_event_handlers(levelname); // Would probably work fine without the level name (→ total clearing) as these sprites do not live longer than the level itself anyway
+        }
+        // These objects stay alive even though a level ends. Only wipe those
+        // handlers for our own level.
+        pAudio->clear_event_handlers(levelname);
+        pKeyboard->clear_event_handlers(levelname);
+        pSavegame->clear_event_handlers(levelname);
+        pLevel_Player->clear_event_handlers(levelname);
     }
-    // These objects stay alive even though a level ends. Only wipe those
-    // handlers for our own level.
-    pAudio->clear_event_handlers(levelname);
-    pKeyboard->clear_event_handlers(levelname);
-    pSavegame->clear_event_handlers(levelname);
-    pLevel_Player->clear_event_handlers(levelname);
 
     // Get all the registered timers from mruby
     mrb_value klass = mrb_obj_value(mrb_class_get(mp_mruby, "Timer"));
@@ -167,6 +242,12 @@ cLevel* cMRuby_Interpreter::Get_Level()
     return mp_level;
 }
 
+void cMRuby_Interpreter::Set_Level(cLevel* p_level)
+{
+    mp_level = p_level;
+    m_off_main_thread = false;
+}
+
 mrb_value cMRuby_Interpreter::Run_Code_In_Context(const std::string& code, mrbc_context* p_context)
 {
     mrb_value retval = mrb_load_nstring_cxt(mp_mruby, code.c_str(), code.length(), p_context);
@@ -182,6 +263,15 @@ mrb_value cMRuby_Interpreter::Run_Code_In_Console_Context(const std::string& cod
 
 bool cMRuby_Interpreter::Run_Code(const std::string& code, const std::string& contextname)
 {
+    // Try to skip the parser by using precompiled bytecode. If the code
+    // does not compile, leave `bytecode' empty and let mruby parse it
+    // below again, which reports the syntax error the usual way.
+    std::string bytecode;
+    if (!m_bytecode_cache.Lookup(code, contextname, bytecode)) {
+        if (cBytecode_Cache::Compile(mp_mruby, code, contextname, bytecode))
+            m_bytecode_cache.Store(code, contextname, bytecode);
+    }
+
     // Create a new context. This is important so we
     // can properly retrieve exceptions, which mrb_load_string()
     // does not allow.
@@ -190,12 +280,19 @@ bool cMRuby_Interpreter::Run_Code(const std::string& code, const std::string& co
     p_context->lineno = 1;
     mrbc_filename(mp_mruby, p_context, contextname.c_str()); // Set context filename (for exceptions)
 
-    Run_Code_In_Context(code, p_context);
+    if (bytecode.empty())
+        Run_Code_In_Context(code, p_context);
+    else
+        mrb_load_irep_cxt(mp_mruby, reinterpret_cast<const uint8_t*>(bytecode.data()), p_context);
 
     bool result;
     if (mp_mruby->exc) {
-        // Exception occured
-        gp_game_console->Display_Exception(mp_mruby);
+        // Exception occured. The game console must not be
+        // touched from outside the main thread.
+        if (m_off_main_thread)
+            mrb_print_error(mp_mruby);
+        else
+            gp_game_console->Display_Exception(mp_mruby);
 
         // Clear exception pointer so execution can continue
         mp_mruby->exc = NULL;
@@ -333,8 +430,7 @@ void cMRuby_Interpreter::Evaluate_Timer_Callbacks()
  */
 mrb_int cMRuby_Interpreter::Protect_From_GC(mrb_value obj)
 {
-    mrb_value mod_tsc = mrb_const_get(mp_mruby, mrb_obj_value(mp_mruby->object_class), mrb_intern_cstr(mp_mruby, "TSC"));
-    mrb_value hsh     = mrb_iv_get(mp_mruby, mod_tsc, mrb_intern_cstr(mp_mruby, "gc_protector"));
+    mrb_value hsh     = Get_GC_Protector();
     mrb_int   oid     = mrb_obj_id(obj);
 
     // TODO: Is the object ID request really secure from GC?
@@ -349,11 +445,102 @@ mrb_int cMRuby_Interpreter::Protect_From_GC(mrb_value obj)
  * free the object.
  */
 void cMRuby_Interpreter::Unprotect_From_GC(mrb_int index)
+{
+    mrb_hash_delete_key(mp_mruby, Get_GC_Protector(), mrb_fixnum_value(index));
+}
+
+mrb_value cMRuby_Interpreter::Get_GC_Protector()
 {
     mrb_value mod_tsc = mrb_const_get(mp_mruby, mrb_obj_value(mp_mruby->object_class), mrb_intern_cstr(mp_mruby, "TSC"));
-    mrb_value hsh     = mrb_iv_get(mp_mruby, mod_tsc, mrb_intern_cstr(mp_mruby, "gc_protector"));
+    return mrb_iv_get(mp_mruby, mod_tsc, mrb_intern_cstr(mp_mruby, "gc_protector"));
+}
+
+/* mruby collects garbage in small steps whenever an allocation pushes
+ * the number of live objects over its threshold, i.e. at some random
+ * point in the middle of a frame. Step_GC() starts and advances the
+ * cycles once a frame instead, after the timer callbacks ran, so the
+ * collector stays enabled (GC.start keeps working) but is tuned to
+ * only fall back to its own steps if a frame allocates a lot. */
+void cMRuby_Interpreter::Init_GC()
+{
+    // Generational mode does major collections in one go, which
+    // cannot be split over several frames.
+    mrb_value mod_gc = mrb_obj_value(mrb_module_get(mp_mruby, "GC"));
+    mrb_funcall(mp_mruby, mod_gc, "generational_mode=", 1, mrb_false_value());
+    if (mp_mruby->exc) {
+        std::cerr << "Scripting engine: warning: failed to disable generational GC" << std::endl;
+        mp_mruby->exc = NULL;
+    }
+
+    // Start the next cycle only once the heap grew to 3x the objects
+    // that survived the last one (mruby default: 2x). Step_GC() starts
+    // it when the heap is halfway there, so the extra headroom is
+    // only used by frames allocating heavily.
+    mp_mruby->gc.interval_ratio = 300;
+    // Do less work per allocation triggered step (default: 200) so
+    // that those steps are short pauses.
+    mp_mruby->gc.step_ratio = 100;
+}
+
+/**
+ * Performs incremental GC steps until either the current collection
+ * cycle is completed or `budget_us' microseconds have passed. Starts
+ * a new cycle once the live objects are halfway to the threshold at
+ * which mruby would start one itself. A cycle that did not finish is
+ * continued on the next call.
+ */
+void cMRuby_Interpreter::Step_GC(unsigned int budget_us)
+{
+    mrb_gc* p_gc = &mp_mruby->gc;
+
+    // GC.disable from a script
+    if (p_gc->disabled) {
+        m_gc_step_us = 0;
+        return;
+    }
+    if (p_gc->state == MRB_GC_STATE_ROOT && p_gc->live < p_gc->threshold / 2) {
+        m_gc_step_us = 0;
+        return;
+    }
 
-    mrb_hash_delete_key(mp_mruby, hsh, mrb_fixnum_value(index));
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    std::chrono::microseconds budget(budget_us);
+
+    do {
+        mrb_incremental_gc(mp_mruby);
+    } while (p_gc->state != MRB_GC_STATE_ROOT && std::chrono::steady_clock::now() - start < budget);
+
+    m_gc_step_us = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+void cMRuby_Interpreter::Full_GC()
+{
+    mrb_full_gc(mp_mruby);
+}
+
+unsigned int cMRuby_Interpreter::Get_GC_Heap_Pages()
+{
+    unsigned int pages = 0;
+    for (mrb_heap_page* p_page = mp_mruby->gc.heaps; p_page; p_page = p_page->next)
+        pages++;
+
+    return pages;
+}
+
+unsigned int cMRuby_Interpreter::Get_GC_Live_Objects()
+{
+    return mp_mruby->gc.live;
+}
+
+unsigned int cMRuby_Interpreter::Get_GC_Step_Time()
+{
+    return m_gc_step_us;
+}
+
+unsigned int cMRuby_Interpreter::Get_GC_Protected_Count()
+{
+    mrb_value size = mrb_funcall(mp_mruby, Get_GC_Protector(), "size", 0);
+    return mrb_fixnum_p(size) ? mrb_fixnum(size) : 0;
 }
 
 void cMRuby_Interpreter::Load_Wrappers()
@@ -17,6 +17,7 @@
 #include "../core/global_basic.hpp"
 #include "../core/global_game.hpp"
 #include "objects/mrb_tsc.hpp"
+#include "bytecode_cache.hpp"
 
 // Some defines to ease use of mruby
 #define MRB_ARGUMENT_ERROR(mrb) (mrb_class_get(mrb, "ArgumentError"))
@@ -32,6 +33,21 @@ namespace TSC {
         // an mrb_data_type nevertheless from us. So we set
         // it for all our objects to this one.
         extern struct mrb_data_type rtTSC_Scriptable;
+        // Except for sprites in a sprite manager, which are
+        // referenced by handle instead. See Wrap_Sprite().
+        extern struct mrb_data_type rtTSC_Sprite;
+
+        // Returns the C++ object of the MRuby object. Raises an
+        // MRuby exception if it is a sprite that was removed
+        // from its sprite manager.
+        void* Get_Data(mrb_state* p_state, mrb_value obj);
+        // Create the MRuby object for a sprite. It refers to the
+        // sprite by handle if it is in a sprite manager.
+        mrb_value Wrap_Sprite(mrb_state* p_state, struct RClass* p_class, cSprite* p_sprite);
+        // Make `self' refer to the sprite by handle. Call this
+        // in the constructors once the sprite was added to the
+        // sprite manager.
+        void Set_Sprite_Data(mrb_state* p_state, mrb_value self, cSprite* p_sprite);
 
         // Takes a C(++) string and directly returns an MRuby
         // symbol object (not an mrb_sym!) for it.
@@ -42,13 +58,13 @@ namespace TSC {
 
         /**
          * Shorthand for doing
-         *   DATA_GET_PTR(p_state, obj, &rtTSC_Scriptable)
+         *   Get_Data(p_state, obj)
          * over and over with a security NULL check.
          */
         template<typename T>
         T* Get_Data_Ptr(mrb_state* p_state, mrb_value obj)
         {
-            T* p_result = static_cast<T*>(mrb_data_get_ptr(p_state, obj, &rtTSC_Scriptable));
+            T* p_result = static_cast<T*>(Get_Data(p_state, obj));
             if (!p_result) {
                 mrb_raise(p_state, MRB_TYPE_ERROR(p_state), "Unexpected NULL pointer. This is most likely an TSC bug.");
                 return NULL; // Not reached
@@ -59,8 +75,12 @@ namespace TSC {
 
         class cMRuby_Interpreter {
         public:
-            // Create a new MRuby instance for the given level.
-            cMRuby_Interpreter(cLevel* p_level);
+            // Create a new MRuby instance for the given level. `p_level'
+            // may be NULL if the interpreter is created ahead of time,
+            // see cMRuby_Interpreter_Pool. Pass `off_main_thread' as true
+            // if constructing it on another thread; errors are printed
+            // to standard error instead of the game console then.
+            cMRuby_Interpreter(cLevel* p_level, bool off_main_thread = false);
             // Destructor
             ~cMRuby_Interpreter();
 
@@ -69,6 +89,8 @@ namespace TSC {
             // true otherwise. `contextname' is purely informational
             // and only ever used in exception messages.
             // This method prints exceptions to standard error.
+            // The compiled bytecode is cached, so running the
+            // same code again does not invoke the parser.
             bool Run_Code(const std::string& code, const std::string& contextname);
             // Execute MRuby code found in a file, using the filename
             // as the context name. Otherwise has the same
@@ -95,22 +117,45 @@ namespace TSC {
             const mrbc_context* Get_Console_Context() const;
             // Returns the cLevel* we’re associated with.
             cLevel* Get_Level();
+            // Associate a pre-initialised interpreter with its level.
+            // Must be called on the main thread.
+            void Set_Level(cLevel* p_level);
             // Ensure an object doesn't get GC'ed.
             mrb_int Protect_From_GC(mrb_value obj);
             // Release the protection for an object created with Protect_From_GC().
             void Unprotect_From_GC(mrb_int index);
+
+            // Advance the incremental garbage collector for at most
+            // `budget_us' microseconds. Call once a frame.
+            void Step_GC(unsigned int budget_us);
+            // Run a complete garbage collection. Only call this where
+            // a hitch does not matter (loading screens, pauses).
+            void Full_GC();
+            // Statistics for the debug window.
+            unsigned int Get_GC_Heap_Pages();
+            unsigned int Get_GC_Live_Objects();
+            unsigned int Get_GC_Step_Time();
+            unsigned int Get_GC_Protected_Count();
         private:
             mrb_state* mp_mruby;
             mrbc_context* mp_console_ctx;
             cLevel* mp_level;
+            bool m_off_main_thread;
             std::vector<mrb_value> m_callbacks;
             boost::mutex m_callback_mutex;
+            cBytecode_Cache m_bytecode_cache;
+            // Duration of the last Step_GC() call in microseconds
+            unsigned int m_gc_step_us;
 
             // Load all MRuby wrapper classes for the C++ classes
             // into the given mruby state.
             void Load_Wrappers();
             // Executes the main.rb file for custom startup scripts.
             void Load_Scripts();
+            // Tune the incremental GC for Step_GC().
+            void Init_GC();
+            // Returns TSC's gc_protector hash.
+            mrb_value Get_GC_Protector();
         };
     };
 };
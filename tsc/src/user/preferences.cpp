@@ -40,6 +40,7 @@ const bool cPreferences::m_always_run_default = 0;
 const std::string cPreferences::m_menu_level_default = "menu_brown_1";
 const float cPreferences::m_camera_hor_speed_default = 0.3f;
 const float cPreferences::m_camera_ver_speed_default = 0.2f;
+const unsigned int cPreferences::m_scripting_gc_budget_default = 1000;
 // Video
 const bool cPreferences::m_video_fullscreen_default = 0;
 const uint16_t cPreferences::m_video_screen_w_default = 1024;
@@ -50,6 +51,9 @@ const uint8_t cPreferences::m_video_screen_bpp_default = 32;
 */
 const bool cPreferences::m_video_vsync_default = 0;
 const uint16_t cPreferences::m_video_fps_limit_default = 240;
+const bool cPreferences::m_video_fps_limit_spin_default = 1;
+const unsigned int cPreferences::m_video_texture_budget_default = 512;
+const bool cPreferences::m_video_sprite_shader_default = 1;
 // default geometry detail is medium
 const float cPreferences::m_geometry_quality_default = 0.5f;
 // default texture detail is high
@@ -144,6 +148,7 @@ void cPreferences::Save(void)
     Add_Property(p_root, "game_menu_level", m_menu_level);
     Add_Property(p_root, "game_camera_hor_speed", m_camera_hor_speed);
     Add_Property(p_root, "game_camera_ver_speed", m_camera_ver_speed);
+    Add_Property(p_root, "game_scripting_gc_budget", m_scripting_gc_budget);
     // Video
     Add_Property(p_root, "video_fullscreen", m_video_fullscreen);
     Add_Property(p_root, "video_screen_w", m_video_screen_w);
@@ -151,6 +156,9 @@ void cPreferences::Save(void)
     Add_Property(p_root, "video_screen_bpp", static_cast<int>(m_video_screen_bpp));
     Add_Property(p_root, "video_vsync", m_video_vsync);
     Add_Property(p_root, "video_fps_limit", m_video_fps_limit);
+    Add_Property(p_root, "video_fps_limit_spin", m_video_fps_limit_spin);
+    Add_Property(p_root, "video_texture_budget", m_video_texture_budget);
+    Add_Property(p_root, "video_sprite_shader", m_video_sprite_shader);
     Add_Property(p_root, "video_geometry_quality", pVideo->m_geometry_quality);
     Add_Property(p_root, "video_texture_quality", pVideo->m_texture_quality);
     // Audio
@@ -194,6 +202,7 @@ void cPreferences::Save(void)
     // Special
     Add_Property(p_root, "level_background_images", m_level_background_images);
     Add_Property(p_root, "image_cache_enabled", m_image_cache_enabled);
+    Add_Property(p_root, "image_cache_compressed", m_image_cache_compressed);
     // Editor
     Add_Property(p_root, "editor_mouse_auto_hide", m_editor_mouse_auto_hide);
     Add_Property(p_root, "editor_show_item_images", m_editor_show_item_images);
@@ -218,6 +227,7 @@ void cPreferences::Reset_All(void)
     // Special
     m_level_background_images = 1;
     m_image_cache_enabled = 1;
+    m_image_cache_compressed = 0;
 }
 
 void cPreferences::Reset_Game(void)
@@ -227,6 +237,7 @@ void cPreferences::Reset_Game(void)
     m_menu_level = m_menu_level_default;
     m_camera_hor_speed = m_camera_hor_speed_default;
     m_camera_ver_speed = m_camera_ver_speed_default;
+    m_scripting_gc_budget = m_scripting_gc_budget_default;
 }
 
 void cPreferences::Reset_Video(void)
@@ -237,6 +248,9 @@ void cPreferences::Reset_Video(void)
     m_video_screen_bpp = m_video_screen_bpp_default;
     m_video_vsync = m_video_vsync_default;
     m_video_fps_limit = m_video_fps_limit_default;
+    m_video_fps_limit_spin = m_video_fps_limit_spin_default;
+    m_video_texture_budget = m_video_texture_budget_default;
+    m_video_sprite_shader = m_video_sprite_shader_default;
     m_video_fullscreen = m_video_fullscreen_default;
     pVideo->m_geometry_quality = m_geometry_quality_default;
     pVideo->m_texture_quality = m_texture_quality_default;
@@ -69,6 +69,8 @@ namespace TSC {
         // smart camera speed
         float m_camera_hor_speed;
         float m_camera_ver_speed;
+        // time the scripting garbage collector may take per frame in microseconds
+        unsigned int m_scripting_gc_budget;
 
         // Audio
         bool m_audio_music;
@@ -82,6 +84,12 @@ namespace TSC {
         uint8_t m_video_screen_bpp;
         bool m_video_vsync;
         uint16_t m_video_fps_limit;
+        // spin shortly before each frame deadline of the fps limit instead of only sleeping
+        bool m_video_fps_limit_spin;
+        // texture memory in MiB above which unused textures are unloaded, 0 for no limit
+        unsigned int m_video_texture_budget;
+        // draw surfaces in batches with the GLSL sprite program if available
+        bool m_video_sprite_shader;
 
         // Keyboard
         // key definitions
@@ -134,6 +142,8 @@ namespace TSC {
         bool m_level_background_images;
         // image cache enabled
         bool m_image_cache_enabled;
+        // store the image cache as S3TC compressed textures if supported
+        bool m_image_cache_compressed;
 
         /* *** *** *** *** *** *** *** */
 
@@ -151,6 +161,7 @@ namespace TSC {
         static const std::string m_menu_level_default;
         static const float m_camera_hor_speed_default;
         static const float m_camera_ver_speed_default;
+        static const unsigned int m_scripting_gc_budget_default;
         // Audio
         static const bool m_audio_music_default;
         static const bool m_audio_sound_default;
@@ -164,6 +175,9 @@ namespace TSC {
         static const uint8_t m_video_screen_bpp_default;
         static const bool m_video_vsync_default;
         static const uint16_t m_video_fps_limit_default;
+        static const bool m_video_fps_limit_spin_default;
+        static const unsigned int m_video_texture_budget_default;
+        static const bool m_video_sprite_shader_default;
         static const float m_geometry_quality_default;
         static const float m_texture_quality_default;
         // Keyboard
@@ -126,6 +126,11 @@ void cPreferencesLoader::handle_property(const std::string& name, const std::str
         mp_preferences->m_camera_hor_speed = string_to_float(value);
     else if (name == "game_camera_ver_speed" || name == "camera_ver_speed")
         mp_preferences->m_camera_ver_speed = string_to_float(value);
+    else if (name == "game_scripting_gc_budget") {
+        val = string_to_int(value);
+        if (val > 0 && val <= 100000)
+            mp_preferences->m_scripting_gc_budget = val;
+    }
     //////////////////// Video ////////////////////
     else if (name == "video_screen_h") {
         val = string_to_int(value);
@@ -158,6 +163,15 @@ void cPreferencesLoader::handle_property(const std::string& name, const std::str
         mp_preferences->m_video_vsync = string_to_bool(value);
     else if (name == "video_fps_limit")
         mp_preferences->m_video_fps_limit = string_to_int(value);
+    else if (name == "video_fps_limit_spin")
+        mp_preferences->m_video_fps_limit_spin = string_to_bool(value);
+    else if (name == "video_texture_budget") {
+        val = string_to_int(value);
+        if (val >= 0 && val <= 65536)
+            mp_preferences->m_video_texture_budget = val;
+    }
+    else if (name == "video_sprite_shader")
+        mp_preferences->m_video_sprite_shader = string_to_bool(value);
     else if (name == "video_fullscreen")
         mp_preferences->m_video_fullscreen = string_to_bool(value);
     else if (name == "video_geometry_detail" || name == "video_geometry_quality")
@@ -332,6 +346,8 @@ void cPreferencesLoader::handle_property(const std::string& name, const std::str
         mp_preferences->m_level_background_images = string_to_bool(value);
     else if (name == "image_cache_enabled")
         mp_preferences->m_image_cache_enabled = string_to_bool(value);
+    else if (name == "image_cache_compressed")
+        mp_preferences->m_image_cache_compressed = string_to_bool(value);
     //////////////////// Editor ////////////////////
     else if (name == "editor_mouse_auto_hide")
         mp_preferences->m_editor_mouse_auto_hide = string_to_bool(value);
@@ -18,6 +18,7 @@
 #include "../../core/property_helper.hpp"
 #include "../../core/game_core.hpp"
 #include "../../level/level_manager.hpp"
+#include "../../core/filesystem/file_writer.hpp"
 #include "savegame_loader.hpp"
 
 using namespace TSC;
@@ -110,45 +111,38 @@ std::string cSave::Get_Active_Level(void)
 
 void cSave::Write_To_File(fs::path filepath)
 {
-    xmlpp::Document doc;
-    xmlpp::Element* p_root = doc.create_root_node("savegame");
-    xmlpp::Element* p_node = NULL;
+    cXml_Writer writer;
+    writer.Start_Element("savegame");
 
     // <information>
-#ifdef USE_LIBXMLPP3
-    p_node = p_root->add_child_element("information");
-#else
-    p_node = p_root->add_child("information");
-#endif
-    Add_Property(p_node, "version", m_version);
-    Add_Property(p_node, "level_engine_version", m_level_engine_version);
-    Add_Property(p_node, "save_time", static_cast<uint64_t>(m_save_time));
-    Add_Property(p_node, "description", m_description);
+    writer.Start_Element("information");
+    Add_Property(writer, "version", m_version);
+    Add_Property(writer, "level_engine_version", m_level_engine_version);
+    Add_Property(writer, "save_time", static_cast<uint64_t>(m_save_time));
+    Add_Property(writer, "description", m_description);
+    writer.End_Element();
     // </information>
 
     // <player>
-#ifdef USE_LIBXMLPP3
-    p_node = p_root->add_child_element("player");
-#else
-    p_node = p_root->add_child("player");
-#endif
-    Add_Property(p_node, "lives", m_lives);
-    Add_Property(p_node, "points", m_points);
-    Add_Property(p_node, "goldpieces", m_goldpieces);
-    Add_Property(p_node, "type", m_player_type);
-    Add_Property(p_node, "type_temp_power", m_player_type_temp_power);
-    Add_Property(p_node, "invincible_star", m_invincible_star);
-    Add_Property(p_node, "invincible", m_invincible);
-    Add_Property(p_node, "ghost_time", m_ghost_time);
-    Add_Property(p_node, "ghost_time_mod", m_ghost_time_mod);
-
-    Add_Property(p_node, "state", m_player_state);
-    Add_Property(p_node, "itembox_item", m_itembox_item);
+    writer.Start_Element("player");
+    Add_Property(writer, "lives", m_lives);
+    Add_Property(writer, "points", m_points);
+    Add_Property(writer, "goldpieces", m_goldpieces);
+    Add_Property(writer, "type", m_player_type);
+    Add_Property(writer, "type_temp_power", m_player_type_temp_power);
+    Add_Property(writer, "invincible_star", m_invincible_star);
+    Add_Property(writer, "invincible", m_invincible);
+    Add_Property(writer, "ghost_time", m_ghost_time);
+    Add_Property(writer, "ghost_time_mod", m_ghost_time_mod);
+
+    Add_Property(writer, "state", m_player_state);
+    Add_Property(writer, "itembox_item", m_itembox_item);
     // if a level is available
     if (!m_levels.empty())
-        Add_Property(p_node, "level_time", m_level_time);
-    Add_Property(p_node, "overworld_active", m_overworld_active);
-    Add_Property(p_node, "overworld_current_waypoint", m_overworld_current_waypoint);
+        Add_Property(writer, "level_time", m_level_time);
+    Add_Property(writer, "overworld_active", m_overworld_active);
+    Add_Property(writer, "overworld_current_waypoint", m_overworld_current_waypoint);
+    writer.End_Element();
     // </player>
 
     // player return stack
@@ -156,23 +150,21 @@ void cSave::Write_To_File(fs::path filepath)
     for (return_iter = m_return_entries.begin(); return_iter != m_return_entries.end(); return_iter++) {
         cSave_Player_Return_Entry item = *return_iter;
 
-#ifdef USE_LIBXMLPP3
-        p_node = p_root->add_child_element("return");
-#else
-        p_node = p_root->add_child("return");
-#endif
+        writer.Start_Element("return");
 
         if (!item.m_level.empty())
-            Add_Property(p_node, "level", item.m_level);
+            Add_Property(writer, "level", item.m_level);
         if (!item.m_entry.empty())
-            Add_Property(p_node, "entry", item.m_entry);
+            Add_Property(writer, "entry", item.m_entry);
+
+        writer.End_Element();
     }
 
     // levels
     Save_LevelList::const_iterator iter;
     for (iter=m_levels.begin(); iter != m_levels.end(); iter++) {
         cSave_Level* p_level = *iter;
-        p_level->Save_To_Node(p_root);
+        p_level->Save_To_Node(writer);
     }
 
     // Overworlds
@@ -181,13 +173,8 @@ void cSave::Write_To_File(fs::path filepath)
         cSave_Overworld* p_overworld = *oiter;
 
         // <overworld>
-#ifdef USE_LIBXMLPP3
-        p_node = p_root->add_child_element("overworld");
-        Add_Property(p_node, "name", p_overworld->m_name);
-#else
-        p_node = p_root->add_child("overworld");
-        Add_Property(p_node, "name", p_overworld->m_name);
-#endif
+        writer.Start_Element("overworld");
+        Add_Property(writer, "name", p_overworld->m_name);
 
         Save_Overworld_WaypointList::const_iterator wpiter;
         for (wpiter=p_overworld->m_waypoints.begin(); wpiter != p_overworld->m_waypoints.end(); wpiter++) {
@@ -198,27 +185,30 @@ void cSave::Write_To_File(fs::path filepath)
                 continue;
 
             // <waypoint>
-#ifdef USE_LIBXMLPP3
-            xmlpp::Element* p_waypoint_node = p_node->add_child_element("waypoint");
-#else
-            xmlpp::Element* p_waypoint_node = p_node->add_child("waypoint");
-#endif
-            Add_Property(p_waypoint_node, "destination", p_wp->m_destination);
-            Add_Property(p_waypoint_node, "access", p_wp->m_access);
+            writer.Start_Element("waypoint");
+            Add_Property(writer, "destination", p_wp->m_destination);
+            Add_Property(writer, "access", p_wp->m_access);
 
             for(size_t i=0; i < p_wp->m_exits.size(); i++) {
                 std::string str_pos     = int_to_string(i);
                 const waypoint_exit& ex = p_wp->m_exits[i];
 
-                Add_Property(p_waypoint_node, "waypoint_exit_" + str_pos + "_locked", ex.locked);
+                Add_Property(writer, "waypoint_exit_" + str_pos + "_locked", ex.locked);
             }
+            writer.End_Element();
             // </waypoint>
         }
 
+        writer.End_Element();
         // </overworld>
     }
 
-    // Write to file (raises xmlpp::exception on error)
-    doc.write_to_file_formatted(Glib::filename_from_utf8(path_to_utf8(filepath)));
-    debug_print("Wrote savegame file '%s'.\n", path_to_utf8(filepath).c_str());
+    writer.End_Element();
+
+    debug_print("Writing savegame file '%s' with %u bytes\n", path_to_utf8(filepath).c_str(), static_cast<unsigned int>(writer.Get_Data().size()));
+
+    /* Written in the background with a temporary file, so an old
+     * savegame stays intact if the game ends while writing.
+    */
+    pFile_Writer->Write(filepath, writer.Get_Data());
 }
@@ -47,8 +47,8 @@ namespace TSC {
         // return the active level if available
         std::string Get_Active_Level(void);
 
-        // Write the savegame out to the given file; raises
-        // xmlpp::exception on error.
+        // Write the savegame out to the given file; this happens
+        // in the background with pFile_Writer.
         void Write_To_File(boost::filesystem::path filepath);
 
         // savegame version
@@ -78,92 +78,74 @@ cSave_Level::~cSave_Level(void)
     m_spawned_objects.clear();
 }
 
-void cSave_Level::Save_To_Node(xmlpp::Element* p_parent_node)
+void cSave_Level::Save_To_Node(cXml_Writer& writer)
 {
     // <level>
-#ifdef USE_LIBXMLPP3
-    xmlpp::Element* p_node = p_parent_node->add_child_element("level");
-    Add_Property(p_node, "level_name", m_name);
-#else
-    xmlpp::Element* p_node = p_parent_node->add_child("level");
-    Add_Property(p_node, "level_name", m_name);
-#endif
+    writer.Start_Element("level");
+    Add_Property(writer, "level_name", m_name);
 
     // Player position. Only save that for the active level.
     if (!Is_Float_Equal(m_level_pos_x, 0.0f) && !Is_Float_Equal(m_level_pos_y, 0.0f)) {
-        Add_Property(p_node, "player_posx", m_level_pos_x);
-        Add_Property(p_node, "player_posy", m_level_pos_y);
+        Add_Property(writer, "player_posx", m_level_pos_x);
+        Add_Property(writer, "player_posy", m_level_pos_y);
     }
 
     /* Custom data a script writer wants to store; empty if the
      * script writer didn’t hook into the on_load and on_save
      * events. */
-#ifdef USE_LIBXMLPP3
     if (!m_script_datas.empty()) {
-        xmlpp::Element* p_datas_node = p_node->add_child_element("mruby_data");
+        writer.Start_Element("mruby_data");
         for(const Script_Data& data: m_script_datas) {
-            xmlpp::Element* p_data_node = p_datas_node->add_child_element("script_data");
+            writer.Start_Element("script_data");
 
             for(auto iter=data.begin(); iter != data.end(); iter++) {
-                xmlpp::Element* p_entry_node = p_data_node->add_child_element("script_data_entry");
-                p_entry_node->set_attribute("name", iter->first);
-                p_entry_node->set_attribute("type", std::get<0>(iter->second));
-                p_entry_node->set_attribute("value", std::get<1>(iter->second));
+                writer.Start_Element("script_data_entry");
+                writer.Add_Attribute("name", iter->first);
+                writer.Add_Attribute("type", std::get<0>(iter->second));
+                writer.Add_Attribute("value", std::get<1>(iter->second));
+                writer.End_Element();
             }
-        }
-    }
-#else
-    if (!m_script_datas.empty()) {
-        xmlpp::Element* p_datas_node = p_node->add_child("mruby_data");
-        for(const Script_Data& data: m_script_datas) {
-            xmlpp::Element* p_data_node = p_datas_node->add_child("script_data");
 
-            for(auto iter=data.begin(); iter != data.end(); iter++) {
-                xmlpp::Element* p_entry_node = p_data_node->add_child("script_data_entry");
-                p_entry_node->set_attribute("name", iter->first);
-                p_entry_node->set_attribute("type", std::get<0>(iter->second));
-                p_entry_node->set_attribute("value", std::get<1>(iter->second));
-            }
+            writer.End_Element();
         }
+        writer.End_Element();
     }
-#endif
 
     // The regular objects.
     // <objects_data>
-#ifdef USE_LIBXMLPP3
-    xmlpp::Element* p_objects_data_node = p_node->add_child_element("objects_data");
-#else
-    xmlpp::Element* p_objects_data_node = p_node->add_child("objects_data");
-#endif
+    writer.Start_Element("objects_data");
     std::vector<const cSprite*>::const_iterator iter;
     for(iter=m_regular_objects.begin(); iter != m_regular_objects.end(); iter++) {
-        xmlpp::Document subdoc;
-        xmlpp::Element* p_object_node = subdoc.create_root_node("object");
         const cSprite* p_sprite = (*iter);
+        writer.Start_Element("object");
 
         /* Let the sprite itself decide whether it wants to be saved.
          * If the virtual method Save_To_Savegame_XML_Node() returns false,
-         * no saving shall be done, the created XML node is ignored and not
-         * used. If the method returns true, we add in the created node. */
-        if (p_sprite->Save_To_Savegame_XML_Node(p_object_node)) {
-            p_objects_data_node->import_node(p_object_node);
+         * no saving shall be done and the started element is discarded
+         * again. If the method returns true, we keep the element. */
+        if (p_sprite->Save_To_Savegame_XML_Node(writer)) {
+            writer.End_Element();
+        }
+        else {
+            writer.Discard_Element();
         }
     }
+    writer.End_Element();
     // </objects_data>
 
     // The spawned objects. These have always to be saved.
     // <spawned_objects>
-#ifdef USE_LIBXMLPP3
-    xmlpp::Element* p_spawned_node = p_node->add_child_element("spawned_objects");
-#else
-    xmlpp::Element* p_spawned_node = p_node->add_child("spawned_objects");
-#endif
+    writer.Start_Element("spawned_objects");
     cSprite_List::iterator iter2; // TODO: Should be const_iterator
     for(iter2=m_spawned_objects.begin(); iter2 != m_spawned_objects.end(); iter2++) {
         cSprite* p_sprite = (*iter2);
-        p_sprite->Save_To_XML_Node(p_spawned_node);
+        writer.Start_Element(p_sprite->m_type_name);
+        p_sprite->Save_To_XML_Node(writer);
+        writer.End_Element();
     }
+    writer.End_Element();
     // </spawned_objects>
 
+    writer.End_Element();
     //</level>
 }
@@ -79,7 +79,7 @@ namespace TSC {
         cSave_Level(void);
         ~cSave_Level(void);
 
-        void Save_To_Node(xmlpp::Element* p_parent_node);
+        void Save_To_Node(cXml_Writer& writer);
 
         std::string m_name;
         /// True if this is the active level.
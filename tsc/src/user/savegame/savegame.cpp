@@ -27,6 +27,7 @@
 #include "../../core/i18n.hpp"
 #include "../../core/filesystem/filesystem.hpp"
 #include "../../core/filesystem/resource_manager.hpp"
+#include "../../core/filesystem/file_writer.hpp"
 #include "../../scripting/events/level_save_load_event.hpp"
 #include "../../core/global_basic.hpp"
 #include "../../audio/audio.hpp"
@@ -59,6 +60,10 @@ cSavegame::~cSavegame(void)
 
 int cSavegame::Load_Game(unsigned int save_slot)
 {
+    uint32_t start_ticks = TSC_GetTicks();
+    // level objects restored from the savegame
+    unsigned int loaded_objects = 0;
+
     cSave* savegame = Load(save_slot);
 
     if (!savegame) {
@@ -180,15 +185,36 @@ int cSavegame::Load_Game(unsigned int save_slot)
 
             save_level->m_spawned_objects.clear();
 
+            /* The savegame only has the objects which changed, keyed by
+             * their UID. Everything else stays as loaded from the level. */
+            std::map<int, cSprite*> uid_objects;
+            for (cSprite_List::iterator itr = level->m_sprite_manager->objects.begin(); itr != level->m_sprite_manager->objects.end(); ++itr) {
+                // the first one if spawned objects reused a UID
+                uid_objects.insert(std::make_pair((*itr)->m_uid, *itr));
+            }
+
             // objects data
             for (Save_Level_ObjectList::iterator itr = save_level->m_level_objects.begin(); itr != save_level->m_level_objects.end(); ++itr) {
                 cSave_Level_Object* save_object = (*itr);
+                cSprite* level_object = NULL;
+
+                // by UID
+                if (save_object->exists("uid")) {
+                    std::map<int, cSprite*>::const_iterator uid_itr = uid_objects.find(string_to_int(save_object->Get_Value("uid")));
+
+                    if (uid_itr != uid_objects.end() && uid_itr->second->m_type == save_object->m_type) {
+                        level_object = uid_itr->second;
+                    }
+                }
 
                 // get position
                 int posx = string_to_int(save_object->Get_Value("posx"));
                 int posy = string_to_int(save_object->Get_Value("posy"));
 
-                cSprite* level_object = level->m_sprite_manager->Get_from_Position(posx, posy, save_object->m_type);
+                // older savegames or a changed level
+                if (!level_object) {
+                    level_object = level->m_sprite_manager->Get_from_Position(posx, posy, save_object->m_type);
+                }
 
                 // if not anymore available
                 if (!level_object) {
@@ -197,6 +223,10 @@ int cSavegame::Load_Game(unsigned int save_slot)
                 }
 
                 level_object->Load_From_Savegame(save_object);
+                // still differs from the level
+                level_object->Set_Save_Dirty();
+                loaded_objects++;
+
                 //If the currently loaded object is a shell (loose or with army in it) and if it was linked, call the Get_Item
                 //method to properly set it up with the player
                 if (save_object ->m_type == TYPE_SHELL  || save_object -> m_type == TYPE_ARMY) {
@@ -281,6 +311,12 @@ int cSavegame::Load_Game(unsigned int save_slot)
     }
 
     delete savegame;
+
+    // size on disk, to compare with the save time
+    boost::system::error_code ec;
+    uintmax_t file_size = fs::file_size(pResource_Manager->Get_User_Savegame_Directory() / utf8_to_path(int_to_string(save_slot) + ".tscsav"), ec);
+
+    debug_print("Loaded savegame slot %u (%u KiB) with %u level objects in %u ms\n", save_slot, ec ? 0 : static_cast<unsigned int>(file_size / 1024), loaded_objects, TSC_GetTicks() - start_ticks);
     return save_type;
 }
 
@@ -291,6 +327,11 @@ bool cSavegame::Save_Game(unsigned int save_slot, std::string description)
         return 0;
     }
 
+    uint32_t start_ticks = TSC_GetTicks();
+    // level objects in the savegame and in all loaded levels
+    unsigned int saved_objects = 0;
+    unsigned int level_objects = 0;
+
     cSave* savegame = new cSave();
 
     // General stuff
@@ -364,10 +405,17 @@ bool cSavegame::Save_Game(unsigned int save_slot, std::string description)
                     }
                 }
 
-                // Base for every object; this will be loaded from the bare level XML.
-                save_level->m_regular_objects.push_back(p_obj);
+                /* Base for every object; this will be loaded from the bare level XML.
+                 * Objects which did not change since the level was loaded are
+                 * the same in it and only need to be saved once they are dirty. */
+                if (p_obj->m_save_dirty) {
+                    save_level->m_regular_objects.push_back(p_obj);
+                }
             }
 
+            saved_objects += save_level->m_regular_objects.size();
+            level_objects += level->m_sprite_manager->objects.size();
+
             savegame->m_levels.push_back(save_level);
         }
     }
@@ -427,14 +475,10 @@ bool cSavegame::Save_Game(unsigned int save_slot, std::string description)
     fs::remove(save_dir / utf8_to_path(int_to_string(save_slot) + ".save"));
     fs::remove(save_dir / utf8_to_path(int_to_string(save_slot) + ".smcsav"));
 
-    try {
-        savegame->Write_To_File(filename);
-    }
-    catch (xmlpp::exception& e) {
-        cerr << "Failed to save savegame '" << filename << "': " << e.what() << endl
-             << "Is the file read-only?" << endl;
-        gp_hud->Set_Text(_("Couldn't save savegame ") + path_to_utf8(filename));
-    }
+    // written in the background, failures are shown by Update_Game()
+    savegame->Write_To_File(filename);
+
+    debug_print("Saved savegame slot %u with %u of %u level objects in %u ms\n", save_slot, saved_objects, level_objects, TSC_GetTicks() - start_ticks);
 
     gp_hud->Set_Text(_("Saved to Slot ") + int_to_string(save_slot));
 
@@ -450,6 +494,9 @@ cSave* cSavegame::Load(unsigned int save_slot)
 
     cSave* savegame = NULL; //The save game object read from the save state file
 
+    // the file may still be written
+    pFile_Writer->Wait();
+
     //First try to load the game using the newer format
     if (File_Exists(filename)) {
         savegame = cSave::Load_From_File(filename);
@@ -548,6 +595,9 @@ std::string cSavegame::Get_Description(unsigned int save_slot, bool only_descrip
 
 bool cSavegame::Is_Valid(unsigned int save_slot) const
 {
+    // the file may still be written
+    pFile_Writer->Wait();
+
     fs::path save_dir = pResource_Manager->Get_User_Savegame_Directory();
     return (File_Exists(save_dir / utf8_to_path(int_to_string(save_slot) + ".tscsav")) || File_Exists(save_dir / utf8_to_path(int_to_string(save_slot) + ".smcsav")) ||
             File_Exists(save_dir / utf8_to_path(int_to_string(save_slot) + ".save")));
@@ -41,7 +41,7 @@ namespace TSC {
 
 /* *** *** *** *** *** *** *** Base Animation class *** *** *** *** *** *** *** *** *** *** */
 
-cAnimation::cAnimation(cSprite_Manager* sprite_manager, std::string type_name /* = "sprite" */)
+cAnimation::cAnimation(cSprite_Manager* sprite_manager, const char* type_name /* = "sprite" */)
     : cMovingSprite(sprite_manager, type_name)
 {
     m_sprite_array = ARRAY_ANIM;
@@ -569,7 +569,7 @@ void cParticle_Emitter::Init(void)
     m_editor_pos_z = 0.111f;
     m_sprite_array = ARRAY_ACTIVE;
     m_type = TYPE_PARTICLE_EMITTER;
-    m_name = "Particle Emitter";
+    Editor_Data().m_name = "Particle Emitter";
 
     m_emitter_based_on_camera_pos = 0;
     m_particle_based_on_emitter_pos = 0.0f;
@@ -662,68 +662,66 @@ std::string cParticle_Emitter::Get_XML_Type_Name()
     return "";
 }
 
-xmlpp::Element* cParticle_Emitter::Save_To_XML_Node(xmlpp::Element* p_element)
+void cParticle_Emitter::Save_To_XML_Node(cXml_Writer& writer)
 {
-    xmlpp::Element* p_node = cAnimation::Save_To_XML_Node(p_element);
+    cAnimation::Save_To_XML_Node(writer);
 
     // particle image filename
-    Add_Property(p_node, "particle_image", path_to_utf8(m_image_filename));
+    Add_Property(writer, "particle_image", path_to_utf8(m_image_filename));
     // position z
-    Add_Property(p_node, "pos_z",      m_pos_z);
-    Add_Property(p_node, "pos_z_rand", m_pos_z_rand);
+    Add_Property(writer, "pos_z",      m_pos_z);
+    Add_Property(writer, "pos_z_rand", m_pos_z_rand);
     // emitter based on camera pos
-    Add_Property(p_node, "emitter_based_on_camera_pos", m_emitter_based_on_camera_pos);
+    Add_Property(writer, "emitter_based_on_camera_pos", m_emitter_based_on_camera_pos);
     // particle based on emitter pos
-    Add_Property(p_node, "particle_based_on_emitter_pos", m_particle_based_on_emitter_pos);
+    Add_Property(writer, "particle_based_on_emitter_pos", m_particle_based_on_emitter_pos);
     // emitter rect (X and Y positions are saved by cSprite::Save_To_XML_Node())
-    Add_Property(p_node, "sizex", static_cast<int>(m_start_rect.m_w));
-    Add_Property(p_node, "sizey", static_cast<int>(m_start_rect.m_h));
+    Add_Property(writer, "sizex", static_cast<int>(m_start_rect.m_w));
+    Add_Property(writer, "sizey", static_cast<int>(m_start_rect.m_h));
     // emitter interval
-    Add_Property(p_node, "emitter_time_to_live", m_emitter_time_to_live);
-    Add_Property(p_node, "emitter_interval",     m_emitter_iteration_interval);
+    Add_Property(writer, "emitter_time_to_live", m_emitter_time_to_live);
+    Add_Property(writer, "emitter_interval",     m_emitter_iteration_interval);
     // quota/count
-    Add_Property(p_node, "quota", m_emitter_quota);
+    Add_Property(writer, "quota", m_emitter_quota);
     // time to live
-    Add_Property(p_node, "time_to_live", m_time_to_live);
-    Add_Property(p_node, "time_to_live_rand", m_time_to_live_rand);
+    Add_Property(writer, "time_to_live", m_time_to_live);
+    Add_Property(writer, "time_to_live_rand", m_time_to_live_rand);
     // velocity
-    Add_Property(p_node, "vel", m_vel);
-    Add_Property(p_node, "vel_rand", m_vel_rand);
+    Add_Property(writer, "vel", m_vel);
+    Add_Property(writer, "vel_rand", m_vel_rand);
     // start rotation
-    Add_Property(p_node, "rot_x", m_start_rot_x);
-    Add_Property(p_node, "rot_y", m_start_rot_y);
-    Add_Property(p_node, "rot_z", m_start_rot_z);
-    Add_Property(p_node, "start_rot_z_uses_direction", m_start_rot_z_uses_direction);
+    Add_Property(writer, "rot_x", m_start_rot_x);
+    Add_Property(writer, "rot_y", m_start_rot_y);
+    Add_Property(writer, "rot_z", m_start_rot_z);
+    Add_Property(writer, "start_rot_z_uses_direction", m_start_rot_z_uses_direction);
     // constant rotation x
-    Add_Property(p_node, "const_rot_x", m_const_rot_x);
-    Add_Property(p_node, "const_rot_x_rand", m_const_rot_x_rand);
+    Add_Property(writer, "const_rot_x", m_const_rot_x);
+    Add_Property(writer, "const_rot_x_rand", m_const_rot_x_rand);
     // constant rotation y
-    Add_Property(p_node, "const_rot_y", m_const_rot_y);
-    Add_Property(p_node, "const_rot_y_rand", m_const_rot_y_rand);
+    Add_Property(writer, "const_rot_y", m_const_rot_y);
+    Add_Property(writer, "const_rot_y_rand", m_const_rot_y_rand);
     // constant rotation z
-    Add_Property(p_node, "const_rot_z", m_const_rot_z);
-    Add_Property(p_node, "const_rot_z_rand", m_const_rot_z_rand);
+    Add_Property(writer, "const_rot_z", m_const_rot_z);
+    Add_Property(writer, "const_rot_z_rand", m_const_rot_z_rand);
     // angle
-    Add_Property(p_node, "angle_start", m_angle_start);
-    Add_Property(p_node, "angle_range", m_angle_range);
+    Add_Property(writer, "angle_start", m_angle_start);
+    Add_Property(writer, "angle_range", m_angle_range);
     // scale
-    Add_Property(p_node, "size_scale", m_size_scale);
-    Add_Property(p_node, "size_scale_rand", m_size_scale_rand);
+    Add_Property(writer, "size_scale", m_size_scale);
+    Add_Property(writer, "size_scale_rand", m_size_scale_rand);
     // horizontal gravity
-    Add_Property(p_node, "gravity_x", m_gravity_x);
-    Add_Property(p_node, "gravity_x_rand", m_gravity_x_rand);
+    Add_Property(writer, "gravity_x", m_gravity_x);
+    Add_Property(writer, "gravity_x_rand", m_gravity_x_rand);
     // vertical gravity
-    Add_Property(p_node, "gravity_y", m_gravity_y);
-    Add_Property(p_node, "gravity_y_rand", m_gravity_y_rand);
+    Add_Property(writer, "gravity_y", m_gravity_y);
+    Add_Property(writer, "gravity_y_rand", m_gravity_y_rand);
     // clip rect
-    Add_Property(p_node, "clip_x", static_cast<int>(m_clip_rect.m_x));
-    Add_Property(p_node, "clip_y", static_cast<int>(m_clip_rect.m_y));
-    Add_Property(p_node, "clip_w", static_cast<int>(m_clip_rect.m_w));
-    Add_Property(p_node, "clip_h", static_cast<int>(m_clip_rect.m_h));
+    Add_Property(writer, "clip_x", static_cast<int>(m_clip_rect.m_x));
+    Add_Property(writer, "clip_y", static_cast<int>(m_clip_rect.m_y));
+    Add_Property(writer, "clip_w", static_cast<int>(m_clip_rect.m_w));
+    Add_Property(writer, "clip_h", static_cast<int>(m_clip_rect.m_h));
     // clip mode
-    Add_Property(p_node, "clip_mode", m_clip_mode);
-
-    return p_node;
+    Add_Property(writer, "clip_mode", m_clip_mode);
 }
 
 void cParticle_Emitter::Pre_Update(void)
@@ -35,7 +35,7 @@ namespace TSC {
 
     class cAnimation : public cMovingSprite {
     public:
-        cAnimation(cSprite_Manager* sprite_manager, std::string type_name = "sprite");
+        cAnimation(cSprite_Manager* sprite_manager, const char* type_name = "sprite");
         virtual ~cAnimation(void);
 
         // initialize animation
@@ -48,7 +48,7 @@ namespace TSC {
         // Create the MRuby object for this
         virtual mrb_value Create_MRuby_Object(mrb_state* p_state)
         {
-            return mrb_obj_value(Data_Wrap_Struct(p_state, mrb_class_get(p_state, "Animation"), &Scripting::rtTSC_Scriptable, this));
+            return Scripting::Wrap_Sprite(p_state, mrb_class_get(p_state, "Animation"), this);
         }
 
         // Set time to live for Objects in seconds
@@ -178,7 +178,7 @@ namespace TSC {
         // Create the MRuby object for this
         virtual mrb_value Create_MRuby_Object(mrb_state* p_state)
         {
-            return mrb_obj_value(Data_Wrap_Struct(p_state, mrb_class_get(p_state, "ParticleEmitter"), &Scripting::rtTSC_Scriptable, this));
+            return Scripting::Wrap_Sprite(p_state, mrb_class_get(p_state, "ParticleEmitter"), this);
         }
 
         // pre-update animation
@@ -366,7 +366,7 @@ namespace TSC {
         ParticleClipMode m_clip_mode;
 
         // Save to XML node
-        virtual xmlpp::Element* Save_To_XML_Node(xmlpp::Element* p_element);
+        virtual void Save_To_XML_Node(cXml_Writer& writer);
 
     protected:
         virtual std::string Get_XML_Type_Name();
@@ -0,0 +1,715 @@
+/***************************************************************************
+ * downscale.cpp - RGBA image downscaling kernels
+ *
+ * Copyright © 2012-2020 The TSC Contributors
+ ***************************************************************************/
+/*
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <cstring>
+
+#include "../video/downscale.hpp"
+#include "../core/global_basic.hpp"
+#include "../core/filesystem/filesystem.hpp"
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define TSC_DOWNSCALE_X86
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+/* GCC and Clang only allow the intrinsics in functions compiled for
+ * the instruction set, MSVC always allows them. This way the rest of
+ * the game does not need to be built with -mavx2. */
+#if defined(TSC_DOWNSCALE_X86) && defined(__GNUC__)
+#define TSC_TARGET_SSE2 __attribute__((target("sse2")))
+#define TSC_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define TSC_TARGET_SSE2
+#define TSC_TARGET_AVX2
+#endif
+
+using namespace std;
+
+namespace fs = boost::filesystem;
+
+namespace TSC {
+
+/* *** *** *** *** *** *** *** Kernels *** *** *** *** *** *** *** *** *** *** */
+
+/* Source pixels contributing to one destination pixel.
+ * Their weights start at m_weight in the weights list. */
+struct cDownscale_Contribution {
+    int m_first;
+    int m_count;
+    size_t m_weight;
+};
+
+/* One set of kernels per instruction set. The images are scaled
+ * vertically by summing the source rows into an accumulator row, which
+ * is where nearly all the time is spent, then horizontally. */
+struct cDownscale_Kernels {
+    const char* m_name;
+    // acc[i] += row[i]
+    void (*m_add_row)(const unsigned char* row, uint16_t* acc, size_t count);
+    /* sum up `block_x' accumulated pixels each and divide by the block
+     * area, which must be a power of two given as `area_shift' */
+    void (*m_resolve_blocks)(const uint16_t* acc, unsigned char* dst, int dst_width, int block_x, int area_shift);
+    // acc[i] += row[i] * weight
+    void (*m_add_row_weighted)(const unsigned char* row, float weight, float* acc, size_t count);
+    // scale an accumulator row horizontally
+    void (*m_resolve_row)(const float* acc, const cDownscale_Contribution* contributions, const float* weights, unsigned char* dst, int dst_width);
+};
+
+static inline unsigned char Float_To_Byte(float value)
+{
+    value += 0.5f;
+
+    if (value <= 0.0f) {
+        return 0;
+    }
+    if (value >= 255.0f) {
+        return 255;
+    }
+
+    return static_cast<unsigned char>(value);
+}
+
+static void Add_Row_Scalar(const unsigned char* row, uint16_t* acc, size_t count)
+{
+    for (size_t i = 0; i < count; i++) {
+        acc[i] += row[i];
+    }
+}
+
+static void Resolve_Blocks_Scalar(const uint16_t* acc, unsigned char* dst, int dst_width, int block_x, int area_shift)
+{
+    const unsigned int rounding = (1 << area_shift) >> 1;
+
+    for (int x = 0; x < dst_width; x++) {
+        unsigned int sum[4] = {rounding, rounding, rounding, rounding};
+
+        for (int u = 0; u < block_x; u++, acc += 4) {
+            sum[0] += acc[0];
+            sum[1] += acc[1];
+            sum[2] += acc[2];
+            sum[3] += acc[3];
+        }
+
+        dst[x * 4] = sum[0] >> area_shift;
+        dst[x * 4 + 1] = sum[1] >> area_shift;
+        dst[x * 4 + 2] = sum[2] >> area_shift;
+        dst[x * 4 + 3] = sum[3] >> area_shift;
+    }
+}
+
+static void Add_Row_Weighted_Scalar(const unsigned char* row, float weight, float* acc, size_t count)
+{
+    for (size_t i = 0; i < count; i++) {
+        acc[i] += row[i] * weight;
+    }
+}
+
+static void Resolve_Row_Scalar(const float* acc, const cDownscale_Contribution* contributions, const float* weights, unsigned char* dst, int dst_width)
+{
+    for (int x = 0; x < dst_width; x++) {
+        const cDownscale_Contribution& contribution = contributions[x];
+        const float* pixel = acc + contribution.m_first * 4;
+        const float* weight = weights + contribution.m_weight;
+        float sum[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+
+        for (int i = 0; i < contribution.m_count; i++, pixel += 4) {
+            sum[0] += pixel[0] * weight[i];
+            sum[1] += pixel[1] * weight[i];
+            sum[2] += pixel[2] * weight[i];
+            sum[3] += pixel[3] * weight[i];
+        }
+
+        dst[x * 4] = Float_To_Byte(sum[0]);
+        dst[x * 4 + 1] = Float_To_Byte(sum[1]);
+        dst[x * 4 + 2] = Float_To_Byte(sum[2]);
+        dst[x * 4 + 3] = Float_To_Byte(sum[3]);
+    }
+}
+
+#ifdef TSC_DOWNSCALE_X86
+
+TSC_TARGET_SSE2 static void Add_Row_SSE2(const unsigned char* row, uint16_t* acc, size_t count)
+{
+    const __m128i zero = _mm_setzero_si128();
+    size_t i = 0;
+
+    // 16 channels at a time, widened to 16 bit
+    for (; i + 16 <= count; i += 16) {
+        __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row + i));
+        __m128i* dst = reinterpret_cast<__m128i*>(acc + i);
+
+        _mm_storeu_si128(dst, _mm_add_epi16(_mm_loadu_si128(dst), _mm_unpacklo_epi8(pixels, zero)));
+        _mm_storeu_si128(dst + 1, _mm_add_epi16(_mm_loadu_si128(dst + 1), _mm_unpackhi_epi8(pixels, zero)));
+    }
+
+    Add_Row_Scalar(row + i, acc + i, count - i);
+}
+
+TSC_TARGET_SSE2 static void Resolve_Blocks_SSE2(const uint16_t* acc, unsigned char* dst, int dst_width, int block_x, int area_shift)
+{
+    const __m128i rounding = _mm_set1_epi16(static_cast<short>((1 << area_shift) >> 1));
+    const __m128i shift = _mm_cvtsi32_si128(area_shift);
+    int x = 0;
+
+    // the common 2 pixels wide blocks: two destination pixels from four accumulated ones
+    if (block_x == 2) {
+        for (; x + 2 <= dst_width; x += 2, acc += 16) {
+            __m128i first = _mm_loadu_si128(reinterpret_cast<const __m128i*>(acc));
+            __m128i second = _mm_loadu_si128(reinterpret_cast<const __m128i*>(acc + 8));
+            __m128i sum = _mm_add_epi16(_mm_unpacklo_epi64(first, second), _mm_unpackhi_epi64(first, second));
+
+            sum = _mm_srl_epi16(_mm_add_epi16(sum, rounding), shift);
+            _mm_storel_epi64(reinterpret_cast<__m128i*>(dst + x * 4), _mm_packus_epi16(sum, sum));
+        }
+    }
+
+    for (; x < dst_width; x++) {
+        __m128i sum = rounding;
+
+        for (int u = 0; u < block_x; u++, acc += 4) {
+            sum = _mm_add_epi16(sum, _mm_loadl_epi64(reinterpret_cast<const __m128i*>(acc)));
+        }
+
+        sum = _mm_srl_epi16(sum, shift);
+
+        int32_t rgba = _mm_cvtsi128_si32(_mm_packus_epi16(sum, sum));
+        memcpy(dst + x * 4, &rgba, 4);
+    }
+}
+
+TSC_TARGET_SSE2 static void Add_Row_Weighted_SSE2(const unsigned char* row, float weight, float* acc, size_t count)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128 factor = _mm_set1_ps(weight);
+    size_t i = 0;
+
+    for (; i + 16 <= count; i += 16) {
+        __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row + i));
+        __m128i low = _mm_unpacklo_epi8(pixels, zero);
+        __m128i high = _mm_unpackhi_epi8(pixels, zero);
+        __m128i parts[4] = {_mm_unpacklo_epi16(low, zero), _mm_unpackhi_epi16(low, zero), _mm_unpacklo_epi16(high, zero), _mm_unpackhi_epi16(high, zero)};
+
+        for (int part = 0; part < 4; part++) {
+            float* dst = acc + i + part * 4;
+            _mm_storeu_ps(dst, _mm_add_ps(_mm_loadu_ps(dst), _mm_mul_ps(_mm_cvtepi32_ps(parts[part]), factor)));
+        }
+    }
+
+    Add_Row_Weighted_Scalar(row + i, weight, acc + i, count - i);
+}
+
+TSC_TARGET_SSE2 static void Resolve_Row_SSE2(const float* acc, const cDownscale_Contribution* contributions, const float* weights, unsigned char* dst, int dst_width)
+{
+    const __m128 half = _mm_set1_ps(0.5f);
+
+    // one RGBA pixel fits exactly into one register
+    for (int x = 0; x < dst_width; x++) {
+        const cDownscale_Contribution& contribution = contributions[x];
+        const float* pixel = acc + contribution.m_first * 4;
+        const float* weight = weights + contribution.m_weight;
+        __m128 sum = _mm_setzero_ps();
+
+        for (int i = 0; i < contribution.m_count; i++, pixel += 4) {
+            sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(pixel), _mm_set1_ps(weight[i])));
+        }
+
+        // saturating packs clamp to 0..255
+        __m128i result = _mm_cvttps_epi32(_mm_add_ps(sum, half));
+        result = _mm_packs_epi32(result, result);
+        result = _mm_packus_epi16(result, result);
+
+        int32_t rgba = _mm_cvtsi128_si32(result);
+        memcpy(dst + x * 4, &rgba, 4);
+    }
+}
+
+TSC_TARGET_AVX2 static void Add_Row_AVX2(const unsigned char* row, uint16_t* acc, size_t count)
+{
+    size_t i = 0;
+
+    // 16 channels at a time, widened to 16 bit
+    for (; i + 16 <= count; i += 16) {
+        __m256i pixels = _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(row + i)));
+        __m256i* dst = reinterpret_cast<__m256i*>(acc + i);
+
+        _mm256_storeu_si256(dst, _mm256_add_epi16(_mm256_loadu_si256(dst), pixels));
+    }
+
+    Add_Row_Scalar(row + i, acc + i, count - i);
+}
+
+TSC_TARGET_AVX2 static void Add_Row_Weighted_AVX2(const unsigned char* row, float weight, float* acc, size_t count)
+{
+    const __m256 factor = _mm256_set1_ps(weight);
+    size_t i = 0;
+
+    for (; i + 8 <= count; i += 8) {
+        __m256 pixels = _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(row + i))));
+
+        _mm256_storeu_ps(acc + i, _mm256_add_ps(_mm256_loadu_ps(acc + i), _mm256_mul_ps(pixels, factor)));
+    }
+
+    Add_Row_Weighted_Scalar(row + i, weight, acc + i, count - i);
+}
+
+#endif
+
+static const cDownscale_Kernels downscale_kernels_scalar = {"scalar", Add_Row_Scalar, Resolve_Blocks_Scalar, Add_Row_Weighted_Scalar, Resolve_Row_Scalar};
+#ifdef TSC_DOWNSCALE_X86
+static const cDownscale_Kernels downscale_kernels_sse2 = {"SSE2", Add_Row_SSE2, Resolve_Blocks_SSE2, Add_Row_Weighted_SSE2, Resolve_Row_SSE2};
+// the horizontal passes only handle one or two pixels at a time, so SSE2 is enough for them
+static const cDownscale_Kernels downscale_kernels_avx2 = {"AVX2", Add_Row_AVX2, Resolve_Blocks_SSE2, Add_Row_Weighted_AVX2, Resolve_Row_SSE2};
+#endif
+
+/* *** *** *** *** *** *** *** CPU detection *** *** *** *** *** *** *** *** *** *** */
+
+static bool Cpu_Has_SSE2(void)
+{
+#if defined(__x86_64__) || defined(_M_X64)
+    // part of the base instruction set
+    return 1;
+#elif defined(TSC_DOWNSCALE_X86) && defined(__GNUC__)
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("sse2");
+#elif defined(TSC_DOWNSCALE_X86) && defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 1);
+    return (info[3] & (1 << 26)) != 0;
+#else
+    return 0;
+#endif
+}
+
+static bool Cpu_Has_AVX2(void)
+{
+#if defined(TSC_DOWNSCALE_X86) && defined(__GNUC__)
+    // also checks that the OS saves the AVX registers
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+#elif defined(TSC_DOWNSCALE_X86) && defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 0);
+
+    if (info[0] < 7) {
+        return 0;
+    }
+
+    // AVX and OSXSAVE
+    __cpuid(info, 1);
+
+    if ((info[2] & (1 << 27)) == 0 || (info[2] & (1 << 28)) == 0) {
+        return 0;
+    }
+    // the OS saves the XMM and YMM registers
+    if ((_xgetbv(0) & 6) != 6) {
+        return 0;
+    }
+
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#else
+    return 0;
+#endif
+}
+
+/* The kernel sets this CPU can run, fastest first. There is no NEON
+ * set yet, ARM uses the plain C++ kernels which compilers vectorize
+ * reasonably well. */
+static std::vector<const cDownscale_Kernels*> Get_Supported_Kernels(void)
+{
+    std::vector<const cDownscale_Kernels*> kernels;
+
+#ifdef TSC_DOWNSCALE_X86
+    if (Cpu_Has_AVX2()) {
+        kernels.push_back(&downscale_kernels_avx2);
+    }
+    if (Cpu_Has_SSE2()) {
+        kernels.push_back(&downscale_kernels_sse2);
+    }
+#endif
+    kernels.push_back(&downscale_kernels_scalar);
+
+    return kernels;
+}
+
+static const cDownscale_Kernels& Get_Best_Kernels(void)
+{
+    // detected once, thread-safe initialization
+    static const cDownscale_Kernels* kernels = Get_Supported_Kernels().front();
+    return *kernels;
+}
+
+const char* Get_Downscale_Kernel_Name(void)
+{
+    return Get_Best_Kernels().m_name;
+}
+
+/* *** *** *** *** *** *** *** Downscaling *** *** *** *** *** *** *** *** *** *** */
+
+/* Integer ratios: sum up each block exactly and round like the
+ * previous scalar implementation did. Power-of-two blocks of up to
+ * 256 pixels, which is what texture detail and maximum texture size
+ * produce, fit into 16 bit and divide by shifting. */
+static void Downscale_Blocks(const cDownscale_Kernels& kernels, const unsigned char* src, int src_width, int src_height, unsigned char* dst, int block_x, int block_y)
+{
+    const int dst_width = src_width / block_x;
+    const int dst_height = src_height / block_y;
+    const size_t row_size = static_cast<size_t>(src_width) * 4;
+    const uint32_t block_area = block_x * block_y;
+
+    if (block_area <= 256 && (block_area & (block_area - 1)) == 0) {
+        int area_shift = 0;
+
+        while ((1u << area_shift) < block_area) {
+            area_shift++;
+        }
+
+        std::vector<uint16_t> acc(row_size);
+
+        for (int y = 0; y < dst_height; y++) {
+            std::fill(acc.begin(), acc.end(), 0);
+
+            for (int v = 0; v < block_y; v++) {
+                kernels.m_add_row(src + (y * block_y + v) * row_size, &acc[0], row_size);
+            }
+
+            kernels.m_resolve_blocks(&acc[0], dst + static_cast<size_t>(y) * dst_width * 4, dst_width, block_x, area_shift);
+        }
+
+        return;
+    }
+
+    // rare odd blocks
+    std::vector<uint32_t> acc(row_size);
+
+    for (int y = 0; y < dst_height; y++) {
+        std::fill(acc.begin(), acc.end(), 0);
+
+        for (int v = 0; v < block_y; v++) {
+            const unsigned char* row = src + (y * block_y + v) * row_size;
+
+            for (size_t i = 0; i < row_size; i++) {
+                acc[i] += row[i];
+            }
+        }
+
+        unsigned char* dst_row = dst + static_cast<size_t>(y) * dst_width * 4;
+        const uint32_t* block = &acc[0];
+
+        for (int x = 0; x < dst_width; x++) {
+            uint32_t sum[4] = {block_area >> 1, block_area >> 1, block_area >> 1, block_area >> 1};
+
+            for (int u = 0; u < block_x; u++, block += 4) {
+                sum[0] += block[0];
+                sum[1] += block[1];
+                sum[2] += block[2];
+                sum[3] += block[3];
+            }
+
+            dst_row[x * 4] = sum[0] / block_area;
+            dst_row[x * 4 + 1] = sum[1] / block_area;
+            dst_row[x * 4 + 2] = sum[2] / block_area;
+            dst_row[x * 4 + 3] = sum[3] / block_area;
+        }
+    }
+}
+
+// Which source pixels make up each destination pixel along one axis
+static void Calculate_Contributions(int src_size, int dst_size, DownscaleFilter filter, std::vector<cDownscale_Contribution>& contributions, std::vector<float>& weights)
+{
+    contributions.resize(dst_size);
+    weights.clear();
+
+    const double scale = static_cast<double>(src_size) / dst_size;
+
+    for (int d = 0; d < dst_size; d++) {
+        cDownscale_Contribution& contribution = contributions[d];
+        contribution.m_weight = weights.size();
+
+        if (filter == DOWNSCALE_FILTER_BOX) {
+            int first = static_cast<int>((static_cast<int64_t>(d) * src_size) / dst_size);
+            int last = static_cast<int>((static_cast<int64_t>(d + 1) * src_size) / dst_size);
+
+            if (last <= first) {
+                last = first + 1;
+            }
+
+            contribution.m_first = first;
+            contribution.m_count = last - first;
+            weights.insert(weights.end(), contribution.m_count, 1.0f / contribution.m_count);
+        }
+        else {
+            const double start = d * scale;
+            const double end = (d + 1) * scale;
+            int first = static_cast<int>(floor(start));
+            int last = std::min(static_cast<int>(ceil(end)), src_size);
+
+            contribution.m_first = first;
+            contribution.m_count = last - first;
+
+            // covered part of each source pixel, normalized to a sum of 1
+            for (int s = first; s < last; s++) {
+                double covered = std::min(end, s + 1.0) - std::max(start, static_cast<double>(s));
+                weights.push_back(static_cast<float>(covered / scale));
+            }
+        }
+    }
+}
+
+static void Downscale_Weighted(const cDownscale_Kernels& kernels, const unsigned char* src, int src_width, int src_height, unsigned char* dst, int dst_width, int dst_height, DownscaleFilter filter)
+{
+    std::vector<cDownscale_Contribution> columns, rows;
+    std::vector<float> column_weights, row_weights;
+
+    Calculate_Contributions(src_width, dst_width, filter, columns, column_weights);
+    Calculate_Contributions(src_height, dst_height, filter, rows, row_weights);
+
+    const size_t row_size = static_cast<size_t>(src_width) * 4;
+    std::vector<float> acc(row_size);
+
+    for (int y = 0; y < dst_height; y++) {
+        std::fill(acc.begin(), acc.end(), 0.0f);
+
+        for (int i = 0; i < rows[y].m_count; i++) {
+            kernels.m_add_row_weighted(src + (rows[y].m_first + i) * row_size, row_weights[rows[y].m_weight + i], &acc[0], row_size);
+        }
+
+        kernels.m_resolve_row(&acc[0], &columns[0], &column_weights[0], dst + static_cast<size_t>(y) * dst_width * 4, dst_width);
+    }
+}
+
+static bool Downscale_RGBA_With(const cDownscale_Kernels& kernels, const unsigned char* src, int src_width, int src_height, unsigned char* dst, int dst_width, int dst_height, DownscaleFilter filter)
+{
+    // error check
+    if (src_width <= 0 || src_height <= 0 || dst_width <= 0 || dst_height <= 0 || src == NULL || dst == NULL) {
+        // invalid argument
+        return 0;
+    }
+
+    // both filters are the same for integer ratios
+    if (src_width % dst_width == 0 && src_height % dst_height == 0) {
+        if (src_width == dst_width && src_height == dst_height) {
+            memcpy(dst, src, static_cast<size_t>(src_width) * src_height * 4);
+        }
+        else {
+            Downscale_Blocks(kernels, src, src_width, src_height, dst, src_width / dst_width, src_height / dst_height);
+        }
+    }
+    else {
+        Downscale_Weighted(kernels, src, src_width, src_height, dst, dst_width, dst_height, filter);
+    }
+
+    return 1;
+}
+
+bool Downscale_RGBA(const unsigned char* src, int src_width, int src_height, unsigned char* dst, int dst_width, int dst_height, DownscaleFilter filter /* = DOWNSCALE_FILTER_AREA */)
+{
+    return Downscale_RGBA_With(Get_Best_Kernels(), src, src_width, src_height, dst, dst_width, dst_height, filter);
+}
+
+bool Downscale_RGBA_Alpha_Weighted(const unsigned char* src, int src_width, int src_height, unsigned char* dst, int dst_width, int dst_height)
+{
+    // error check
+    if (src_width <= 0 || src_height <= 0 || dst_width <= 0 || dst_height <= 0 || src == NULL || dst == NULL) {
+        // invalid argument
+        return 0;
+    }
+
+    std::vector<cDownscale_Contribution> columns;
+    std::vector<cDownscale_Contribution> rows;
+    std::vector<float> column_weights;
+    std::vector<float> row_weights;
+
+    Calculate_Contributions(src_width, dst_width, DOWNSCALE_FILTER_AREA, columns, column_weights);
+    Calculate_Contributions(src_height, dst_height, DOWNSCALE_FILTER_AREA, rows, row_weights);
+
+    for (int y = 0; y < dst_height; y++) {
+        for (int x = 0; x < dst_width; x++) {
+            // alpha weighted and plain colour sums
+            float color[3] = {0.0f, 0.0f, 0.0f};
+            float plain_color[3] = {0.0f, 0.0f, 0.0f};
+            float alpha = 0.0f;
+
+            for (int j = 0; j < rows[y].m_count; j++) {
+                const unsigned char* row = src + static_cast<size_t>(rows[y].m_first + j) * src_width * 4;
+                const float row_weight = row_weights[rows[y].m_weight + j];
+
+                for (int i = 0; i < columns[x].m_count; i++) {
+                    const unsigned char* pixel = row + (columns[x].m_first + i) * 4;
+                    const float weight = row_weight * column_weights[columns[x].m_weight + i];
+                    const float weighted_alpha = weight * pixel[3];
+
+                    for (int c = 0; c < 3; c++) {
+                        color[c] += weighted_alpha * pixel[c];
+                        plain_color[c] += weight * pixel[c];
+                    }
+
+                    alpha += weighted_alpha;
+                }
+            }
+
+            unsigned char* out = dst + (static_cast<size_t>(y) * dst_width + x) * 4;
+
+            for (int c = 0; c < 3; c++) {
+                // fully transparent keeps the plain average
+                float value = alpha > 0.0f ? color[c] / alpha : plain_color[c];
+                out[c] = static_cast<unsigned char>(std::min(value + 0.5f, 255.0f));
+            }
+
+            out[3] = static_cast<unsigned char>(std::min(alpha + 0.5f, 255.0f));
+        }
+    }
+
+    return 1;
+}
+
+/* *** *** *** *** *** *** *** Benchmark *** *** *** *** *** *** *** *** *** *** */
+
+/* The previous cVideo::Downscale_Image() for 4 channels, only kept
+ * as reference for the benchmark.
+ * function from Jonathan Dummer
+ * from image helper functions
+ * MIT license
+*/
+static void Downscale_Reference(const unsigned char* const orig, int width, int height, unsigned char* resampled, int block_size_x, int block_size_y)
+{
+    const int channels = 4;
+    int mip_width = std::max(width / block_size_x, 1);
+    int mip_height = std::max(height / block_size_y, 1);
+
+    for (int j = 0; j < mip_height; ++j) {
+        for (int i = 0; i < mip_width; ++i) {
+            for (int c = 0; c < channels; ++c) {
+                const int index = (j * block_size_y) * width * channels + (i * block_size_x) * channels + c;
+                int u_block = block_size_x;
+                int v_block = block_size_y;
+
+                if (block_size_x * (i + 1) > width) {
+                    u_block = width - i * block_size_y;
+                }
+                if (block_size_y * (j + 1) > height) {
+                    v_block = height - j * block_size_y;
+                }
+
+                int block_area = u_block * v_block;
+                int sum_value = block_area >> 1;
+
+                for (int v = 0; v < v_block; ++v) {
+                    for (int u = 0; u < u_block; ++u) {
+                        sum_value += orig[index + v * width * channels + u * channels];
+                    }
+                }
+
+                resampled[j * mip_width * channels + i * channels + c] = sum_value / block_area;
+            }
+        }
+    }
+}
+
+void Benchmark_Downscale(const fs::path& dir)
+{
+    const int rounds = 5;
+
+    std::vector<fs::path> files = Get_Directory_Files(dir, ".png");
+    std::vector<sf::Image> images;
+    double megapixels = 0.0;
+
+    for (std::vector<fs::path>::const_iterator itr = files.begin(); itr != files.end(); ++itr) {
+        sf::Image image;
+
+        // too small to be halved
+        if (!image.loadFromFile(path_to_utf8(*itr)) || image.getSize().x < 2 || image.getSize().y < 2) {
+            continue;
+        }
+
+        megapixels += image.getSize().x * image.getSize().y / 1000000.0;
+        images.push_back(image);
+    }
+
+    cout << "Downscaling " << images.size() << " images (" << fixed << setprecision(1) << megapixels << " megapixels) from " << path_to_utf8(dir) << ", " << rounds << " rounds each" << endl;
+
+    if (images.empty()) {
+        return;
+    }
+
+    std::vector<std::vector<unsigned char> > reference(images.size());
+    std::vector<unsigned char> output;
+
+    // half size with the previous implementation
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    for (int round = 0; round < rounds; round++) {
+        for (size_t i = 0; i < images.size(); i++) {
+            reference[i].resize((images[i].getSize().x / 2) * (images[i].getSize().y / 2) * 4);
+            Downscale_Reference(images[i].getPixelsPtr(), images[i].getSize().x, images[i].getSize().y, &reference[i][0], 2, 2);
+        }
+    }
+
+    double reference_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    double reference_rate = megapixels * rounds / reference_seconds;
+
+    cout << setw(10) << left << "previous" << " half: " << setw(8) << right << reference_rate << " MPixel/s" << endl;
+
+    std::vector<const cDownscale_Kernels*> kernels = Get_Supported_Kernels();
+
+    for (std::vector<const cDownscale_Kernels*>::const_iterator itr = kernels.begin(); itr != kernels.end(); ++itr) {
+        unsigned int mismatches = 0;
+
+        // half size
+        start = std::chrono::steady_clock::now();
+
+        for (int round = 0; round < rounds; round++) {
+            for (size_t i = 0; i < images.size(); i++) {
+                int width = images[i].getSize().x / 2;
+                int height = images[i].getSize().y / 2;
+
+                output.resize(width * height * 4);
+                Downscale_RGBA_With(**itr, images[i].getPixelsPtr(), images[i].getSize().x, images[i].getSize().y, &output[0], width, height, DOWNSCALE_FILTER_AREA);
+
+                // the previous implementation truncates odd sizes, so only even ones are comparable
+                if (round == 0 && images[i].getSize().x % 2 == 0 && images[i].getSize().y % 2 == 0 && output != reference[i]) {
+                    mismatches++;
+                }
+            }
+        }
+
+        double half_rate = megapixels * rounds / std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        // three quarters, a non-integer ratio
+        start = std::chrono::steady_clock::now();
+
+        for (int round = 0; round < rounds; round++) {
+            for (size_t i = 0; i < images.size(); i++) {
+                int width = std::max(images[i].getSize().x * 3 / 4, 1u);
+                int height = std::max(images[i].getSize().y * 3 / 4, 1u);
+
+                output.resize(width * height * 4);
+                Downscale_RGBA_With(**itr, images[i].getPixelsPtr(), images[i].getSize().x, images[i].getSize().y, &output[0], width, height, DOWNSCALE_FILTER_AREA);
+            }
+        }
+
+        double area_rate = megapixels * rounds / std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        cout << setw(10) << left << (*itr)->m_name << " half: " << setw(8) << right << half_rate << " MPixel/s (" << setprecision(2) << half_rate / reference_rate << "x)"
+             << setprecision(1) << "  3/4 area: " << setw(8) << area_rate << " MPixel/s  mismatches: " << mismatches << endl;
+    }
+}
+
+/* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
+
+} // namespace TSC
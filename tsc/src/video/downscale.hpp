@@ -0,0 +1,59 @@
+/***************************************************************************
+ * downscale.hpp - RGBA image downscaling kernels
+ *
+ * Copyright © 2012-2020 The TSC Contributors
+ ***************************************************************************/
+/*
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef TSC_DOWNSCALE_HPP
+#define TSC_DOWNSCALE_HPP
+
+#include "../core/global_basic.hpp"
+
+namespace TSC {
+
+    /* *** *** *** *** *** *** *** Downscaling *** *** *** *** *** *** *** *** *** *** */
+
+    enum DownscaleFilter {
+        /* Average the source pixels whose top-left corner falls into the
+         * destination pixel. Exact for integer ratios and fastest. */
+        DOWNSCALE_FILTER_BOX,
+        /* Weight every source pixel by how much of it the destination
+         * pixel covers. Same as the box filter for integer ratios, but
+         * without the uneven blocks it produces for other ratios. */
+        DOWNSCALE_FILTER_AREA
+    };
+
+    /* Scale the 8 bit RGBA image `src' to `dst' with the given sizes.
+     * `dst' must hold dst_width * dst_height * 4 bytes.
+     * Uses the fastest kernel the CPU supports (AVX2, SSE2 or plain C++).
+     * Returns 0 on invalid arguments.
+    */
+    bool Downscale_RGBA(const unsigned char* src, int src_width, int src_height, unsigned char* dst, int dst_width, int dst_height, DownscaleFilter filter = DOWNSCALE_FILTER_AREA);
+
+    /* Scale like the area filter but weight the colours by alpha, so fully
+     * transparent pixels don't bleed into the visible ones. Meant for
+     * mipmap levels and not optimized.
+    */
+    bool Downscale_RGBA_Alpha_Weighted(const unsigned char* src, int src_width, int src_height, unsigned char* dst, int dst_width, int dst_height);
+
+    // Name of the kernel set selected for this CPU
+    const char* Get_Downscale_Kernel_Name(void);
+
+    /* Compare the kernels with the previous scalar implementation on all
+     * PNG images below `dir' and print the throughput to stdout. */
+    void Benchmark_Downscale(const boost::filesystem::path& dir);
+
+    /* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
+
+} // namespace TSC
+
+#endif
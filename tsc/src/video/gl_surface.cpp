@@ -22,18 +22,147 @@
 #include "../core/property_helper.hpp"
 #include "../core/global_basic.hpp"
 
+#include <unordered_set>
+
 using namespace std;
 
 namespace fs = boost::filesystem;
 
 namespace TSC {
 
+/* *** *** *** *** *** *** *** *** cGL_Texture *** *** *** *** *** *** *** *** *** */
+
+// All texture objects alive
+static std::unordered_set<cGL_Texture*> texture_objects;
+// Texture object owning each OpenGL texture
+static std::unordered_map<GLuint, cGL_Texture*> texture_owners;
+
+uint32_t cGL_Texture::s_frame = 0;
+size_t cGL_Texture::s_total_bytes = 0;
+
+cGL_Texture::cGL_Texture(GLuint id)
+{
+    m_id = 0;
+    m_ref_count = 0;
+    m_last_use_frame = s_frame;
+    m_bytes = 0;
+    m_reload_pending = 0;
+
+    texture_objects.insert(this);
+    Set_ID(id);
+}
+
+cGL_Texture::~cGL_Texture(void)
+{
+    assert(m_ref_count == 0);
+
+    Delete_GL_Texture();
+    texture_objects.erase(this);
+}
+
+void cGL_Texture::Add_Ref(void)
+{
+    m_ref_count++;
+}
+
+void cGL_Texture::Release(void)
+{
+    // only called by intrusive_ptr, which holds one of the references
+    assert(m_ref_count > 0);
+
+    if (--m_ref_count == 0) {
+        delete this;
+    }
+}
+
+void cGL_Texture::Set_ID(GLuint id)
+{
+    if (id == m_id) {
+        return;
+    }
+
+    Delete_GL_Texture();
+
+    if (!id) {
+        return;
+    }
+
+    m_reload_pending = 0;
+
+    std::unordered_map<GLuint, cGL_Texture*>::iterator itr = texture_owners.find(id);
+
+    // it would be deleted twice
+    if (itr != texture_owners.end()) {
+        debug_print("Warning : cGL_Texture : Texture %u is already owned by %p\n", id, static_cast<void*>(itr->second));
+        itr->second->m_id = 0;
+        itr->second->Set_Bytes(0);
+    }
+
+    m_id = id;
+    texture_owners[id] = this;
+}
+
+void cGL_Texture::Delete_GL_Texture(void)
+{
+    GLuint id = Take_ID();
+
+    // a frame rendered in the render thread may still use it
+    if (id) {
+        pVideo->m_render_thread.Delete_Texture(id);
+    }
+}
+
+GLuint cGL_Texture::Take_ID(void)
+{
+    GLuint id = m_id;
+
+    if (id) {
+        texture_owners.erase(id);
+        m_id = 0;
+    }
+
+    Set_Bytes(0);
+    return id;
+}
+
+void cGL_Texture::Set_Bytes(size_t bytes)
+{
+    s_total_bytes = s_total_bytes - m_bytes + bytes;
+    m_bytes = bytes;
+}
+
+void cGL_Texture::Invalidate_All(void)
+{
+    for (std::unordered_map<GLuint, cGL_Texture*>::iterator itr = texture_owners.begin(); itr != texture_owners.end(); ++itr) {
+        itr->second->m_id = 0;
+        itr->second->Set_Bytes(0);
+    }
+
+    texture_owners.clear();
+}
+
+size_t cGL_Texture::Get_Count(void)
+{
+    return texture_objects.size();
+}
+
+void cGL_Texture::Report_Leaks(void)
+{
+    if (texture_objects.empty()) {
+        return;
+    }
+
+    debug_print("Warning : cGL_Texture : %u textures were never released\n", static_cast<unsigned int>(texture_objects.size()));
+
+    for (std::unordered_set<cGL_Texture*>::const_iterator itr = texture_objects.begin(); itr != texture_objects.end(); ++itr) {
+        debug_print("  texture %u with %u references\n", (*itr)->m_id, (*itr)->m_ref_count);
+    }
+}
+
 /* *** *** *** *** *** *** *** *** cGL_Surface *** *** *** *** *** *** *** *** *** */
 
 cGL_Surface::cGL_Surface(void)
 {
-    m_image = 0;
-
     m_int_x = 0;
     m_int_y = 0;
     m_start_w = 0;
@@ -42,6 +171,9 @@ cGL_Surface::cGL_Surface(void)
     m_h = 0;
     m_tex_w = 0;
     m_tex_h = 0;
+    m_tex_cover_w = 1.0f;
+    m_tex_cover_h = 1.0f;
+    m_opaque = 0;
 
     // internal rotation data
     m_base_rot_x = 0;
@@ -54,7 +186,6 @@ cGL_Surface::cGL_Surface(void)
     m_col_w = 0;
     m_col_h = 0;
 
-    m_auto_del_img = 1;
     m_managed = 0;
     m_obsolete = 0;
 
@@ -68,10 +199,8 @@ cGL_Surface::cGL_Surface(void)
 
 cGL_Surface::~cGL_Surface(void)
 {
-    // don't delete a managed OpenGL image if still in use by another managed cGL_Surface
-    if (m_auto_del_img && glIsTexture(m_image) && (!m_managed || !Is_Texture_Use_Multiple())) {
-        glDeleteTextures(1, &m_image);
-    }
+    // deletes the OpenGL texture if no copy uses it anymore
+    mp_texture.reset();
 
     if (destruction_function) {
         destruction_function(this);
@@ -84,7 +213,7 @@ cGL_Surface* cGL_Surface::Copy(void) const
     cGL_Surface* new_surface = new cGL_Surface();
 
     // data
-    new_surface->m_image = m_image;
+    new_surface->mp_texture = mp_texture;
     new_surface->m_int_x = m_int_x;
     new_surface->m_int_y = m_int_y;
     new_surface->m_start_w = m_start_w;
@@ -93,6 +222,9 @@ cGL_Surface* cGL_Surface::Copy(void) const
     new_surface->m_h = m_h;
     new_surface->m_tex_h = m_tex_h;
     new_surface->m_tex_w = m_tex_w;
+    new_surface->m_tex_cover_w = m_tex_cover_w;
+    new_surface->m_tex_cover_h = m_tex_cover_h;
+    new_surface->m_opaque = m_opaque;
     new_surface->m_base_rot_x = m_base_rot_x;
     new_surface->m_base_rot_y = m_base_rot_y;
     new_surface->m_base_rot_z = m_base_rot_z;
@@ -137,7 +269,7 @@ void cGL_Surface::Blit(float x, float y, float z, cSurface_Request* request /* =
 void cGL_Surface::Blit_Data(cSurface_Request* request) const
 {
     // texture id
-    request->m_texture_id = m_image;
+    request->m_texture_id = Get_Texture_ID();
 
     // position
     request->m_pos_x += m_int_x;
@@ -146,6 +278,9 @@ void cGL_Surface::Blit_Data(cSurface_Request* request) const
     // size
     request->m_w = m_start_w;
     request->m_h = m_start_h;
+    request->m_tex_cover_w = m_tex_cover_w;
+    request->m_tex_cover_h = m_tex_cover_h;
+    request->m_opaque = m_opaque;
 
     // rotation
     request->m_rot_x += m_base_rot_x;
@@ -153,15 +288,59 @@ void cGL_Surface::Blit_Data(cSurface_Request* request) const
     request->m_rot_z += m_base_rot_z;
 }
 
+bool cGL_Surface::Blit_Tiled(float x, float y, float w, float h, float z, float tile_x, float tile_y, bool repeat_y /* = 1 */) const
+{
+    // the padding would be repeated as well
+    if (m_tex_cover_w < 1.0f || m_tex_cover_h < 1.0f || m_w <= 0.0f || m_h <= 0.0f) {
+        return 0;
+    }
+
+    if (m_base_rot_x != 0.0f || m_base_rot_y != 0.0f || m_base_rot_z != 0.0f) {
+        return 0;
+    }
+
+    // one row placed like Blit()
+    if (!repeat_y) {
+        y = tile_y + m_int_y;
+        h = m_h;
+    }
+
+    cTiled_Surface_Request* request = new cTiled_Surface_Request();
+
+    request->m_texture_id = Get_Texture_ID();
+    request->m_opaque = m_opaque;
+
+    // position
+    request->m_pos_x = x;
+    request->m_pos_y = y;
+    request->m_pos_z = z;
+
+    // size
+    request->m_w = w;
+    request->m_h = h;
+
+    // tiles start at the tile position with the internal drawing offset
+    request->m_tex_x = (x - tile_x - m_int_x) / m_w;
+    request->m_tex_y = (y - tile_y - m_int_y) / m_h;
+    request->m_tex_repeat_w = w / m_w;
+    request->m_tex_repeat_h = h / m_h;
+    request->m_repeat_y = repeat_y;
+
+    // add request
+    pRenderer->Add(request);
+
+    return 1;
+}
+
 void cGL_Surface::Save(const std::string& filename)
 {
-    if (!m_image) {
+    if (!Get_Texture_ID()) {
         cerr << "Couldn't save cGL_Surface : No Image Texture ID set" << endl;
         return;
     }
 
     // bind the texture
-    glBindTexture(GL_TEXTURE_2D, m_image);
+    glBindTexture(GL_TEXTURE_2D, Get_Texture_ID());
 
     // create image data
     GLubyte* data = new GLubyte[m_tex_w * m_tex_h * 4];
@@ -180,19 +359,85 @@ void cGL_Surface::Set_Ground_Type(GroundType gtype)
 
 bool cGL_Surface::Is_Texture_Use_Multiple(void) const
 {
-    for (GL_Surface_List::iterator itr = pImage_Manager->objects.begin(); itr != pImage_Manager->objects.end(); ++itr) {
-        cGL_Surface* obj = (*itr);
+    return mp_texture && mp_texture->Get_Ref_Count() > 1;
+}
 
-        if (obj == this) {
-            continue;
-        }
+void cGL_Surface::Set_Texture(cGL_Texture* texture)
+{
+    // intrusive_ptr takes the new reference before releasing the old one
+    mp_texture = texture;
+}
 
-        if (obj->m_image == m_image) {
-            return 1;
-        }
+void cGL_Surface::Set_Texture_Size(unsigned int width, unsigned int height, bool mipmap /* = 0 */)
+{
+    m_tex_w = width;
+    m_tex_h = height;
+
+    if (mp_texture) {
+        size_t bytes = static_cast<size_t>(width) * height * 4;
+        // the smaller mipmap levels add a third
+        mp_texture->Set_Bytes(mipmap ? bytes + bytes / 3 : bytes);
+    }
+}
+
+void cGL_Surface::Take_Texture(cGL_Surface* surface)
+{
+    size_t bytes = surface->mp_texture ? surface->mp_texture->Get_Bytes() : 0;
+
+    // the surface size depends on the settings, only the texture resolution may differ
+    Set_Texture_ID(surface->mp_texture ? surface->mp_texture->Take_ID() : 0);
+    m_tex_w = surface->m_tex_w;
+    m_tex_h = surface->m_tex_h;
+    m_tex_cover_w = surface->m_tex_cover_w;
+    m_tex_cover_h = surface->m_tex_cover_h;
+    m_opaque = surface->m_opaque;
+
+    if (mp_texture) {
+        mp_texture->Set_Bytes(bytes);
     }
+}
 
-    return 0;
+void cGL_Surface::Unload_Texture(void)
+{
+    if (!mp_texture) {
+        return;
+    }
+
+    mp_texture->Delete_GL_Texture();
+    mp_texture->m_reload_pending = !m_path.empty();
+}
+
+void cGL_Surface::Reload_Texture(void) const
+{
+    if (!mp_texture || !mp_texture->m_reload_pending) {
+        return;
+    }
+
+    // only try once
+    mp_texture->m_reload_pending = 0;
+
+    // the texture is shared with copies anyway
+    cGL_Surface* self = const_cast<cGL_Surface*>(this);
+
+    cGL_Surface* surface_copy = pVideo->Load_GL_Surface(m_path);
+
+    if (!surface_copy) {
+        cerr << "Warning: cGL_Surface :: Reload_Texture " << path_to_utf8(m_path) << " loading failed" << endl;
+        return;
+    }
+
+    self->Take_Texture(surface_copy);
+    delete surface_copy;
+}
+
+void cGL_Surface::Set_Texture_ID(GLuint id)
+{
+    if (mp_texture) {
+        mp_texture->Set_ID(id);
+    }
+    else if (id) {
+        Set_Texture(new cGL_Texture(id));
+    }
 }
 
 cSaved_Texture* cGL_Surface::Get_Software_Texture(bool only_filename /* = 0 */)
@@ -202,7 +447,7 @@ cSaved_Texture* cGL_Surface::Get_Software_Texture(bool only_filename /* = 0 */)
     // hardware texture to software texture
     if (!only_filename) {
         // bind the texture
-        glBindTexture(GL_TEXTURE_2D, m_image);
+        glBindTexture(GL_TEXTURE_2D, Get_Texture_ID());
 
         // texture settings
         glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_WIDTH, &soft_tex->m_width);
@@ -268,7 +513,9 @@ void cGL_Surface::Load_Software_Texture(cSaved_Texture* soft_tex)
         // Create Hardware Texture
         pVideo->Create_GL_Texture(soft_tex->m_width, soft_tex->m_height, soft_tex->m_pixels, mipmaps);
 
-        m_image = tex_id;
+        // copies get the new texture too
+        Set_Texture_ID(tex_id);
+        Set_Texture_Size(soft_tex->m_width, soft_tex->m_height, mipmaps);
     }
     // load from file
     else {
@@ -279,12 +526,8 @@ void cGL_Surface::Load_Software_Texture(cSaved_Texture* soft_tex)
             return;
         }
 
-        // get image
-        m_image = surface_copy->m_image;
-        m_tex_w = surface_copy->m_tex_w;
-        m_tex_h = surface_copy->m_tex_h;
-        // keep hardware texture
-        surface_copy->m_auto_del_img = 0;
+        // get image, copies get it too
+        Take_Texture(surface_copy);
         // delete copy
         delete surface_copy;
     }
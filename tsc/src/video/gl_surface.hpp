@@ -19,9 +19,110 @@
 
 #include "../core/global_basic.hpp"
 #include "../core/math/point.hpp"
+#include <boost/intrusive_ptr.hpp>
 
 namespace TSC {
 
+    /* *** *** *** *** *** *** *** *** OpenGL Texture *** *** *** *** *** *** *** *** *** */
+
+    /* An OpenGL texture shared between a surface and its copies
+     * Only held through boost::intrusive_ptr. The OpenGL texture and
+     * this object are deleted when the last surface releases it. Debug
+     * builds report textures owned by two objects and textures still
+     * alive on exit.
+    */
+    class cGL_Texture {
+    public:
+        // Take ownership of the OpenGL texture. Starts without references.
+        cGL_Texture(GLuint id);
+
+        friend void intrusive_ptr_add_ref(cGL_Texture* texture)
+        {
+            texture->Add_Ref();
+        }
+        friend void intrusive_ptr_release(cGL_Texture* texture)
+        {
+            texture->Release();
+        }
+
+        unsigned int Get_Ref_Count(void) const
+        {
+            return m_ref_count;
+        }
+
+        GLuint Get_ID(void) const
+        {
+            return m_id;
+        }
+        // Return the OpenGL texture for drawing and remember that it was used this frame
+        GLuint Use(void)
+        {
+            m_last_use_frame = s_frame;
+            return m_id;
+        }
+        /* Whether the OpenGL texture was unloaded to be loaded again on use
+         * Set by cGL_Surface::Unload_Texture(), cleared by Set_ID()
+        */
+        bool m_reload_pending;
+
+        // Whether it was drawn within the last frames
+        bool Is_Recently_Used(uint32_t frames = 2) const
+        {
+            return s_frame - m_last_use_frame <= frames;
+        }
+        uint32_t Get_Last_Use_Frame(void) const
+        {
+            return m_last_use_frame;
+        }
+
+        // Estimated video memory of the OpenGL texture
+        size_t Get_Bytes(void) const
+        {
+            return m_bytes;
+        }
+        void Set_Bytes(size_t bytes);
+        // Replace the OpenGL texture, deleting the previous one
+        void Set_ID(GLuint id);
+        /* Delete the OpenGL texture but keep this object
+         * Set_ID() can give it a new texture later.
+        */
+        void Delete_GL_Texture(void);
+        // Give up the OpenGL texture without deleting it and return it
+        GLuint Take_ID(void);
+
+        // Forget all OpenGL textures after they were deleted with the context
+        static void Invalidate_All(void);
+        // Advance the frame counter used by Use(), call once per rendered frame
+        static void Next_Frame(void)
+        {
+            s_frame++;
+        }
+        // Number of texture objects alive
+        static size_t Get_Count(void);
+        // Estimated video memory of all OpenGL textures
+        static size_t Get_Total_Bytes(void)
+        {
+            return s_total_bytes;
+        }
+        // Print the textures still alive, call on exit
+        static void Report_Leaks(void);
+
+    private:
+        ~cGL_Texture(void);
+
+        void Add_Ref(void);
+        // Release a reference and delete the texture with the last one
+        void Release(void);
+
+        GLuint m_id;
+        unsigned int m_ref_count;
+        uint32_t m_last_use_frame;
+        size_t m_bytes;
+
+        static uint32_t s_frame;
+        static size_t s_total_bytes;
+    };
+
     /* *** *** *** *** *** *** *** *** OpenGL Surface *** *** *** *** *** *** *** *** *** */
 
     class cGL_Surface {
@@ -35,6 +136,12 @@ namespace TSC {
         void Blit(float x, float y, float z, cSurface_Request* request = NULL) const;
         // Blit only the surface data on the given request
         void Blit_Data(cSurface_Request* request) const;
+        /* Blit the surface repeated over the given area as one quad
+         * tile_x/tile_y : a position where a whole tile starts
+         * repeat_y : if not set only the row of tiles at tile_y is drawn, y and h are not used
+         * Returns 0 if the texture is padded or rotated and has to be blitted per tile.
+        */
+        bool Blit_Tiled(float x, float y, float w, float h, float z, float tile_x, float tile_y, bool repeat_y = 1) const;
 
         // Copy cGL_Surface and return it
         cGL_Surface* Copy(void) const;
@@ -48,6 +155,35 @@ namespace TSC {
         // Check if the OpenGL texture is used by another cGL_Surface
         bool Is_Texture_Use_Multiple(void) const;
 
+        // Use the given texture, releasing the current one. NULL only releases it.
+        void Set_Texture(cGL_Texture* texture);
+        // Use the given OpenGL texture, replacing the one shared with copies
+        void Set_Texture_ID(GLuint id);
+
+        // Set the texture size and account for its memory
+        void Set_Texture_Size(unsigned int width, unsigned int height, bool mipmap = 0);
+        // Use the texture of `surface', which may be deleted afterwards
+        void Take_Texture(cGL_Surface* surface);
+        /* Delete the OpenGL texture, it is loaded again from m_path
+         * when the surface is drawn the next time
+        */
+        void Unload_Texture(void);
+        // Load the texture from m_path if unloaded
+        void Reload_Texture(void) const;
+
+        // OpenGL texture for drawing
+        GLuint Get_Texture_ID(void) const
+        {
+            if (!mp_texture) {
+                return 0;
+            }
+            if (mp_texture->m_reload_pending) {
+                Reload_Texture();
+            }
+
+            return mp_texture->Use();
+        }
+
         /* Return a software texture copy
          * only_filename: if set doesn't save the software texture but only the filename
         */
@@ -65,8 +201,8 @@ namespace TSC {
         // Set a function called on destruction
         void Set_Destruction_Function(void (*nfunction)(cGL_Surface*));
 
-        // GL texture number
-        GLuint m_image;
+        // GL texture, shared with copies
+        boost::intrusive_ptr<cGL_Texture> mp_texture;
         // internal drawing offset
         float m_int_x;
         float m_int_y;
@@ -79,6 +215,13 @@ namespace TSC {
         // texture dimension
         unsigned int m_tex_w;
         unsigned int m_tex_h;
+        /* part of the surface covered by the texture
+         * below 1 if the image is not padded to a power of 2 size
+        */
+        float m_tex_cover_w;
+        float m_tex_cover_h;
+        // if every pixel of the texture has full alpha
+        bool m_opaque;
         // internal rotation
         float m_base_rot_x;
         float m_base_rot_y;
@@ -96,8 +239,6 @@ namespace TSC {
         // mappings resolved as well as any "base" commands in a .settings file.
         // In other words: This is the PNG file that was loaded.
         boost::filesystem::path m_real_png_path;
-        // should the image be deleted
-        bool m_auto_del_img;
         // if managed over the image manager
         bool m_managed;
         // if the image is tagged as obsolete
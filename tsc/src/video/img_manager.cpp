@@ -17,9 +17,11 @@
 #include "../video/img_manager.hpp"
 #include "../video/renderer.hpp"
 #include "../video/loading_screen.hpp"
+#include "../video/img_settings.hpp"
 #include "../core/i18n.hpp"
 #include "../core/global_basic.hpp"
 #include "../core/property_helper.hpp"
+#include "../core/parallel.hpp"
 
 using namespace std;
 
@@ -57,6 +59,7 @@ cImage_Manager::cImage_Manager(void)
     : cObject_Manager<cGL_Surface>()
 {
     m_high_texture_id = 0;
+    m_evicted_textures = 0;
 }
 
 cImage_Manager::~cImage_Manager(void)
@@ -124,34 +127,51 @@ void cImage_Manager::Grab_Textures(bool from_file /* = 0 */, bool draw_gui /* =
     unsigned int loaded_files = 0;
     unsigned int file_count = objects.size();
 
+    m_reload_surfaces.clear();
+
     // save all textures
     for (GL_Surface_List::iterator itr = objects.begin(); itr != objects.end(); ++itr) {
         // get surface
         cGL_Surface* obj = (*itr);
 
-        // skip surfaces with an already deleted texture
-        if (!glIsTexture(obj->m_image)) {
+        /* skip surfaces with an already deleted texture
+         * pending or evicted ones stay pending and are loaded from the new cache when drawn
+        */
+        if (!obj->mp_texture || !glIsTexture(obj->mp_texture->Get_ID())) {
             continue;
         }
 
-        // get software texture and save it to software memory
-        m_saved_textures.push_back(obj->Get_Software_Texture(from_file));
-        // delete hardware texture
-        if (glIsTexture(obj->m_image)) {
-            glDeleteTextures(1, &obj->m_image);
-        }
-
-        // count files
-        loaded_files++;
-
-        // draw
-        if (draw_gui) {
-            // update progress
-            progress_bar->setProgress(static_cast<float>(loaded_files) / static_cast<float>(file_count));
+        /* from a file: no need to read the texture back, it is loaded
+         * again from the image cache of the new resolution */
+        if (!obj->m_path.empty()) {
+            if (obj->mp_texture->Is_Recently_Used()) {
+                m_reload_surfaces.push_back(obj);
+            }
 
-            Loading_Screen_Draw();
+            obj->Unload_Texture();
+        }
+        else {
+            // get software texture and save it to software memory
+            m_saved_textures.push_back(obj->Get_Software_Texture(from_file));
+            /* delete hardware texture
+             * the texture object stays, so copies get the restored texture too
+            */
+            obj->mp_texture->Delete_GL_Texture();
+
+            // count files
+            loaded_files++;
+
+            // draw
+            if (draw_gui) {
+                // update progress
+                progress_bar->setProgress(static_cast<float>(loaded_files) / static_cast<float>(file_count));
+
+                Loading_Screen_Draw();
+            }
         }
     }
+
+    debug_print("Unloaded %u textures, %u in use, %u saved in software memory\n", static_cast<unsigned int>(objects.size()), static_cast<unsigned int>(m_reload_surfaces.size()), static_cast<unsigned int>(m_saved_textures.size()));
 }
 
 void cImage_Manager::Restore_Textures(bool draw_gui /* = 0 */)
@@ -193,6 +213,49 @@ void cImage_Manager::Restore_Textures(bool draw_gui /* = 0 */)
     }
 
     m_saved_textures.clear();
+
+    // the remaining unloaded textures are loaded when drawn
+    Reload_Surfaces(m_reload_surfaces, progress_bar);
+    m_reload_surfaces.clear();
+}
+
+// Number of images decoded at once, bounds the memory used for decoded images
+static const size_t IMAGE_RELOAD_BATCH_SIZE = 64;
+
+void cImage_Manager::Reload_Surfaces(const GL_Surface_List& surfaces, CEGUI::ProgressBar* progress_bar)
+{
+    uint32_t start_ticks = TSC_GetTicks();
+
+    unsigned int thread_count = Get_Worker_Thread_Count();
+
+    // one parser per thread as the global one is not thread-safe
+    std::vector<cImage_Settings_Parser> parsers(thread_count);
+    // decoded images of the current batch
+    std::vector<cVideo::cSoftware_Image> images(std::min(IMAGE_RELOAD_BATCH_SIZE, surfaces.size()));
+
+    // decode in parallel
+    Parallel_For_Batches(surfaces.size(), IMAGE_RELOAD_BATCH_SIZE, thread_count, [&surfaces, &images, &parsers](size_t i, unsigned int thread) {
+        images[i % IMAGE_RELOAD_BATCH_SIZE] = pVideo->Load_Image(surfaces[i]->m_path, 1, 1, &parsers[thread]);
+    }, [&surfaces, &images, progress_bar](size_t start, size_t end) {
+        // upload in order, OpenGL is only used from this thread
+        for (size_t i = start; i < end; i++) {
+            cGL_Surface* obj = surfaces[i];
+            // deletes the decoded pixels
+            cGL_Surface* surface_copy = pVideo->Create_GL_Surface(obj->m_path, images[i % IMAGE_RELOAD_BATCH_SIZE]);
+
+            if (surface_copy) {
+                obj->Take_Texture(surface_copy);
+                delete surface_copy;
+            }
+        }
+
+        if (progress_bar) {
+            progress_bar->setProgress(static_cast<float>(end) / static_cast<float>(surfaces.size()));
+            Loading_Screen_Draw();
+        }
+    });
+
+    debug_print("Reloaded %u textures in %u ms using %u threads\n", static_cast<unsigned int>(surfaces.size()), TSC_GetTicks() - start_ticks, thread_count);
 }
 
 void cImage_Manager::Delete_Image_Textures(void)
@@ -201,22 +264,87 @@ void cImage_Manager::Delete_Image_Textures(void)
         // get object
         cGL_Surface* obj = (*itr);
 
-        if (obj->m_auto_del_img && glIsTexture(obj->m_image)) {
-            glDeleteTextures(1, &obj->m_image);
+        if (obj->mp_texture) {
+            obj->mp_texture->Delete_GL_Texture();
+        }
+    }
+}
+
+// Textures drawn in these last frames are kept
+static const uint32_t TEXTURE_EVICT_UNUSED_FRAMES = 300;
+
+unsigned int cImage_Manager::Evict_Textures(size_t budget, const std::unordered_set<cGL_Texture*>& in_use)
+{
+    size_t total = cGL_Texture::Get_Total_Bytes();
+
+    if (total <= budget) {
+        return 0;
+    }
+
+    // free a bit more so it does not run again for every new texture
+    size_t target = budget - budget / 10;
+
+    // one surface for each texture not drawn recently
+    std::unordered_map<cGL_Texture*, cGL_Surface*> textures;
+
+    for (GL_Surface_List::iterator itr = objects.begin(); itr != objects.end(); ++itr) {
+        cGL_Surface* obj = (*itr);
+        cGL_Texture* texture = obj->mp_texture.get();
+
+        if (!texture || !texture->Get_ID() || obj->m_path.empty()) {
+            continue;
+        }
+        if (texture->Is_Recently_Used(TEXTURE_EVICT_UNUSED_FRAMES) || in_use.count(texture)) {
+            continue;
         }
+
+        textures[texture] = obj;
+    }
+
+    std::vector<cGL_Surface*> candidates;
+    candidates.reserve(textures.size());
+
+    for (std::unordered_map<cGL_Texture*, cGL_Surface*>::iterator itr = textures.begin(); itr != textures.end(); ++itr) {
+        candidates.push_back(itr->second);
     }
+
+    // least recently used first
+    std::sort(candidates.begin(), candidates.end(), [](const cGL_Surface* a, const cGL_Surface* b) {
+        return a->mp_texture->Get_Last_Use_Frame() < b->mp_texture->Get_Last_Use_Frame();
+    });
+
+    unsigned int count = 0;
+
+    for (std::vector<cGL_Surface*>::iterator itr = candidates.begin(); itr != candidates.end() && total > target; ++itr) {
+        size_t bytes = (*itr)->mp_texture->Get_Bytes();
+
+        (*itr)->Unload_Texture();
+        total = total > bytes ? total - bytes : 0;
+        count++;
+    }
+
+    m_evicted_textures += count;
+
+    if (count) {
+        debug_print("Evicted %u textures, %u KiB texture memory left\n", count, static_cast<unsigned int>(cGL_Texture::Get_Total_Bytes() / 1024));
+    }
+
+    return count;
 }
 
 bool cImage_Manager::Delete(size_t array_num, bool delete_data)
 {
-    if (array_num < objects.size()) {
-        std::string filepath = path_to_utf8(objects[array_num]->m_path);
-        objects.erase(objects.begin() + array_num);
-        m_index_table.erase(filepath);
+    // not in vector
+    if (array_num >= objects.size()) {
+        return 0;
     }
 
+    // the element is gone after erasing
+    cGL_Surface* obj = objects[array_num];
+    Erase_Index(array_num);
+
     if (delete_data) {
-        delete objects[array_num];
+        delete obj;
     }
 
     return 1;
@@ -224,13 +352,47 @@ bool cImage_Manager::Delete(size_t array_num, bool delete_data)
 
 bool cImage_Manager::Delete(cGL_Surface* obj, bool delete_data)
 {
-    std::string filepath = path_to_utf8(obj->m_path);
-    if (cObject_Manager::Delete(obj, delete_data)) {
-        m_index_table.erase(filepath);
-        return true;
+    // empty object
+    if (!obj) {
+        return 0;
     }
+
+    std::unordered_map<std::string, size_t>::iterator iter = m_index_table.find(path_to_utf8(obj->m_path));
+
+    if (iter != m_index_table.end() && objects[iter->second] == obj) {
+        Erase_Index(iter->second);
+    }
+    // not indexed, e.g. a copy with the same path
     else {
-        return false;
+        GL_Surface_List::iterator obj_itr = std::find(objects.begin(), objects.end(), obj);
+
+        if (obj_itr != objects.end()) {
+            Erase_Index(obj_itr - objects.begin());
+        }
+    }
+
+    if (delete_data) {
+        delete obj;
+    }
+
+    return 1;
+}
+
+void cImage_Manager::Erase_Index(size_t array_num)
+{
+    std::unordered_map<std::string, size_t>::iterator iter = m_index_table.find(path_to_utf8(objects[array_num]->m_path));
+
+    if (iter != m_index_table.end() && iter->second == array_num) {
+        m_index_table.erase(iter);
+    }
+
+    objects.erase(objects.begin() + array_num);
+
+    // the following images moved down
+    for (iter = m_index_table.begin(); iter != m_index_table.end(); ++iter) {
+        if (iter->second > array_num) {
+            iter->second--;
+        }
     }
 }
 
@@ -245,12 +407,13 @@ void cImage_Manager::Delete_Hardware_Textures(void)
     }
 
     m_high_texture_id = 0;
+    // texture objects surviving this must not delete the old ids again
+    cGL_Texture::Invalidate_All();
 }
 
 void cImage_Manager::Delete_All(void)
 {
-    // stops cGL_Surface destructor from checking if GL texture id still in use
-    Delete_Image_Textures();
+    // textures still used by copies are kept
     cObject_Manager<cGL_Surface>::Delete_All();
     m_index_table.clear();
 }
@@ -22,6 +22,8 @@
 #include "../core/obj_manager.hpp"
 #include "../video/gl_surface.hpp"
 
+#include <unordered_set>
+
 namespace TSC {
 
     /* *** *** *** *** *** cSaved_Texture *** *** *** *** *** *** *** *** *** *** *** *** */
@@ -85,14 +87,18 @@ namespace TSC {
             return Get_Pointer(path);
         }
 
-        /* Save hardware textures in software memory
+        /* Delete the hardware textures before the OpenGL context is recreated
+         * Surfaces created from a file are loaded again from the image cache,
+         * only those drawn in the last frames by Restore_Textures() and the
+         * others when they are drawn the next time. Other surfaces are saved
+         * in software memory.
          * from_file: if set don't store in software memory but load again from file
          * draw_gui : if set use the loading screen gui for drawing
         */
         void Grab_Textures(bool from_file = 0, bool draw_gui = 0);
 
-        /* Load the saved software textures back into hardware textures or
-         * load textures from file if set
+        /* Load the saved software textures back into hardware textures and
+         * reload the textures in use from file
          * draw_gui : if set use the loading screen gui for drawing
         */
         void Restore_Textures(bool draw_gui = 0);
@@ -100,6 +106,14 @@ namespace TSC {
         // Delete all surface textures, but keep object vector entries
         void Delete_Image_Textures(void);
 
+        /* Unload the least recently used textures of surfaces created from
+         * a file until the texture memory is below the budget in bytes.
+         * They are loaded again from the image cache when drawn the next time.
+         * in_use : textures which are never unloaded
+         * Returns the number of unloaded textures
+        */
+        unsigned int Evict_Textures(size_t budget, const std::unordered_set<cGL_Texture*>& in_use);
+
         // Delete all hardware surfaces
         void Delete_Hardware_Textures(void);
 
@@ -111,10 +125,19 @@ namespace TSC {
 
         // highest opengl texture id found
         GLuint m_high_texture_id;
+        // textures unloaded by Evict_Textures()
+        unsigned int m_evicted_textures;
 
     private:
+        // Remove the surface from the array and the path index
+        void Erase_Index(size_t array_num);
+        // Decode the images of the surfaces on all cores and upload them
+        void Reload_Surfaces(const GL_Surface_List& surfaces, CEGUI::ProgressBar* progress_bar);
+
         // saved textures for reloading
         Saved_Texture_List m_saved_textures;
+        // surfaces in use which are reloaded from file by Restore_Textures()
+        GL_Surface_List m_reload_surfaces;
 
         std::unordered_map<std::string, size_t> m_index_table;
     };
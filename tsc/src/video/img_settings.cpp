@@ -53,15 +53,15 @@ cImage_Settings_Data::~cImage_Settings_Data(void)
 
 }
 
-cSize_Int cImage_Settings_Data::Get_Surface_Size(const sf::Image* p_sf_image) const
+cSize_Int cImage_Settings_Data::Get_Surface_Size(unsigned int image_width, unsigned int image_height) const
 {
-    if (!p_sf_image) {
+    if (!image_width || !image_height) {
         return cSize_Int();
     }
 
     // check if texture needs to get downscaled
-    float new_w = static_cast<float>(Get_Power_of_2(p_sf_image->getSize().x));
-    float new_h = static_cast<float>(Get_Power_of_2(p_sf_image->getSize().y));
+    float new_w = static_cast<float>(Get_Power_of_2(image_width));
+    float new_h = static_cast<float>(Get_Power_of_2(image_height));
 
     // if image settings dimension
     if (m_width > 0 && m_height > 0) {
@@ -252,6 +252,15 @@ cImage_Settings_Parser::~cImage_Settings_Parser(void)
 
 cImage_Settings_Data* cImage_Settings_Parser::Get(const boost::filesystem::path& filename, bool load_base_settings /* = 1 */)
 {
+    // already resolved in the index
+    if (load_base_settings) {
+        cImage_Settings_Data* settings = m_index.Get(filename);
+
+        if (settings) {
+            return settings;
+        }
+    }
+
     m_load_base = load_base_settings;
     m_settings_temp = new cImage_Settings_Data();
 
@@ -20,6 +20,7 @@
 #include "../core/global_basic.hpp"
 #include "../core/file_parser.hpp"
 #include "../video/gl_surface.hpp"
+#include "../video/img_settings_index.hpp"
 #include "../core/math/rect.hpp"
 
 namespace TSC {
@@ -31,8 +32,8 @@ namespace TSC {
         cImage_Settings_Data(void);
         ~cImage_Settings_Data(void);
 
-        // returns the best surface size for the current resolution
-        cSize_Int Get_Surface_Size(const sf::Image* p_sf_image) const;
+        // returns the best surface size for an image of this size at the current resolution
+        cSize_Int Get_Surface_Size(unsigned int image_width, unsigned int image_height) const;
         // Apply settings to an image
         void Apply(cGL_Surface* image) const;
         // Apply base settings
@@ -81,6 +82,7 @@ namespace TSC {
         /* Returns the settings from the given file
          * load_base_settings : if set will overwrite settings with all base settings if available
          * The returned settings data should be deleted if not used anymore
+         * If the file is in the settings index it is not parsed
         */
         cImage_Settings_Data* Get(const boost::filesystem::path& filename, bool load_base_settings = 1);
 
@@ -91,6 +93,8 @@ namespace TSC {
         cImage_Settings_Data* m_settings_temp;
         // load base settings
         bool m_load_base;
+        // resolved settings of all game pixmaps
+        cImage_Settings_Index m_index;
     };
 
     /* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
@@ -0,0 +1,423 @@
+/***************************************************************************
+ * img_settings_index.cpp - Binary index of resolved image settings
+ *
+ * Copyright © 2012-2020 The TSC Contributors
+ ***************************************************************************/
+/*
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <boost/filesystem/fstream.hpp>
+#include <cstring>
+
+#include "../video/img_settings_index.hpp"
+#include "../video/img_settings.hpp"
+#include "../core/global_basic.hpp"
+#include "../core/game_core.hpp"
+#include "../core/property_helper.hpp"
+#include "../core/filesystem/filesystem.hpp"
+#include "../core/filesystem/resource_manager.hpp"
+
+using namespace std;
+
+namespace fs = boost::filesystem;
+
+namespace TSC {
+
+/* Increase when changing the file layout or the meaning of a field */
+static const uint32_t IMG_SETTINGS_INDEX_FORMAT = 1;
+static const char IMG_SETTINGS_INDEX_MAGIC[8] = {'T', 'S', 'C', 'I', 'M', 'G', 'S', 'I'};
+
+struct cImage_Settings_Index::Header {
+    char magic[8];
+    uint32_t format;
+    uint32_t data_version;
+    uint32_t entry_count;
+    uint32_t bucket_count;
+    uint32_t strings_size;
+    uint32_t reserved;
+};
+
+struct cImage_Settings_Index::Entry {
+    // key (relative settings path)
+    uint32_t hash;
+    uint32_t key_offset;
+    uint32_t key_length;
+    // cImage_Settings_Data values
+    int32_t int_x;
+    int32_t int_y;
+    float col_rect[4];
+    int32_t width;
+    int32_t height;
+    int32_t rotation[3];
+    int32_t massive_type;
+    int32_t ground_type;
+    uint32_t flags;
+    uint32_t base_offset;
+    uint32_t base_length;
+    uint32_t editor_tags_offset;
+    uint32_t editor_tags_length;
+    uint32_t name_offset;
+    uint32_t name_length;
+    uint32_t author_offset;
+    uint32_t author_length;
+};
+
+enum {
+    IMG_SETTINGS_INDEX_MIPMAP = 1,
+    IMG_SETTINGS_INDEX_BASE_SETTINGS = 2,
+    IMG_SETTINGS_INDEX_OBSOLETE = 4
+};
+
+/* *** *** *** *** *** *** cImage_Settings_Index *** *** *** *** *** *** *** *** *** *** *** */
+
+cImage_Settings_Index::cImage_Settings_Index(void)
+{
+    mp_header = NULL;
+    mp_buckets = NULL;
+    mp_entries = NULL;
+    mp_strings = NULL;
+}
+
+cImage_Settings_Index::~cImage_Settings_Index(void)
+{
+    Close();
+}
+
+bool cImage_Settings_Index::Load(const fs::path& index_file)
+{
+    // already mapped
+    if (Is_Loaded() && m_filename == index_file) {
+        return 1;
+    }
+
+    Close();
+
+    if (!File_Exists(index_file)) {
+        return 0;
+    }
+
+    try {
+        m_file.open(path_to_utf8(index_file));
+    }
+    catch (const std::exception& ex) {
+        cerr << "Warning : Could not map image settings index " << path_to_utf8(index_file) << " : " << ex.what() << endl;
+        return 0;
+    }
+
+    if (!m_file.is_open() || m_file.size() < sizeof(Header)) {
+        Close();
+        return 0;
+    }
+
+    const Header* header = reinterpret_cast<const Header*>(m_file.data());
+
+    // written by another game version or for another data directory
+    if (memcmp(header->magic, IMG_SETTINGS_INDEX_MAGIC, sizeof(header->magic)) != 0 || header->format != IMG_SETTINGS_INDEX_FORMAT || header->data_version != Data_Version_Hash()) {
+        Close();
+        return 0;
+    }
+
+    // truncated
+    uint64_t expected_size = sizeof(Header) + static_cast<uint64_t>(header->bucket_count) * sizeof(uint32_t) + static_cast<uint64_t>(header->entry_count) * sizeof(Entry) + header->strings_size;
+
+    if (m_file.size() != expected_size || header->bucket_count == 0 || (header->bucket_count & (header->bucket_count - 1)) != 0) {
+        Close();
+        return 0;
+    }
+
+    mp_header = header;
+    mp_buckets = reinterpret_cast<const uint32_t*>(m_file.data() + sizeof(Header));
+    mp_entries = reinterpret_cast<const Entry*>(mp_buckets + header->bucket_count);
+    mp_strings = reinterpret_cast<const char*>(mp_entries + header->entry_count);
+    m_filename = index_file;
+
+    debug_print("Loaded image settings index with %u entries\n", header->entry_count);
+    return 1;
+}
+
+void cImage_Settings_Index::Close(void)
+{
+    if (m_file.is_open()) {
+        m_file.close();
+    }
+
+    m_filename.clear();
+    mp_header = NULL;
+    mp_buckets = NULL;
+    mp_entries = NULL;
+    mp_strings = NULL;
+}
+
+bool cImage_Settings_Index::Is_Loaded(void) const
+{
+    return mp_header != NULL;
+}
+
+bool cImage_Settings_Index::Build(const fs::path& index_file)
+{
+    uint32_t start_ticks = TSC_GetTicks();
+
+    vector<fs::path> settings_files = Get_Directory_Files(pResource_Manager->Get_Game_Pixmaps_Directory(), ".settings");
+    vector<Entry> entries;
+    std::string strings;
+
+    entries.reserve(settings_files.size());
+
+    cImage_Settings_Parser parser;
+
+    for (vector<fs::path>::const_iterator itr = settings_files.begin(); itr != settings_files.end(); ++itr) {
+        std::string key;
+
+        if (!Make_Key(*itr, key)) {
+            continue;
+        }
+
+        cImage_Settings_Data* settings = parser.Get(*itr);
+
+        if (!settings) {
+            continue;
+        }
+
+        Entry entry;
+        memset(&entry, 0, sizeof(Entry));
+
+        entry.hash = Hash(key.c_str(), key.length());
+        entry.key_offset = strings.size();
+        entry.key_length = key.length();
+        strings += key;
+
+        entry.int_x = settings->m_int_x;
+        entry.int_y = settings->m_int_y;
+        entry.col_rect[0] = settings->m_col_rect.m_x;
+        entry.col_rect[1] = settings->m_col_rect.m_y;
+        entry.col_rect[2] = settings->m_col_rect.m_w;
+        entry.col_rect[3] = settings->m_col_rect.m_h;
+        entry.width = settings->m_width;
+        entry.height = settings->m_height;
+        entry.rotation[0] = settings->m_rotation_x;
+        entry.rotation[1] = settings->m_rotation_y;
+        entry.rotation[2] = settings->m_rotation_z;
+        entry.massive_type = settings->m_massive_type;
+        entry.ground_type = settings->m_ground_type;
+
+        if (settings->m_mipmap) {
+            entry.flags |= IMG_SETTINGS_INDEX_MIPMAP;
+        }
+        if (settings->m_base_settings) {
+            entry.flags |= IMG_SETTINGS_INDEX_BASE_SETTINGS;
+        }
+        if (settings->m_obsolete) {
+            entry.flags |= IMG_SETTINGS_INDEX_OBSOLETE;
+        }
+
+        std::string base = path_to_utf8(settings->m_base);
+        entry.base_offset = strings.size();
+        entry.base_length = base.length();
+        strings += base;
+
+        entry.editor_tags_offset = strings.size();
+        entry.editor_tags_length = settings->m_editor_tags.length();
+        strings += settings->m_editor_tags;
+
+        entry.name_offset = strings.size();
+        entry.name_length = settings->m_name.length();
+        strings += settings->m_name;
+
+        entry.author_offset = strings.size();
+        entry.author_length = settings->m_author.length();
+        strings += settings->m_author;
+
+        entries.push_back(entry);
+        delete settings;
+    }
+
+    // keep the table at most half full
+    uint32_t bucket_count = 16;
+
+    while (bucket_count < entries.size() * 2) {
+        bucket_count *= 2;
+    }
+
+    vector<uint32_t> buckets(bucket_count, 0);
+
+    for (uint32_t i = 0; i < entries.size(); i++) {
+        uint32_t bucket = entries[i].hash & (bucket_count - 1);
+
+        // linear probing
+        while (buckets[bucket]) {
+            bucket = (bucket + 1) & (bucket_count - 1);
+        }
+
+        buckets[bucket] = i + 1;
+    }
+
+    Header header;
+    memset(&header, 0, sizeof(Header));
+    memcpy(header.magic, IMG_SETTINGS_INDEX_MAGIC, sizeof(header.magic));
+    header.format = IMG_SETTINGS_INDEX_FORMAT;
+    header.data_version = Data_Version_Hash();
+    header.entry_count = entries.size();
+    header.bucket_count = bucket_count;
+    header.strings_size = strings.size();
+
+    // write to a temporary file first so a crash never leaves a damaged index behind
+    fs::path temp_file = index_file;
+    temp_file += utf8_to_path(".tmp");
+
+    fs::ofstream ofs(temp_file, ios::out | ios::binary | ios::trunc);
+
+    if (!ofs) {
+        cerr << "Warning : Could not write image settings index " << path_to_utf8(temp_file) << endl;
+        return 0;
+    }
+
+    ofs.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+    ofs.write(reinterpret_cast<const char*>(buckets.data()), buckets.size() * sizeof(uint32_t));
+    if (!entries.empty()) {
+        ofs.write(reinterpret_cast<const char*>(entries.data()), entries.size() * sizeof(Entry));
+    }
+    ofs.write(strings.data(), strings.size());
+    ofs.close();
+
+    if (ofs.fail()) {
+        cerr << "Warning : Could not write image settings index " << path_to_utf8(temp_file) << endl;
+        fs::remove(temp_file);
+        return 0;
+    }
+
+    boost::system::error_code ec;
+    fs::rename(temp_file, index_file, ec);
+
+    if (ec) {
+        cerr << "Warning : Could not write image settings index " << path_to_utf8(index_file) << " : " << ec.message() << endl;
+        fs::remove(temp_file, ec);
+        return 0;
+    }
+
+    debug_print("Built image settings index with %u entries in %u ms\n", static_cast<unsigned int>(entries.size()), TSC_GetTicks() - start_ticks);
+    return 1;
+}
+
+bool cImage_Settings_Index::Contains(const fs::path& settings_file) const
+{
+    return Find(settings_file) != NULL;
+}
+
+cImage_Settings_Data* cImage_Settings_Index::Get(const fs::path& settings_file) const
+{
+    const Entry* entry = Find(settings_file);
+
+    if (!entry) {
+        return NULL;
+    }
+
+    cImage_Settings_Data* settings = new cImage_Settings_Data();
+
+    settings->m_base = utf8_to_path(Get_String(entry->base_offset, entry->base_length));
+    settings->m_base_settings = (entry->flags & IMG_SETTINGS_INDEX_BASE_SETTINGS) != 0;
+    settings->m_int_x = entry->int_x;
+    settings->m_int_y = entry->int_y;
+    settings->m_col_rect = GL_rect(entry->col_rect[0], entry->col_rect[1], entry->col_rect[2], entry->col_rect[3]);
+    settings->m_width = entry->width;
+    settings->m_height = entry->height;
+    settings->m_rotation_x = entry->rotation[0];
+    settings->m_rotation_y = entry->rotation[1];
+    settings->m_rotation_z = entry->rotation[2];
+    settings->m_mipmap = (entry->flags & IMG_SETTINGS_INDEX_MIPMAP) != 0;
+    settings->m_editor_tags = Get_String(entry->editor_tags_offset, entry->editor_tags_length);
+    settings->m_name = Get_String(entry->name_offset, entry->name_length);
+    settings->m_massive_type = static_cast<MassiveType>(entry->massive_type);
+    settings->m_ground_type = static_cast<GroundType>(entry->ground_type);
+    settings->m_author = Get_String(entry->author_offset, entry->author_length);
+    settings->m_obsolete = (entry->flags & IMG_SETTINGS_INDEX_OBSOLETE) != 0;
+
+    return settings;
+}
+
+bool cImage_Settings_Index::Make_Key(const fs::path& settings_file, std::string& key)
+{
+    std::string filename = path_to_utf8(settings_file);
+    std::string pixmaps_dir = path_to_utf8(pResource_Manager->Get_Game_Pixmaps_Directory());
+
+    // only files from the pixmaps directory are indexed
+    if (filename.length() <= pixmaps_dir.length() + 1 || filename.compare(0, pixmaps_dir.length(), pixmaps_dir) != 0) {
+        return 0;
+    }
+
+    key = filename.substr(pixmaps_dir.length() + 1);
+    // same key on all platforms
+    string_replace_all(key, "\\", "/");
+
+    return 1;
+}
+
+uint32_t cImage_Settings_Index::Hash(const char* str, size_t len)
+{
+    // FNV-1a
+    uint32_t hash = 2166136261U;
+
+    for (size_t i = 0; i < len; i++) {
+        hash ^= static_cast<unsigned char>(str[i]);
+        hash *= 16777619U;
+    }
+
+    return hash;
+}
+
+uint32_t cImage_Settings_Index::Data_Version_Hash(void)
+{
+    std::string version = int_to_string(tsc_version) + "|" + path_to_utf8(pResource_Manager->Get_Game_Pixmaps_Directory());
+    return Hash(version.c_str(), version.length());
+}
+
+const cImage_Settings_Index::Entry* cImage_Settings_Index::Find(const fs::path& settings_file) const
+{
+    if (!Is_Loaded()) {
+        return NULL;
+    }
+
+    std::string key;
+
+    if (!Make_Key(settings_file, key)) {
+        return NULL;
+    }
+
+    uint32_t hash = Hash(key.c_str(), key.length());
+    uint32_t mask = mp_header->bucket_count - 1;
+
+    for (uint32_t bucket = hash & mask; mp_buckets[bucket]; bucket = (bucket + 1) & mask) {
+        uint32_t index = mp_buckets[bucket] - 1;
+
+        if (index >= mp_header->entry_count) {
+            return NULL;
+        }
+
+        const Entry* entry = &mp_entries[index];
+
+        if (entry->hash == hash && Get_String(entry->key_offset, entry->key_length) == key) {
+            return entry;
+        }
+    }
+
+    return NULL;
+}
+
+std::string cImage_Settings_Index::Get_String(uint32_t offset, uint32_t length) const
+{
+    if (static_cast<uint64_t>(offset) + length > mp_header->strings_size) {
+        return std::string();
+    }
+
+    return std::string(mp_strings + offset, length);
+}
+
+/* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
+
+} // namespace TSC
@@ -0,0 +1,91 @@
+/***************************************************************************
+ * img_settings_index.hpp - Binary index of resolved image settings
+ *
+ * Copyright © 2012-2020 The TSC Contributors
+ ***************************************************************************/
+/*
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef TSC_IMG_SETTINGS_INDEX_HPP
+#define TSC_IMG_SETTINGS_INDEX_HPP
+
+#include "../core/global_basic.hpp"
+#include <boost/iostreams/device/mapped_file.hpp>
+
+namespace TSC {
+
+    class cImage_Settings_Data;
+
+    /* *** *** *** *** *** *** cImage_Settings_Index *** *** *** *** *** *** *** *** *** *** *** */
+
+    /* Index of the fully resolved settings (with all base settings
+     * applied) of every .settings file below the pixmaps directory.
+     * It is built once per game version into the image cache directory
+     * and memory-mapped afterwards, so that looking up settings is a
+     * hash table probe instead of parsing a chain of text files.
+     *
+     * File layout (native byte order, it never leaves the machine):
+     *   Header
+     *   uint32_t buckets[bucket_count]  -- entry index + 1, 0 if empty
+     *   Entry entries[entry_count]
+     *   char strings[strings_size]      -- keys, names, tags, ...
+     */
+    class cImage_Settings_Index {
+    public:
+        cImage_Settings_Index(void);
+        ~cImage_Settings_Index(void);
+
+        /* Map the given index file. Returns false if it does not exist,
+         * is damaged or was built for another game version or data
+         * directory. */
+        bool Load(const boost::filesystem::path& index_file);
+        // Unmap the index. Lookups fail afterwards.
+        void Close(void);
+        // Whether an index is mapped
+        bool Is_Loaded(void) const;
+
+        /* Parse all .settings files in the pixmaps directory and write
+         * the index to `index_file'. This is slow. */
+        static bool Build(const boost::filesystem::path& index_file);
+
+        // Whether the given settings file is in the index
+        bool Contains(const boost::filesystem::path& settings_file) const;
+        /* Returns the resolved settings for the given settings file or
+         * NULL if it is not indexed. The returned settings data should
+         * be deleted if not used anymore. */
+        cImage_Settings_Data* Get(const boost::filesystem::path& settings_file) const;
+
+    private:
+        struct Header;
+        struct Entry;
+
+        // Index key for a settings file (path relative to the pixmaps directory)
+        static bool Make_Key(const boost::filesystem::path& settings_file, std::string& key);
+        // Hash used for the bucket table
+        static uint32_t Hash(const char* str, size_t len);
+        // Hash identifying the game version and data directory
+        static uint32_t Data_Version_Hash(void);
+
+        const Entry* Find(const boost::filesystem::path& settings_file) const;
+        std::string Get_String(uint32_t offset, uint32_t length) const;
+
+        boost::filesystem::path m_filename;
+        boost::iostreams::mapped_file_source m_file;
+        const Header* mp_header;
+        const uint32_t* mp_buckets;
+        const Entry* mp_entries;
+        const char* mp_strings;
+    };
+
+    /* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
+
+} // namespace TSC
+
+#endif
@@ -0,0 +1,267 @@
+/***************************************************************************
+ * ktx_file.cpp - KTX texture files for the image cache
+ *
+ * Copyright © 2012-2020 The TSC Contributors
+ ***************************************************************************/
+/*
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "../video/ktx_file.hpp"
+#include "../video/texture_compression.hpp"
+#include "../core/math/utilities.hpp"
+#include "../core/global_basic.hpp"
+
+using namespace std;
+
+namespace fs = boost::filesystem;
+
+namespace TSC {
+
+/* *** *** *** *** *** *** *** KTX files *** *** *** *** *** *** *** *** *** *** */
+
+static const unsigned char ktx_identifier[12] = {0xAB, 0x4B, 0x54, 0x58, 0x20, 0x31, 0x31, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A};
+static const uint32_t ktx_endianness = 0x04030201;
+// rows are stored from the top like in the pixel buffers
+static const char ktx_orientation_key[] = "KTXorientation";
+static const char ktx_orientation_value[] = "S=r,T=d";
+
+struct cKTX_Header {
+    unsigned char m_identifier[12];
+    uint32_t m_endianness;
+    uint32_t m_gl_type;
+    uint32_t m_gl_type_size;
+    uint32_t m_gl_format;
+    uint32_t m_gl_internal_format;
+    uint32_t m_gl_base_internal_format;
+    uint32_t m_pixel_width;
+    uint32_t m_pixel_height;
+    uint32_t m_pixel_depth;
+    uint32_t m_array_elements;
+    uint32_t m_faces;
+    uint32_t m_mipmap_levels;
+    uint32_t m_key_value_bytes;
+};
+
+static void Write_Uint32(fs::ofstream& file, uint32_t value)
+{
+    file.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+bool Save_KTX(const fs::path& path, const cPixel_Buffer& buffer)
+{
+    fs::ofstream file(path, ios::out | ios::binary | ios::trunc);
+
+    if (!file) {
+        cerr << "Warning : Save_KTX : Could not create file " << path_to_utf8(path) << " for writing" << endl;
+        return 0;
+    }
+
+    // key and value with their terminating null characters
+    uint32_t key_value_size = sizeof(ktx_orientation_key) + sizeof(ktx_orientation_value);
+    uint32_t key_value_padding = 3 - ((key_value_size + 3) % 4);
+
+    cKTX_Header header;
+    memcpy(header.m_identifier, ktx_identifier, sizeof(ktx_identifier));
+    header.m_endianness = ktx_endianness;
+    header.m_gl_type_size = 1;
+    header.m_gl_base_internal_format = GL_RGBA;
+
+    // compressed textures have no type and format
+    if (buffer.Get_Format() == PIXEL_FORMAT_BC3) {
+        header.m_gl_type = 0;
+        header.m_gl_format = 0;
+        header.m_gl_internal_format = GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+    }
+    else {
+        header.m_gl_type = GL_UNSIGNED_BYTE;
+        header.m_gl_format = GL_RGBA;
+        header.m_gl_internal_format = GL_RGBA8;
+    }
+    header.m_pixel_width = buffer.Get_Width();
+    header.m_pixel_height = buffer.Get_Height();
+    header.m_pixel_depth = 0;
+    header.m_array_elements = 0;
+    header.m_faces = 1;
+    header.m_mipmap_levels = buffer.Get_Levels();
+    header.m_key_value_bytes = sizeof(uint32_t) + key_value_size + key_value_padding;
+
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    Write_Uint32(file, key_value_size);
+    file.write(ktx_orientation_key, sizeof(ktx_orientation_key));
+    file.write(ktx_orientation_value, sizeof(ktx_orientation_value));
+    file.write("\0\0\0", key_value_padding);
+
+    // RGBA rows and BC3 blocks need no padding
+    for (unsigned int level = 0; level < buffer.Get_Levels(); level++) {
+        uint32_t size = buffer.Get_Level_Size(level);
+
+        Write_Uint32(file, size);
+        file.write(reinterpret_cast<const char*>(buffer.Get_Level(level)), size);
+    }
+
+    if (!file) {
+        cerr << "Warning : Save_KTX : Could not write " << path_to_utf8(path) << endl;
+        return 0;
+    }
+
+    return 1;
+}
+
+bool Load_KTX(const fs::path& path, cPixel_Buffer& buffer, unsigned int& width, unsigned int& height, bool pad_power_of_2 /* = 1 */, const Pixel_Size_Callback& size_callback /* = nullptr */, bool compressed /* = 0 */)
+{
+    fs::ifstream file(path, ios::in | ios::binary);
+
+    if (!file) {
+        return 0;
+    }
+
+    cKTX_Header header;
+
+    if (!file.read(reinterpret_cast<char*>(&header), sizeof(header))) {
+        return 0;
+    }
+
+    if (memcmp(header.m_identifier, ktx_identifier, sizeof(ktx_identifier)) != 0 || header.m_endianness != ktx_endianness) {
+        cerr << "Warning : Load_KTX : " << path_to_utf8(path) << " is no KTX file in native byte order" << endl;
+        return 0;
+    }
+
+    Pixel_Format format;
+
+    if (header.m_gl_type == GL_UNSIGNED_BYTE && header.m_gl_format == GL_RGBA) {
+        format = PIXEL_FORMAT_RGBA;
+    }
+    else if (header.m_gl_type == 0 && header.m_gl_format == 0 && header.m_gl_internal_format == GL_COMPRESSED_RGBA_S3TC_DXT5_EXT) {
+        format = PIXEL_FORMAT_BC3;
+    }
+    else {
+        cerr << "Warning : Load_KTX : " << path_to_utf8(path) << " has an unsupported texture format" << endl;
+        return 0;
+    }
+
+    if (header.m_pixel_depth > 1 || header.m_array_elements > 0 || header.m_faces != 1
+        || !header.m_pixel_width || !header.m_pixel_height || header.m_pixel_width > 65536 || header.m_pixel_height > 65536) {
+        cerr << "Warning : Load_KTX : " << path_to_utf8(path) << " has an unsupported texture format" << endl;
+        return 0;
+    }
+
+    file.seekg(header.m_key_value_bytes, ios::cur);
+
+    width = header.m_pixel_width;
+    height = header.m_pixel_height;
+
+    unsigned int levels = std::max(header.m_mipmap_levels, 1u);
+    // a full mipmap chain down to 1x1 is floor(log2(max(w, h))) + 1 levels
+    unsigned int max_levels = 1;
+
+    for (unsigned int size = std::max(width, height); size > 1; size >>= 1) {
+        max_levels++;
+    }
+
+    if (levels > max_levels) {
+        cerr << "Warning : Load_KTX : " << path_to_utf8(path) << " has " << levels << " mipmap levels, at most " << max_levels << " are possible" << endl;
+        return 0;
+    }
+    unsigned int target_width = 0;
+    unsigned int target_height = 0;
+
+    if (size_callback) {
+        size_callback(width, height, target_width, target_height);
+    }
+
+    // padding needs a new first level
+    bool padded = pad_power_of_2 && (Get_Power_of_2(width) != width || Get_Power_of_2(height) != height);
+    // first level to load
+    unsigned int first = levels;
+
+    if (!padded && (!target_width || !target_height)) {
+        first = 0;
+        target_width = width;
+        target_height = height;
+    }
+    else if (!padded) {
+        for (unsigned int level = 0; level < levels; level++) {
+            if (std::max(width >> level, 1u) == target_width && std::max(height >> level, 1u) == target_height) {
+                first = level;
+                break;
+            }
+        }
+    }
+
+    // scale the first level to the target size without mipmaps
+    bool scaled = first == levels;
+
+    if (scaled) {
+        first = 0;
+        levels = 1;
+    }
+
+    // levels needing no conversion are read into the buffer directly
+    cPixel_Buffer* image = &buffer;
+
+    if (scaled || (format == PIXEL_FORMAT_BC3 && !compressed)) {
+        image = cPixel_Buffer::Acquire();
+    }
+
+    if (scaled) {
+        image->Resize(width, height, 1, format);
+    }
+    else {
+        image->Resize(target_width, target_height, levels - first, format);
+    }
+
+    for (unsigned int level = 0; level < levels; level++) {
+        uint32_t size = 0;
+        size_t level_size = cPixel_Buffer::Get_Chain_Size(std::max(width >> level, 1u), std::max(height >> level, 1u), 1, format);
+
+        if (!file.read(reinterpret_cast<char*>(&size), sizeof(size)) || size != level_size) {
+            cerr << "Warning : Load_KTX : " << path_to_utf8(path) << " has an invalid mipmap level " << level << endl;
+
+            if (image != &buffer) {
+                cPixel_Buffer::Release(image);
+            }
+            return 0;
+        }
+
+        if (level < first) {
+            file.seekg(size, ios::cur);
+            continue;
+        }
+
+        if (!file.read(reinterpret_cast<char*>(image->Get_Level(level - first)), size)) {
+            cerr << "Warning : Load_KTX : " << path_to_utf8(path) << " is truncated" << endl;
+
+            if (image != &buffer) {
+                cPixel_Buffer::Release(image);
+            }
+            return 0;
+        }
+    }
+
+    if (image != &buffer && format == PIXEL_FORMAT_BC3) {
+        cPixel_Buffer* pixels = scaled ? cPixel_Buffer::Acquire() : &buffer;
+
+        Decompress_BC3(*image, *pixels);
+        cPixel_Buffer::Release(image);
+        image = pixels;
+    }
+
+    if (scaled) {
+        Copy_To_Pixel_Buffer(image->Get_Pixels(), width, height, buffer, pad_power_of_2, target_width, target_height);
+        cPixel_Buffer::Release(image);
+    }
+
+    return 1;
+}
+
+/* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
+
+} // namespace TSC
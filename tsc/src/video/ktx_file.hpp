@@ -0,0 +1,51 @@
+/***************************************************************************
+ * ktx_file.hpp - KTX texture files for the image cache
+ *
+ * Copyright © 2012-2020 The TSC Contributors
+ ***************************************************************************/
+/*
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef TSC_KTX_FILE_HPP
+#define TSC_KTX_FILE_HPP
+
+#include "../core/global_basic.hpp"
+#include "../video/png_decoder.hpp"
+
+namespace TSC {
+
+    /* *** *** *** *** *** *** *** KTX files *** *** *** *** *** *** *** *** *** *** */
+
+    /* The image cache stores images with precomputed mipmaps as KTX 1.1
+     * files (https://www.khronos.org/opengles/sdk/tools/KTX/file_format_spec/).
+     * Only 2D textures with 8 bit RGBA or BC3 compressed levels in native
+     * byte order are written and read.
+    */
+
+    // Save the image and all mipmap levels of `buffer' in its pixel format
+    bool Save_KTX(const boost::filesystem::path& path, const cPixel_Buffer& buffer);
+
+    /* Load a file written by Save_KTX() into `buffer'
+     * width/height : set to the size of the first level
+     * pad_power_of_2 : pad the image if it has no power of 2 size, this drops the mipmaps
+     * size_callback : see Load_Pixel_Buffer(). If the target size is the size
+     *                 of a mipmap level it is loaded with its smaller levels,
+     *                 otherwise the first level is scaled without mipmaps.
+     * compressed : keep BC3 levels compressed if they are not scaled,
+     *              otherwise they are decompressed to RGBA
+     * Returns 0 on errors or unsupported files.
+    */
+    bool Load_KTX(const boost::filesystem::path& path, cPixel_Buffer& buffer, unsigned int& width, unsigned int& height, bool pad_power_of_2 = 1, const Pixel_Size_Callback& size_callback = nullptr, bool compressed = 0);
+
+    /* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
+
+} // namespace TSC
+
+#endif
@@ -110,10 +110,12 @@ void TSC::Loading_Screen_Draw(void)
     pVideo->Clear_Screen();
     pVideo->Draw_Rect(NULL, 0.00001f, &black);
 
-    // Render
-    pRenderer->Render();
-    CEGUI::System::getSingleton().renderAllGUIContexts();
-    pVideo->mp_window->display();
+    // Render, with the window context of the render thread if it runs
+    pVideo->m_render_thread.Run([]() {
+        pRenderer->Render();
+        CEGUI::System::getSingleton().renderAllGUIContexts();
+        pVideo->mp_window->display();
+    });
 }
 
 void TSC::Loading_Screen_Exit(void)
@@ -131,4 +133,7 @@ void TSC::Loading_Screen_Exit(void)
     else {
         throw(std::runtime_error("Can't exit from loading screen if no loading screen exists!"));
     }
+
+    // the decode buffers are only reused while loading
+    cPixel_Buffer::Clear_Pool();
 }
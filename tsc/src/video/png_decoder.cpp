@@ -0,0 +1,672 @@
+/***************************************************************************
+ * png_decoder.cpp - PNG decoding into texture upload buffers
+ *
+ * Copyright © 2012-2020 The TSC Contributors
+ ***************************************************************************/
+/*
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "../video/png_decoder.hpp"
+#include "../video/downscale.hpp"
+#include "../video/ktx_file.hpp"
+#include "../video/texture_compression.hpp"
+#include "../core/math/utilities.hpp"
+#include "../core/filesystem/filesystem.hpp"
+#include "../core/global_basic.hpp"
+#include "../core/alloc_counter.hpp"
+
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/lock_guard.hpp>
+
+using namespace std;
+
+namespace fs = boost::filesystem;
+
+namespace TSC {
+
+/* *** *** *** *** *** *** *** cPixel_Buffer *** *** *** *** *** *** *** *** *** *** */
+
+// Number of buffers kept for reuse
+static const size_t PIXEL_BUFFER_POOL_SIZE = 8;
+// Larger buffers are freed when released
+static const size_t PIXEL_BUFFER_POOL_MAX_BYTES = 32 * 1024 * 1024;
+// Memory kept by all buffers in the pool, buffers above it are freed when released
+static const size_t PIXEL_BUFFER_POOL_MAX_TOTAL_BYTES = 64 * 1024 * 1024;
+
+static boost::mutex pixel_buffer_mutex;
+static std::vector<cPixel_Buffer*> pixel_buffer_pool;
+static size_t pixel_buffer_pool_bytes = 0;
+
+cPixel_Buffer::cPixel_Buffer(void)
+{
+    mp_pixels = NULL;
+    m_capacity = 0;
+    m_width = 0;
+    m_height = 0;
+    m_levels = 0;
+    m_format = PIXEL_FORMAT_RGBA;
+}
+
+cPixel_Buffer::~cPixel_Buffer(void)
+{
+    Clear();
+}
+
+unsigned char* cPixel_Buffer::Resize(unsigned int width, unsigned int height, unsigned int levels /* = 1 */, Pixel_Format format /* = PIXEL_FORMAT_RGBA */)
+{
+    Reserve(Get_Chain_Size(width, height, levels, format));
+
+    m_width = width;
+    m_height = height;
+    m_levels = levels;
+    m_format = format;
+
+    return mp_pixels;
+}
+
+void cPixel_Buffer::Reserve(size_t size, size_t keep /* = 0 */)
+{
+    if (size <= m_capacity) {
+        return;
+    }
+
+    unsigned char* pixels = new unsigned char[size];
+
+    if (keep) {
+        memcpy(pixels, mp_pixels, keep);
+    }
+
+    delete[] mp_pixels;
+
+    mp_pixels = pixels;
+    m_capacity = size;
+}
+
+void cPixel_Buffer::Build_Mipmaps(void)
+{
+    unsigned int levels = 1;
+
+    while ((m_width >> levels) > 0 || (m_height >> levels) > 0) {
+        levels++;
+    }
+
+    Reserve(Get_Chain_Size(m_width, m_height, levels), Get_Chain_Size(m_width, m_height, 1));
+    m_levels = levels;
+
+    for (unsigned int level = 1; level < levels; level++) {
+        Downscale_RGBA_Alpha_Weighted(Get_Level(level - 1), Get_Level_Width(level - 1), Get_Level_Height(level - 1), Get_Level(level), Get_Level_Width(level), Get_Level_Height(level));
+    }
+}
+
+bool cPixel_Buffer::Is_Opaque(void) const
+{
+    if (m_format == PIXEL_FORMAT_BC3) {
+        return Is_BC3_Opaque(*this);
+    }
+
+    const unsigned char* alpha = mp_pixels + 3;
+    const unsigned char* end = mp_pixels + static_cast<size_t>(m_width) * m_height * 4;
+
+    for (; alpha < end; alpha += 4) {
+        if (*alpha != 255) {
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+size_t cPixel_Buffer::Get_Chain_Size(unsigned int width, unsigned int height, unsigned int levels, Pixel_Format format /* = PIXEL_FORMAT_RGBA */)
+{
+    size_t size = 0;
+
+    for (unsigned int level = 0; level < levels; level++) {
+        unsigned int level_width = std::max(width >> level, 1u);
+        unsigned int level_height = std::max(height >> level, 1u);
+
+        if (format == PIXEL_FORMAT_BC3) {
+            size += Get_BC3_Size(level_width, level_height);
+        }
+        else {
+            size += static_cast<size_t>(level_width) * level_height * 4;
+        }
+    }
+
+    return size;
+}
+
+void cPixel_Buffer::Clear(void)
+{
+    if (mp_pixels) {
+        delete[] mp_pixels;
+        mp_pixels = NULL;
+    }
+
+    m_capacity = 0;
+    m_width = 0;
+    m_height = 0;
+    m_levels = 0;
+    m_format = PIXEL_FORMAT_RGBA;
+}
+
+cPixel_Buffer* cPixel_Buffer::Acquire(void)
+{
+    {
+        boost::lock_guard<boost::mutex> lock(pixel_buffer_mutex);
+
+        if (!pixel_buffer_pool.empty()) {
+            cPixel_Buffer* buffer = pixel_buffer_pool.back();
+            pixel_buffer_pool.pop_back();
+            pixel_buffer_pool_bytes -= buffer->m_capacity;
+            return buffer;
+        }
+    }
+
+    return new cPixel_Buffer();
+}
+
+void cPixel_Buffer::Release(cPixel_Buffer* buffer)
+{
+    if (!buffer) {
+        return;
+    }
+
+    if (buffer->m_capacity <= PIXEL_BUFFER_POOL_MAX_BYTES) {
+        boost::lock_guard<boost::mutex> lock(pixel_buffer_mutex);
+
+        if (pixel_buffer_pool.size() < PIXEL_BUFFER_POOL_SIZE && pixel_buffer_pool_bytes + buffer->m_capacity <= PIXEL_BUFFER_POOL_MAX_TOTAL_BYTES) {
+            pixel_buffer_pool.push_back(buffer);
+            pixel_buffer_pool_bytes += buffer->m_capacity;
+            return;
+        }
+    }
+
+    delete buffer;
+}
+
+void cPixel_Buffer::Clear_Pool(void)
+{
+    std::vector<cPixel_Buffer*> buffers;
+
+    {
+        boost::lock_guard<boost::mutex> lock(pixel_buffer_mutex);
+        buffers.swap(pixel_buffer_pool);
+        pixel_buffer_pool_bytes = 0;
+    }
+
+    for (std::vector<cPixel_Buffer*>::iterator itr = buffers.begin(); itr != buffers.end(); ++itr) {
+        delete *itr;
+    }
+}
+
+size_t cPixel_Buffer::Get_Pool_Bytes(void)
+{
+    boost::lock_guard<boost::mutex> lock(pixel_buffer_mutex);
+    return pixel_buffer_pool_bytes;
+}
+
+// Make the pixels right of and below the image transparent
+static void Clear_Padding(cPixel_Buffer& buffer, unsigned int width, unsigned int height)
+{
+    if (width < buffer.Get_Width()) {
+        for (unsigned int y = 0; y < height; y++) {
+            memset(buffer.Get_Row(y) + width * 4, 0, (buffer.Get_Width() - width) * 4);
+        }
+    }
+    if (height < buffer.Get_Height()) {
+        memset(buffer.Get_Row(height), 0, static_cast<size_t>(buffer.Get_Height() - height) * buffer.Get_Width() * 4);
+    }
+}
+
+/* *** *** *** *** *** *** *** cPNG_Decoder *** *** *** *** *** *** *** *** *** *** */
+
+// The images are valid for sf::Image too, so warnings are not of interest
+static void PNG_Ignore_Warning(png_structp png, png_const_charp message)
+{
+}
+
+cPNG_Decoder::cPNG_Decoder(void)
+{
+    mp_file = NULL;
+    mp_png = NULL;
+    mp_info = NULL;
+
+    m_width = 0;
+    m_height = 0;
+    m_passes = 1;
+}
+
+cPNG_Decoder::~cPNG_Decoder(void)
+{
+    Close();
+}
+
+bool cPNG_Decoder::Open(const fs::path& path)
+{
+    Close();
+
+    // see cVideo::Save_Surface for why this is needed
+#ifdef _WIN32
+    mp_file = _wfopen(path.native().c_str(), L"rb");
+#else
+    mp_file = fopen(path.native().c_str(), "rb");
+#endif
+
+    if (!mp_file) {
+        return 0;
+    }
+
+    png_byte signature[8];
+
+    if (fread(signature, 1, 8, mp_file) != 8 || png_sig_cmp(signature, 0, 8) != 0) {
+        Close();
+        return 0;
+    }
+
+    mp_png = png_create_read_struct(PNG_LIBPNG_VER_STRING, NULL, NULL, PNG_Ignore_Warning);
+
+    if (mp_png) {
+        mp_info = png_create_info_struct(mp_png);
+    }
+
+    if (!mp_info) {
+        Close();
+        return 0;
+    }
+
+    // libpng errors jump back here
+    if (setjmp(png_jmpbuf(mp_png))) {
+        Close();
+        return 0;
+    }
+
+    png_init_io(mp_png, mp_file);
+    png_set_sig_bytes(mp_png, 8);
+    png_read_info(mp_png, mp_info);
+
+    png_uint_32 width = 0;
+    png_uint_32 height = 0;
+    int bit_depth = 0;
+    int color_type = 0;
+
+    png_get_IHDR(mp_png, mp_info, &width, &height, &bit_depth, &color_type, NULL, NULL, NULL);
+
+    // convert everything to 8 bit RGBA
+    if (color_type == PNG_COLOR_TYPE_PALETTE) {
+        png_set_palette_to_rgb(mp_png);
+    }
+    if (color_type == PNG_COLOR_TYPE_GRAY && bit_depth < 8) {
+        png_set_expand_gray_1_2_4_to_8(mp_png);
+    }
+    if (bit_depth == 16) {
+        png_set_strip_16(mp_png);
+    }
+    if (color_type == PNG_COLOR_TYPE_GRAY || color_type == PNG_COLOR_TYPE_GRAY_ALPHA) {
+        png_set_gray_to_rgb(mp_png);
+    }
+    if (png_get_valid(mp_png, mp_info, PNG_INFO_tRNS)) {
+        png_set_tRNS_to_alpha(mp_png);
+    }
+    else if (!(color_type & PNG_COLOR_MASK_ALPHA)) {
+        png_set_filler(mp_png, 0xFF, PNG_FILLER_AFTER);
+    }
+
+    m_passes = png_set_interlace_handling(mp_png);
+    png_read_update_info(mp_png, mp_info);
+
+    if (png_get_rowbytes(mp_png, mp_info) != width * 4) {
+        cerr << "Warning : cPNG_Decoder : Unsupported format in " << path_to_utf8(path) << endl;
+        Close();
+        return 0;
+    }
+
+    m_width = width;
+    m_height = height;
+    return 1;
+}
+
+void cPNG_Decoder::Close(void)
+{
+    if (mp_png) {
+        png_destroy_read_struct(&mp_png, mp_info ? &mp_info : NULL, NULL);
+        mp_png = NULL;
+        mp_info = NULL;
+    }
+    if (mp_file) {
+        fclose(mp_file);
+        mp_file = NULL;
+    }
+}
+
+bool cPNG_Decoder::Decode(cPixel_Buffer& buffer, bool pad_power_of_2 /* = 1 */, unsigned int target_width /* = 0 */, unsigned int target_height /* = 0 */)
+{
+    if (!mp_png) {
+        return 0;
+    }
+
+    unsigned int width = pad_power_of_2 ? Get_Power_of_2(m_width) : m_width;
+    unsigned int height = pad_power_of_2 ? Get_Power_of_2(m_height) : m_height;
+
+    if (!target_width || !target_height) {
+        target_width = width;
+        target_height = height;
+    }
+
+    bool scaled = target_width != width || target_height != height;
+    // whole blocks of rows can be scaled while decoding
+    bool streamed = scaled && m_passes == 1 && target_width <= width && target_height <= height && width % target_width == 0 && height % target_height == 0;
+    unsigned int block_height = streamed ? height / target_height : 0;
+
+    // holds a block of rows or the full image for scaling
+    cPixel_Buffer* strip = scaled ? cPixel_Buffer::Acquire() : NULL;
+
+    // libpng errors jump back here
+    if (setjmp(png_jmpbuf(mp_png))) {
+        cPixel_Buffer::Release(strip);
+        Close();
+        return 0;
+    }
+
+    if (streamed) {
+        buffer.Resize(target_width, target_height);
+        strip->Resize(width, block_height);
+        Read_Scaled(buffer, *strip, block_height);
+    }
+    else if (scaled) {
+        strip->Resize(width, height);
+        Read_Full(*strip);
+        buffer.Resize(target_width, target_height);
+        Downscale_RGBA(strip->Get_Pixels(), width, height, buffer.Get_Pixels(), target_width, target_height);
+    }
+    else {
+        buffer.Resize(width, height);
+        Read_Full(buffer);
+    }
+
+    cPixel_Buffer::Release(strip);
+    Close();
+    return 1;
+}
+
+void cPNG_Decoder::Read_Full(cPixel_Buffer& buffer)
+{
+    m_rows.resize(m_height);
+
+    for (unsigned int y = 0; y < m_height; y++) {
+        m_rows[y] = buffer.Get_Row(y);
+    }
+
+    png_read_image(mp_png, &m_rows[0]);
+    Clear_Padding(buffer, m_width, m_height);
+}
+
+void cPNG_Decoder::Read_Scaled(cPixel_Buffer& buffer, cPixel_Buffer& strip, unsigned int block_height)
+{
+    unsigned int image_y = 0;
+
+    for (unsigned int y = 0; y < buffer.Get_Height(); y++) {
+        unsigned int rows = std::min(block_height, m_height > image_y ? m_height - image_y : 0);
+
+        for (unsigned int row = 0; row < rows; row++) {
+            png_read_row(mp_png, strip.Get_Row(row), NULL);
+        }
+
+        image_y += rows;
+        Clear_Padding(strip, m_width, rows);
+        Downscale_RGBA(strip.Get_Pixels(), strip.Get_Width(), block_height, buffer.Get_Row(y), buffer.Get_Width(), 1, DOWNSCALE_FILTER_BOX);
+    }
+}
+
+/* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
+
+bool Load_Pixel_Buffer(const fs::path& path, cPixel_Buffer& buffer, unsigned int& width, unsigned int& height, bool pad_power_of_2 /* = 1 */, const Pixel_Size_Callback& size_callback /* = nullptr */, bool compressed /* = 0 */)
+{
+    // cached with mipmaps or compressed
+    if (path.extension() == fs::path(".ktx")) {
+        return Load_KTX(path, buffer, width, height, pad_power_of_2, size_callback, compressed);
+    }
+
+    unsigned int target_width = 0;
+    unsigned int target_height = 0;
+
+    cPNG_Decoder decoder;
+
+    if (decoder.Open(path)) {
+        width = decoder.Get_Width();
+        height = decoder.Get_Height();
+
+        if (size_callback) {
+            size_callback(width, height, target_width, target_height);
+        }
+
+        return decoder.Decode(buffer, pad_power_of_2, target_width, target_height);
+    }
+
+    // other formats
+    sf::Image image;
+
+    if (!image.loadFromFile(path_to_utf8(path))) {
+        return 0;
+    }
+
+    width = image.getSize().x;
+    height = image.getSize().y;
+
+    if (size_callback) {
+        size_callback(width, height, target_width, target_height);
+    }
+
+    Copy_To_Pixel_Buffer(image.getPixelsPtr(), width, height, buffer, pad_power_of_2, target_width, target_height);
+    return 1;
+}
+
+void Copy_To_Pixel_Buffer(const unsigned char* pixels, unsigned int width, unsigned int height, cPixel_Buffer& buffer, bool pad_power_of_2, unsigned int target_width /* = 0 */, unsigned int target_height /* = 0 */)
+{
+    unsigned int padded_width = pad_power_of_2 ? Get_Power_of_2(width) : width;
+    unsigned int padded_height = pad_power_of_2 ? Get_Power_of_2(height) : height;
+
+    if (!target_width || !target_height) {
+        target_width = padded_width;
+        target_height = padded_height;
+    }
+
+    bool scaled = target_width != padded_width || target_height != padded_height;
+    cPixel_Buffer* padded = scaled ? cPixel_Buffer::Acquire() : &buffer;
+
+    padded->Resize(padded_width, padded_height);
+
+    for (unsigned int y = 0; y < height; y++) {
+        memcpy(padded->Get_Row(y), pixels + static_cast<size_t>(y) * width * 4, width * 4);
+    }
+
+    Clear_Padding(*padded, width, height);
+
+    if (scaled) {
+        buffer.Resize(target_width, target_height);
+        Downscale_RGBA(padded->Get_Pixels(), padded_width, padded_height, buffer.Get_Pixels(), target_width, target_height);
+        cPixel_Buffer::Release(padded);
+    }
+}
+
+/* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
+
+// Load like before with sf::Image, padded to a power of two and scaled with a new sf::Image
+static bool Load_Previous(const fs::path& path, bool half)
+{
+    sf::Image* p_image = new sf::Image();
+
+    if (!p_image->loadFromFile(path_to_utf8(path))) {
+        delete p_image;
+        return 0;
+    }
+
+    unsigned int width = Get_Power_of_2(p_image->getSize().x);
+    unsigned int height = Get_Power_of_2(p_image->getSize().y);
+
+    if (width != p_image->getSize().x || height != p_image->getSize().y) {
+        sf::Image* p_padded = new sf::Image();
+        p_padded->create(width, height, sf::Color::Transparent);
+        p_padded->copy(*p_image, 0, 0);
+        delete p_image;
+        p_image = p_padded;
+    }
+
+    if (half && width > 1 && height > 1) {
+        width /= 2;
+        height /= 2;
+
+        unsigned char* p_pixels = static_cast<unsigned char*>(malloc(static_cast<size_t>(width) * height * 4));
+
+        if (!p_pixels) {
+            delete p_image;
+            return 0;
+        }
+
+        Downscale_RGBA(p_image->getPixelsPtr(), p_image->getSize().x, p_image->getSize().y, p_pixels, width, height);
+
+        sf::Image* p_scaled = new sf::Image();
+        p_scaled->create(width, height, p_pixels);
+        delete p_image;
+        p_image = p_scaled;
+        free(p_pixels);
+    }
+
+    delete p_image;
+    return 1;
+}
+
+// Load with the decoder like cVideo::Load_GL_Surface() does
+static bool Load_Decoder(const fs::path& path, cPixel_Buffer& buffer, bool half)
+{
+    unsigned int width = 0;
+    unsigned int height = 0;
+
+    return Load_Pixel_Buffer(path, buffer, width, height, 1, [half](unsigned int width, unsigned int height, unsigned int& target_width, unsigned int& target_height) {
+        target_width = std::max(Get_Power_of_2(width) >> half, 1u);
+        target_height = std::max(Get_Power_of_2(height) >> half, 1u);
+    });
+}
+
+void Benchmark_Image_Load(const fs::path& dir)
+{
+    std::vector<fs::path> files = Get_Directory_Files(dir, ".png");
+
+    cout << "Loading " << files.size() << " images from " << path_to_utf8(dir) << endl;
+
+    // texture memory with and without power of 2 padding
+    double padded_bytes = 0.0;
+    double exact_bytes = 0.0;
+
+    for (std::vector<fs::path>::const_iterator itr = files.begin(); itr != files.end(); ++itr) {
+        cPNG_Decoder decoder;
+
+        if (decoder.Open(*itr)) {
+            padded_bytes += 4.0 * Get_Power_of_2(decoder.Get_Width()) * Get_Power_of_2(decoder.Get_Height());
+            exact_bytes += 4.0 * decoder.Get_Width() * decoder.Get_Height();
+        }
+    }
+
+    if (padded_bytes > 0.0) {
+        cout << fixed << setprecision(1) << "Texture memory at full size: " << padded_bytes / (1024 * 1024) << " MiB padded to powers of 2, "
+             << exact_bytes / (1024 * 1024) << " MiB without padding (" << 100.0 * (padded_bytes - exact_bytes) / padded_bytes << "% less)" << endl;
+    }
+
+    for (int half = 0; half < 2; half++) {
+        unsigned int count = 0;
+
+        // previous path
+        uint64_t alloc_count = Get_Alloc_Count();
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+        for (std::vector<fs::path>::const_iterator itr = files.begin(); itr != files.end(); ++itr) {
+            if (Load_Previous(*itr, half)) {
+                count++;
+            }
+        }
+
+        double previous_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        uint64_t previous_allocs = Get_Alloc_Count() - alloc_count;
+
+        if (!count) {
+            return;
+        }
+
+        // decoding into reused buffers
+        cPixel_Buffer::Clear_Pool();
+        cPixel_Buffer* buffer = cPixel_Buffer::Acquire();
+        alloc_count = Get_Alloc_Count();
+        start = std::chrono::steady_clock::now();
+
+        for (std::vector<fs::path>::const_iterator itr = files.begin(); itr != files.end(); ++itr) {
+            Load_Decoder(*itr, *buffer, half);
+        }
+
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        uint64_t allocs = Get_Alloc_Count() - alloc_count;
+        cPixel_Buffer::Release(buffer);
+        // kept allocated for the next images
+        size_t pool_bytes = cPixel_Buffer::Get_Pool_Bytes();
+
+        cout << (half ? "half size" : "full size") << ":" << endl;
+        cout << fixed << setprecision(2)
+             << "  previous: " << setw(8) << previous_seconds * 1000.0 / count << " ms/image" << endl
+             << "  decoder : " << setw(8) << seconds * 1000.0 / count << " ms/image, pool keeps " << pool_bytes / 1024 << " KiB" << endl;
+
+#ifdef ENABLE_ALLOC_COUNTER
+        cout << "  allocations: previous " << previous_allocs / static_cast<double>(count) << "/image, decoder " << allocs / static_cast<double>(count) << "/image" << endl;
+
+        /* Peak of the memory allocated with operator new while loading
+         * each image alone, the same way for both. The pool is emptied
+         * before each image so the buffers it would keep are counted.
+         * malloc() inside libpng and SFML's image loader is not counted
+         * for either. */
+        size_t previous_peak = 0;
+        size_t previous_total_peak = 0;
+        size_t peak = 0;
+        size_t total_peak = 0;
+
+        for (std::vector<fs::path>::const_iterator itr = files.begin(); itr != files.end(); ++itr) {
+            cPixel_Buffer::Clear_Pool();
+            Reset_Peak_Alloc_Bytes();
+            uint64_t base = Get_Live_Alloc_Bytes();
+
+            Load_Previous(*itr, half);
+
+            size_t image_peak = static_cast<size_t>(Get_Peak_Alloc_Bytes() - base);
+            previous_peak = std::max(previous_peak, image_peak);
+            previous_total_peak += image_peak;
+
+            cPixel_Buffer::Clear_Pool();
+            Reset_Peak_Alloc_Bytes();
+            base = Get_Live_Alloc_Bytes();
+
+            {
+                cPixel_Buffer image_buffer;
+                Load_Decoder(*itr, image_buffer, half);
+            }
+
+            image_peak = static_cast<size_t>(Get_Peak_Alloc_Bytes() - base);
+            peak = std::max(peak, image_peak);
+            total_peak += image_peak;
+        }
+
+        cout << "  peak memory: previous " << previous_total_peak / 1024.0 / count << " KiB/image, largest " << previous_peak / 1024
+             << " KiB, decoder " << total_peak / 1024.0 / count << " KiB/image, largest " << peak / 1024 << " KiB" << endl;
+#else
+        (void)previous_allocs;
+        (void)allocs;
+        cout << "  allocations and peak memory: build with ENABLE_ALLOC_COUNTER" << endl;
+#endif
+    }
+}
+
+/* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
+
+} // namespace TSC
@@ -0,0 +1,215 @@
+/***************************************************************************
+ * png_decoder.hpp - PNG decoding into texture upload buffers
+ *
+ * Copyright © 2012-2020 The TSC Contributors
+ ***************************************************************************/
+/*
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef TSC_PNG_DECODER_HPP
+#define TSC_PNG_DECODER_HPP
+
+#include "../core/global_basic.hpp"
+
+namespace TSC {
+
+    /* *** *** *** *** *** *** *** cPixel_Buffer *** *** *** *** *** *** *** *** *** *** */
+
+    enum Pixel_Format {
+        // 8 bit RGBA pixels
+        PIXEL_FORMAT_RGBA,
+        // S3TC DXT5 compressed 4x4 blocks, see texture_compression.hpp
+        PIXEL_FORMAT_BC3
+    };
+
+    /* 8 bit RGBA pixels ready for glTexImage2D, optionally followed by
+     * the smaller mipmap levels. Images from the compressed image cache
+     * hold BC3 blocks instead.
+     * The memory is kept when it is resized to a smaller image, so buffers
+     * taken with Acquire() are reused for the following images.
+    */
+    class cPixel_Buffer {
+    public:
+        cPixel_Buffer(void);
+        ~cPixel_Buffer(void);
+
+        /* Set the size and return the pixels. The content is undefined.
+         * levels : number of mipmap levels including the image
+        */
+        unsigned char* Resize(unsigned int width, unsigned int height, unsigned int levels = 1, Pixel_Format format = PIXEL_FORMAT_RGBA);
+        // Free the memory
+        void Clear(void);
+
+        /* Calculate the mipmap levels down to 1x1 from the image
+         * Colours are weighted by alpha, so transparent pixels don't darken the edges.
+         * Only for RGBA pixels.
+        */
+        void Build_Mipmaps(void);
+
+        /* If every pixel of the image has full alpha
+         * Only the image is checked, not the mipmap levels.
+        */
+        bool Is_Opaque(void) const;
+
+        Pixel_Format Get_Format(void) const
+        {
+            return m_format;
+        }
+        // Number of mipmap levels including the image
+        unsigned int Get_Levels(void) const
+        {
+            return m_levels;
+        }
+        // Pixels of a mipmap level, 0 is the image
+        unsigned char* Get_Level(unsigned int level) const
+        {
+            return mp_pixels + Get_Chain_Size(m_width, m_height, level, m_format);
+        }
+        // Bytes of a mipmap level
+        size_t Get_Level_Size(unsigned int level) const
+        {
+            return Get_Chain_Size(Get_Level_Width(level), Get_Level_Height(level), 1, m_format);
+        }
+        unsigned int Get_Level_Width(unsigned int level) const
+        {
+            return std::max(m_width >> level, 1u);
+        }
+        unsigned int Get_Level_Height(unsigned int level) const
+        {
+            return std::max(m_height >> level, 1u);
+        }
+
+        // Bytes of the first `levels' mipmap levels of an image
+        static size_t Get_Chain_Size(unsigned int width, unsigned int height, unsigned int levels, Pixel_Format format = PIXEL_FORMAT_RGBA);
+
+        unsigned char* Get_Pixels(void) const
+        {
+            return mp_pixels;
+        }
+        unsigned char* Get_Row(unsigned int y) const
+        {
+            return mp_pixels + static_cast<size_t>(y) * m_width * 4;
+        }
+        unsigned int Get_Width(void) const
+        {
+            return m_width;
+        }
+        unsigned int Get_Height(void) const
+        {
+            return m_height;
+        }
+
+        /* Return a buffer from the pool or a new one
+         * Thread safe. Must be given back with Release().
+        */
+        static cPixel_Buffer* Acquire(void);
+        // Give the buffer back to the pool, it may be deleted
+        static void Release(cPixel_Buffer* buffer);
+        // Delete the buffers kept for reuse
+        static void Clear_Pool(void);
+
+        // Memory of the buffers kept for reuse
+        static size_t Get_Pool_Bytes(void);
+
+    private:
+        // Make room for `size' bytes, keeping the first `keep' bytes
+        void Reserve(size_t size, size_t keep = 0);
+
+        unsigned char* mp_pixels;
+        size_t m_capacity;
+        unsigned int m_width;
+        unsigned int m_height;
+        unsigned int m_levels;
+        Pixel_Format m_format;
+    };
+
+    /* Called with the image size to set the size it should be scaled to
+     * The target size is left at 0 to keep the size.
+    */
+    typedef std::function<void (unsigned int image_width, unsigned int image_height, unsigned int& target_width, unsigned int& target_height)> Pixel_Size_Callback;
+
+    /* *** *** *** *** *** *** *** cPNG_Decoder *** *** *** *** *** *** *** *** *** *** */
+
+    /* Decodes a PNG file directly into a pixel buffer as 8 bit RGBA
+     * Palette, grey and 16 bit images are converted like sf::Image does.
+    */
+    class cPNG_Decoder {
+    public:
+        cPNG_Decoder(void);
+        ~cPNG_Decoder(void);
+
+        // Open the file and read the header. Returns 0 if it is no valid PNG image.
+        bool Open(const boost::filesystem::path& path);
+        // Close the file
+        void Close(void);
+
+        // Image size from the header
+        unsigned int Get_Width(void) const
+        {
+            return m_width;
+        }
+        unsigned int Get_Height(void) const
+        {
+            return m_height;
+        }
+
+        /* Decode the image into `buffer'
+         * pad_power_of_2 : enlarge the size to a power of two with transparent pixels
+         * target_width/height : scale the (padded) image down to this size if set.
+         *     Integer ratios are scaled row by row while decoding and never
+         *     hold the full size image in memory.
+         * Returns 0 on errors. The decoder must be opened again afterwards.
+        */
+        bool Decode(cPixel_Buffer& buffer, bool pad_power_of_2 = 1, unsigned int target_width = 0, unsigned int target_height = 0);
+
+    private:
+        // Read the rows into `buffer' and clear the padding
+        void Read_Full(cPixel_Buffer& buffer);
+        // Read the rows in blocks and scale each block to one row of `buffer'
+        void Read_Scaled(cPixel_Buffer& buffer, cPixel_Buffer& strip, unsigned int block_height);
+
+        FILE* mp_file;
+        png_structp mp_png;
+        png_infop mp_info;
+
+        unsigned int m_width;
+        unsigned int m_height;
+        // number of interlace passes
+        int m_passes;
+        // row pointers for png_read_image(), a member as libpng errors jump over local destructors
+        std::vector<png_bytep> m_rows;
+    };
+
+    /* Load the PNG or other image file into `buffer' like cPNG_Decoder::Decode()
+     * KTX files from the image cache are loaded with their mipmap levels,
+     * see ktx_file.hpp. Other files are loaded with sf::Image and copied.
+     * width/height : set to the image size before padding
+     * pad_power_of_2 : enlarge the size to a power of two with transparent pixels
+     * size_callback : called with the image size to get the target size
+     * compressed : keep compressed KTX files compressed, see Load_KTX()
+     * Returns 0 on errors.
+    */
+    bool Load_Pixel_Buffer(const boost::filesystem::path& path, cPixel_Buffer& buffer, unsigned int& width, unsigned int& height, bool pad_power_of_2 = 1, const Pixel_Size_Callback& size_callback = nullptr, bool compressed = 0);
+
+    /* Copy the RGBA pixels into `buffer'
+     * pad_power_of_2 : enlarge the size to a power of two with transparent pixels
+     * target_width/height : scale the (padded) image down to this size if set
+    */
+    void Copy_To_Pixel_Buffer(const unsigned char* pixels, unsigned int width, unsigned int height, cPixel_Buffer& buffer, bool pad_power_of_2, unsigned int target_width = 0, unsigned int target_height = 0);
+
+    /* Compare the loading of all PNG images below `dir' with the previous
+     * sf::Image path and print the time and peak memory to stdout. */
+    void Benchmark_Image_Load(const boost::filesystem::path& dir);
+
+    /* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
+
+} // namespace TSC
+
+#endif
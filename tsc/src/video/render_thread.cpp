@@ -0,0 +1,247 @@
+/***************************************************************************
+ * render_thread.cpp - rendering frames in their own thread
+ *
+ * Copyright © 2012-2020 The TSC Contributors
+ ***************************************************************************/
+/*
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "../video/render_thread.hpp"
+#include "../video/video.hpp"
+#include "../video/renderer.hpp"
+#include "../core/global_basic.hpp"
+
+#include <boost/thread/lock_guard.hpp>
+
+using namespace std;
+
+namespace TSC {
+
+/* *** *** *** *** *** *** *** cRender_Thread *** *** *** *** *** *** *** *** *** *** */
+
+cRender_Thread::cRender_Thread(void)
+{
+    mp_window = NULL;
+    mp_context = NULL;
+
+    m_frame_new = 0;
+    m_frame_busy = 0;
+    m_gui_pending = 0;
+    m_main_waiting = 0;
+    m_quit = 0;
+    mp_job = NULL;
+}
+
+cRender_Thread::~cRender_Thread(void)
+{
+    Stop();
+}
+
+void cRender_Thread::Start(sf::RenderWindow* window)
+{
+    if (Is_Running()) {
+        return;
+    }
+
+    mp_window = window;
+
+    // a context can only be active in one thread
+    mp_window->setActive(false);
+    // shares the textures with the window
+    mp_context = new sf::Context();
+
+    m_quit = 0;
+    m_thread = boost::thread(&cRender_Thread::Thread_Main, this);
+
+    debug_print("Info : Rendering in a separate thread\n");
+}
+
+void cRender_Thread::Stop(void)
+{
+    if (!Is_Running()) {
+        return;
+    }
+
+    {
+        boost::lock_guard<boost::mutex> lock(m_mutex);
+        m_quit = 1;
+        m_main_waiting = 1;
+    }
+
+    m_condition.notify_all();
+    m_thread.join();
+
+    m_main_waiting = 0;
+    m_quit = 0;
+
+    // textures deleted after the last frame
+    if (!m_deleted_textures.empty()) {
+        glDeleteTextures(m_deleted_textures.size(), &m_deleted_textures[0]);
+        m_deleted_textures.clear();
+    }
+
+    delete mp_context;
+    mp_context = NULL;
+
+    mp_window->setActive(true);
+    mp_window = NULL;
+}
+
+void cRender_Thread::Submit_Frame(void)
+{
+    // textures created by this thread have to be complete before the render thread uses them
+    glFinish();
+
+    boost::unique_lock<boost::mutex> lock(m_mutex);
+    m_main_waiting = 1;
+    m_condition.notify_all();
+
+    // the previous queue is used until its GUI is rendered
+    while (m_gui_pending) {
+        m_condition.wait(lock);
+    }
+
+    m_main_waiting = 0;
+
+    // switch active renderer
+    cRenderQueue* new_render = pRenderer;
+    pRenderer = pRenderer_current;
+    pRenderer_current = new_render;
+
+    // move objects that should render more than once
+    if (!pRenderer->m_render_data.empty()) {
+        pRenderer_current->m_render_data.insert(pRenderer_current->m_render_data.begin(), pRenderer->m_render_data.begin(), pRenderer->m_render_data.end());
+        pRenderer->m_render_data.clear();
+    }
+
+    m_frame_new = 1;
+    m_gui_pending = 1;
+    m_condition.notify_all();
+}
+
+void cRender_Thread::Wait(void)
+{
+    if (!Is_Running() || Is_Current()) {
+        return;
+    }
+
+    boost::unique_lock<boost::mutex> lock(m_mutex);
+    m_main_waiting = 1;
+    m_condition.notify_all();
+
+    while (m_frame_new || m_frame_busy) {
+        m_condition.wait(lock);
+    }
+
+    m_main_waiting = 0;
+}
+
+void cRender_Thread::Run(const std::function<void(void)>& func)
+{
+    if (!Is_Running() || Is_Current()) {
+        func();
+        return;
+    }
+
+    // the job may use textures created by this thread
+    glFinish();
+
+    boost::unique_lock<boost::mutex> lock(m_mutex);
+    mp_job = &func;
+    m_main_waiting = 1;
+    m_condition.notify_all();
+
+    while (mp_job) {
+        m_condition.wait(lock);
+    }
+
+    m_main_waiting = 0;
+}
+
+void cRender_Thread::Delete_Texture(GLuint id)
+{
+    if (!Is_Running() || Is_Current()) {
+        glDeleteTextures(1, &id);
+        return;
+    }
+
+    boost::lock_guard<boost::mutex> lock(m_mutex);
+    m_deleted_textures.push_back(id);
+}
+
+void cRender_Thread::Thread_Main(void)
+{
+    mp_window->setActive(true);
+
+    std::vector<GLuint> deleted_textures;
+    boost::unique_lock<boost::mutex> lock(m_mutex);
+
+    while (1) {
+        while (!m_frame_new && !mp_job && !m_quit) {
+            m_condition.wait(lock);
+        }
+
+        if (mp_job) {
+            lock.unlock();
+            (*mp_job)();
+            lock.lock();
+
+            mp_job = NULL;
+            m_condition.notify_all();
+            continue;
+        }
+
+        if (!m_frame_new) {
+            break;
+        }
+
+        m_frame_new = 0;
+        m_frame_busy = 1;
+        deleted_textures.swap(m_deleted_textures);
+        lock.unlock();
+
+        // the previous frames no longer use them
+        if (!deleted_textures.empty()) {
+            glDeleteTextures(deleted_textures.size(), &deleted_textures[0]);
+            deleted_textures.clear();
+        }
+
+        pVideo->Render_Queue(pRenderer_current);
+
+        lock.lock();
+
+        // CEGUI may only be used while the main thread is waiting
+        while (!m_main_waiting) {
+            m_condition.wait(lock);
+        }
+
+        // it keeps waiting until the GUI is done
+        lock.unlock();
+        pVideo->Render_GUI();
+        lock.lock();
+
+        m_gui_pending = 0;
+        m_condition.notify_all();
+        lock.unlock();
+
+        mp_window->display();
+
+        lock.lock();
+        m_frame_busy = 0;
+        m_condition.notify_all();
+    }
+
+    lock.unlock();
+    mp_window->setActive(false);
+}
+
+/* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
+
+} // namespace TSC
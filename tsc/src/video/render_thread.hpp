@@ -0,0 +1,113 @@
+/***************************************************************************
+ * render_thread.hpp - rendering frames in their own thread
+ *
+ * Copyright © 2012-2020 The TSC Contributors
+ ***************************************************************************/
+/*
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef TSC_RENDER_THREAD_HPP
+#define TSC_RENDER_THREAD_HPP
+
+#include "../core/global_basic.hpp"
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/condition_variable.hpp>
+
+namespace TSC {
+
+    /* *** *** *** *** *** *** *** cRender_Thread *** *** *** *** *** *** *** *** *** *** */
+
+    /* Renders the frames in a thread which owns the OpenGL context of the
+     * window, while the main thread already updates the next frame.
+     *
+     * The main thread fills pRenderer and hands it over with
+     * Submit_Frame(), which swaps it with pRenderer_current. Only the
+     * render thread reads pRenderer_current until the next submit, so
+     * the requests need no locking.
+     *
+     * CEGUI is not thread safe. The GUI of a frame is therefore only
+     * rendered while the main thread waits in Submit_Frame(), Wait() or
+     * Run(), which makes it show the state one frame ahead of the world.
+     *
+     * The main thread keeps a context sharing the textures with the
+     * window, so textures can still be created from it. Deleting them
+     * has to go through Delete_Texture() as a frame in flight may still
+     * use them. Any other OpenGL state has to be changed with Run().
+     */
+    class cRender_Thread {
+    public:
+        cRender_Thread(void);
+        // Stops the thread
+        ~cRender_Thread(void);
+
+        // Start rendering in the thread with the context of the window
+        void Start(sf::RenderWindow* window);
+        // Render the last frame and give the context back to the calling thread
+        void Stop(void);
+
+        // Whether the thread was started
+        bool Is_Running(void) const
+        {
+            return m_thread.joinable();
+        }
+        // Whether called from the render thread
+        bool Is_Current(void) const
+        {
+            return boost::this_thread::get_id() == m_thread.get_id();
+        }
+
+        /* Hand the filled render queue to the thread
+         * Waits until the previous frame no longer uses its queue.
+        */
+        void Submit_Frame(void);
+        // Wait until the submitted frames are displayed
+        void Wait(void);
+        /* Call the function from the render thread between two frames and wait for it
+         * Called directly if the thread is not running.
+        */
+        void Run(const std::function<void(void)>& func);
+        /* Delete the OpenGL texture before the next frame is rendered
+         * Deleted directly if the thread is not running.
+        */
+        void Delete_Texture(GLuint id);
+
+    private:
+        void Thread_Main(void);
+
+        sf::RenderWindow* mp_window;
+        // context of the starting thread sharing the textures
+        sf::Context* mp_context;
+
+        boost::thread m_thread;
+        boost::mutex m_mutex;
+        // signals all state changes
+        boost::condition_variable m_condition;
+
+        // a submitted frame was not yet started
+        bool m_frame_new;
+        // a frame is rendered
+        bool m_frame_busy;
+        // the GUI of the submitted frame was not yet rendered
+        bool m_gui_pending;
+        // the main thread waits and does not use CEGUI
+        bool m_main_waiting;
+        // stop the thread when the frames are done
+        bool m_quit;
+        // function given to Run()
+        const std::function<void(void)>* mp_job;
+        // textures to delete before the next frame
+        std::vector<GLuint> m_deleted_textures;
+    };
+
+    /* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
+
+} // namespace TSC
+
+#endif
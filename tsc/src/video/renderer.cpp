@@ -17,6 +17,8 @@
 #include "../core/global_basic.hpp"
 #include "../video/renderer.hpp"
 #include "../core/game_core.hpp"
+#include "../core/math/utilities.hpp"
+#include "../user/preferences.hpp"
 #include "../core/global_basic.hpp"
 
 using namespace std;
@@ -49,12 +51,23 @@ void cRender_Request::Draw(void)
     // virtual
 }
 
+bool cRender_Request::Add_To_Batch(cSprite_Batch& batch)
+{
+    return 0;
+}
+
+bool cRender_Request::Is_Opaque(void) const
+{
+    return 0;
+}
+
 /* *** *** *** *** *** *** cClear_Request *** *** *** *** *** *** *** *** *** *** *** */
 
 cClear_Request::cClear_Request(void)
     : cRender_Request()
 {
     m_type = REND_CLEAR;
+    m_color = black;
 }
 
 cClear_Request::~cClear_Request(void)
@@ -64,6 +77,7 @@ cClear_Request::~cClear_Request(void)
 
 void cClear_Request::Draw(void)
 {
+    glClearColor(m_color.red / 255.0f, m_color.green / 255.0f, m_color.blue / 255.0f, m_color.alpha / 255.0f);
     // clear screen
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
     // clear the matrix (default position and orientation)
@@ -514,12 +528,15 @@ cSurface_Request::cSurface_Request(void)
 
     m_w = 0.0f;
     m_h = 0.0f;
+    m_tex_cover_w = 1.0f;
+    m_tex_cover_h = 1.0f;
 
     m_scale_x = 1.0f;
     m_scale_y = 1.0f;
     m_scale_z = 1.0f;
 
     m_color = static_cast<uint8_t>(255);
+    m_opaque = 0;
 
     m_delete_texture = 0;
 }
@@ -614,6 +631,12 @@ void cSurface_Request::Draw(void)
         last_bind_texture = m_texture_id;
     }
 
+    /* the rest of the surface would be transparent padding
+     * and the rotation center stays the same
+    */
+    const float right = m_tex_cover_w < 1.0f ? m_w * m_tex_cover_w - half_w : half_w;
+    const float bottom = m_tex_cover_h < 1.0f ? m_h * m_tex_cover_h - half_h : half_h;
+
     /* vertex arrays should not be used to draw simple primitives as it
      * does have no positive performance gain
     */
@@ -624,13 +647,13 @@ void cSurface_Request::Draw(void)
     glVertex2f(-half_w, -half_h);
     // top right
     glTexCoord2f(1.0f, 0.0f);
-    glVertex2f(half_w, -half_h);
+    glVertex2f(right, -half_h);
     // bottom right
     glTexCoord2f(1.0f, 1.0f);
-    glVertex2f(half_w, half_h);
+    glVertex2f(right, bottom);
     // bottom left
     glTexCoord2f(0.0f, 1.0f);
-    glVertex2f(-half_w, half_h);
+    glVertex2f(-half_w, bottom);
     glEnd();
 
     // clear color
@@ -645,11 +668,216 @@ void cSurface_Request::Draw(void)
     Render_Basic_Clear();
 }
 
+bool cSurface_Request::Add_To_Batch(cSprite_Batch& batch)
+{
+    if (!cSprite_Batch::Is_Supported_Combine(m_combine_type)) {
+        return 0;
+    }
+
+    float vertices[4][3];
+
+    // shadow as the combine color with the shadow alpha, just below the surface
+    if (m_shadow_pos) {
+        Color color = black;
+        color.alpha = m_shadow_color.alpha;
+
+        const float combine_color[3] = {
+            static_cast<float>(m_shadow_color.red) / 260,
+            static_cast<float>(m_shadow_color.green) / 260,
+            static_cast<float>(m_shadow_color.blue) / 260
+        };
+
+        Get_Vertices(m_pos_x + m_shadow_pos, m_pos_y + m_shadow_pos, m_pos_z - 0.000001f, vertices);
+        batch.Add_Quad(m_texture_id, m_blend_sfactor, m_blend_dfactor, vertices, color, GL_REPLACE, combine_color);
+    }
+
+    Get_Vertices(m_pos_x, m_pos_y, m_pos_z, vertices);
+    batch.Add_Quad(m_texture_id, m_blend_sfactor, m_blend_dfactor, vertices, m_color, m_combine_type, m_combine_color);
+
+    return 1;
+}
+
+bool cSurface_Request::Is_Opaque(void) const
+{
+    // the shadow is translucent and drawn below
+    return m_opaque && m_color.alpha == 255 && !m_shadow_pos && m_blend_sfactor == GL_SRC_ALPHA && m_blend_dfactor == GL_ONE_MINUS_SRC_ALPHA;
+}
+
+float cSurface_Request::Get_Screen_Area(void) const
+{
+    float vertices[4][3];
+    Get_Vertices(m_pos_x, m_pos_y, m_pos_z, vertices);
+
+    // only the part on the screen
+    const float left = Clamp(std::min(vertices[0][0], vertices[2][0]), 0.0f, static_cast<float>(pPreferences->m_video_screen_w));
+    const float right = Clamp(std::max(vertices[0][0], vertices[2][0]), 0.0f, static_cast<float>(pPreferences->m_video_screen_w));
+    const float top = Clamp(std::min(vertices[0][1], vertices[2][1]), 0.0f, static_cast<float>(pPreferences->m_video_screen_h));
+    const float bottom = Clamp(std::max(vertices[0][1], vertices[2][1]), 0.0f, static_cast<float>(pPreferences->m_video_screen_h));
+
+    return (right - left) * (bottom - top);
+}
+
+void cSurface_Request::Get_Vertices(float pos_x, float pos_y, float pos_z, float vertices[4][3]) const
+{
+    // get half the size
+    const float half_w = m_w / 2;
+    const float half_h = m_h / 2;
+    // position
+    float final_pos_x = pos_x + (half_w * m_scale_x);
+    float final_pos_y = pos_y + (half_h * m_scale_y);
+
+    // set camera position
+    if (!m_no_camera) {
+        final_pos_x -= pActive_Camera->m_x;
+        final_pos_y -= pActive_Camera->m_y;
+    }
+
+    // the rest of the surface would be transparent padding
+    const float right = m_tex_cover_w < 1.0f ? m_w * m_tex_cover_w - half_w : half_w;
+    const float bottom = m_tex_cover_h < 1.0f ? m_h * m_tex_cover_h - half_h : half_h;
+
+    const float corners[4][2] = {{-half_w, -half_h}, {right, -half_h}, {right, bottom}, {-half_w, bottom}};
+
+    // the first two columns of the rotation matrix from glRotatef() around x, y and z as the corners have no z
+    float rotation[3][2] = {{1.0f, 0.0f}, {0.0f, 1.0f}, {0.0f, 0.0f}};
+
+    if (m_rot_x != 0.0f || m_rot_y != 0.0f || m_rot_z != 0.0f) {
+        const float deg_to_rad = static_cast<float>(M_PI / 180.0);
+        const float sin_x = sin(m_rot_x * deg_to_rad);
+        const float cos_x = cos(m_rot_x * deg_to_rad);
+        const float sin_y = sin(m_rot_y * deg_to_rad);
+        const float cos_y = cos(m_rot_y * deg_to_rad);
+        const float sin_z = sin(m_rot_z * deg_to_rad);
+        const float cos_z = cos(m_rot_z * deg_to_rad);
+
+        // Rx * Ry * Rz
+        rotation[0][0] = cos_y * cos_z;
+        rotation[0][1] = -cos_y * sin_z;
+        rotation[1][0] = sin_x * sin_y * cos_z + cos_x * sin_z;
+        rotation[1][1] = -sin_x * sin_y * sin_z + cos_x * cos_z;
+        rotation[2][0] = -cos_x * sin_y * cos_z + sin_x * sin_z;
+        rotation[2][1] = cos_x * sin_y * sin_z + sin_x * cos_z;
+    }
+
+    const float global_x = m_global_scale ? global_upscalex : 1.0f;
+    const float global_y = m_global_scale ? global_upscaley : 1.0f;
+
+    for (unsigned int i = 0; i < 4; i++) {
+        const float x = corners[i][0];
+        const float y = corners[i][1];
+
+        vertices[i][0] = (final_pos_x + m_scale_x * (rotation[0][0] * x + rotation[0][1] * y)) * global_x;
+        vertices[i][1] = (final_pos_y + m_scale_y * (rotation[1][0] * x + rotation[1][1] * y)) * global_y;
+        vertices[i][2] = pos_z + m_scale_z * (rotation[2][0] * x + rotation[2][1] * y);
+    }
+}
+
+/* *** *** *** *** *** *** cTiled_Surface_Request *** *** *** *** *** *** *** *** *** *** *** */
+
+cTiled_Surface_Request::cTiled_Surface_Request(void)
+    : cSurface_Request()
+{
+    m_tex_x = 0.0f;
+    m_tex_y = 0.0f;
+    m_tex_repeat_w = 1.0f;
+    m_tex_repeat_h = 1.0f;
+    m_repeat_y = 1;
+}
+
+cTiled_Surface_Request::~cTiled_Surface_Request(void)
+{
+
+}
+
+void cTiled_Surface_Request::Draw(void)
+{
+    Render_Basic();
+
+    float final_pos_x = m_pos_x;
+    float final_pos_y = m_pos_y;
+
+    // set camera position
+    if (!m_no_camera) {
+        final_pos_x -= pActive_Camera->m_x;
+        final_pos_y -= pActive_Camera->m_y;
+    }
+
+    glTranslatef(final_pos_x, final_pos_y, m_pos_z);
+
+    Render_Advanced();
+
+    // color
+    if (m_color.red != 255 || m_color.green != 255 || m_color.blue != 255 || m_color.alpha != 255) {
+        glColor4ub(m_color.red, m_color.green, m_color.blue, m_color.alpha);
+    }
+
+    if (!glIsEnabled(GL_TEXTURE_2D)) {
+        glEnable(GL_TEXTURE_2D);
+    }
+
+    // only bind if not the same texture
+    if (last_bind_texture != m_texture_id) {
+        glBindTexture(GL_TEXTURE_2D, m_texture_id);
+        last_bind_texture = m_texture_id;
+    }
+
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+
+    // filtering would blend a single row with the opposite edge
+    if (m_repeat_y) {
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+    }
+
+    const float tex_right = m_tex_x + m_tex_repeat_w;
+    const float tex_bottom = m_tex_y + m_tex_repeat_h;
+
+    // rectangle
+    glBegin(GL_QUADS);
+    // top left
+    glTexCoord2f(m_tex_x, m_tex_y);
+    glVertex2f(0.0f, 0.0f);
+    // top right
+    glTexCoord2f(tex_right, m_tex_y);
+    glVertex2f(m_w, 0.0f);
+    // bottom right
+    glTexCoord2f(tex_right, tex_bottom);
+    glVertex2f(m_w, m_h);
+    // bottom left
+    glTexCoord2f(m_tex_x, tex_bottom);
+    glVertex2f(0.0f, m_h);
+    glEnd();
+
+    // other surfaces of the texture expect the default wrap mode from cVideo::Create_Texture()
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+
+    if (m_repeat_y) {
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    }
+
+    // clear color
+    if (m_color.red != 255 || m_color.green != 255 || m_color.blue != 255 || m_color.alpha != 255) {
+        glColor4f(1.0f, 1.0f, 1.0f, 1.0f);
+    }
+
+    Render_Advanced_Clear();
+    Render_Basic_Clear();
+}
+
+bool cTiled_Surface_Request::Add_To_Batch(cSprite_Batch& batch)
+{
+    return 0;
+}
+
 /* *** *** *** *** *** *** cRenderQueue *** *** *** *** *** *** *** *** *** *** *** */
 
 cRenderQueue::cRenderQueue(unsigned int reserve_items)
 {
     m_render_data.reserve(reserve_items);
+
+    m_opaque_count = 0;
+    m_translucent_count = 0;
+    m_opaque_area = 0.0f;
+    m_translucent_area = 0.0f;
 }
 
 cRenderQueue::~cRenderQueue(void)
@@ -676,6 +904,10 @@ void cRenderQueue::Add(cRender_Request* obj)
 
 /**
  * Executes all render requests collected via Add().
+ *
+ * Opaque surfaces are drawn first from front to back with blending
+ * disabled, so the depth test rejects the pixels they hide before they
+ * are textured. Everything else is drawn from back to front afterwards.
  */
 void cRenderQueue::Render(bool clear /* = 1 */)
 {
@@ -684,18 +916,90 @@ void cRenderQueue::Render(bool clear /* = 1 */)
     // reset last texture
     last_bind_texture = 0;
 
+    // surfaces are batched if the sprite program is available
+    cSprite_Batch* batch = pVideo->m_sprite_batch.Is_Active() ? &pVideo->m_sprite_batch : NULL;
+
+    m_opaque_count = 0;
+    m_translucent_count = 0;
+    m_opaque_area = 0.0f;
+    m_translucent_area = 0.0f;
+
+    // requests up to the last screen clear are drawn in order as the clear would remove the opaque ones
+    RenderList::iterator first = m_render_data.begin();
+
     for (RenderList::iterator itr = m_render_data.begin(); itr != m_render_data.end(); ++itr) {
-        cRender_Request* obj = (*itr);
+        if ((*itr)->m_type == REND_CLEAR) {
+            first = itr + 1;
+        }
+    }
 
-        obj->Draw();
-        obj->m_render_count--;
+    for (RenderList::iterator itr = m_render_data.begin(); itr != first; ++itr) {
+        Draw_Request(*itr, batch);
+    }
+
+    // opaque from front to back
+    glDisable(GL_BLEND);
+    // the first drawn of the same z position stays on top like it would without the depth test
+    glDepthFunc(GL_LESS);
+
+    for (RenderList::iterator itr = m_render_data.end(); itr != first;) {
+        --itr;
+
+        if ((*itr)->Is_Opaque()) {
+            Draw_Request(*itr, batch);
+        }
+    }
+
+    Flush_Batch(batch);
+    glDepthFunc(GL_LEQUAL);
+    glEnable(GL_BLEND);
+
+    // translucent from back to front
+    for (RenderList::iterator itr = first; itr != m_render_data.end(); ++itr) {
+        if (!(*itr)->Is_Opaque()) {
+            Draw_Request(*itr, batch);
+        }
     }
 
+    Flush_Batch(batch);
+
     if (clear) {
         Clear(0);
     }
 }
 
+void cRenderQueue::Draw_Request(cRender_Request* obj, cSprite_Batch* batch)
+{
+    if (game_debug && obj->m_type == REND_SURFACE) {
+        const cSurface_Request* surface = static_cast<const cSurface_Request*>(obj);
+
+        if (surface->Is_Opaque()) {
+            m_opaque_count++;
+            m_opaque_area += surface->Get_Screen_Area();
+        }
+        else {
+            m_translucent_count++;
+            m_translucent_area += surface->Get_Screen_Area();
+        }
+    }
+
+    if (!batch || !obj->Add_To_Batch(*batch)) {
+        // keep the order
+        Flush_Batch(batch);
+
+        obj->Draw();
+    }
+
+    obj->m_render_count--;
+}
+
+void cRenderQueue::Flush_Batch(cSprite_Batch* batch)
+{
+    if (batch && batch->Flush()) {
+        last_bind_texture = 0;
+    }
+}
+
 void cRenderQueue::Fake_Render(unsigned int amount /* = 1 */, bool clear /* = 1 */)
 {
     for (RenderList::iterator itr = m_render_data.begin(); itr != m_render_data.end(); ++itr) {
@@ -18,6 +18,7 @@
 #define TSC_RENDERER_HPP
 
 #include "../video/video.hpp"
+#include "../video/sprite_batch.hpp"
 #include "../core/math/line.hpp"
 #include "../core/math/rect.hpp"
 
@@ -45,6 +46,14 @@ namespace TSC {
 
         // draw
         virtual void Draw(void);
+        /* Add to the batch instead of drawing
+         * Returns 0 if it can't be batched and must be drawn with Draw().
+        */
+        virtual bool Add_To_Batch(cSprite_Batch& batch);
+        /* If it covers everything behind it and can be drawn without blending
+         * Opaque requests are drawn front to back before the others.
+        */
+        virtual bool Is_Opaque(void) const;
 
         // render type
         RenderType m_type;
@@ -65,6 +74,9 @@ namespace TSC {
 
         // draw
         virtual void Draw(void);
+
+        // clear color
+        Color m_color;
     };
 
     /* *** *** *** *** *** *** cRender_Request_Advanced *** *** *** *** *** *** *** *** *** *** *** */
@@ -199,6 +211,12 @@ namespace TSC {
 
         // Draw
         virtual void Draw(void);
+        // Add the shadow and surface quads
+        virtual bool Add_To_Batch(cSprite_Batch& batch);
+        // If the texture is opaque and drawn without shadow, translucent colour or blend function
+        virtual bool Is_Opaque(void) const;
+        // Area covered on the screen in pixels, rotation is not taken into account
+        float Get_Screen_Area(void) const;
 
         // texture id
         GLuint m_texture_id;
@@ -212,12 +230,47 @@ namespace TSC {
         // size
         float m_w;
         float m_h;
+        // part of the size covered by the texture, see cGL_Surface
+        float m_tex_cover_w;
+        float m_tex_cover_h;
 
         // color
         Color m_color;
+        // if every pixel of the texture has full alpha, see cGL_Surface
+        bool m_opaque;
 
         // delete texture after request finished
         bool m_delete_texture;
+
+    private:
+        // Transform the corners like Draw() with the fixed-function pipeline
+        void Get_Vertices(float pos_x, float pos_y, float pos_z, float vertices[4][3]) const;
+    };
+
+    /* *** *** *** *** *** *** cTiled_Surface_Request *** *** *** *** *** *** *** *** *** *** *** */
+
+    /* A texture repeated over the size as one quad with GL_REPEAT wrapping
+     * The texture must not be padded, see cGL_Surface::Blit_Tiled().
+     * Shadow, rotation and scale are not supported.
+    */
+    class cTiled_Surface_Request : public cSurface_Request {
+    public:
+        cTiled_Surface_Request(void);
+        virtual ~cTiled_Surface_Request(void);
+
+        // Draw
+        virtual void Draw(void);
+        // Not batched as the wrap mode is a texture state
+        virtual bool Add_To_Batch(cSprite_Batch& batch);
+
+        // texture coordinates of the top left corner
+        float m_tex_x;
+        float m_tex_y;
+        // texture repeats over the size
+        float m_tex_repeat_w;
+        float m_tex_repeat_h;
+        // if the texture also wraps vertically, else the edge is clamped
+        bool m_repeat_y;
     };
 
     /* *** *** *** *** *** *** cRenderQueue *** *** *** *** *** *** *** *** *** *** *** */
@@ -250,6 +303,13 @@ namespace TSC {
         // render data array
         RenderList m_render_data;
 
+        // surfaces drawn in the last Render(), only counted in debug mode
+        unsigned int m_opaque_count;
+        unsigned int m_translucent_count;
+        // screen pixels covered by them, more than the screen size is overdraw
+        float m_opaque_area;
+        float m_translucent_area;
+
         // Z position sort
         struct zpos_sort {
             bool operator()(const cRender_Request* a, const cRender_Request* b) const
@@ -257,6 +317,12 @@ namespace TSC {
                 return a->m_pos_z < b->m_pos_z;
             }
         };
+
+    private:
+        // Draw or add to the batch
+        void Draw_Request(cRender_Request* obj, cSprite_Batch* batch);
+        // Draw the batched requests
+        void Flush_Batch(cSprite_Batch* batch);
     };
 
     /* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
@@ -0,0 +1,407 @@
+/***************************************************************************
+ * screen_capture.cpp - Asynchronous screenshots and frame capturing
+ *
+ * Copyright © 2012-2020 The TSC Contributors
+ ***************************************************************************/
+/*
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <cstring>
+
+#include "../video/screen_capture.hpp"
+#include "../video/video.hpp"
+#include "../core/global_basic.hpp"
+#include "../core/property_helper.hpp"
+#include "../core/math/utilities.hpp"
+#include "../core/i18n.hpp"
+#include "../core/filesystem/filesystem.hpp"
+#include "../core/filesystem/resource_manager.hpp"
+#include "../gui/hud.hpp"
+
+using namespace std;
+
+namespace fs = boost::filesystem;
+
+/* The pixel buffer object functions are OpenGL 2.1 (or the
+ * ARB_pixel_buffer_object extension) and not exported by every
+ * platform's OpenGL library, so they are looked up at runtime. */
+#ifndef APIENTRY
+#define APIENTRY
+#endif
+#ifndef GL_PIXEL_PACK_BUFFER
+#define GL_PIXEL_PACK_BUFFER 0x88EB
+#endif
+#ifndef GL_STREAM_READ
+#define GL_STREAM_READ 0x88E1
+#endif
+#ifndef GL_READ_ONLY
+#define GL_READ_ONLY 0x88B8
+#endif
+
+typedef void (APIENTRY* TSC_GL_Gen_Buffers)(GLsizei n, GLuint* buffers);
+typedef void (APIENTRY* TSC_GL_Delete_Buffers)(GLsizei n, const GLuint* buffers);
+typedef void (APIENTRY* TSC_GL_Bind_Buffer)(GLenum target, GLuint buffer);
+typedef void (APIENTRY* TSC_GL_Buffer_Data)(GLenum target, ptrdiff_t size, const void* data, GLenum usage);
+typedef void* (APIENTRY* TSC_GL_Map_Buffer)(GLenum target, GLenum access);
+typedef GLboolean(APIENTRY* TSC_GL_Unmap_Buffer)(GLenum target);
+
+static TSC_GL_Gen_Buffers tsc_glGenBuffers = NULL;
+static TSC_GL_Delete_Buffers tsc_glDeleteBuffers = NULL;
+static TSC_GL_Bind_Buffer tsc_glBindBuffer = NULL;
+static TSC_GL_Buffer_Data tsc_glBufferData = NULL;
+static TSC_GL_Map_Buffer tsc_glMapBuffer = NULL;
+static TSC_GL_Unmap_Buffer tsc_glUnmapBuffer = NULL;
+
+// Maximum number of frames waiting for the worker during continuous capture
+static const size_t MAX_QUEUED_CAPTURE_FRAMES = 8;
+
+namespace TSC {
+
+/* *** *** *** *** *** *** *** cScreen_Capture *** *** *** *** *** *** *** *** *** *** */
+
+cScreen_Capture::cScreen_Capture(void)
+{
+    m_pbo_supported = 0;
+    m_pbo[0] = 0;
+    m_pbo[1] = 0;
+    m_pbo_index = 0;
+    m_pbo_job[0] = NULL;
+    m_pbo_job[1] = NULL;
+
+    m_width = 0;
+    m_height = 0;
+
+    m_screenshot_requested = 0;
+    m_screenshot_number = 0;
+
+    m_capturing = 0;
+    m_capture_interval = 1;
+    m_capture_ppm = 0;
+    m_capture_frame = 0;
+    m_captured_frames = 0;
+    m_skipped_frames = 0;
+
+    m_quit = 0;
+    m_thread = boost::thread(&cScreen_Capture::Worker, this);
+}
+
+cScreen_Capture::~cScreen_Capture(void)
+{
+    // the OpenGL context may already be gone, drop frames still in the pixel buffers
+    delete m_pbo_job[0];
+    delete m_pbo_job[1];
+
+    {
+        boost::lock_guard<boost::mutex> lock(m_mutex);
+        m_quit = 1;
+    }
+
+    m_jobs_changed.notify_all();
+    m_thread.join();
+}
+
+void cScreen_Capture::Init(unsigned int width, unsigned int height)
+{
+    // pending readbacks are for the old size
+    delete m_pbo_job[0];
+    delete m_pbo_job[1];
+    m_pbo_job[0] = NULL;
+    m_pbo_job[1] = NULL;
+
+    m_width = width;
+    m_height = height;
+
+    if (m_pbo_supported && m_pbo[0]) {
+        tsc_glDeleteBuffers(2, m_pbo);
+        m_pbo[0] = 0;
+        m_pbo[1] = 0;
+    }
+
+    tsc_glGenBuffers = reinterpret_cast<TSC_GL_Gen_Buffers>(sf::Context::getFunction("glGenBuffers"));
+    tsc_glDeleteBuffers = reinterpret_cast<TSC_GL_Delete_Buffers>(sf::Context::getFunction("glDeleteBuffers"));
+    tsc_glBindBuffer = reinterpret_cast<TSC_GL_Bind_Buffer>(sf::Context::getFunction("glBindBuffer"));
+    tsc_glBufferData = reinterpret_cast<TSC_GL_Buffer_Data>(sf::Context::getFunction("glBufferData"));
+    tsc_glMapBuffer = reinterpret_cast<TSC_GL_Map_Buffer>(sf::Context::getFunction("glMapBuffer"));
+    tsc_glUnmapBuffer = reinterpret_cast<TSC_GL_Unmap_Buffer>(sf::Context::getFunction("glUnmapBuffer"));
+
+    // cVideo::m_opengl_version is not yet known on the first call
+    const char* version = reinterpret_cast<const char*>(glGetString(GL_VERSION));
+    const char* extensions = reinterpret_cast<const char*>(glGetString(GL_EXTENSIONS));
+    float gl_version = version ? string_to_float(std::string(version).substr(0, 3)) : 0.0f;
+
+    m_pbo_supported = (gl_version >= 2.1f || (extensions && strstr(extensions, "GL_ARB_pixel_buffer_object"))) &&
+                      tsc_glGenBuffers && tsc_glDeleteBuffers && tsc_glBindBuffer && tsc_glBufferData && tsc_glMapBuffer && tsc_glUnmapBuffer;
+
+    if (!m_pbo_supported) {
+        debug_print("Pixel buffer objects not available, screenshots are read back synchronously\n");
+        return;
+    }
+
+    tsc_glGenBuffers(2, m_pbo);
+
+    for (unsigned int i = 0; i < 2; i++) {
+        tsc_glBindBuffer(GL_PIXEL_PACK_BUFFER, m_pbo[i]);
+        tsc_glBufferData(GL_PIXEL_PACK_BUFFER, m_width * m_height * 4, NULL, GL_STREAM_READ);
+    }
+
+    tsc_glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+}
+
+void cScreen_Capture::Request_Screenshot(void)
+{
+    // find the first free number only once instead of probing for every screenshot
+    if (!m_screenshot_number) {
+        m_screenshot_number = Next_Free_Number(pResource_Manager->Get_User_Screenshot_Directory(), "", ".png");
+    }
+
+    m_screenshot_requested = 1;
+}
+
+void cScreen_Capture::Start_Capture(unsigned int interval, bool ppm /* = 0 */)
+{
+    if (m_capturing) {
+        Stop_Capture();
+    }
+
+    fs::path screenshot_dir = pResource_Manager->Get_User_Screenshot_Directory();
+    m_capture_dir = screenshot_dir / utf8_to_path("capture_" + int_to_string(Next_Free_Number(screenshot_dir, "capture_", "")));
+
+    try {
+        fs::create_directories(m_capture_dir);
+    }
+    catch (const std::exception& ex) {
+        cerr << "Warning: Could not create capture directory " << path_to_utf8(m_capture_dir) << " : " << ex.what() << endl;
+        return;
+    }
+
+    m_capturing = 1;
+    m_capture_interval = interval > 0 ? interval : 1;
+    m_capture_ppm = ppm;
+    m_capture_frame = 0;
+    m_captured_frames = 0;
+    m_skipped_frames = 0;
+
+    cout << "Capturing every " << m_capture_interval << ". frame to " << path_to_utf8(m_capture_dir) << endl;
+}
+
+void cScreen_Capture::Stop_Capture(void)
+{
+    if (!m_capturing) {
+        return;
+    }
+
+    m_capturing = 0;
+    cout << "Captured " << m_captured_frames << " frames, skipped " << m_skipped_frames << " frames because writing was too slow" << endl;
+}
+
+bool cScreen_Capture::Is_Capturing(void) const
+{
+    return m_capturing;
+}
+
+void cScreen_Capture::Frame_Done(void)
+{
+    cJob* job = NULL;
+
+    if (m_screenshot_requested) {
+        job = new cJob();
+        job->m_filename = pResource_Manager->Get_User_Screenshot_Directory() / utf8_to_path(int_to_string(m_screenshot_number) + ".png");
+        job->m_ppm = 0;
+
+        // show info
+        gp_hud->Set_Text("Screenshot " + int_to_string(m_screenshot_number) + _(" saved"));
+
+        m_screenshot_number++;
+        m_screenshot_requested = 0;
+    }
+    else if (m_capturing && m_capture_frame++ % m_capture_interval == 0) {
+        size_t queued;
+        {
+            boost::lock_guard<boost::mutex> lock(m_mutex);
+            queued = m_jobs.size();
+        }
+
+        // writing can't keep up
+        if (queued >= MAX_QUEUED_CAPTURE_FRAMES) {
+            m_skipped_frames++;
+        }
+        else {
+            char filename[32];
+            snprintf(filename, sizeof(filename), "frame_%06u.%s", m_capture_frame - 1, m_capture_ppm ? "ppm" : "png");
+
+            job = new cJob();
+            job->m_filename = m_capture_dir / utf8_to_path(filename);
+            job->m_ppm = m_capture_ppm;
+            m_captured_frames++;
+        }
+    }
+
+    if (job) {
+        job->m_width = m_width;
+        job->m_height = m_height;
+        Start_Readback(job);
+    }
+
+    if (m_pbo_supported) {
+        m_pbo_index = 1 - m_pbo_index;
+        Finish_Readback();
+    }
+}
+
+void cScreen_Capture::Start_Readback(cJob* job)
+{
+    // read RGBA, rows are always 4 byte aligned then
+    glPixelStorei(GL_PACK_ALIGNMENT, 4);
+
+    if (!m_pbo_supported) {
+        job->m_data.resize(m_width * m_height * 4);
+        glReadPixels(0, 0, m_width, m_height, GL_RGBA, GL_UNSIGNED_BYTE, static_cast<GLvoid*>(job->m_data.data()));
+        Queue_Job(job);
+        return;
+    }
+
+    // returns immediately, the copy happens while the next frame is drawn
+    tsc_glBindBuffer(GL_PIXEL_PACK_BUFFER, m_pbo[m_pbo_index]);
+    glReadPixels(0, 0, m_width, m_height, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+    tsc_glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    m_pbo_job[m_pbo_index] = job;
+}
+
+void cScreen_Capture::Finish_Readback(void)
+{
+    cJob* job = m_pbo_job[m_pbo_index];
+
+    if (!job) {
+        return;
+    }
+
+    m_pbo_job[m_pbo_index] = NULL;
+
+    tsc_glBindBuffer(GL_PIXEL_PACK_BUFFER, m_pbo[m_pbo_index]);
+    const unsigned char* pixels = static_cast<const unsigned char*>(tsc_glMapBuffer(GL_PIXEL_PACK_BUFFER, GL_READ_ONLY));
+
+    if (pixels) {
+        job->m_data.assign(pixels, pixels + job->m_width * job->m_height * 4);
+        tsc_glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+    }
+
+    tsc_glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    if (!pixels) {
+        cerr << "Warning: Could not map pixel buffer for " << path_to_utf8(job->m_filename) << endl;
+        delete job;
+        return;
+    }
+
+    Queue_Job(job);
+}
+
+void cScreen_Capture::Queue_Job(cJob* job)
+{
+    {
+        boost::lock_guard<boost::mutex> lock(m_mutex);
+        m_jobs.push_back(job);
+    }
+
+    m_jobs_changed.notify_all();
+}
+
+void cScreen_Capture::Worker(void)
+{
+    boost::unique_lock<boost::mutex> lock(m_mutex);
+
+    while (true) {
+        while (m_jobs.empty() && !m_quit) {
+            m_jobs_changed.wait(lock);
+        }
+
+        // write everything queued before quitting
+        if (m_jobs.empty()) {
+            return;
+        }
+
+        cJob* job = m_jobs.front();
+        m_jobs.pop_front();
+
+        lock.unlock();
+        Write_Job(job);
+        delete job;
+        lock.lock();
+    }
+}
+
+void cScreen_Capture::Write_Job(const cJob* job)
+{
+    unsigned int pixel_count = job->m_width * job->m_height;
+
+    // the alpha channel of the framebuffer is meaningless
+    std::vector<unsigned char> rgb(pixel_count * 3);
+
+    for (unsigned int i = 0; i < pixel_count; i++) {
+        rgb[i * 3] = job->m_data[i * 4];
+        rgb[i * 3 + 1] = job->m_data[i * 4 + 1];
+        rgb[i * 3 + 2] = job->m_data[i * 4 + 2];
+    }
+
+    if (!job->m_ppm) {
+        pVideo->Save_Surface(job->m_filename, rgb.data(), job->m_width, job->m_height, 3, 1);
+        return;
+    }
+
+    fs::ofstream ofs(job->m_filename, ios::out | ios::binary | ios::trunc);
+
+    if (!ofs) {
+        cerr << "Warning: Could not create file " << path_to_utf8(job->m_filename) << " for writing" << endl;
+        return;
+    }
+
+    ofs << "P6\n" << job->m_width << " " << job->m_height << "\n255\n";
+
+    // reverse direction because of opengl glReadPixels
+    for (unsigned int row = job->m_height; row > 0; row--) {
+        ofs.write(reinterpret_cast<const char*>(rgb.data() + (row - 1) * job->m_width * 3), job->m_width * 3);
+    }
+}
+
+unsigned int cScreen_Capture::Next_Free_Number(const fs::path& dir, const std::string& prefix, const std::string& suffix)
+{
+    unsigned int number = 1;
+
+    if (!Dir_Exists(dir)) {
+        return number;
+    }
+
+    for (fs::directory_iterator itr(dir); itr != fs::directory_iterator(); ++itr) {
+        std::string name = path_to_utf8(itr->path().filename());
+
+        if (name.length() <= prefix.length() + suffix.length() || name.compare(0, prefix.length(), prefix) != 0 || name.compare(name.length() - suffix.length(), suffix.length(), suffix) != 0) {
+            continue;
+        }
+
+        std::string digits = name.substr(prefix.length(), name.length() - prefix.length() - suffix.length());
+
+        if (!Is_Valid_Number(digits)) {
+            continue;
+        }
+
+        int found = string_to_int(digits);
+
+        if (found >= static_cast<int>(number)) {
+            number = found + 1;
+        }
+    }
+
+    return number;
+}
+
+/* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
+
+} // namespace TSC
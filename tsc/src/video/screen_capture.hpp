@@ -0,0 +1,123 @@
+/***************************************************************************
+ * screen_capture.hpp - Asynchronous screenshots and frame capturing
+ *
+ * Copyright © 2012-2020 The TSC Contributors
+ ***************************************************************************/
+/*
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef TSC_SCREEN_CAPTURE_HPP
+#define TSC_SCREEN_CAPTURE_HPP
+
+#include "../core/global_basic.hpp"
+#include <deque>
+#include <boost/thread/condition_variable.hpp>
+
+namespace TSC {
+
+    /* *** *** *** *** *** *** *** cScreen_Capture *** *** *** *** *** *** *** *** *** *** */
+
+    /* Copies rendered frames to disk without stalling the game.
+     *
+     * Frames are read back into one of two pixel buffer objects. The
+     * transfer runs while the next frame is drawn, and the buffer is
+     * only mapped one frame later. If pixel buffer objects are not
+     * available, glReadPixels() is called directly as before. Either
+     * way, encoding and writing the file happens on a worker thread.
+     *
+     * Besides single screenshots, every Nth frame can be captured
+     * continuously into numbered files, e.g. for recording benchmark
+     * runs. If the worker can't keep up, frames are skipped rather than
+     * slowing the game down.
+     */
+    class cScreen_Capture {
+    public:
+        cScreen_Capture(void);
+        ~cScreen_Capture(void);
+
+        /* (Re)create the OpenGL resources for the given screen size.
+         * The OpenGL context must be current. */
+        void Init(unsigned int width, unsigned int height);
+
+        // Save the next rendered frame as screenshot
+        void Request_Screenshot(void);
+        /* Save every `interval'th frame into a new directory below the
+         * screenshot directory. If `ppm' is set, frames are written as
+         * uncompressed binary PPM instead of PNG, which is much faster. */
+        void Start_Capture(unsigned int interval, bool ppm = 0);
+        void Stop_Capture(void);
+        bool Is_Capturing(void) const;
+
+        /* Call once per frame after everything is drawn, but before
+         * the buffers are swapped. */
+        void Frame_Done(void);
+
+    private:
+        struct cJob {
+            boost::filesystem::path m_filename;
+            std::vector<unsigned char> m_data;
+            unsigned int m_width;
+            unsigned int m_height;
+            bool m_ppm;
+        };
+
+        // Start reading the current frame
+        void Start_Readback(cJob* job);
+        // Get the data of the frame started in the previous call to Frame_Done()
+        void Finish_Readback(void);
+        // Give a job with data to the worker
+        void Queue_Job(cJob* job);
+        // Worker thread function
+        void Worker(void);
+        // Write the RGBA data of a job to disk
+        static void Write_Job(const cJob* job);
+
+        // Next free number in `dir' for files/directories named `prefix' `number' `suffix'
+        static unsigned int Next_Free_Number(const boost::filesystem::path& dir, const std::string& prefix, const std::string& suffix);
+
+        // Whether the pixel buffer functions are available
+        bool m_pbo_supported;
+        // pixel buffer objects
+        GLuint m_pbo[2];
+        // pixel buffer written to in the current frame
+        unsigned int m_pbo_index;
+        // jobs waiting for their pixel buffer
+        cJob* m_pbo_job[2];
+
+        unsigned int m_width;
+        unsigned int m_height;
+
+        // single screenshot requested
+        bool m_screenshot_requested;
+        // next screenshot number
+        unsigned int m_screenshot_number;
+
+        // continuous capture
+        bool m_capturing;
+        unsigned int m_capture_interval;
+        bool m_capture_ppm;
+        boost::filesystem::path m_capture_dir;
+        unsigned int m_capture_frame;
+        unsigned int m_captured_frames;
+        unsigned int m_skipped_frames;
+
+        // worker
+        std::deque<cJob*> m_jobs;
+        bool m_quit;
+        boost::mutex m_mutex;
+        boost::condition_variable m_jobs_changed;
+        boost::thread m_thread;
+    };
+
+    /* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
+
+} // namespace TSC
+
+#endif
@@ -0,0 +1,388 @@
+/***************************************************************************
+ * sprite_batch.cpp - batched sprite drawing with a GLSL program
+ *
+ * Copyright © 2012-2020 The TSC Contributors
+ ***************************************************************************/
+/*
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "../video/sprite_batch.hpp"
+#include "../core/math/utilities.hpp"
+#include "../core/global_basic.hpp"
+
+using namespace std;
+
+/* The shader functions are OpenGL 2.0 and not exported by every
+ * platform's OpenGL library, so they are looked up at runtime. */
+#ifndef APIENTRY
+#define APIENTRY
+#endif
+#ifndef GL_FRAGMENT_SHADER
+#define GL_FRAGMENT_SHADER 0x8B30
+#endif
+#ifndef GL_VERTEX_SHADER
+#define GL_VERTEX_SHADER 0x8B31
+#endif
+#ifndef GL_COMPILE_STATUS
+#define GL_COMPILE_STATUS 0x8B81
+#endif
+#ifndef GL_LINK_STATUS
+#define GL_LINK_STATUS 0x8B82
+#endif
+
+typedef GLuint (APIENTRY* TSC_GL_Create_Shader)(GLenum type);
+typedef void (APIENTRY* TSC_GL_Shader_Source)(GLuint shader, GLsizei count, const char* const* string, const GLint* length);
+typedef void (APIENTRY* TSC_GL_Compile_Shader)(GLuint shader);
+typedef void (APIENTRY* TSC_GL_Get_Shader_Iv)(GLuint shader, GLenum pname, GLint* params);
+typedef void (APIENTRY* TSC_GL_Get_Shader_Info_Log)(GLuint shader, GLsizei max_length, GLsizei* length, char* info_log);
+typedef void (APIENTRY* TSC_GL_Delete_Shader)(GLuint shader);
+typedef GLuint (APIENTRY* TSC_GL_Create_Program)(void);
+typedef void (APIENTRY* TSC_GL_Attach_Shader)(GLuint program, GLuint shader);
+typedef void (APIENTRY* TSC_GL_Link_Program)(GLuint program);
+typedef void (APIENTRY* TSC_GL_Get_Program_Iv)(GLuint program, GLenum pname, GLint* params);
+typedef void (APIENTRY* TSC_GL_Get_Program_Info_Log)(GLuint program, GLsizei max_length, GLsizei* length, char* info_log);
+typedef void (APIENTRY* TSC_GL_Delete_Program)(GLuint program);
+typedef void (APIENTRY* TSC_GL_Use_Program)(GLuint program);
+typedef GLint (APIENTRY* TSC_GL_Get_Attrib_Location)(GLuint program, const char* name);
+typedef GLint (APIENTRY* TSC_GL_Get_Uniform_Location)(GLuint program, const char* name);
+typedef void (APIENTRY* TSC_GL_Uniform_1i)(GLint location, GLint v0);
+typedef void (APIENTRY* TSC_GL_Enable_Vertex_Attrib_Array)(GLuint index);
+typedef void (APIENTRY* TSC_GL_Disable_Vertex_Attrib_Array)(GLuint index);
+typedef void (APIENTRY* TSC_GL_Vertex_Attrib_Pointer)(GLuint index, GLint size, GLenum type, GLboolean normalized, GLsizei stride, const void* pointer);
+
+static TSC_GL_Create_Shader tsc_glCreateShader = NULL;
+static TSC_GL_Shader_Source tsc_glShaderSource = NULL;
+static TSC_GL_Compile_Shader tsc_glCompileShader = NULL;
+static TSC_GL_Get_Shader_Iv tsc_glGetShaderiv = NULL;
+static TSC_GL_Get_Shader_Info_Log tsc_glGetShaderInfoLog = NULL;
+static TSC_GL_Delete_Shader tsc_glDeleteShader = NULL;
+static TSC_GL_Create_Program tsc_glCreateProgram = NULL;
+static TSC_GL_Attach_Shader tsc_glAttachShader = NULL;
+static TSC_GL_Link_Program tsc_glLinkProgram = NULL;
+static TSC_GL_Get_Program_Iv tsc_glGetProgramiv = NULL;
+static TSC_GL_Get_Program_Info_Log tsc_glGetProgramInfoLog = NULL;
+static TSC_GL_Delete_Program tsc_glDeleteProgram = NULL;
+static TSC_GL_Use_Program tsc_glUseProgram = NULL;
+static TSC_GL_Get_Attrib_Location tsc_glGetAttribLocation = NULL;
+static TSC_GL_Get_Uniform_Location tsc_glGetUniformLocation = NULL;
+static TSC_GL_Uniform_1i tsc_glUniform1i = NULL;
+static TSC_GL_Enable_Vertex_Attrib_Array tsc_glEnableVertexAttribArray = NULL;
+static TSC_GL_Disable_Vertex_Attrib_Array tsc_glDisableVertexAttribArray = NULL;
+static TSC_GL_Vertex_Attrib_Pointer tsc_glVertexAttribPointer = NULL;
+
+/* The transformation and colour are the same as with the fixed-function
+ * pipeline, the combine attribute holds the GL_TEXTURE_ENV_COLOR and the
+ * combine mode. Alpha is always texture alpha times vertex alpha and the
+ * alpha test still applies after the fragment shader.
+*/
+static const char* sprite_vertex_shader =
+    "#version 120\n"
+    "attribute vec4 combine;\n"
+    "varying vec4 v_combine;\n"
+    "void main()\n"
+    "{\n"
+    "    gl_Position = gl_ModelViewProjectionMatrix * gl_Vertex;\n"
+    "    gl_TexCoord[0] = gl_MultiTexCoord0;\n"
+    "    gl_FrontColor = gl_Color;\n"
+    "    v_combine = combine;\n"
+    "}\n";
+
+static const char* sprite_fragment_shader =
+    "#version 120\n"
+    "uniform sampler2D sprite_texture;\n"
+    "varying vec4 v_combine;\n"
+    "void main()\n"
+    "{\n"
+    "    vec4 texel = texture2D(sprite_texture, gl_TexCoord[0].st);\n"
+    "    vec3 rgb;\n"
+    // no combine : GL_MODULATE with the vertex colour
+    "    if (v_combine.a < 0.5) {\n"
+    "        rgb = texel.rgb * gl_Color.rgb;\n"
+    "    }\n"
+    // GL_REPLACE
+    "    else if (v_combine.a < 1.5) {\n"
+    "        rgb = v_combine.rgb;\n"
+    "    }\n"
+    // GL_ADD
+    "    else if (v_combine.a < 2.5) {\n"
+    "        rgb = min(v_combine.rgb + texel.rgb, 1.0);\n"
+    "    }\n"
+    // GL_MODULATE
+    "    else {\n"
+    "        rgb = v_combine.rgb * texel.rgb;\n"
+    "    }\n"
+    "    gl_FragColor = vec4(rgb, texel.a * gl_Color.a);\n"
+    "}\n";
+
+namespace TSC {
+
+/* *** *** *** *** *** *** *** cSprite_Batch *** *** *** *** *** *** *** *** *** *** */
+
+// Quads drawn at once at most
+static const size_t SPRITE_BATCH_MAX_QUADS = 4096;
+
+// Compile a shader and print the log if it failed
+static GLuint Compile_Shader(GLenum type, const char* source)
+{
+    GLuint shader = tsc_glCreateShader(type);
+    tsc_glShaderSource(shader, 1, &source, NULL);
+    tsc_glCompileShader(shader);
+
+    GLint status = 0;
+    tsc_glGetShaderiv(shader, GL_COMPILE_STATUS, &status);
+
+    if (!status) {
+        char log[1024];
+        tsc_glGetShaderInfoLog(shader, sizeof(log), NULL, log);
+        cerr << "Warning : Sprite shader compilation failed : " << log << endl;
+
+        tsc_glDeleteShader(shader);
+        return 0;
+    }
+
+    return shader;
+}
+
+cSprite_Batch::cSprite_Batch(void)
+{
+    m_texture = 0;
+    m_blend_sfactor = GL_SRC_ALPHA;
+    m_blend_dfactor = GL_ONE_MINUS_SRC_ALPHA;
+
+    m_program = 0;
+    m_combine_location = -1;
+
+    m_quads = 0;
+    m_draw_calls = 0;
+    m_last_quads = 0;
+    m_last_draw_calls = 0;
+
+    m_vertices.reserve(SPRITE_BATCH_MAX_QUADS * 4);
+}
+
+cSprite_Batch::~cSprite_Batch(void)
+{
+    // the program is destroyed with the OpenGL context
+}
+
+bool cSprite_Batch::Init(bool enabled /* = 1 */)
+{
+    m_program = 0;
+    m_vertices.clear();
+
+    if (!enabled) {
+        debug_print("Sprite program disabled, using the fixed-function pipeline\n");
+        return 0;
+    }
+
+    const char* version = reinterpret_cast<const char*>(glGetString(GL_VERSION));
+
+    if (!version || atoi(version) < 2) {
+        debug_print("Sprite program needs OpenGL 2.0, using the fixed-function pipeline\n");
+        return 0;
+    }
+
+    tsc_glCreateShader = reinterpret_cast<TSC_GL_Create_Shader>(sf::Context::getFunction("glCreateShader"));
+    tsc_glShaderSource = reinterpret_cast<TSC_GL_Shader_Source>(sf::Context::getFunction("glShaderSource"));
+    tsc_glCompileShader = reinterpret_cast<TSC_GL_Compile_Shader>(sf::Context::getFunction("glCompileShader"));
+    tsc_glGetShaderiv = reinterpret_cast<TSC_GL_Get_Shader_Iv>(sf::Context::getFunction("glGetShaderiv"));
+    tsc_glGetShaderInfoLog = reinterpret_cast<TSC_GL_Get_Shader_Info_Log>(sf::Context::getFunction("glGetShaderInfoLog"));
+    tsc_glDeleteShader = reinterpret_cast<TSC_GL_Delete_Shader>(sf::Context::getFunction("glDeleteShader"));
+    tsc_glCreateProgram = reinterpret_cast<TSC_GL_Create_Program>(sf::Context::getFunction("glCreateProgram"));
+    tsc_glAttachShader = reinterpret_cast<TSC_GL_Attach_Shader>(sf::Context::getFunction("glAttachShader"));
+    tsc_glLinkProgram = reinterpret_cast<TSC_GL_Link_Program>(sf::Context::getFunction("glLinkProgram"));
+    tsc_glGetProgramiv = reinterpret_cast<TSC_GL_Get_Program_Iv>(sf::Context::getFunction("glGetProgramiv"));
+    tsc_glGetProgramInfoLog = reinterpret_cast<TSC_GL_Get_Program_Info_Log>(sf::Context::getFunction("glGetProgramInfoLog"));
+    tsc_glDeleteProgram = reinterpret_cast<TSC_GL_Delete_Program>(sf::Context::getFunction("glDeleteProgram"));
+    tsc_glUseProgram = reinterpret_cast<TSC_GL_Use_Program>(sf::Context::getFunction("glUseProgram"));
+    tsc_glGetAttribLocation = reinterpret_cast<TSC_GL_Get_Attrib_Location>(sf::Context::getFunction("glGetAttribLocation"));
+    tsc_glGetUniformLocation = reinterpret_cast<TSC_GL_Get_Uniform_Location>(sf::Context::getFunction("glGetUniformLocation"));
+    tsc_glUniform1i = reinterpret_cast<TSC_GL_Uniform_1i>(sf::Context::getFunction("glUniform1i"));
+    tsc_glEnableVertexAttribArray = reinterpret_cast<TSC_GL_Enable_Vertex_Attrib_Array>(sf::Context::getFunction("glEnableVertexAttribArray"));
+    tsc_glDisableVertexAttribArray = reinterpret_cast<TSC_GL_Disable_Vertex_Attrib_Array>(sf::Context::getFunction("glDisableVertexAttribArray"));
+    tsc_glVertexAttribPointer = reinterpret_cast<TSC_GL_Vertex_Attrib_Pointer>(sf::Context::getFunction("glVertexAttribPointer"));
+
+    if (!tsc_glCreateShader || !tsc_glShaderSource || !tsc_glCompileShader || !tsc_glGetShaderiv || !tsc_glGetShaderInfoLog || !tsc_glDeleteShader
+        || !tsc_glCreateProgram || !tsc_glAttachShader || !tsc_glLinkProgram || !tsc_glGetProgramiv || !tsc_glGetProgramInfoLog || !tsc_glDeleteProgram
+        || !tsc_glUseProgram || !tsc_glGetAttribLocation || !tsc_glGetUniformLocation || !tsc_glUniform1i
+        || !tsc_glEnableVertexAttribArray || !tsc_glDisableVertexAttribArray || !tsc_glVertexAttribPointer) {
+        cerr << "Warning : OpenGL 2.0 shader functions not found, using the fixed-function pipeline" << endl;
+        return 0;
+    }
+
+    GLuint vertex_shader = Compile_Shader(GL_VERTEX_SHADER, sprite_vertex_shader);
+    GLuint fragment_shader = Compile_Shader(GL_FRAGMENT_SHADER, sprite_fragment_shader);
+
+    if (!vertex_shader || !fragment_shader) {
+        if (vertex_shader) {
+            tsc_glDeleteShader(vertex_shader);
+        }
+        if (fragment_shader) {
+            tsc_glDeleteShader(fragment_shader);
+        }
+
+        return 0;
+    }
+
+    GLuint program = tsc_glCreateProgram();
+    tsc_glAttachShader(program, vertex_shader);
+    tsc_glAttachShader(program, fragment_shader);
+    tsc_glLinkProgram(program);
+
+    // deleted with the program
+    tsc_glDeleteShader(vertex_shader);
+    tsc_glDeleteShader(fragment_shader);
+
+    GLint status = 0;
+    tsc_glGetProgramiv(program, GL_LINK_STATUS, &status);
+
+    if (!status) {
+        char log[1024];
+        tsc_glGetProgramInfoLog(program, sizeof(log), NULL, log);
+        cerr << "Warning : Sprite program linking failed : " << log << endl;
+
+        tsc_glDeleteProgram(program);
+        return 0;
+    }
+
+    m_combine_location = tsc_glGetAttribLocation(program, "combine");
+
+    if (m_combine_location < 0) {
+        cerr << "Warning : Sprite program has no combine attribute" << endl;
+        tsc_glDeleteProgram(program);
+        return 0;
+    }
+
+    tsc_glUseProgram(program);
+    tsc_glUniform1i(tsc_glGetUniformLocation(program, "sprite_texture"), 0);
+    tsc_glUseProgram(0);
+
+    m_program = program;
+    debug_print("Sprite program enabled\n");
+
+    return 1;
+}
+
+bool cSprite_Batch::Is_Supported_Combine(GLint combine_type)
+{
+    return combine_type == 0 || combine_type == GL_REPLACE || combine_type == GL_ADD || combine_type == GL_MODULATE;
+}
+
+void cSprite_Batch::Add_Quad(GLuint texture, GLenum blend_sfactor, GLenum blend_dfactor, const float vertices[4][3], const Color& color, GLint combine_type, const float combine_color[3])
+{
+    if (texture != m_texture || blend_sfactor != m_blend_sfactor || blend_dfactor != m_blend_dfactor || m_vertices.size() >= SPRITE_BATCH_MAX_QUADS * 4) {
+        Flush();
+
+        m_texture = texture;
+        m_blend_sfactor = blend_sfactor;
+        m_blend_dfactor = blend_dfactor;
+    }
+
+    static const float tex_coords[4][2] = {{0.0f, 0.0f}, {1.0f, 0.0f}, {1.0f, 1.0f}, {0.0f, 1.0f}};
+
+    float mode = 0.0f;
+
+    if (combine_type == GL_REPLACE) {
+        mode = 1.0f;
+    }
+    else if (combine_type == GL_ADD) {
+        mode = 2.0f;
+    }
+    else if (combine_type == GL_MODULATE) {
+        mode = 3.0f;
+    }
+
+    for (unsigned int i = 0; i < 4; i++) {
+        cVertex vertex;
+
+        vertex.m_x = vertices[i][0];
+        vertex.m_y = vertices[i][1];
+        vertex.m_z = vertices[i][2];
+        vertex.m_u = tex_coords[i][0];
+        vertex.m_v = tex_coords[i][1];
+        vertex.m_color[0] = color.red;
+        vertex.m_color[1] = color.green;
+        vertex.m_color[2] = color.blue;
+        vertex.m_color[3] = color.alpha;
+
+        // the texture environment colour is clamped as well
+        for (unsigned int c = 0; c < 3; c++) {
+            vertex.m_combine[c] = mode ? Clamp(combine_color[c], 0.0f, 1.0f) : 0.0f;
+        }
+
+        vertex.m_combine[3] = mode;
+
+        m_vertices.push_back(vertex);
+    }
+
+    m_quads++;
+}
+
+bool cSprite_Batch::Flush(void)
+{
+    if (m_vertices.empty()) {
+        return 0;
+    }
+
+    // the vertices are already transformed
+    glLoadIdentity();
+
+    if (m_blend_sfactor != GL_SRC_ALPHA || m_blend_dfactor != GL_ONE_MINUS_SRC_ALPHA) {
+        glBlendFunc(m_blend_sfactor, m_blend_dfactor);
+    }
+
+    glBindTexture(GL_TEXTURE_2D, m_texture);
+    tsc_glUseProgram(m_program);
+
+    const cVertex* data = &m_vertices[0];
+
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+    glEnableClientState(GL_COLOR_ARRAY);
+    tsc_glEnableVertexAttribArray(m_combine_location);
+
+    glVertexPointer(3, GL_FLOAT, sizeof(cVertex), &data->m_x);
+    glTexCoordPointer(2, GL_FLOAT, sizeof(cVertex), &data->m_u);
+    glColorPointer(4, GL_UNSIGNED_BYTE, sizeof(cVertex), data->m_color);
+    tsc_glVertexAttribPointer(m_combine_location, 4, GL_FLOAT, GL_FALSE, sizeof(cVertex), data->m_combine);
+
+    glDrawArrays(GL_QUADS, 0, static_cast<GLsizei>(m_vertices.size()));
+
+    tsc_glDisableVertexAttribArray(m_combine_location);
+    glDisableClientState(GL_COLOR_ARRAY);
+    glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+    glDisableClientState(GL_VERTEX_ARRAY);
+
+    tsc_glUseProgram(0);
+
+    // the current colour is undefined after using a colour array
+    glColor4f(1.0f, 1.0f, 1.0f, 1.0f);
+
+    if (m_blend_sfactor != GL_SRC_ALPHA || m_blend_dfactor != GL_ONE_MINUS_SRC_ALPHA) {
+        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    }
+
+    m_vertices.clear();
+    m_draw_calls++;
+
+    return 1;
+}
+
+void cSprite_Batch::Next_Frame(void)
+{
+    m_last_quads = m_quads;
+    m_last_draw_calls = m_draw_calls;
+    m_quads = 0;
+    m_draw_calls = 0;
+}
+
+/* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
+
+} // namespace TSC
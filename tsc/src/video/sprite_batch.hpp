@@ -0,0 +1,115 @@
+/***************************************************************************
+ * sprite_batch.hpp - batched sprite drawing with a GLSL program
+ *
+ * Copyright © 2012-2020 The TSC Contributors
+ ***************************************************************************/
+/*
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef TSC_SPRITE_BATCH_HPP
+#define TSC_SPRITE_BATCH_HPP
+
+#include "../core/global_basic.hpp"
+#include "../video/color.hpp"
+
+namespace TSC {
+
+    /* *** *** *** *** *** *** *** cSprite_Batch *** *** *** *** *** *** *** *** *** *** */
+
+    /* Collects textured quads and draws them with one glDrawArrays() call.
+     *
+     * The vertices are transformed on the CPU and the colour combine
+     * (GL_REPLACE, GL_ADD or GL_MODULATE with a constant colour like the
+     * fixed-function GL_COMBINE texture environment) is a vertex attribute
+     * of a GLSL 1.20 program. Quads with different rotations, colours,
+     * combine modes and shadows therefore end up in the same batch, which
+     * is only drawn when the texture or the blend function changes.
+     *
+     * Without OpenGL 2.0 the program is not available and the render
+     * requests draw themselves with the fixed-function pipeline as before.
+     */
+    class cSprite_Batch {
+    public:
+        cSprite_Batch(void);
+        ~cSprite_Batch(void);
+
+        /* Create the program for the current OpenGL context.
+         * The program of a previous context is not deleted as it was destroyed with it.
+         * enabled : if not set the fixed-function pipeline is used
+         * Returns 0 if the program is not used.
+        */
+        bool Init(bool enabled = 1);
+
+        // If the program is used
+        bool Is_Active(void) const
+        {
+            return m_program != 0;
+        }
+
+        // If the combine type can be drawn by the program
+        static bool Is_Supported_Combine(GLint combine_type);
+
+        /* Add a quad, drawing the previous ones if the texture or the blend function changes.
+         * vertices : x, y and z of the top left, top right, bottom right and bottom left corner
+         * combine_type : 0, GL_REPLACE, GL_ADD or GL_MODULATE
+        */
+        void Add_Quad(GLuint texture, GLenum blend_sfactor, GLenum blend_dfactor, const float vertices[4][3], const Color& color, GLint combine_type, const float combine_color[3]);
+
+        /* Draw the added quads
+         * Returns 0 if there was nothing to draw.
+         * Leaves the texture bound and the fixed-function pipeline active.
+        */
+        bool Flush(void);
+
+        // Call once per frame to update the statistics
+        void Next_Frame(void);
+        // Quads drawn in the last frame
+        unsigned int Get_Quad_Count(void) const
+        {
+            return m_last_quads;
+        }
+        // Draw calls in the last frame
+        unsigned int Get_Draw_Calls(void) const
+        {
+            return m_last_draw_calls;
+        }
+
+    private:
+        struct cVertex {
+            float m_x;
+            float m_y;
+            float m_z;
+            float m_u;
+            float m_v;
+            uint8_t m_color[4];
+            // combine colour and mode
+            float m_combine[4];
+        };
+
+        std::vector<cVertex> m_vertices;
+        // state of the added quads
+        GLuint m_texture;
+        GLenum m_blend_sfactor;
+        GLenum m_blend_dfactor;
+
+        GLuint m_program;
+        GLint m_combine_location;
+
+        unsigned int m_quads;
+        unsigned int m_draw_calls;
+        unsigned int m_last_quads;
+        unsigned int m_last_draw_calls;
+    };
+
+    /* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
+
+} // namespace TSC
+
+#endif
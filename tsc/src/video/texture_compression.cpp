@@ -0,0 +1,399 @@
+/***************************************************************************
+ * texture_compression.cpp - S3TC texture compression for the image cache
+ *
+ * Copyright © 2012-2020 The TSC Contributors
+ ***************************************************************************/
+/*
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "../video/texture_compression.hpp"
+#include "../core/math/utilities.hpp"
+#include "../core/global_basic.hpp"
+
+using namespace std;
+
+namespace TSC {
+
+/* *** *** *** *** *** *** *** BC3 *** *** *** *** *** *** *** *** *** *** */
+
+static const unsigned int BC3_BLOCK_BYTES = 16;
+
+size_t Get_BC3_Size(unsigned int width, unsigned int height)
+{
+    return static_cast<size_t>((width + 3) / 4) * ((height + 3) / 4) * BC3_BLOCK_BYTES;
+}
+
+// Copy the 4x4 pixels at the block position, pixels outside the image repeat the edge
+static void Get_Block(const unsigned char* pixels, unsigned int width, unsigned int height, unsigned int block_x, unsigned int block_y, unsigned char block[64])
+{
+    for (unsigned int y = 0; y < 4; y++) {
+        unsigned int src_y = std::min(block_y * 4 + y, height - 1);
+
+        for (unsigned int x = 0; x < 4; x++) {
+            unsigned int src_x = std::min(block_x * 4 + x, width - 1);
+            memcpy(block + (y * 4 + x) * 4, pixels + (static_cast<size_t>(src_y) * width + src_x) * 4, 4);
+        }
+    }
+}
+
+// The 8 alpha values of a block, the last 6 are interpolated
+static void Get_Alpha_Palette(unsigned int alpha0, unsigned int alpha1, unsigned int palette[8])
+{
+    palette[0] = alpha0;
+    palette[1] = alpha1;
+
+    if (alpha0 > alpha1) {
+        for (unsigned int i = 2; i < 8; i++) {
+            palette[i] = ((8 - i) * alpha0 + (i - 1) * alpha1) / 7;
+        }
+    }
+    else {
+        for (unsigned int i = 2; i < 6; i++) {
+            palette[i] = ((6 - i) * alpha0 + (i - 1) * alpha1) / 5;
+        }
+
+        palette[6] = 0;
+        palette[7] = 255;
+    }
+}
+
+static void Unpack_565(uint16_t color, int rgb[3])
+{
+    int r = (color >> 11) & 31;
+    int g = (color >> 5) & 63;
+    int b = color & 31;
+
+    rgb[0] = (r << 3) | (r >> 2);
+    rgb[1] = (g << 2) | (g >> 4);
+    rgb[2] = (b << 3) | (b >> 2);
+}
+
+static uint16_t Pack_565(const float rgb[3])
+{
+    int r = static_cast<int>(Clamp(rgb[0], 0.0f, 255.0f) * 31.0f / 255.0f + 0.5f);
+    int g = static_cast<int>(Clamp(rgb[1], 0.0f, 255.0f) * 63.0f / 255.0f + 0.5f);
+    int b = static_cast<int>(Clamp(rgb[2], 0.0f, 255.0f) * 31.0f / 255.0f + 0.5f);
+
+    return static_cast<uint16_t>((r << 11) | (g << 5) | b);
+}
+
+/* The 4 colours of a block, the last 2 are interpolated
+ * BC3 always uses 4 colours, unlike BC1 with color0 <= color1.
+*/
+static void Get_Color_Palette(uint16_t color0, uint16_t color1, int palette[4][3])
+{
+    Unpack_565(color0, palette[0]);
+    Unpack_565(color1, palette[1]);
+
+    for (unsigned int c = 0; c < 3; c++) {
+        palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+        palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+    }
+}
+
+static void Encode_Alpha(const unsigned char block[64], unsigned char* out)
+{
+    unsigned int min_alpha = 255;
+    unsigned int max_alpha = 0;
+
+    for (unsigned int i = 0; i < 16; i++) {
+        min_alpha = std::min(min_alpha, static_cast<unsigned int>(block[i * 4 + 3]));
+        max_alpha = std::max(max_alpha, static_cast<unsigned int>(block[i * 4 + 3]));
+    }
+
+    out[0] = max_alpha;
+    out[1] = min_alpha;
+
+    uint64_t indices = 0;
+
+    if (max_alpha > min_alpha) {
+        unsigned int palette[8];
+        Get_Alpha_Palette(max_alpha, min_alpha, palette);
+
+        for (unsigned int i = 0; i < 16; i++) {
+            int alpha = block[i * 4 + 3];
+            uint64_t best = 0;
+            int best_error = 256;
+
+            for (unsigned int p = 0; p < 8; p++) {
+                int error = abs(alpha - static_cast<int>(palette[p]));
+
+                if (error < best_error) {
+                    best = p;
+                    best_error = error;
+                }
+            }
+
+            indices |= best << (i * 3);
+        }
+    }
+
+    // 48 bits in little endian order
+    for (unsigned int i = 0; i < 6; i++) {
+        out[2 + i] = static_cast<unsigned char>(indices >> (i * 8));
+    }
+}
+
+static void Encode_Color(const unsigned char block[64], unsigned char* out)
+{
+    // fit the colours of the visible pixels as transparent ones are not seen
+    unsigned int visible = 0;
+
+    for (unsigned int i = 0; i < 16; i++) {
+        if (block[i * 4 + 3]) {
+            visible++;
+        }
+    }
+
+    float mean[3] = {0.0f, 0.0f, 0.0f};
+    unsigned int count = 0;
+
+    for (unsigned int i = 0; i < 16; i++) {
+        if (visible && !block[i * 4 + 3]) {
+            continue;
+        }
+
+        for (unsigned int c = 0; c < 3; c++) {
+            mean[c] += block[i * 4 + c];
+        }
+
+        count++;
+    }
+
+    for (unsigned int c = 0; c < 3; c++) {
+        mean[c] /= count;
+    }
+
+    // covariance matrix
+    float cov[3][3] = {{0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}};
+
+    for (unsigned int i = 0; i < 16; i++) {
+        if (visible && !block[i * 4 + 3]) {
+            continue;
+        }
+
+        float d[3];
+
+        for (unsigned int c = 0; c < 3; c++) {
+            d[c] = block[i * 4 + c] - mean[c];
+        }
+
+        for (unsigned int a = 0; a < 3; a++) {
+            for (unsigned int b = 0; b < 3; b++) {
+                cov[a][b] += d[a] * d[b];
+            }
+        }
+    }
+
+    // principal axis with the power method
+    float axis[3] = {1.0f, 1.0f, 1.0f};
+
+    for (unsigned int iteration = 0; iteration < 8; iteration++) {
+        float next[3];
+        float length = 0.0f;
+
+        for (unsigned int a = 0; a < 3; a++) {
+            next[a] = cov[a][0] * axis[0] + cov[a][1] * axis[1] + cov[a][2] * axis[2];
+            length = std::max(length, fabs(next[a]));
+        }
+
+        // single colour
+        if (length < 0.0001f) {
+            break;
+        }
+
+        for (unsigned int a = 0; a < 3; a++) {
+            axis[a] = next[a] / length;
+        }
+    }
+
+    float min_t = 0.0f;
+    float max_t = 0.0f;
+    float axis_length = axis[0] * axis[0] + axis[1] * axis[1] + axis[2] * axis[2];
+
+    for (unsigned int i = 0; i < 16; i++) {
+        if (visible && !block[i * 4 + 3]) {
+            continue;
+        }
+
+        float t = 0.0f;
+
+        for (unsigned int c = 0; c < 3; c++) {
+            t += (block[i * 4 + c] - mean[c]) * axis[c];
+        }
+
+        t /= axis_length;
+        min_t = std::min(min_t, t);
+        max_t = std::max(max_t, t);
+    }
+
+    // move the end points a bit inwards as the extremes are rarely hit exactly
+    float inset = (max_t - min_t) / 16.0f;
+    min_t += inset;
+    max_t -= inset;
+
+    float end0[3];
+    float end1[3];
+
+    for (unsigned int c = 0; c < 3; c++) {
+        end0[c] = mean[c] + axis[c] * max_t;
+        end1[c] = mean[c] + axis[c] * min_t;
+    }
+
+    uint16_t color0 = Pack_565(end0);
+    uint16_t color1 = Pack_565(end1);
+
+    if (color0 < color1) {
+        std::swap(color0, color1);
+    }
+
+    out[0] = color0 & 0xFF;
+    out[1] = color0 >> 8;
+    out[2] = color1 & 0xFF;
+    out[3] = color1 >> 8;
+
+    uint32_t indices = 0;
+
+    if (color0 != color1) {
+        int palette[4][3];
+        Get_Color_Palette(color0, color1, palette);
+
+        for (unsigned int i = 0; i < 16; i++) {
+            uint32_t best = 0;
+            int best_error = INT_MAX;
+
+            for (unsigned int p = 0; p < 4; p++) {
+                int error = 0;
+
+                for (unsigned int c = 0; c < 3; c++) {
+                    int d = block[i * 4 + c] - palette[p][c];
+                    error += d * d;
+                }
+
+                if (error < best_error) {
+                    best = p;
+                    best_error = error;
+                }
+            }
+
+            indices |= best << (i * 2);
+        }
+    }
+
+    for (unsigned int i = 0; i < 4; i++) {
+        out[4 + i] = static_cast<unsigned char>(indices >> (i * 8));
+    }
+}
+
+static void Decode_Block(const unsigned char* in, unsigned char block[64])
+{
+    unsigned int alpha_palette[8];
+    Get_Alpha_Palette(in[0], in[1], alpha_palette);
+
+    uint64_t alpha_indices = 0;
+
+    for (unsigned int i = 0; i < 6; i++) {
+        alpha_indices |= static_cast<uint64_t>(in[2 + i]) << (i * 8);
+    }
+
+    int color_palette[4][3];
+    Get_Color_Palette(in[8] | (in[9] << 8), in[10] | (in[11] << 8), color_palette);
+
+    uint32_t color_indices = in[12] | (in[13] << 8) | (in[14] << 16) | (static_cast<uint32_t>(in[15]) << 24);
+
+    for (unsigned int i = 0; i < 16; i++) {
+        const int* color = color_palette[(color_indices >> (i * 2)) & 3];
+
+        block[i * 4] = color[0];
+        block[i * 4 + 1] = color[1];
+        block[i * 4 + 2] = color[2];
+        block[i * 4 + 3] = alpha_palette[(alpha_indices >> (i * 3)) & 7];
+    }
+}
+
+void Compress_BC3(const cPixel_Buffer& src, cPixel_Buffer& dst)
+{
+    dst.Resize(src.Get_Width(), src.Get_Height(), src.Get_Levels(), PIXEL_FORMAT_BC3);
+
+    unsigned char block[64];
+
+    for (unsigned int level = 0; level < src.Get_Levels(); level++) {
+        unsigned int width = src.Get_Level_Width(level);
+        unsigned int height = src.Get_Level_Height(level);
+        const unsigned char* pixels = src.Get_Level(level);
+        unsigned char* out = dst.Get_Level(level);
+
+        for (unsigned int block_y = 0; block_y < (height + 3) / 4; block_y++) {
+            for (unsigned int block_x = 0; block_x < (width + 3) / 4; block_x++) {
+                Get_Block(pixels, width, height, block_x, block_y, block);
+                Encode_Alpha(block, out);
+                Encode_Color(block, out + 8);
+                out += BC3_BLOCK_BYTES;
+            }
+        }
+    }
+}
+
+void Decompress_BC3(const cPixel_Buffer& src, cPixel_Buffer& dst)
+{
+    dst.Resize(src.Get_Width(), src.Get_Height(), src.Get_Levels());
+
+    unsigned char block[64];
+
+    for (unsigned int level = 0; level < src.Get_Levels(); level++) {
+        unsigned int width = src.Get_Level_Width(level);
+        unsigned int height = src.Get_Level_Height(level);
+        const unsigned char* in = src.Get_Level(level);
+        unsigned char* pixels = dst.Get_Level(level);
+
+        for (unsigned int block_y = 0; block_y < (height + 3) / 4; block_y++) {
+            for (unsigned int block_x = 0; block_x < (width + 3) / 4; block_x++) {
+                Decode_Block(in, block);
+                in += BC3_BLOCK_BYTES;
+
+                // blocks at the right and bottom edges may be partly outside
+                for (unsigned int y = 0; y < 4 && block_y * 4 + y < height; y++) {
+                    unsigned int x_count = std::min(4u, width - block_x * 4);
+                    memcpy(pixels + (static_cast<size_t>(block_y * 4 + y) * width + block_x * 4) * 4, block + y * 16, x_count * 4);
+                }
+            }
+        }
+    }
+}
+
+bool Is_BC3_Opaque(const cPixel_Buffer& src)
+{
+    unsigned int width = src.Get_Width();
+    unsigned int height = src.Get_Height();
+    const unsigned char* in = src.Get_Pixels();
+
+    unsigned char block[64];
+
+    for (unsigned int block_y = 0; block_y < (height + 3) / 4; block_y++) {
+        for (unsigned int block_x = 0; block_x < (width + 3) / 4; block_x++) {
+            Decode_Block(in, block);
+            in += BC3_BLOCK_BYTES;
+
+            for (unsigned int y = 0; y < 4 && block_y * 4 + y < height; y++) {
+                for (unsigned int x = 0; x < 4 && block_x * 4 + x < width; x++) {
+                    if (block[y * 16 + x * 4 + 3] != 255) {
+                        return 0;
+                    }
+                }
+            }
+        }
+    }
+
+    return 1;
+}
+
+/* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
+
+} // namespace TSC
@@ -0,0 +1,54 @@
+/***************************************************************************
+ * texture_compression.hpp - S3TC texture compression for the image cache
+ *
+ * Copyright © 2012-2020 The TSC Contributors
+ ***************************************************************************/
+/*
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef TSC_TEXTURE_COMPRESSION_HPP
+#define TSC_TEXTURE_COMPRESSION_HPP
+
+#include "../core/global_basic.hpp"
+#include "../video/png_decoder.hpp"
+
+#ifndef GL_COMPRESSED_RGBA_S3TC_DXT5_EXT
+#define GL_COMPRESSED_RGBA_S3TC_DXT5_EXT 0x83F3
+#endif
+
+namespace TSC {
+
+    /* *** *** *** *** *** *** *** BC3 *** *** *** *** *** *** *** *** *** *** */
+
+    /* BC3 (S3TC DXT5) stores each 4x4 pixel block in 16 bytes: interpolated
+     * 8 bit alpha followed by interpolated RGB565 colours. This is a quarter
+     * of the RGBA memory and it is uploaded to the graphics card as is.
+    */
+
+    // Bytes of an image with the given size
+    size_t Get_BC3_Size(unsigned int width, unsigned int height);
+
+    /* Compress all mipmap levels of the RGBA buffer `src' into `dst'
+     * The colour endpoints are fitted to the principal axis of the visible
+     * pixels of each block. Slow compared to loading, meant for the image cache.
+    */
+    void Compress_BC3(const cPixel_Buffer& src, cPixel_Buffer& dst);
+
+    // Decompress all mipmap levels of the BC3 buffer `src' into RGBA pixels in `dst'
+    void Decompress_BC3(const cPixel_Buffer& src, cPixel_Buffer& dst);
+
+    // If every pixel of the image in the BC3 buffer `src' has full alpha
+    bool Is_BC3_Opaque(const cPixel_Buffer& src);
+
+    /* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
+
+} // namespace TSC
+
+#endif
@@ -31,13 +31,45 @@
 #include "../core/filesystem/filesystem.hpp"
 #include "../core/filesystem/resource_manager.hpp"
 #include "../core/filesystem/relative.hpp"
+#include "../core/parallel.hpp"
 #include "../gui/hud.hpp"
+#include "../core/editor/editor_catalogue.hpp"
+#include "ktx_file.hpp"
+#include "texture_compression.hpp"
 #include "video.hpp"
 
 using namespace std;
 
 namespace fs = boost::filesystem;
 
+/* glCompressedTexImage2D is OpenGL 1.3 and the occlusion queries are
+ * OpenGL 1.5, they are not exported by every platform's OpenGL library,
+ * so they are looked up at runtime. */
+#ifndef APIENTRY
+#define APIENTRY
+#endif
+#ifndef GL_SAMPLES_PASSED
+#define GL_SAMPLES_PASSED 0x8914
+#endif
+#ifndef GL_QUERY_RESULT
+#define GL_QUERY_RESULT 0x8866
+#endif
+#ifndef GL_QUERY_RESULT_AVAILABLE
+#define GL_QUERY_RESULT_AVAILABLE 0x8867
+#endif
+
+typedef void (APIENTRY* TSC_GL_Compressed_Tex_Image_2D)(GLenum target, GLint level, GLenum internalformat, GLsizei width, GLsizei height, GLint border, GLsizei image_size, const void* data);
+typedef void (APIENTRY* TSC_GL_Gen_Queries)(GLsizei n, GLuint* ids);
+typedef void (APIENTRY* TSC_GL_Begin_Query)(GLenum target, GLuint id);
+typedef void (APIENTRY* TSC_GL_End_Query)(GLenum target);
+typedef void (APIENTRY* TSC_GL_Get_Query_Object_Uiv)(GLuint id, GLenum pname, GLuint* params);
+
+static TSC_GL_Compressed_Tex_Image_2D tsc_glCompressedTexImage2D = NULL;
+static TSC_GL_Gen_Queries tsc_glGenQueries = NULL;
+static TSC_GL_Begin_Query tsc_glBeginQuery = NULL;
+static TSC_GL_End_Query tsc_glEndQuery = NULL;
+static TSC_GL_Get_Query_Object_Uiv tsc_glGetQueryObjectuiv = NULL;
+
 namespace TSC {
 
 /* *** *** *** *** *** *** *** Video class *** *** *** *** *** *** *** *** *** *** */
@@ -55,6 +87,12 @@ cVideo::cVideo(void)
 
     m_default_buffer = GL_BACK;
     m_max_texture_size = 512;
+    m_npot_textures = 0;
+    m_s3tc_textures = 0;
+    m_imgcache_compressed = 0;
+    m_overdraw_samples = 0;
+    m_overdraw_query = 0;
+    m_overdraw_query_pending = 0;
 
     m_audio_init_failed = 0;
     m_joy_init_failed = 0;
@@ -64,7 +102,7 @@ cVideo::cVideo(void)
 #ifdef __unix__
     glx_context = NULL;
 #endif
-    m_render_thread = boost::thread();
+    m_clear_color = black;
 
     mp_cegui_renderer = NULL;
     mp_default_tooltip = NULL;
@@ -74,6 +112,9 @@ cVideo::cVideo(void)
 
 cVideo::~cVideo(void)
 {
+    // CEGUI is destroyed with the context in this thread
+    m_render_thread.Stop();
+
     if (mp_default_tooltip) {
         CEGUI::WindowManager::getSingleton().destroyWindow(mp_default_tooltip);
         CEGUI::System::getSingleton().getDefaultGUIContext().setDefaultTooltipObject(0);
@@ -166,7 +207,8 @@ void cVideo::Init_CEGUI(void)
 
 void cVideo::Init_Video(bool reload_textures_from_file /* = false */, bool use_preferences /* = true */)
 {
-    Render_Finish();
+    // the window is recreated with a new context
+    m_render_thread.Stop();
 
     sf::VideoMode videomode(800, 600, 16); // defaults
     sf::VideoMode desktopmode(sf::VideoMode::getDesktopMode());
@@ -311,6 +353,11 @@ void cVideo::Init_Video(bool reload_textures_from_file /* = false */, bool use_p
 
         m_initialised = 1;
     }
+
+#ifdef ENABLE_RENDER_THREAD
+    // the window context moves to the render thread
+    m_render_thread.Start(mp_window);
+#endif
 }
 
 void cVideo::Init_OpenGL(void)
@@ -333,8 +380,8 @@ void cVideo::Init_OpenGL(void)
     // set the smooth shading model
     glShadeModel(GL_SMOOTH);
 
-    // set clear color to black
-    glClearColor(0, 0, 0, 1);
+    // set clear color
+    glClearColor(m_clear_color.red / 255.0f, m_clear_color.green / 255.0f, m_clear_color.blue / 255.0f, m_clear_color.alpha / 255.0f);
 
     // Z-Buffer
     glEnable(GL_DEPTH_TEST);
@@ -360,6 +407,43 @@ void cVideo::Init_OpenGL(void)
     Init_Texture_Detail();
     // Resolution Scale
     Init_Resolution_Scale();
+    // screenshot readback buffers
+    m_screen_capture.Init(pPreferences->m_video_screen_w, pPreferences->m_video_screen_h);
+
+    // images are only padded to a power of 2 size if needed
+    const char* gl_version = reinterpret_cast<const char*>(glGetString(GL_VERSION));
+    const char* gl_extensions = reinterpret_cast<const char*>(glGetString(GL_EXTENSIONS));
+    m_npot_textures = (gl_version && atoi(gl_version) >= 2) || (gl_extensions && strstr(gl_extensions, "GL_ARB_texture_non_power_of_two"));
+
+    debug_print("Info : %s textures\n", m_npot_textures ? "Non power of 2" : "Power of 2 padded");
+
+    // compressed images from the image cache are decompressed if not supported
+    tsc_glCompressedTexImage2D = reinterpret_cast<TSC_GL_Compressed_Tex_Image_2D>(sf::Context::getFunction("glCompressedTexImage2D"));
+
+    if (!tsc_glCompressedTexImage2D) {
+        tsc_glCompressedTexImage2D = reinterpret_cast<TSC_GL_Compressed_Tex_Image_2D>(sf::Context::getFunction("glCompressedTexImage2DARB"));
+    }
+
+    m_s3tc_textures = tsc_glCompressedTexImage2D && gl_extensions && strstr(gl_extensions, "GL_EXT_texture_compression_s3tc");
+
+    debug_print("Info : S3TC texture compression %s\n", m_s3tc_textures ? "available" : "not available");
+
+    // sprite program or fixed-function pipeline
+    m_sprite_batch.Init(pPreferences->m_video_sprite_shader);
+
+    // samples query for the overdraw statistics, the old one was destroyed with the context
+    tsc_glGenQueries = reinterpret_cast<TSC_GL_Gen_Queries>(sf::Context::getFunction("glGenQueries"));
+    tsc_glBeginQuery = reinterpret_cast<TSC_GL_Begin_Query>(sf::Context::getFunction("glBeginQuery"));
+    tsc_glEndQuery = reinterpret_cast<TSC_GL_End_Query>(sf::Context::getFunction("glEndQuery"));
+    tsc_glGetQueryObjectuiv = reinterpret_cast<TSC_GL_Get_Query_Object_Uiv>(sf::Context::getFunction("glGetQueryObjectuiv"));
+
+    if (!tsc_glBeginQuery || !tsc_glEndQuery || !tsc_glGetQueryObjectuiv) {
+        tsc_glGenQueries = NULL;
+    }
+
+    m_overdraw_samples = 0;
+    m_overdraw_query = 0;
+    m_overdraw_query_pending = 0;
 
     // clear screen
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
@@ -370,7 +454,11 @@ void cVideo::Init_OpenGL(void)
 
 void cVideo::Init_Geometry(void)
 {
-    Render_Finish();
+    // the hints belong to the window context
+    if (m_render_thread.Is_Running() && !m_render_thread.Is_Current()) {
+        m_render_thread.Run(std::bind(&cVideo::Init_Geometry, this));
+        return;
+    }
 
     // Geometry Anti-Aliasing
     if (m_geometry_quality > 0.5f) {
@@ -409,7 +497,10 @@ void cVideo::Init_Geometry(void)
 
 void cVideo::Init_Texture_Detail(void)
 {
-    Render_Finish();
+    if (m_render_thread.Is_Running() && !m_render_thread.Is_Current()) {
+        m_render_thread.Run(std::bind(&cVideo::Init_Texture_Detail, this));
+        return;
+    }
 
     /* filter quality of generated mipmap images
      * only available if OpenGL version is 1.4 or greater
@@ -434,6 +525,9 @@ void cVideo::Init_Resolution_Scale(void) const
     global_downscaley = static_cast<float>(game_res_h) / static_cast<float>(pPreferences->m_video_screen_h);
 }
 
+// Number of images cached at once between loading screen updates
+static const size_t IMAGE_CACHE_BATCH_SIZE = 32;
+
 /**
  * Create the cache of downscaled images. This function
  * expects to be run while the loading screen is active,
@@ -448,8 +542,17 @@ void cVideo::Init_Resolution_Scale(void) const
  */
 void cVideo::Init_Image_Cache(bool recreate /* = 0 */)
 {
+    // the catalogue thread reads the settings index and writes into the image cache
+    if (pEditor_Catalogue) {
+        pEditor_Catalogue->Wait();
+    }
+
     m_imgcache_dir = pResource_Manager->Get_User_Imgcache_Directory();
-    fs::path imgcache_dir_active = m_imgcache_dir / utf8_to_path(int_to_string(pPreferences->m_video_screen_w) + "x" + int_to_string(pPreferences->m_video_screen_h));
+    m_imgcache_compressed = 0;
+
+    // only compress if it can be uploaded, the compressed images are in their own directory
+    bool compressed = pPreferences->m_image_cache_compressed && m_s3tc_textures;
+    fs::path imgcache_dir_active = m_imgcache_dir / utf8_to_path(int_to_string(pPreferences->m_video_screen_w) + "x" + int_to_string(pPreferences->m_video_screen_h) + (compressed ? "_bc3" : ""));
 
     // if cache is disabled
     if (!pPreferences->m_image_cache_enabled) {
@@ -458,6 +561,9 @@ void cVideo::Init_Image_Cache(bool recreate /* = 0 */)
 
     // if not the same game version
     if (recreate || pPreferences->m_game_version != tsc_version) {
+        // the index is in there
+        pSettingsParser->m_index.Close();
+
         // delete all caches
         if (Dir_Exists(m_imgcache_dir)) {
             try {
@@ -475,6 +581,17 @@ void cVideo::Init_Image_Cache(bool recreate /* = 0 */)
         fs::create_directories(m_imgcache_dir);
     }
 
+    // image settings index
+    fs::path settings_index_file = m_imgcache_dir / utf8_to_path("settings.idx");
+
+    if (!pSettingsParser->m_index.Load(settings_index_file)) {
+        Loading_Screen_Draw_Text(_("Indexing Image Settings"));
+
+        if (cImage_Settings_Index::Build(settings_index_file)) {
+            pSettingsParser->m_index.Load(settings_index_file);
+        }
+    }
+
     // no cache available
     if (!Dir_Exists(imgcache_dir_active)) {
         fs::create_directories(imgcache_dir_active / utf8_to_path(GAME_PIXMAPS_DIR));
@@ -482,6 +599,7 @@ void cVideo::Init_Image_Cache(bool recreate /* = 0 */)
     // cache available
     else {
         m_imgcache_dir = imgcache_dir_active;
+        m_imgcache_compressed = compressed;
         return;
     }
 
@@ -493,145 +611,127 @@ void cVideo::Init_Image_Cache(bool recreate /* = 0 */)
     Loading_Screen_Draw_Text(_("Caching Images"));
 
     // get all files
-    vector<fs::path> image_files = Get_Directory_Files(pResource_Manager->Get_Game_Pixmaps_Directory(), ".settings", true);
+    vector<fs::path> files = Get_Directory_Files(pResource_Manager->Get_Game_Pixmaps_Directory(), ".settings", true);
+    vector<fs::path> image_files;
 
-    unsigned int loaded_files = 0;
-    unsigned int file_count = image_files.size();
-
-    // create directories, load images and save to cache
-    for (vector<fs::path>::iterator itr = image_files.begin(); itr != image_files.end(); ++itr) {
-        // get filenames
-        fs::path filename = (*itr);
-        fs::path cache_filename = imgcache_dir_active / fs_relative(pResource_Manager->Get_Game_Data_Directory(), filename);
-
-        // if directory
-        if (fs::is_directory(filename)) {
-            if (!fs::is_directory(cache_filename)) {
-                fs::create_directory(cache_filename);
-            }
-
-            loaded_files++;
+    // create the directories first as the images are cached from several threads
+    for (vector<fs::path>::iterator itr = files.begin(); itr != files.end(); ++itr) {
+        if (!fs::is_directory(*itr)) {
+            image_files.push_back(*itr);
             continue;
         }
 
-        bool settings_file = false;
+        fs::path cache_dir = imgcache_dir_active / fs_relative(pResource_Manager->Get_Game_Data_Directory(), *itr);
 
-        // Don't use .settings file type directly for image loading
-        if (filename.extension() == fs::path(".settings")) {
-            settings_file = true;
-            filename.replace_extension(".png");
+        if (!fs::is_directory(cache_dir)) {
+            fs::create_directory(cache_dir);
         }
+    }
 
-        // load software image
-        cSoftware_Image software_image = Load_Image(filename);
-        sf::Image* p_sf_image = software_image.m_sf_image;
-        cImage_Settings_Data* settings = software_image.m_settings;
+    uint32_t start_ticks = TSC_GetTicks();
 
-        // failed to load image
-        if (!p_sf_image) {
-            continue;
-        }
+    unsigned int thread_count = Get_Worker_Thread_Count();
 
-        /* don't cache if no image settings or images without the width and height set
-         * as there is currently no support to get the old and real image size
-         * and thus the scaled down (cached) image size is used which is wrong
-        */
-        if (!settings || !settings->m_width || !settings->m_height) {
-            if (settings) {
-                debug_print("Info : %s has no image settings image size set and will not get cached\n", cache_filename.c_str());
-            }
-            else {
-                debug_print("Info : %s has no image settings and will not get cached\n", cache_filename.c_str());
-            }
-            delete p_sf_image;
-            continue;
-        }
+    // one parser per thread as the global one is not thread-safe
+    std::vector<cImage_Settings_Parser> parsers(thread_count);
 
-        // create final image
-        p_sf_image = Convert_To_Final_Software_Image(p_sf_image);
+    // decode, scale and compress in parallel
+    Parallel_For_Batches(image_files.size(), IMAGE_CACHE_BATCH_SIZE, thread_count, [this, &image_files, &imgcache_dir_active, compressed, &parsers](size_t i, unsigned int thread) {
+        Cache_Image(image_files[i], imgcache_dir_active, compressed, &parsers[thread]);
+    }, [&image_files](size_t start, size_t end) {
+        // update progress
+        Loading_Screen_Set_Progress(static_cast<float>(end) / static_cast<float>(image_files.size()));
+        Loading_Screen_Draw();
+    });
 
-        // get final size for this resolution
-        cSize_Int size = settings->Get_Surface_Size(p_sf_image);
-        delete settings;
-        int new_width = size.m_width;
-        int new_height = size.m_height;
+    debug_print("Cached %u images in %u ms using %u threads%s\n", static_cast<unsigned int>(image_files.size()), TSC_GetTicks() - start_ticks, thread_count, compressed ? " with BC3 compression" : "");
 
-        // apply maximum texture size
-        Apply_Max_Texture_Size(new_width, new_height);
+    // set back texture detail
+    m_texture_quality = real_texture_detail;
+    // set directory after surfaces got loaded from Load_GL_Surface()
+    m_imgcache_dir = imgcache_dir_active;
+    m_imgcache_compressed = compressed;
+}
 
-        // does not need to be downsampled
-        if (new_width >= p_sf_image->getSize().x && new_height >= p_sf_image->getSize().y) {
-            delete p_sf_image;
-            p_sf_image = NULL;
-            continue;
-        }
+void cVideo::Cache_Image(fs::path filename, const fs::path& cache_dir, bool compressed, cImage_Settings_Parser* settings_parser) const
+{
+    fs::path cache_filename = cache_dir / fs_relative(pResource_Manager->Get_Game_Data_Directory(), filename);
+    bool settings_file = false;
 
-        // calculate block reduction
-        int reduce_block_x = p_sf_image->getSize().x / new_width;
-        int reduce_block_y = p_sf_image->getSize().y / new_height;
-
-        // create downsampled image
-        /* Old SDL TSC queried SDL for a "bytes per pixels" value, see
-         * <https://wiki.libsdl.org/SDL_PixelFormat>.  This is simply
-         * the number of bytes required to store all info about one
-         * pixel.  It can easily be calculated without SDL: If yor
-         * image has a depth of 8 *bits* per colour, then a pixel
-         * consists of 3x8 = 24 bits (RGB) or 4x8 = 32 bits
-         * (RGBA). For 24 bits you need 3 bytes to store, for 32 bits
-         * 4 bytes. SFML guarantees in the documentation of
-         * sf::Image::getPixelPtr() that RGBA data is returned with a
-         * colour depth of 8 bit (resulting in 32 bits per pixel as
-         * per the above). If SFML ever supports other colour depths,
-         * the required bytes-per-pixel storage value can easily be
-         * calculated with:
-         *   ceil(bits-per-pixel * 4 / 8.0)
-         * Where 4
-         * stands for RGBA. For plain RGB you'd need to insert 3
-         * instead. For now, relying on SFML's docs, we just hardcode
-         * 4 bytes as that is what SFML returns to us. */
-        unsigned int image_bpp = 4; // 8 bits-per-color x 4 colors (RGBA) = 32 bits. 32 bits / 8 bits = 4 bytes.
-        unsigned char* image_downsampled = new unsigned char[new_width * new_height * image_bpp];
-        bool downsampled = Downscale_Image(static_cast<const unsigned char*>(p_sf_image->getPixelsPtr()), p_sf_image->getSize().x, p_sf_image->getSize().y, image_bpp, image_downsampled, reduce_block_x, reduce_block_y);
-
-        delete p_sf_image;
-
-        // if image is available
-        if (downsampled) {
-            // save as png
-            if (settings_file) {
-                cache_filename.replace_extension(".png");
-            }
+    // Don't use .settings file type directly for image loading
+    if (filename.extension() == fs::path(".settings")) {
+        settings_file = true;
+        filename.replace_extension(".png");
+    }
+
+    // load software image, scaled to the size for this resolution while decoding
+    cSoftware_Image software_image = Load_Image(filename, 1, 1, settings_parser);
+    cPixel_Buffer* pixels = software_image.m_pixels;
+    cImage_Settings_Data* settings = software_image.m_settings;
 
-            // save image
-            Save_Surface(cache_filename, image_downsampled, new_width, new_height, image_bpp);
+    // failed to load image
+    if (!pixels) {
+        return;
+    }
+
+    bool downsampled = pixels->Get_Width() < software_image.m_image_width || pixels->Get_Height() < software_image.m_image_height;
+    // downsampled or padded
+    bool resized = pixels->Get_Width() != software_image.m_image_width || pixels->Get_Height() != software_image.m_image_height;
+
+    /* don't cache if no image settings or downsampled images without the width and height set
+     * as there is currently no support to get the old and real image size
+     * and thus the scaled down (cached) image size is used which is wrong
+    */
+    if (!settings || ((!settings->m_width || !settings->m_height) && (resized || !(settings->m_mipmap || compressed)))) {
+        if (settings) {
+            debug_print("Info : %s has no image settings image size set and will not get cached\n", cache_filename.c_str());
+            delete settings;
         }
+        else {
+            debug_print("Info : %s has no image settings and will not get cached\n", cache_filename.c_str());
+        }
+        cPixel_Buffer::Release(pixels);
+        return;
+    }
 
-        delete[] image_downsampled;
+    bool mipmap = settings->m_mipmap;
+    delete settings;
 
-        // count files
-        loaded_files++;
+    // does not need to be downsampled, mipmapped or compressed
+    if (!downsampled && !mipmap && !compressed) {
+        cPixel_Buffer::Release(pixels);
+        return;
+    }
 
-        // draw
-        // update progress
-        Loading_Screen_Set_Progress(static_cast<float>(loaded_files) / static_cast<float>(file_count));
+    if (mipmap) {
+        pixels->Build_Mipmaps();
+    }
+
+    // save as BC3 with all mipmap levels
+    if (compressed) {
+        cPixel_Buffer* blocks = cPixel_Buffer::Acquire();
+        Compress_BC3(*pixels, *blocks);
+
+        cache_filename.replace_extension(".ktx");
+        Save_KTX(cache_filename, *blocks);
+
+        cPixel_Buffer::Release(blocks);
+    }
+    // save with all mipmap levels
+    else if (mipmap) {
+        cache_filename.replace_extension(".ktx");
+        Save_KTX(cache_filename, *pixels);
+    }
+    // save as png
+    else {
+        if (settings_file) {
+            cache_filename.replace_extension(".png");
+        }
 
-// OLD #ifdef _DEBUG
-// OLD             // update filename
-// OLD             cGL_Surface* surface_filename = pFont->Render_Text(pFont->m_font_small, path_to_utf8(filename), white);
-// OLD             // draw filename
-// OLD             surface_filename->Blit(game_res_w * 0.2f, game_res_h * 0.8f, 0.1f);
-// OLD #endif
-            Loading_Screen_Draw();
-// OLD #ifdef _DEBUG
-// OLD             // delete
-// OLD             delete surface_filename;
-// OLD #endif
+        Save_Surface(cache_filename, pixels->Get_Pixels(), pixels->Get_Width(), pixels->Get_Height());
     }
 
-    // set back texture detail
-    m_texture_quality = real_texture_detail;
-    // set directory after surfaces got loaded from Load_GL_Surface()
-    m_imgcache_dir = imgcache_dir_active;
+    cPixel_Buffer::Release(pixels);
 }
 
 int cVideo::Test_Video(int width, int height, int bpp, int flags /* = 0 */) const
@@ -663,131 +763,108 @@ vector<cSize_Int> cVideo::Get_Supported_Resolutions(int flags /* = 0 */) const
     return valid_resolutions;
 }
 
-void cVideo::Make_GL_Context_Current(void)
+void cVideo::Render(bool threaded /* = 0 */)
 {
-// Not ported to SFML yet, because unused function
-// Part of the unfinished separate rendering thread implementation in TSC
-// (TSC_RENDER_THREAD_TEST macro).
-    throw(std::runtime_error("Make_GL_Context_Current() not implemented"));
-
-// scoped context lock here
-//#ifdef _WIN32
-//    if (wglGetCurrentContext() != wm_info.hglrc) {
-//        wglMakeCurrent(GetDC(wm_info.window), wm_info.hglrc);
-//    }
-//#elif __unix__
-//    if (glx_context != NULL) {
-//        glXMakeCurrent(wm_info.info.x11.gfxdisplay, wm_info.info.x11.window, glx_context);
-//    }
-//#elif __APPLE__
-//    // party time
-//#endif
-}
+    // for finding the textures in use
+    cGL_Texture::Next_Frame();
 
-void cVideo::Make_GL_Context_Inactive(void)
-{
-#ifdef _WIN32
-    wglMakeCurrent(NULL, NULL);
-#elif __unix__
-    // OLD glXMakeCurrent(wm_info.info.x11.gfxdisplay, None, NULL);
-#elif __APPLE__
-    // party time
-#endif
-}
+    if (m_render_thread.Is_Running()) {
+        m_render_thread.Submit_Frame();
 
-void cVideo::Render_From_Thread(void)
-{
-    Make_GL_Context_Current();
+        if (!threaded) {
+            m_render_thread.Wait();
+        }
 
-    pRenderer_current->Render();
-    // under linux with sofware mesa 7.9 it only showed the rendered output with SDL_GL_SwapBuffers()
+        // update performance timer, the waiting for the render thread
+        pFramerate->m_perf_timer[PERF_RENDER_GAME]->Update();
+        return;
+    }
+
+    Render_Queue(pRenderer);
+
+    // update performance timer
+    pFramerate->m_perf_timer[PERF_RENDER_GAME]->Update();
+
+    Render_GUI();
 
     // update performance timer
-    //pFramerate->m_perf_timer[PERF_RENDER_GAME]->Update();
+    pFramerate->m_perf_timer[PERF_RENDER_GUI]->Update();
 
-    Make_GL_Context_Inactive();
+    mp_window->display();
+
+    // update performance timer
+    pFramerate->m_perf_timer[PERF_RENDER_BUFFER]->Update();
 }
 
-void cVideo::Render(bool threaded /* = 0 */)
+void cVideo::Render_Queue(cRenderQueue* queue)
 {
-    Render_Finish();
+    m_sprite_batch.Next_Frame();
 
-    if (threaded) {
-        CEGUI::System::getSingleton().renderAllGUIContexts();
+    // count the drawn samples in debug mode
+    bool overdraw_query = game_debug && Begin_Overdraw_Query();
 
-        // update performance timer
-        pFramerate->m_perf_timer[PERF_RENDER_GUI]->Update();
+    queue->Render();
 
-        mp_window->display();
-
-        // update performance timer
-        pFramerate->m_perf_timer[PERF_RENDER_BUFFER]->Update();
+    if (overdraw_query) {
+        tsc_glEndQuery(GL_SAMPLES_PASSED);
+        m_overdraw_query_pending = 1;
+    }
+}
 
-        // switch active renderer
-        cRenderQueue* new_render = pRenderer;
-        pRenderer = pRenderer_current;
-        pRenderer_current = new_render;
+void cVideo::Render_GUI(void)
+{
+    // Render GUI after everything else, i.e. on top of everything
+    CEGUI::System::getSingleton().renderAllGUIContexts();
 
-        // move objects that should render more than once
-        if (!pRenderer->m_render_data.empty()) {
-            pRenderer_current->m_render_data.insert(pRenderer_current->m_render_data.begin(), pRenderer->m_render_data.begin(), pRenderer->m_render_data.end());
-            pRenderer->m_render_data.clear();
-        }
+    // screenshots and frame capturing
+    m_screen_capture.Frame_Done();
+}
 
-        // make main thread inactive
-        Make_GL_Context_Inactive();
-        // start render thread
-        m_render_thread = boost::thread(&cVideo::Render_From_Thread, this);
+bool cVideo::Begin_Overdraw_Query(void)
+{
+    if (!tsc_glGenQueries) {
+        return 0;
     }
-    // single thread mode
-    else {
-        pRenderer->Render();
-
-        // update performance timer
-        pFramerate->m_perf_timer[PERF_RENDER_GAME]->Update();
 
-        // Render GUI after everything else, i.e. on top of everything
-        CEGUI::System::getSingleton().renderAllGUIContexts();
+    if (!m_overdraw_query) {
+        tsc_glGenQueries(1, &m_overdraw_query);
+    }
 
-        // update performance timer
-        pFramerate->m_perf_timer[PERF_RENDER_GUI]->Update();
+    // the last result is only read when available to not wait for the graphics card
+    if (m_overdraw_query_pending) {
+        GLuint available = 0;
+        tsc_glGetQueryObjectuiv(m_overdraw_query, GL_QUERY_RESULT_AVAILABLE, &available);
 
-        mp_window->display();
+        if (!available) {
+            return 0;
+        }
 
-        // update performance timer
-        pFramerate->m_perf_timer[PERF_RENDER_BUFFER]->Update();
+        tsc_glGetQueryObjectuiv(m_overdraw_query, GL_QUERY_RESULT, &m_overdraw_samples);
+        m_overdraw_query_pending = 0;
     }
+
+    tsc_glBeginQuery(GL_SAMPLES_PASSED, m_overdraw_query);
+    return 1;
 }
 
 void cVideo::Render_Finish(void)
 {
-#ifndef TSC_RENDER_THREAD_TEST
-    return;
-#endif
-    if (m_render_thread.joinable()) {
-        m_render_thread.join();
-    }
+    m_render_thread.Wait();
+}
 
-    // todo : use opengl in only one thread
-    Make_GL_Context_Current();
+void cVideo::Set_Clear_Color(const Color& color)
+{
+    // used by the next clear requests
+    m_clear_color = color;
 }
 
 void cVideo::Toggle_Fullscreen(void)
 {
-    Render_Finish();
-
     // toggle fullscreen
     pPreferences->m_video_fullscreen = !pPreferences->m_video_fullscreen;
 
-    // save clear color
-    GLclampf clear_color[4];
-    glGetFloatv(GL_COLOR_CLEAR_VALUE, clear_color);
-
-    // Video must be reinitialized
+    // Video must be reinitialized, the clear color is kept
     Init_Video();
-
-    // set back clear color
-    glClearColor(clear_color[0], clear_color[1], clear_color[2], clear_color[3]);
 }
 
 cGL_Surface* cVideo::Get_Surface(fs::path filename, bool print_errors /* = true */)
@@ -818,15 +895,18 @@ cGL_Surface* cVideo::Get_Surface(fs::path filename, bool print_errors /* = true
     return image;
 }
 
-cVideo::cSoftware_Image cVideo::Load_Image(boost::filesystem::path filename, bool load_settings /* = 1 */, bool print_errors /* = 1 */) const
+cVideo::cSoftware_Image cVideo::Load_Image(boost::filesystem::path filename, bool load_settings /* = 1 */, bool print_errors /* = 1 */, cImage_Settings_Parser* settings_parser /* = NULL */) const
 {
+    if (!settings_parser) {
+        settings_parser = pSettingsParser;
+    }
+
     // pixmaps dir must be given
     if (!filename.is_absolute()) {
         filename = fs::absolute(filename, pResource_Manager->Get_Game_Pixmaps_Directory());
     }
 
     cSoftware_Image software_image = cSoftware_Image();
-    sf::Image* p_sf_image = new sf::Image();
     bool successfully_loaded = false;
     cImage_Settings_Data* settings = NULL;
     fs::path final_png_path;
@@ -839,15 +919,30 @@ cVideo::cSoftware_Image cVideo::Load_Image(boost::filesystem::path filename, boo
         if (settings_file.extension() != fs::path(".settings"))
             settings_file.replace_extension(".settings");
 
-        if (fs::exists(settings_file) && fs::is_regular_file(settings_file)) {
-            settings = pSettingsParser->Get(settings_file);
+        if (pSettingsParser->m_index.Contains(settings_file) || (fs::exists(settings_file) && fs::is_regular_file(settings_file))) {
+            // the index is read-only and may be shared between threads
+            settings = pSettingsParser->m_index.Get(settings_file);
+
+            if (!settings) {
+                settings = settings_parser->Get(settings_file);
+            }
 
             // add cache dir and remove data dir
             fs::path img_filename_cache = m_imgcache_dir / fs_relative(pResource_Manager->Get_Game_Data_Directory(), filename);
 
+            // cached with the mipmaps or compressed
+            if (settings->m_mipmap || m_imgcache_compressed) {
+                fs::path ktx_filename_cache = img_filename_cache;
+                ktx_filename_cache.replace_extension(".ktx");
+
+                if (fs::exists(ktx_filename_cache)) {
+                    img_filename_cache = ktx_filename_cache;
+                }
+            }
+
             // check if image cache file exists
             if (fs::exists(img_filename_cache) && fs::is_regular_file(img_filename_cache)) {
-                successfully_loaded = p_sf_image->loadFromFile(path_to_utf8(img_filename_cache));
+                successfully_loaded = Load_Image_Pixels(img_filename_cache, settings, software_image);
 
                 if (successfully_loaded) {
                     final_png_path = img_filename_cache;
@@ -868,7 +963,7 @@ cVideo::cSoftware_Image cVideo::Load_Image(boost::filesystem::path filename, boo
                     }
                 }
 
-                successfully_loaded = p_sf_image->loadFromFile(path_to_utf8(img_filename));
+                successfully_loaded = Load_Image_Pixels(img_filename, settings, software_image);
 
                 if (successfully_loaded) {
                     final_png_path = img_filename;
@@ -879,7 +974,7 @@ cVideo::cSoftware_Image cVideo::Load_Image(boost::filesystem::path filename, boo
 
     // if not set in image settings and file exists
     if (!successfully_loaded && exists(filename) && (!settings || settings->m_base.empty())) {
-        successfully_loaded = p_sf_image->loadFromFile(path_to_utf8(filename));
+        successfully_loaded = Load_Image_Pixels(filename, settings, software_image);
 
         if (successfully_loaded) {
             final_png_path = filename;
@@ -896,16 +991,73 @@ cVideo::cSoftware_Image cVideo::Load_Image(boost::filesystem::path filename, boo
             cerr << "Error loading image : " << path_to_utf8(filename) << endl << endl;
         }
 
-        delete p_sf_image;
         return software_image;
     }
 
-    software_image.m_sf_image = p_sf_image;
     software_image.m_settings = settings;
     software_image.m_real_png_path = final_png_path;
     return software_image;
 }
 
+bool cVideo::Load_Image_Pixels(const fs::path& filename, const cImage_Settings_Data* settings, cSoftware_Image& software_image) const
+{
+    if (!software_image.m_pixels) {
+        software_image.m_pixels = cPixel_Buffer::Acquire();
+    }
+
+    // the sizes only depend on the image size, so it is scaled while decoding
+    bool loaded = Load_Pixel_Buffer(filename, *software_image.m_pixels, software_image.m_image_width, software_image.m_image_height, !m_npot_textures,
+    [this, settings, &software_image](unsigned int image_width, unsigned int image_height, unsigned int& texture_width, unsigned int& texture_height) {
+        int width;
+        int height;
+
+        if (settings) {
+            cSize_Int size = settings->Get_Surface_Size(image_width, image_height);
+            width = size.m_width;
+            height = size.m_height;
+            Apply_Max_Texture_Size(width, height);
+        }
+        else {
+            width = Get_Power_of_2(image_width);
+            height = Get_Power_of_2(image_height);
+        }
+
+        software_image.m_width = Get_Power_of_2(width);
+        software_image.m_height = Get_Power_of_2(height);
+
+        width = software_image.m_width;
+        height = software_image.m_height;
+        // check if the image size is greater than the maximum texture size
+        Apply_Max_Texture_Size(width, height);
+
+        // without the padding at the same scale
+        if (m_npot_textures) {
+            unsigned int padded_width = Get_Power_of_2(image_width);
+            unsigned int padded_height = Get_Power_of_2(image_height);
+
+            width = std::max((image_width * width + padded_width / 2) / padded_width, 1u);
+            height = std::max((image_height * height + padded_height / 2) / padded_height, 1u);
+
+            software_image.m_cover_w = static_cast<float>(image_width) / padded_width;
+            software_image.m_cover_h = static_cast<float>(image_height) / padded_height;
+        }
+
+        texture_width = width;
+        texture_height = height;
+    }, m_s3tc_textures);
+
+    if (!loaded) {
+        cPixel_Buffer::Release(software_image.m_pixels);
+        software_image.m_pixels = NULL;
+    }
+    // classified here as this is also how the image cache is built, padding is never opaque
+    else {
+        software_image.m_opaque = software_image.m_pixels->Is_Opaque();
+    }
+
+    return loaded;
+}
+
 cGL_Surface* cVideo::Load_GL_Surface(boost::filesystem::path filename, bool use_settings /* = 1 */, bool print_errors /* = 1 */)
 {
     // pixmaps dir must be given
@@ -914,8 +1066,11 @@ cGL_Surface* cVideo::Load_GL_Surface(boost::filesystem::path filename, bool use_
     }
 
     // load software image
-    cSoftware_Image software_image = Load_Image(filename, use_settings, print_errors);
-    sf::Image* p_sf_image = software_image.m_sf_image;
+    return Create_GL_Surface(filename, Load_Image(filename, use_settings, print_errors), print_errors);
+}
+
+cGL_Surface* cVideo::Create_GL_Surface(const fs::path& filename, cSoftware_Image software_image, bool print_errors /* = 1 */)
+{
     cImage_Settings_Data* settings = software_image.m_settings;
 
     // final surface
@@ -923,21 +1078,21 @@ cGL_Surface* cVideo::Load_GL_Surface(boost::filesystem::path filename, bool use_
 
     // with settings
     if (settings) {
-        // get the size
-        cSize_Int size = settings->Get_Surface_Size(p_sf_image);
-        Apply_Max_Texture_Size(size.m_width, size.m_height);
         // get basic settings surface
-        image = pVideo->Create_Texture(p_sf_image, settings->m_mipmap, size.m_width, size.m_height);
+        image = Create_Texture(software_image.m_pixels, software_image.m_width, software_image.m_height, settings->m_mipmap);
         // apply settings
         settings->Apply(image);
         delete settings;
     }
     // without settings
     else {
-        image = Create_Texture(p_sf_image);
+        image = Create_Texture(software_image.m_pixels, software_image.m_width, software_image.m_height);
     }
     // set filenames
     if (image) {
+        image->m_tex_cover_w = software_image.m_cover_w;
+        image->m_tex_cover_h = software_image.m_cover_h;
+        image->m_opaque = software_image.m_opaque;
         image->m_path = filename;
         image->m_real_png_path = software_image.m_real_png_path;
     }
@@ -949,50 +1104,15 @@ cGL_Surface* cVideo::Load_GL_Surface(boost::filesystem::path filename, bool use_
     return image;
 }
 
-/**
- * OpenGL only understands textures whose edges each have a length
- * that is a power of 2. This function ensures that our images fulfill
- * this requirement; if they don’t already have such edges, `p_sf_image'
- * is expanded to a size that fits the power-of-2 rule; the newly created
- * pixels are set to transparency.
- */
-sf::Image* cVideo::Convert_To_Final_Software_Image(sf::Image* p_sf_image) const
-{
-    // get power of two size
-    sf::Vector2u cursize = p_sf_image->getSize();
-    const unsigned int width = Get_Power_of_2(cursize.x);
-    const unsigned int height = Get_Power_of_2(cursize.y);
-
-    // if it needs to be changed
-    if (width != cursize.x || height != cursize.y) {
-        // create power of 2 surface
-        sf::Image* new_image = new sf::Image();
-        new_image->create(width, height, sf::Color::Transparent);
-        // copy over the old image into the new one (i.e., blit it onto it)
-        new_image->copy(*p_sf_image, 0, 0);
-        // delete original surface
-        delete p_sf_image;
-        // set new surface
-        p_sf_image = new_image;
-    }
-
-    return p_sf_image;
-}
-
-cGL_Surface* cVideo::Create_Texture(sf::Image* p_sf_image, bool mipmap /* = 0 */, unsigned int force_width /* = 0 */, unsigned int force_height /* = 0 */) const
+cGL_Surface* cVideo::Create_Texture(cPixel_Buffer* pixels, unsigned int width, unsigned int height, bool mipmap /* = 0 */) const
 {
-    if (!p_sf_image) {
+    if (!pixels) {
         return NULL;
     }
 
-    // create final image
-    p_sf_image = Convert_To_Final_Software_Image(p_sf_image);
-
-    /* todo : Make this a render request because it forces an early thread render finish as opengl commands are used directly.
-     * Reduces performance if the render thread is on. It's usually called from the text rendering in cTimeDisplay::Update.
+    /* with the render thread running the texture is created in the shared context of this thread
+     * and completed before the next frame is submitted
     */
-    pVideo->Render_Finish();
-
     // create one texture
     GLuint image_num = 0;
     glGenTextures(1, &image_num);
@@ -1000,7 +1120,7 @@ cGL_Surface* cVideo::Create_Texture(sf::Image* p_sf_image, bool mipmap /* = 0 */
     // if image id is 0 it failed
     if (!image_num) {
         cerr << "Error : GL image generation failed" << endl;
-        delete p_sf_image;
+        cPixel_Buffer::Release(pixels);
         return NULL;
     }
 
@@ -1009,44 +1129,27 @@ cGL_Surface* cVideo::Create_Texture(sf::Image* p_sf_image, bool mipmap /* = 0 */
         pImage_Manager->m_high_texture_id = image_num;
     }
 
-    int width = p_sf_image->getSize().x;
-    int height = p_sf_image->getSize().y;
-
-    // forced size is set
-    if (force_width > 0 && force_height > 0) {
-        // get power of two size
-        force_width = Get_Power_of_2(force_width);
-        force_height = Get_Power_of_2(force_height);
-
-        // apply forced size
-        if (force_width != width || force_height != height) {
-            width = force_width;
-            height = force_height;
-        }
-    }
-
     // texture size
-    int texture_width = width;
-    int texture_height = height;
+    int texture_width = pixels->Get_Width();
+    int texture_height = pixels->Get_Height();
     // check if the image size is greater than the maximum texture size
     Apply_Max_Texture_Size(texture_width, texture_height);
 
-    // scale to new size
-    if (texture_width != p_sf_image->getSize().x || texture_height != p_sf_image->getSize().y) {
-        int reduce_block_x = p_sf_image->getSize().x / texture_width;
-        int reduce_block_y = p_sf_image->getSize().y / texture_height;
-
-        // create scaled image
-        unsigned char* new_pixels = static_cast<unsigned char*>(malloc(texture_width * texture_height * 4));
-        Downscale_Image(static_cast<const unsigned char*>(p_sf_image->getPixelsPtr()), p_sf_image->getSize().x, p_sf_image->getSize().y, 8 /* getPixelsPtr() guarantees 8 BPP */, new_pixels, reduce_block_x, reduce_block_y);
-
-        sf::Image* p_new_image = new sf::Image();
-        p_new_image->create(texture_width, texture_height, static_cast<const uint8_t*>(new_pixels));
-
-        delete p_sf_image;
-        p_sf_image = p_new_image;
+    /* compressed images are only kept by Load_Image() if they can be uploaded
+     * and already have the size they were cached with
+    */
+    if (pixels->Get_Format() == PIXEL_FORMAT_BC3) {
+        texture_width = pixels->Get_Width();
+        texture_height = pixels->Get_Height();
+    }
+    // scale to new size, images from Load_Image() are already scaled while decoding
+    else if (texture_width != pixels->Get_Width() || texture_height != pixels->Get_Height()) {
+        cPixel_Buffer* scaled_pixels = cPixel_Buffer::Acquire();
+        scaled_pixels->Resize(texture_width, texture_height);
+        Downscale_Image(pixels->Get_Pixels(), pixels->Get_Width(), pixels->Get_Height(), scaled_pixels->Get_Pixels(), texture_width, texture_height);
 
-        free(new_pixels);
+        cPixel_Buffer::Release(pixels);
+        pixels = scaled_pixels;
     }
 
     // use the generated texture
@@ -1057,19 +1160,48 @@ cGL_Surface* cVideo::Create_Texture(sf::Image* p_sf_image, bool mipmap /* = 0 */
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
     // set texture magnification function
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-    // upload to OpenGL texture
-    Create_GL_Texture(texture_width, texture_height, p_sf_image->getPixelsPtr(), mipmap);
 
-    // unset pixel store mode
-    // OLD (see corresponding call further above) glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+    // memory of the compressed levels, others are counted by Set_Texture_Size()
+    size_t texture_bytes = 0;
+
+    // upload the compressed image cache levels as they are
+    if (pixels->Get_Format() == PIXEL_FORMAT_BC3) {
+        unsigned int levels = mipmap ? pixels->Get_Levels() : 1;
 
-    delete p_sf_image;
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, levels > 1 ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, levels - 1);
+
+        for (unsigned int level = 0; level < levels; level++) {
+            tsc_glCompressedTexImage2D(GL_TEXTURE_2D, level, GL_COMPRESSED_RGBA_S3TC_DXT5_EXT, pixels->Get_Level_Width(level), pixels->Get_Level_Height(level), 0, pixels->Get_Level_Size(level), pixels->Get_Level(level));
+        }
+
+        texture_bytes = cPixel_Buffer::Get_Chain_Size(texture_width, texture_height, levels, PIXEL_FORMAT_BC3);
+    }
+    // upload the mipmaps from the image cache
+    else if (mipmap && pixels->Get_Levels() > 1) {
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, pixels->Get_Levels() - 1);
+
+        for (unsigned int level = 0; level < pixels->Get_Levels(); level++) {
+            glTexImage2D(GL_TEXTURE_2D, level, GL_RGBA, pixels->Get_Level_Width(level), pixels->Get_Level_Height(level), 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels->Get_Level(level));
+        }
+    }
+    // upload to OpenGL texture
+    else {
+        Create_GL_Texture(texture_width, texture_height, pixels->Get_Pixels(), mipmap);
+    }
+
+    cPixel_Buffer::Release(pixels);
 
     // create OpenGL surface class
     cGL_Surface* image = new cGL_Surface();
-    image->m_image = image_num;
-    image->m_tex_w = texture_width;
-    image->m_tex_h = texture_height;
+    image->Set_Texture_ID(image_num);
+    image->Set_Texture_Size(texture_width, texture_height, mipmap);
+
+    if (texture_bytes) {
+        image->mp_texture->Set_Bytes(texture_bytes);
+    }
+
     image->m_start_w = static_cast<float>(width);
     image->m_start_h = static_cast<float>(height);
     image->m_w = image->m_start_w;
@@ -1123,8 +1255,10 @@ void cVideo::Create_GL_Texture(unsigned int width, unsigned int height, const vo
 Color cVideo::Get_Pixel(int x, int y) const
 {
     GLubyte* pixel = new GLubyte[3];
-    // read it
-    glReadPixels(x, y, 1, 1, GL_RGB, GL_UNSIGNED_BYTE, pixel);
+    // read it from the window
+    pVideo->m_render_thread.Run([&]() {
+        glReadPixels(x, y, 1, 1, GL_RGB, GL_UNSIGNED_BYTE, pixel);
+    });
 
     // convert to color
     Color color = Color(pixel[0], pixel[1], pixel[2]);
@@ -1136,7 +1270,9 @@ Color cVideo::Get_Pixel(int x, int y) const
 
 void cVideo::Clear_Screen(void) const
 {
-    pRenderer->Add(new cClear_Request());
+    cClear_Request* request = new cClear_Request();
+    request->m_color = m_clear_color;
+    pRenderer->Add(request);
 }
 
 void cVideo::Draw_Rect(const GL_rect* rect, float z, const Color* color, cRect_Request* request /* = NULL */) const
@@ -1348,97 +1484,15 @@ void cVideo::Apply_Max_Texture_Size(int& width, int& height) const
     }
 }
 
-/* function from Jonathan Dummer
- * from image helper functions
- * MIT license
-*/
-bool cVideo::Downscale_Image(const unsigned char* const orig, int width, int height, int channels, unsigned char* resampled, int block_size_x, int block_size_y) const
+bool cVideo::Downscale_Image(const unsigned char* const orig, int width, int height, unsigned char* resampled, int new_width, int new_height, DownscaleFilter filter /* = DOWNSCALE_FILTER_AREA */) const
 {
-    // error check
-    if (width <= 0 || height <= 0 || channels <= 0 || orig == NULL || resampled == NULL || block_size_x <= 0 || block_size_y <= 0) {
-        // invalid argument
-        return 0;
-    }
-
-    int mip_width = width / block_size_x;
-    int mip_height = height / block_size_y;
-
-    // check size
-    if (mip_width < 1) {
-        mip_width = 1;
-    }
-    if (mip_height < 1) {
-        mip_height = 1;
-    }
-
-    int j, i, c;
-
-    for (j = 0; j < mip_height; ++j) {
-        for (i = 0; i < mip_width; ++i) {
-            for (c = 0; c < channels; ++c) {
-                const int index = (j * block_size_y) * width * channels + (i * block_size_x) * channels + c;
-                int sum_value;
-                int u,v;
-                int u_block = block_size_x;
-                int v_block = block_size_y;
-                int block_area;
-
-                /* do a bit of checking so we don't over-run the boundaries
-                 * necessary for non-square textures!
-                 */
-                if (block_size_x * (i + 1) > width) {
-                    u_block = width - i * block_size_y;
-                }
-                if (block_size_y * (j + 1) > height) {
-                    v_block = height - j * block_size_y;
-                }
-                block_area = u_block * v_block;
-
-                /* for this pixel, see what the average
-                 * of all the values in the block are.
-                 * note: start the sum at the rounding value, not at 0
-                 */
-                sum_value = block_area >> 1;
-                for (v = 0; v < v_block; ++v) {
-                    for (u = 0; u < u_block; ++u) {
-                        sum_value += orig[index + v * width * channels + u * channels];
-                    }
-                }
-
-                resampled[j * mip_width * channels + i * channels + c] = sum_value / block_area;
-            }
-        }
-    }
-
-    return 1;
+    return Downscale_RGBA(orig, width, height, resampled, new_width, new_height, filter);
 }
 
 void cVideo::Save_Screenshot(void)
 {
-    Render_Finish();
-
-    fs::path filename;
-
-    for (unsigned int i = 1; i < 1000; i++) {
-        filename = pResource_Manager->Get_User_Screenshot_Directory() / utf8_to_path(int_to_string(i) + ".png");
-
-        if (!File_Exists(filename)) {
-            // create image data
-            GLubyte* data = new GLubyte[pPreferences->m_video_screen_w * pPreferences->m_video_screen_h * 3];
-            // read opengl screen
-            glReadPixels(0, 0, pPreferences->m_video_screen_w, pPreferences->m_video_screen_h, GL_RGB, GL_UNSIGNED_BYTE, static_cast<GLvoid*>(data));
-            // save
-            Save_Surface(filename, data, pPreferences->m_video_screen_w, pPreferences->m_video_screen_h, 3, 1);
-            // clear data
-            delete[] data;
-
-            // show info
-            gp_hud->Set_Text("Screenshot " + int_to_string(i) + _(" saved"));
-
-            // finished
-            return;
-        }
-    }
+    // taken when the current frame is finished
+    m_screen_capture.Request_Screenshot();
 }
 
 void cVideo::Save_Surface(const fs::path& filename, const unsigned char* data, unsigned int width, unsigned int height, unsigned int bpp /* = 4 */, bool reverse_data /* = 0 */) const
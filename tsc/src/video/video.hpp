@@ -20,6 +20,11 @@
 #include "../core/global_basic.hpp"
 #include "../core/global_game.hpp"
 #include "../video/color.hpp"
+#include "../video/screen_capture.hpp"
+#include "../video/sprite_batch.hpp"
+#include "../video/render_thread.hpp"
+#include "../video/downscale.hpp"
+#include "../video/png_decoder.hpp"
 
 namespace TSC {
 
@@ -82,17 +87,19 @@ namespace TSC {
         */
         vector<cSize_Int> Get_Supported_Resolutions(int flags = 0) const;
 
-        // make the opengl context active for the current thread
-        void Make_GL_Context_Current(void);
-        // make the opengl context inactive for the current thread
-        void Make_GL_Context_Inactive(void);
-
-        // Render. Should be called from a thread
-        void Render_From_Thread(void);
-        // Render game, GUI and swap the opengl buffer
+        /* Render game, GUI and swap the opengl buffer
+         * threaded : if the render thread runs, return without waiting for the frame
+        */
         void Render(bool threaded = 0);
-        // Finish thread rendering
+        // Wait until the render thread displayed the frame
         void Render_Finish(void);
+        // Render the world from the queue, called by Render() or the render thread
+        void Render_Queue(cRenderQueue* queue);
+        // Render the GUI on top of the world and capture the frame
+        void Render_GUI(void);
+
+        // Set the color the screen is cleared with
+        void Set_Clear_Color(const Color& color);
 
         // Toggle fullscreen video mode ( new mode is set to preferences )
         void Toggle_Fullscreen(void);
@@ -107,11 +114,30 @@ namespace TSC {
         public:
             cSoftware_Image(void)
             {
-                m_sf_image = NULL;
+                m_pixels = NULL;
+                m_width = 0;
+                m_height = 0;
+                m_image_width = 0;
+                m_image_height = 0;
+                m_cover_w = 1.0f;
+                m_cover_h = 1.0f;
+                m_opaque = 0;
                 m_settings = NULL;
             };
 
-            sf::Image* m_sf_image;
+            // texture pixels with a power of 2 size, already scaled to the texture size
+            cPixel_Buffer* m_pixels;
+            // surface size, may be larger than the texture
+            unsigned int m_width;
+            unsigned int m_height;
+            // size of the image file
+            unsigned int m_image_width;
+            unsigned int m_image_height;
+            // part of the surface covered by the pixels, see cGL_Surface
+            float m_cover_w;
+            float m_cover_h;
+            // if every pixel has full alpha
+            bool m_opaque;
             cImage_Settings_Data* m_settings;
             boost::filesystem::path m_real_png_path; /// The fully resolved path to the loaded PNG image file.
         };
@@ -120,8 +146,10 @@ namespace TSC {
          * The returned image should be deleted if not used anymore but not the settings data which is managed
          * load_settings : enable file settings if set to 1
          * print_errors : print errors if image couldn't be created or loaded
+         * settings_parser : parser for settings files not in the index, pSettingsParser if NULL.
+         *                   Other threads must pass their own.
         */
-        cSoftware_Image Load_Image(boost::filesystem::path filename, bool load_settings = 1, bool print_errors = 1) const;
+        cSoftware_Image Load_Image(boost::filesystem::path filename, bool load_settings = 1, bool print_errors = 1, cImage_Settings_Parser* settings_parser = NULL) const;
 
         /* Load and return the hardware image
          * use_settings : enable file settings if set to 1
@@ -129,22 +157,18 @@ namespace TSC {
          * The returned image should be deleted if not used anymore
         */
         cGL_Surface* Load_GL_Surface(boost::filesystem::path filename, bool use_settings = 1, bool print_errors = 1);
-
-        /* Convert to a scaled software image with a power of 2 size and 32 bits per pixel.
-         * Conversion only happens if needed.
-         * surface : the source image which gets converted if needed
-         * Do not use p_sf_image after calling this function anymore,
-         * use the returned new image instead. p_sf_image is freed by
-         * this function automatically.
+        /* Create the hardware image from an image returned by Load_Image()
+         * The software image and its settings are deleted
         */
-        sf::Image* Convert_To_Final_Software_Image(sf::Image* p_sf_image) const;
+        cGL_Surface* Create_GL_Surface(const boost::filesystem::path& filename, cSoftware_Image software_image, bool print_errors = 1);
 
-        /* Convert an SFML image to a GL image
-         * surface : the source SFML image which will be auto-deleted.
+        /* Upload the pixels to a new GL image
+         * pixels : the pixel buffer which is given back with cPixel_Buffer::Release()
+         * width/height : the surface size, the pixels are scaled down to
+         *                the maximum texture size if needed
          * mipmap : create texture mipmaps
-         * force_width/height : force the given width and height
         */
-        cGL_Surface* Create_Texture(sf::Image* p_sf_image, bool mipmap = 0, unsigned int force_width = 0, unsigned int force_height = 0) const;
+        cGL_Surface* Create_Texture(cPixel_Buffer* pixels, unsigned int width, unsigned int height, bool mipmap = 0) const;
 
         /* Copy pixels to the bound GL texture
          * mipmap : create texture mipmaps
@@ -180,13 +204,16 @@ namespace TSC {
         // scale the size down if the width or height is bigger than the maximum supported texture size
         void Apply_Max_Texture_Size(int& width, int& height) const;
 
-        /* Downscale an image
+        /* Downscale an RGBA image to the given size
          * Can be used for creating MIPmaps
-         * The incoming image should have a power-of-two size
+         * Integer ratios average each block of pixels, other ratios use
+         * the given filter. See downscale.hpp.
         */
-        bool Downscale_Image(const unsigned char* const orig, int width, int height, int channels, unsigned char* resampled, int block_size_x, int block_size_y) const;
+        bool Downscale_Image(const unsigned char* const orig, int width, int height, unsigned char* resampled, int new_width, int new_height, DownscaleFilter filter = DOWNSCALE_FILTER_AREA) const;
 
-        // Save an image of the current screen
+        /* Save an image of the current screen
+         * The image is read back and written in the background
+        */
         void Save_Screenshot(void);
         // Save data as png image
         void Save_Surface(const boost::filesystem::path& filename, const unsigned char* data, unsigned int width, unsigned int height, unsigned int bpp = 4, bool reverse_data = 0) const;
@@ -211,6 +238,10 @@ namespace TSC {
         GLint m_default_buffer;
         // max texture size
         GLint m_max_texture_size;
+        // if textures may have any size (OpenGL 2.0 or ARB_texture_non_power_of_two)
+        bool m_npot_textures;
+        // if S3TC compressed textures can be uploaded (EXT_texture_compression_s3tc)
+        bool m_s3tc_textures;
 
         // if audio initialization failed
         bool m_audio_init_failed;
@@ -219,6 +250,8 @@ namespace TSC {
 
         // active image cache directory
         boost::filesystem::path m_imgcache_dir;
+        // if the active image cache holds BC3 compressed images
+        bool m_imgcache_compressed;
 
         // geometry quality level 0.0 - 1.0
         float m_geometry_quality;
@@ -227,12 +260,23 @@ namespace TSC {
 
         sf::RenderWindow* mp_window;
 
+        // screenshots and continuous frame capturing
+        cScreen_Capture m_screen_capture;
+        // surface requests drawn with the sprite program
+        cSprite_Batch m_sprite_batch;
+        /* samples drawn by the render queue in a recent frame
+         * only measured in debug mode with OpenGL 1.5 occlusion queries
+        */
+        GLuint m_overdraw_samples;
+
 #ifdef __unix__
         // current opengl context
         GLXContext glx_context;
 #endif
-        // rendering thread
-        boost::thread m_render_thread;
+        // renders the frames if enabled, see ENABLE_RENDER_THREAD
+        cRender_Thread m_render_thread;
+        // screen clear color of the next frames
+        Color m_clear_color;
 
         // GUI System
         CEGUI::OpenGLRenderer* mp_cegui_renderer;
@@ -255,6 +299,25 @@ namespace TSC {
 
         // if set video is initialized successfully
         bool m_initialised;
+
+    private:
+        /* Decode the image file into the software image with the surface
+         * and texture size from the settings if given
+        */
+        bool Load_Image_Pixels(const boost::filesystem::path& filename, const cImage_Settings_Data* settings, cSoftware_Image& software_image) const;
+        /* Save the image or settings file scaled for this resolution below `cache_dir'
+         * if it needs to be downsampled, mipmapped or compressed.
+         * Called from several threads by Init_Image_Cache().
+        */
+        void Cache_Image(boost::filesystem::path filename, const boost::filesystem::path& cache_dir, bool compressed, cImage_Settings_Parser* settings_parser) const;
+        /* Read the finished samples query and start it for this frame
+         * Returns 0 if it is not available or still running.
+        */
+        bool Begin_Overdraw_Query(void);
+
+        GLuint m_overdraw_query;
+        // if started and the result was not read yet
+        bool m_overdraw_query_pending;
     };
 
     /* Draw an Screen Fadeout Effect